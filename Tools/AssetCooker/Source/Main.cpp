@@ -0,0 +1,503 @@
+// Cooks game assets into binary formats that load without text parsing.
+// Usage: AssetCooker <source root> <output root> [directories...] [--benchmark] [--atlas] [--atlas-page=<size>]
+// Directories are relative to the source root and default to Assets and Data. The output root mirrors the source tree and
+// every file keeps its name, so the game and AssetPacker use the cooked tree exactly like the source one:
+//   .xml, .tsx and .manifest files become cooked XML documents (actors, scenes, tilesets and scene manifests)
+//   .tmx maps become cooked maps with their tilesets embedded
+//   everything else is copied as is
+// With --atlas the small textures a scene manifest lists are also packed into atlas pages next to the scene, and the
+// cooked manifest prefetches the pages instead of them. Sprites and animations find them there through TextureAtlas.
+// The textures are still copied, tinted sprites and tilesets keep loading them
+
+#include <Logic/Map/TiledMap.h>
+#include <Application/Resources/ResourceCache.h>
+#include <Application/Graphics/Textures/TextureAtlas.h>
+#include <Application/OS/IOpSys.h>
+#include <Utils/BinaryXml.h>
+#include <Utils/Logger.h>
+#include <Utils/RectPacker.h>
+#include <Utils/TinyXml2/tinyxml2.h>
+
+// The cooker keeps its own main, SDL is only used to decode and write images
+#define SDL_MAIN_HANDLED
+#include <SDL/SDL_image.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _DEBUG
+#include <VLD/vld.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    /// How the file is cooked
+    enum class CookType
+    {
+        kXml,       ///< Cooked XML document
+        kMap,       ///< Cooked map
+        kCopy       ///< Copied as is
+    };
+
+    /// A file that was cooked
+    struct CookedFile
+    {
+        std::string m_path;     ///< Path relative to the root
+        CookType m_type;        ///< How the file was cooked
+    };
+
+    /// How the atlases are built
+    struct AtlasOptions
+    {
+        bool m_isEnabled = false;       ///< Should the small textures of every scene be packed
+        int m_pageSize = 2048;          ///< Max width and height of a page
+        int m_maxTextureSize = 256;     ///< Textures larger than this in either dimension are not packed
+        int m_padding = 2;              ///< Pixels between the packed textures, half of them repeat the texture edges against filtering bleed
+    };
+
+    using SurfacePtr = std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)>;
+
+    /// A texture to pack
+    struct AtlasImage
+    {
+        std::string m_path;             ///< Path relative to the root, as the manifest lists it
+        SurfacePtr m_pSurface;          ///< Decoded pixels
+        yang::IRect m_rect;             ///< Where it was packed
+        size_t m_page;                  ///< Page it was packed onto
+    };
+
+    /// Picks the cook type from the file extension
+    CookType GetCookType(const fs::path& path)
+    {
+        fs::path extension = path.extension();
+        if (extension == ".xml" || extension == ".tsx" || extension == ".manifest")
+            return CookType::kXml;
+        if (extension == ".tmx")
+            return CookType::kMap;
+        return CookType::kCopy;
+    }
+
+    /// Reads the whole file
+    bool ReadFile(const fs::path& path, std::vector<std::byte>& data)
+    {
+        std::ifstream inFile(path, std::ios::in | std::ios::binary);
+        if (inFile.fail())
+            return false;
+
+        inFile.seekg(0, std::ios::end);
+        data.resize(static_cast<size_t>(inFile.tellg()));
+        inFile.seekg(0, std::ios::beg);
+        inFile.read(reinterpret_cast<char*>(data.data()), data.size());
+        return !inFile.fail();
+    }
+
+    /// Writes the whole file, creating the directories on the way
+    bool WriteFile(const fs::path& path, const std::vector<std::byte>& data)
+    {
+        std::error_code error;
+        fs::create_directories(path.parent_path(), error);
+
+        std::ofstream outFile(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (outFile.fail())
+            return false;
+
+        outFile.write(reinterpret_cast<const char*>(data.data()), data.size());
+        return !outFile.fail();
+    }
+
+    /// Copies the edge pixels of a packed image into its padding, so filtering at the edges samples the image and not its neighbours
+    void ExtrudeEdges(SDL_Surface* pImage, SDL_Surface* pPage, const yang::IRect& rect, int extrude)
+    {
+        int width = rect.width;
+        int height = rect.height;
+
+        // Edges are stretched across the padding, corners are stretched from the corner pixels
+        SDL_Rect edges[][2] =
+        {
+            { { 0, 0, width, 1 }, { rect.x, rect.y - extrude, width, extrude } },
+            { { 0, height - 1, width, 1 }, { rect.x, rect.y + height, width, extrude } },
+            { { 0, 0, 1, height }, { rect.x - extrude, rect.y, extrude, height } },
+            { { width - 1, 0, 1, height }, { rect.x + width, rect.y, extrude, height } },
+            { { 0, 0, 1, 1 }, { rect.x - extrude, rect.y - extrude, extrude, extrude } },
+            { { width - 1, 0, 1, 1 }, { rect.x + width, rect.y - extrude, extrude, extrude } },
+            { { 0, height - 1, 1, 1 }, { rect.x - extrude, rect.y + height, extrude, extrude } },
+            { { width - 1, height - 1, 1, 1 }, { rect.x + width, rect.y + height, extrude, extrude } }
+        };
+
+        for (auto& edge : edges)
+        {
+            SDL_BlitScaled(pImage, &edge[0], pPage, &edge[1]);
+        }
+    }
+
+    /// Packs the small textures the scene manifest lists into atlas pages, writes the pages and the cooked atlas file next to the
+    /// cooked scene, and makes the manifest prefetch the pages instead of the packed textures
+    /// \param manifestPath - path of the manifest relative to the source root
+    /// \param outputRoot - root of the cooked tree
+    /// \param options - how to build the atlas
+    /// \param manifest - manifest document to change
+    /// \return false if a page or the atlas file failed to be written
+    bool BuildSceneAtlas(const std::string& manifestPath, const fs::path& outputRoot, const AtlasOptions& options, tinyxml2::XMLDocument& manifest)
+    {
+        using namespace tinyxml2;
+
+        constexpr std::string_view kManifestSuffix = ".manifest";
+        std::string scenePath = manifestPath.substr(0, manifestPath.size() - kManifestSuffix.size());
+
+        XMLElement* pRoot = manifest.RootElement();
+        if (!pRoot)
+            return true;
+
+        std::vector<AtlasImage> images;
+        for (XMLElement* pResource = pRoot->FirstChildElement("Resource"); pResource != nullptr; pResource = pResource->NextSiblingElement("Resource"))
+        {
+            const char* pSource = pResource->Attribute("src");
+            const char* pType = pResource->Attribute("type");
+            if (!pSource || !pType || std::string_view(pType) != "Texture")
+                continue;
+
+            SurfacePtr pLoaded(IMG_Load(pSource), &SDL_FreeSurface);
+            if (!pLoaded)
+            {
+                std::printf("Not packing %s, failed to decode: %s\n", pSource, IMG_GetError());
+                continue;
+            }
+
+            if (pLoaded->w > options.m_maxTextureSize || pLoaded->h > options.m_maxTextureSize)
+                continue;
+
+            SurfacePtr pSurface(SDL_ConvertSurfaceFormat(pLoaded.get(), SDL_PIXELFORMAT_RGBA32, 0), &SDL_FreeSurface);
+            if (!pSurface)
+                continue;
+
+            SDL_SetSurfaceBlendMode(pSurface.get(), SDL_BLENDMODE_NONE);
+            images.push_back(AtlasImage{ pSource, std::move(pSurface), {}, 0 });
+        }
+
+        // One texture gains nothing from a page
+        if (images.size() < 2)
+            return true;
+
+        // Tallest first packs the skyline tight, the path keeps the result the same from run to run
+        std::sort(images.begin(), images.end(), [](const AtlasImage& left, const AtlasImage& right)
+            {
+                if (left.m_pSurface->h != right.m_pSurface->h)
+                    return left.m_pSurface->h > right.m_pSurface->h;
+                if (left.m_pSurface->w != right.m_pSurface->w)
+                    return left.m_pSurface->w > right.m_pSurface->w;
+                return left.m_path < right.m_path;
+            });
+
+        std::vector<yang::RectPacker> pages;
+        for (AtlasImage& image : images)
+        {
+            yang::IVec2 size(image.m_pSurface->w, image.m_pSurface->h);
+            size_t page = 0;
+            for (; page < pages.size(); ++page)
+            {
+                if (pages[page].Insert(size, image.m_rect))
+                    break;
+            }
+
+            if (page == pages.size())
+            {
+                pages.emplace_back(yang::IVec2(options.m_pageSize, options.m_pageSize), options.m_padding);
+                pages.back().Insert(size, image.m_rect);
+            }
+
+            image.m_page = page;
+        }
+
+        XMLDocument atlas;
+        XMLElement* pAtlasRoot = atlas.NewElement("TextureAtlas");
+        atlas.InsertFirstChild(pAtlasRoot);
+
+        for (size_t page = 0; page < pages.size(); ++page)
+        {
+            yang::IVec2 usedSize = pages[page].GetUsedSize();
+            SurfacePtr pPage(SDL_CreateRGBSurfaceWithFormat(0, usedSize.x, usedSize.y, 32, SDL_PIXELFORMAT_RGBA32), &SDL_FreeSurface);
+            if (!pPage)
+            {
+                std::printf("Failed to create atlas page of %s: %s\n", scenePath.c_str(), SDL_GetError());
+                return false;
+            }
+
+            std::string pagePath = scenePath + yang::TextureAtlas::kFileSuffix + std::to_string(page) + ".png";
+            XMLElement* pPageData = atlas.NewElement("Page");
+            pPageData->SetAttribute("src", pagePath.c_str());
+            pAtlasRoot->InsertEndChild(pPageData);
+
+            for (AtlasImage& image : images)
+            {
+                if (image.m_page != page)
+                    continue;
+
+                SDL_Rect destination{ image.m_rect.x, image.m_rect.y, image.m_rect.width, image.m_rect.height };
+                SDL_BlitSurface(image.m_pSurface.get(), nullptr, pPage.get(), &destination);
+                if (options.m_padding / 2 > 0)
+                {
+                    ExtrudeEdges(image.m_pSurface.get(), pPage.get(), image.m_rect, options.m_padding / 2);
+                }
+
+                XMLElement* pTexture = atlas.NewElement("Texture");
+                pTexture->SetAttribute("src", image.m_path.c_str());
+                pTexture->SetAttribute("x", image.m_rect.x);
+                pTexture->SetAttribute("y", image.m_rect.y);
+                pTexture->SetAttribute("width", image.m_rect.width);
+                pTexture->SetAttribute("height", image.m_rect.height);
+                pPageData->InsertEndChild(pTexture);
+            }
+
+            fs::path pageFile = outputRoot / pagePath;
+            std::error_code error;
+            fs::create_directories(pageFile.parent_path(), error);
+            if (IMG_SavePNG(pPage.get(), pageFile.string().c_str()) != 0)
+            {
+                std::printf("Failed to write atlas page %s: %s\n", pagePath.c_str(), IMG_GetError());
+                return false;
+            }
+
+            std::printf("Atlas page %s: %dx%d, %.0f%% used\n", pagePath.c_str(), usedSize.x, usedSize.y, pages[page].GetOccupancy() * 100.f);
+        }
+
+        std::vector<std::byte> atlasData;
+        yang::WriteBinaryXml(atlas, atlasData);
+        if (!WriteFile(outputRoot / (scenePath + yang::TextureAtlas::kFileSuffix), atlasData))
+        {
+            std::printf("Failed to write atlas of %s\n", scenePath.c_str());
+            return false;
+        }
+
+        // The scene loads the pages now, prefetching the packed textures would load them for nothing
+        for (XMLElement* pResource = pRoot->FirstChildElement("Resource"); pResource != nullptr; )
+        {
+            XMLElement* pNext = pResource->NextSiblingElement("Resource");
+            const char* pSource = pResource->Attribute("src");
+            if (pSource && std::any_of(images.begin(), images.end(), [pSource](const AtlasImage& image) { return image.m_path == pSource; }))
+            {
+                pRoot->DeleteChild(pResource);
+            }
+            pResource = pNext;
+        }
+
+        for (XMLElement* pPageData = pAtlasRoot->FirstChildElement("Page"); pPageData != nullptr; pPageData = pPageData->NextSiblingElement("Page"))
+        {
+            XMLElement* pResource = manifest.NewElement("Resource");
+            pResource->SetAttribute("type", "Texture");
+            pResource->SetAttribute("src", pPageData->Attribute("src"));
+            pRoot->InsertEndChild(pResource);
+        }
+
+        std::printf("Atlas of %s: %zu textures on %zu pages\n", scenePath.c_str(), images.size(), pages.size());
+        return true;
+    }
+
+    /// Cooks the file
+    /// \param path - path relative to the current directory, which is the source root
+    /// \param type - how to cook the file
+    /// \param outputRoot - root of the cooked tree, atlas pages are written there directly
+    /// \param atlasOptions - how to build the scene atlases
+    /// \param output - cooked bytes
+    bool CookFile(const std::string& path, CookType type, const fs::path& outputRoot, const AtlasOptions& atlasOptions, std::vector<std::byte>& output)
+    {
+        switch (type)
+        {
+        case CookType::kXml:
+        {
+            std::vector<std::byte> source;
+            tinyxml2::XMLDocument doc;
+            if (!ReadFile(path, source) || yang::LoadXmlDocument(source.data(), source.size(), doc) != tinyxml2::XML_SUCCESS)
+                return false;
+
+            if (atlasOptions.m_isEnabled && fs::path(path).extension() == ".manifest" && !BuildSceneAtlas(path, outputRoot, atlasOptions, doc))
+                return false;
+
+            yang::WriteBinaryXml(doc, output);
+            return true;
+        }
+        case CookType::kMap:
+            return yang::TiledMap::CookMap(path.c_str(), output);
+        default:
+            return ReadFile(path, output);
+        }
+    }
+
+    /// Loads every cooked document and map both from the source and from the cooked tree, the way the game would, and prints the timings
+    void RunLoadBenchmark(const fs::path& outputRoot, const std::vector<CookedFile>& files)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        std::chrono::duration<float> sourceTime{};
+        std::chrono::duration<float> cookedTime{};
+        size_t sourceBytes = 0;
+        size_t cookedBytes = 0;
+        size_t fileCount = 0;
+
+        for (const CookedFile& file : files)
+        {
+            if (file.m_type == CookType::kCopy)
+                continue;
+
+            std::vector<std::byte> sourceData;
+            std::vector<std::byte> cookedData;
+            if (!ReadFile(file.m_path, sourceData) || !ReadFile(outputRoot / file.m_path, cookedData))
+                continue;
+
+            ++fileCount;
+            sourceBytes += sourceData.size();
+            cookedBytes += cookedData.size();
+
+            if (file.m_type == CookType::kXml)
+            {
+                auto start = Clock::now();
+                tinyxml2::XMLDocument sourceDoc;
+                yang::LoadXmlDocument(sourceData.data(), sourceData.size(), sourceDoc);
+                sourceTime += Clock::now() - start;
+
+                start = Clock::now();
+                tinyxml2::XMLDocument cookedDoc;
+                yang::LoadXmlDocument(cookedData.data(), cookedData.size(), cookedDoc);
+                cookedTime += Clock::now() - start;
+            }
+            else
+            {
+                // Maps are timed through CookMap, which is LoadMap without the textures. Both files are already in the
+                // resource cache after a warm up read, so only the parsing is timed
+                std::string cookedPath = (outputRoot / file.m_path).string();
+                std::vector<std::byte> unused;
+                yang::TiledMap::CookMap(cookedPath.c_str(), unused);
+
+                unused.clear();
+                auto start = Clock::now();
+                yang::TiledMap::CookMap(file.m_path.c_str(), unused);
+                sourceTime += Clock::now() - start;
+
+                unused.clear();
+                start = Clock::now();
+                yang::TiledMap::CookMap(cookedPath.c_str(), unused);
+                cookedTime += Clock::now() - start;
+            }
+        }
+
+        std::printf("Load benchmark, %zu documents and maps:\n", fileCount);
+        std::printf("  source: %zu bytes in %.2f ms\n", sourceBytes, sourceTime.count() * 1000.f);
+        std::printf("  cooked: %zu bytes in %.2f ms\n", cookedBytes, cookedTime.count() * 1000.f);
+    }
+}
+
+int main(int argc, const char** argv)
+{
+    if (argc < 3)
+    {
+        std::printf("Usage: AssetCooker <source root> <output root> [directories...] [--benchmark] [--atlas] [--atlas-page=<size>]\n");
+        return 1;
+    }
+
+    auto pSystem = yang::IOpSys::Create();
+    if (!pSystem)
+        return 1;
+
+    yang::Logger::Get()->Init(pSystem.get());
+    LOG_CATEGORY(Error, 0, Red, Light);
+
+    fs::path outputRoot = fs::absolute(argv[2]);
+    bool runBenchmark = false;
+    AtlasOptions atlasOptions;
+    std::vector<fs::path> directories;
+
+    for (int i = 3; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--benchmark") == 0)
+            runBenchmark = true;
+        else if (std::strcmp(argv[i], "--atlas") == 0)
+            atlasOptions.m_isEnabled = true;
+        else if (std::strncmp(argv[i], "--atlas-page=", 13) == 0)
+            atlasOptions.m_pageSize = std::max(std::atoi(argv[i] + 13), atlasOptions.m_maxTextureSize + atlasOptions.m_padding * 2);
+        else
+            directories.emplace_back(argv[i]);
+    }
+
+    if (directories.empty())
+    {
+        directories = { "Assets", "Data" };
+    }
+
+    // Maps load their tilesets through the resource cache with paths relative to the root, like in the game
+    std::error_code error;
+    fs::current_path(argv[1], error);
+    if (error)
+    {
+        std::printf("Failed to open source root %s: %s\n", argv[1], error.message().c_str());
+        yang::Logger::Get()->Finish();
+        return 1;
+    }
+
+    if (atlasOptions.m_isEnabled && (IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) != IMG_INIT_PNG)
+    {
+        std::printf("Failed to initialize PNG support for the atlases: %s\n", IMG_GetError());
+        yang::Logger::Get()->Finish();
+        return 1;
+    }
+
+    std::vector<CookedFile> cookedFiles;
+    size_t sourceBytes = 0;
+    size_t cookedBytes = 0;
+    bool succeeded = true;
+
+    for (const fs::path& directory : directories)
+    {
+        for (fs::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+        {
+            if (!it->is_regular_file())
+                continue;
+
+            std::string path = it->path().generic_string();
+            CookType type = GetCookType(it->path());
+            std::vector<std::byte> output;
+            if (!CookFile(path, type, outputRoot, atlasOptions, output) || !WriteFile(outputRoot / path, output))
+            {
+                std::printf("Failed to cook %s\n", path.c_str());
+                succeeded = false;
+                continue;
+            }
+
+            sourceBytes += static_cast<size_t>(it->file_size());
+            cookedBytes += output.size();
+            cookedFiles.push_back({ std::move(path), type });
+        }
+
+        if (error)
+        {
+            std::printf("Failed to read directory %s: %s\n", directory.string().c_str(), error.message().c_str());
+            succeeded = false;
+            error.clear();
+        }
+    }
+
+    std::printf("Cooked %zu files into %s: %zu bytes, %zu bytes cooked\n", cookedFiles.size(), outputRoot.string().c_str(), sourceBytes, cookedBytes);
+
+    if (succeeded && runBenchmark)
+    {
+        RunLoadBenchmark(outputRoot, cookedFiles);
+    }
+
+    if (atlasOptions.m_isEnabled)
+    {
+        IMG_Quit();
+    }
+
+    yang::ResourceCache::Get()->Cleanup();
+    yang::Logger::Get()->Finish();
+    return succeeded ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+// Packs game assets into a resource archive that ResourceCache mounts on startup.
+// Usage: AssetPacker <archive> <root directory> [directories...] [--no-compress] [--benchmark]
+// Directories are relative to the root and default to Assets and Data. Resources are stored with paths relative to the root,
+// exactly as the game loads them, so the root is the directory the game runs from.
+
+#include <Application/Resources/ResourceArchive.h>
+#include <Application/Resources/ResourceArchiveWriter.h>
+#include <Application/Resources/MappedFile.h>
+#include <Application/OS/IOpSys.h>
+#include <Utils/Logger.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef _DEBUG
+#include <VLD/vld.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    /// Reads the whole file
+    bool ReadFile(const fs::path& path, std::vector<std::byte>& data)
+    {
+        std::ifstream inFile(path, std::ios::in | std::ios::binary);
+        if (inFile.fail())
+            return false;
+
+        inFile.seekg(0, std::ios::end);
+        data.resize(static_cast<size_t>(inFile.tellg()));
+        inFile.seekg(0, std::ios::beg);
+        inFile.read(reinterpret_cast<char*>(data.data()), data.size());
+        return !inFile.fail();
+    }
+
+    /// Loads every packed file both ways, the way ResourceCache would, and prints the timings
+    void RunStartupBenchmark(const char* archivePath, const fs::path& root, const std::vector<std::string>& paths)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // Loose files: one open and map per file
+        size_t looseBytes = 0;
+        auto looseStart = Clock::now();
+        for (const std::string& path : paths)
+        {
+            if (auto pMapping = yang::MappedFile::Open((root / path).string().c_str()); pMapping != nullptr)
+            {
+                looseBytes += pMapping->GetSize();
+            }
+        }
+        std::chrono::duration<float> looseTime = Clock::now() - looseStart;
+
+        // Archive: one mapping, then a binary search and maybe a decompression per file
+        size_t archiveBytes = 0;
+        auto archiveStart = Clock::now();
+        if (auto pArchive = yang::ResourceArchive::Open(archivePath); pArchive != nullptr)
+        {
+            for (const std::string& path : paths)
+            {
+                if (auto pResource = pArchive->LoadResource(yang::ResourceArchive::NormalizePath(path.c_str())); pResource != nullptr)
+                {
+                    archiveBytes += pResource->GetData().size();
+                }
+            }
+        }
+        std::chrono::duration<float> archiveTime = Clock::now() - archiveStart;
+
+        std::printf("Startup benchmark, %zu files:\n", paths.size());
+        std::printf("  loose files: %zu bytes in %.2f ms\n", looseBytes, looseTime.count() * 1000.f);
+        std::printf("  archive:     %zu bytes in %.2f ms\n", archiveBytes, archiveTime.count() * 1000.f);
+    }
+}
+
+int main(int argc, const char** argv)
+{
+    if (argc < 3)
+    {
+        std::printf("Usage: AssetPacker <archive> <root directory> [directories...] [--no-compress] [--benchmark]\n");
+        return 1;
+    }
+
+    auto pSystem = yang::IOpSys::Create();
+    if (!pSystem)
+        return 1;
+
+    yang::Logger::Get()->Init(pSystem.get());
+    LOG_CATEGORY(Error, 0, Red, Light);
+
+    const char* archivePath = argv[1];
+    fs::path root = argv[2];
+    bool allowCompression = true;
+    bool runBenchmark = false;
+    std::vector<fs::path> directories;
+
+    for (int i = 3; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--no-compress") == 0)
+            allowCompression = false;
+        else if (std::strcmp(argv[i], "--benchmark") == 0)
+            runBenchmark = true;
+        else
+            directories.emplace_back(argv[i]);
+    }
+
+    if (directories.empty())
+    {
+        directories = { "Assets", "Data" };
+    }
+
+    yang::ResourceArchiveWriter writer;
+    std::vector<std::string> packedPaths;
+    bool succeeded = true;
+
+    for (const fs::path& directory : directories)
+    {
+        std::error_code error;
+        for (fs::recursive_directory_iterator it(root / directory, error), end; !error && it != end; it.increment(error))
+        {
+            if (!it->is_regular_file())
+                continue;
+
+            std::string path = fs::relative(it->path(), root).generic_string();
+            std::vector<std::byte> data;
+            if (!ReadFile(it->path(), data) || !writer.AddFile(path.c_str(), std::move(data), allowCompression))
+            {
+                std::printf("Failed to pack %s\n", path.c_str());
+                succeeded = false;
+                continue;
+            }
+
+            packedPaths.emplace_back(std::move(path));
+        }
+
+        if (error)
+        {
+            std::printf("Failed to read directory %s: %s\n", (root / directory).string().c_str(), error.message().c_str());
+            succeeded = false;
+        }
+    }
+
+    if (succeeded && writer.Write(archivePath))
+    {
+        std::printf("Packed %zu files into %s: %zu bytes, %zu bytes stored\n", writer.GetEntryCount(), archivePath, writer.GetOriginalBytes(), writer.GetStoredBytes());
+
+        if (runBenchmark)
+        {
+            RunStartupBenchmark(archivePath, root, packedPaths);
+        }
+    }
+    else
+    {
+        succeeded = false;
+    }
+
+    yang::Logger::Get()->Finish();
+    return succeeded ? 0 : 1;
+}
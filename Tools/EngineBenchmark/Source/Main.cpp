@@ -0,0 +1,1091 @@
+// Benchmarks engine systems on generated assets.
+// Usage: EngineBenchmark [--textures] [--maps] [--decode] [--world] [--work-dir=<path>]
+// The assets are generated into the work directory (benchmark_assets by default) on the first run and reused after.
+// Everything runs on the HeadlessRenderer, so texture loads include the image decoding and the engine side of the
+// texture creation, but not the GPU upload of SDLRenderer. Every pass runs if none is given:
+//   --textures  loads the same textures with Load and with LoadAsync, and compares the total time and the longest
+//               main thread stall of the two
+//   --maps      loads a large sprite sheet, a large Tiled map and its cooked version, with the files memory mapped and
+//               copied, cold and warm. Cold drops the files from the OS file cache first, warm has them cached. The
+//               resource cache is empty in both
+//   --decode    loads the same map with CSV, base64 and zlib compressed base64 layers, and reports the layer decoding
+//               time per million tiles. One tile in eight is flipped, and the decoded tiles and flip flags are checked
+//   --world     pans the viewport across a 4096 x 4096 tile world with 100000 actors, renders the map and queries the
+//               scene spatial index for the visible actors every frame, and reports the frame times and what was culled
+
+#include <Logic/Map/TiledMap.h>
+#include <Logic/Actor/Actor.h>
+#include <Logic/Scene/SceneSpatialIndex.h>
+#include <Application/ApplicationGlobals.h>
+#include <Application/Graphics/Viewport.h>
+#include <Application/Resources/ResourceCache.h>
+#include <Application/Graphics/IGraphics.h>
+#include <Application/Window/NullWindow.h>
+#include <Application/OS/IOpSys.h>
+#include <Utils/Logger.h>
+
+// The benchmark keeps its own main, SDL is only used to write the generated images
+#define SDL_MAIN_HANDLED
+#include <SDL/SDL_image.h>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _DEBUG
+#include <VLD/vld.h>
+#endif
+
+namespace
+{
+    namespace fs = std::filesystem;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr unsigned kSeed = 1234;                    ///< Seed of the asset generator, so runs are comparable
+    constexpr int kTextureCount = 200;                  ///< Textures loaded by the texture pass
+    constexpr int kTextureSize = 512;                   ///< Width and height of the generated textures
+    constexpr int kTextureRuns = 3;                     ///< Timed runs of every texture load mode, the best one is reported
+    constexpr int kMapSize = 1024;                      ///< Width and height of the large map in tiles
+    constexpr int kMapLayerCount = 4;                   ///< Layers of the large map
+    constexpr int kTileSize = 32;                       ///< Width and height of a tile in pixels
+    constexpr int kSheetSize = 4096;                    ///< Width and height of the sprite sheet the map tiles come from
+    constexpr int kMapRuns = 3;                         ///< Timed runs of every map load mode, the best one is reported
+    constexpr int kDecodeRuns = 5;                      ///< Timed decodes of every layer encoding, the best one is reported
+    constexpr int kWorldSize = 4096;                    ///< Width and height of the world map in tiles
+    constexpr int kWorldFrames = 600;                   ///< Frames the viewport pans across the world
+    constexpr int kWorldActorCount = 100000;            ///< Actors spread over the world
+    constexpr int kTerrainPatchSize = 8;                ///< Width and height of the world ground patches that share a tile
+
+    /// How the generated maps store the layer data
+    enum class LayerEncoding
+    {
+        kCsv,               ///< Comma separated tile IDs
+        kBase64,            ///< Base64 of the tile IDs
+        kBase64Zlib,        ///< Base64 of the zlib compressed tile IDs
+        kMaxEncodings,
+    };
+
+    /// Passes picked on the command line
+    struct Options
+    {
+        bool m_isTexturePass = false;                   ///< Run the texture load pass
+        bool m_isMapPass = false;                       ///< Run the map and sprite sheet load pass
+        bool m_isDecodePass = false;                    ///< Run the layer decoding pass
+        bool m_isWorldPass = false;                     ///< Run the world culling pass
+        fs::path m_workDirectory = "benchmark_assets";  ///< Where the generated assets are
+    };
+
+    /// Timings of a texture load run
+    struct TextureLoadResult
+    {
+        double m_totalMs = 0.0;             ///< Time from the first request until every texture was created
+        double m_mainThreadMs = 0.0;        ///< Time the main thread spent in the load calls
+        double m_maxStallMs = 0.0;          ///< Longest single load call, or longest frame of ProcessAsyncLoads
+        size_t m_frameCount = 0;            ///< Frames until every texture was created, one per load when loading synchronously
+        size_t m_loadedCount = 0;           ///< Textures that loaded
+    };
+
+    /// Timings of a map load run
+    struct MapLoadResult
+    {
+        double m_sheetMs = 0.0;             ///< Time to load the sprite sheet texture
+        double m_mapMs = 0.0;               ///< Time to load the Tiled map, its sprite sheet is already loaded
+        double m_cookedMapMs = 0.0;         ///< Time to load the cooked map, its sprite sheet is already loaded
+    };
+
+    /// Files of the map pass
+    struct MapAssets
+    {
+        std::string m_sheetPath;            ///< Sprite sheet texture
+        std::string m_tilesetPath;          ///< Tileset of the sprite sheet
+        std::string m_mapPath;              ///< Tiled map
+        std::string m_cookedMapPath;        ///< Cooked Tiled map
+    };
+
+    double ToMs(Clock::duration duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    /// Writes the whole file, creating the directories on the way
+    bool WriteFile(const fs::path& path, const void* pData, size_t size)
+    {
+        std::error_code error;
+        fs::create_directories(path.parent_path(), error);
+
+        std::ofstream outFile(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (outFile.fail())
+        {
+            LOG(Error, "Unable to write %s", path.string().c_str());
+            return false;
+        }
+
+        outFile.write(static_cast<const char*>(pData), size);
+        return !outFile.fail();
+    }
+
+    /// Drops the file from the OS file cache, so the next read goes to the disk. Best effort, the OS may keep the pages
+    /// if somebody else has the file open or mapped
+    void DropFileCache(const std::string& path)
+    {
+#ifdef _WIN32
+        // Windows purges the cached pages of a file when it's opened without buffering
+        HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_NO_BUFFERING, nullptr);
+        if (hFile != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(hFile);
+        }
+#else
+        int file = open(path.c_str(), O_RDONLY);
+        if (file >= 0)
+        {
+            posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED);
+            close(file);
+        }
+#endif
+    }
+
+    /// Writes a noisy gradient, so the PNGs compress and decode like real textures rather than flat color
+    bool GenerateTexture(const fs::path& path, int size, std::mt19937& random)
+    {
+        SDL_Surface* pSurface = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!pSurface)
+        {
+            LOG(Error, "Unable to create %dx%d surface, %s", size, size, SDL_GetError());
+            return false;
+        }
+
+        std::uniform_int_distribution<int> noise(0, 31);
+        int hue = static_cast<int>(random() % 192);
+        for (int y = 0; y < size; ++y)
+        {
+            uint8_t* pRow = static_cast<uint8_t*>(pSurface->pixels) + static_cast<size_t>(y) * pSurface->pitch;
+            for (int x = 0; x < size; ++x)
+            {
+                pRow[x * 4 + 0] = static_cast<uint8_t>(hue + noise(random));
+                pRow[x * 4 + 1] = static_cast<uint8_t>(x * 192 / size + noise(random));
+                pRow[x * 4 + 2] = static_cast<uint8_t>(y * 192 / size + noise(random));
+                pRow[x * 4 + 3] = 255;
+            }
+        }
+
+        bool isSaved = IMG_SavePNG(pSurface, path.string().c_str()) == 0;
+        if (!isSaved)
+        {
+            LOG(Error, "Unable to write %s, %s", path.string().c_str(), IMG_GetError());
+        }
+        SDL_FreeSurface(pSurface);
+        return isSaved;
+    }
+
+    /// Generates the textures that don't exist yet
+    /// \return paths of the textures, empty if generating failed
+    std::vector<std::string> PrepareTextures(const fs::path& workDirectory)
+    {
+        fs::path directory = workDirectory / "textures";
+        std::error_code error;
+        fs::create_directories(directory, error);
+
+        std::mt19937 random(kSeed);
+        std::vector<std::string> paths;
+        for (int i = 0; i < kTextureCount; ++i)
+        {
+            char name[32];
+            std::snprintf(name, sizeof(name), "texture_%03d.png", i);
+            fs::path path = directory / name;
+            if (!fs::exists(path) && !GenerateTexture(path, kTextureSize, random))
+                return {};
+
+            paths.emplace_back(path.generic_string());
+        }
+        return paths;
+    }
+
+    /// Loads every texture with Load, one after another
+    TextureLoadResult LoadTexturesSync(const std::vector<std::string>& paths)
+    {
+        yang::ResourceCache* pCache = yang::ResourceCache::Get();
+        TextureLoadResult result;
+        std::vector<std::shared_ptr<yang::ITexture>> textures;
+
+        auto startTime = Clock::now();
+        for (const std::string& path : paths)
+        {
+            auto loadStartTime = Clock::now();
+            auto pTexture = pCache->Load<yang::ITexture>(path.c_str());
+            result.m_maxStallMs = std::max(result.m_maxStallMs, ToMs(Clock::now() - loadStartTime));
+
+            if (pTexture)
+            {
+                ++result.m_loadedCount;
+                textures.emplace_back(std::move(pTexture));
+            }
+        }
+
+        result.m_totalMs = ToMs(Clock::now() - startTime);
+        result.m_mainThreadMs = result.m_totalMs;
+        result.m_frameCount = paths.size();
+        return result;
+    }
+
+    /// Requests every texture with LoadAsync in one frame, then runs frames until ProcessAsyncLoads created all of them.
+    /// The frames only process the loads, so the total is the shortest time the workers and the uploads need
+    TextureLoadResult LoadTexturesAsync(const std::vector<std::string>& paths)
+    {
+        yang::ResourceCache* pCache = yang::ResourceCache::Get();
+        TextureLoadResult result;
+        std::vector<yang::ResourceHandle<yang::ITexture>> handles;
+        handles.reserve(paths.size());
+
+        auto startTime = Clock::now();
+        for (const std::string& path : paths)
+        {
+            handles.emplace_back(pCache->LoadAsync<yang::ITexture>(path.c_str()));
+        }
+        result.m_mainThreadMs = ToMs(Clock::now() - startTime);
+        result.m_maxStallMs = result.m_mainThreadMs;
+        result.m_frameCount = 1;
+
+        while (pCache->GetPendingLoadCount() > 0)
+        {
+            auto frameStartTime = Clock::now();
+            pCache->ProcessAsyncLoads();
+            double frameMs = ToMs(Clock::now() - frameStartTime);
+
+            result.m_mainThreadMs += frameMs;
+            result.m_maxStallMs = std::max(result.m_maxStallMs, frameMs);
+            ++result.m_frameCount;
+
+            // Give the workers the core between frames, like the rest of a real frame would
+            std::this_thread::yield();
+        }
+
+        result.m_totalMs = ToMs(Clock::now() - startTime);
+        result.m_loadedCount = std::count_if(handles.begin(), handles.end(), [](const auto& handle) { return handle.Get() != nullptr; });
+        return result;
+    }
+
+    void PrintTextureResult(const char* pName, const TextureLoadResult& result)
+    {
+        std::printf("  %-8s %10.2f %12.2f %10.3f %8zu %8zu\n", pName, result.m_totalMs, result.m_mainThreadMs, result.m_maxStallMs, result.m_frameCount, result.m_loadedCount);
+    }
+
+    /// Picks the run with the shortest total time
+    TextureLoadResult Best(const TextureLoadResult& left, const TextureLoadResult& right)
+    {
+        return (left.m_frameCount == 0 || right.m_totalMs < left.m_totalMs) ? right : left;
+    }
+
+    /// Runs the texture pass. Every run starts from an empty resource cache, the files themselves stay in the OS file
+    /// cache after the warm up run, so the runs compare decoding and creation rather than the disk
+    bool RunTexturePass(const Options& options, yang::IGraphics* pGraphics)
+    {
+        std::vector<std::string> paths = PrepareTextures(options.m_workDirectory);
+        if (paths.empty())
+            return false;
+
+        yang::ResourceCache* pCache = yang::ResourceCache::Get();
+        auto runOnce = [pCache, pGraphics, &paths](auto loadFunction)
+        {
+            pCache->Init(pGraphics, nullptr, nullptr);
+            TextureLoadResult result = loadFunction(paths);
+            pCache->Cleanup();
+            return result;
+        };
+
+        runOnce(LoadTexturesSync);
+
+        TextureLoadResult syncResult;
+        TextureLoadResult asyncResult;
+        for (int run = 0; run < kTextureRuns; ++run)
+        {
+            syncResult = Best(syncResult, runOnce(LoadTexturesSync));
+            asyncResult = Best(asyncResult, runOnce(LoadTexturesAsync));
+        }
+
+        std::printf("%zu textures of %d x %d, %zu upload(s) per frame, best of %d runs\n", paths.size(), kTextureSize, kTextureSize,
+            pCache->GetMaxUploadsPerFrame(), kTextureRuns);
+        std::printf("  %-8s %10s %12s %10s %8s %8s\n", "mode", "total ms", "main thr ms", "stall ms", "frames", "loaded");
+        PrintTextureResult("sync", syncResult);
+        PrintTextureResult("async", asyncResult);
+        return syncResult.m_loadedCount == paths.size() && asyncResult.m_loadedCount == paths.size();
+    }
+
+    /// Encodes the bytes as base64 text with padding
+    std::string EncodeBase64(const std::vector<std::byte>& data)
+    {
+        static constexpr char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        std::string text;
+        text.reserve((data.size() + 2) / 3 * 4);
+        for (size_t i = 0; i < data.size(); i += 3)
+        {
+            uint32_t group = static_cast<uint32_t>(data[i]) << 16;
+            if (i + 1 < data.size())
+                group |= static_cast<uint32_t>(data[i + 1]) << 8;
+            if (i + 2 < data.size())
+                group |= static_cast<uint32_t>(data[i + 2]);
+
+            text += kAlphabet[(group >> 18) & 63];
+            text += kAlphabet[(group >> 12) & 63];
+            text += (i + 1 < data.size()) ? kAlphabet[(group >> 6) & 63] : '=';
+            text += (i + 2 < data.size()) ? kAlphabet[group & 63] : '=';
+        }
+        return text;
+    }
+
+    /// Writes the bits of a deflate stream, least significant bit first
+    class DeflateBitWriter
+    {
+    public:
+        DeflateBitWriter(std::vector<std::byte>& output) : m_output(output) {}
+
+        /// Writes the lowest bitCount bits of value
+        void Write(uint32_t value, int bitCount)
+        {
+            m_bits |= static_cast<uint64_t>(value) << m_bitCount;
+            m_bitCount += bitCount;
+            while (m_bitCount >= 8)
+            {
+                m_output.push_back(static_cast<std::byte>(m_bits & 0xFF));
+                m_bits >>= 8;
+                m_bitCount -= 8;
+            }
+        }
+
+        /// Writes a Huffman code, they are stored most significant bit first
+        void WriteCode(uint32_t code, int bitCount)
+        {
+            uint32_t reversed = 0;
+            for (int i = 0; i < bitCount; ++i)
+            {
+                reversed |= ((code >> i) & 1) << (bitCount - 1 - i);
+            }
+            Write(reversed, bitCount);
+        }
+
+        /// Pads the last byte with zero bits
+        void Flush()
+        {
+            if (m_bitCount > 0)
+            {
+                Write(0, 8 - m_bitCount);
+            }
+        }
+
+    private:
+        std::vector<std::byte>& m_output;   ///< Bytes of the stream
+        uint64_t m_bits = 0;                ///< Bits not written to the output yet
+        int m_bitCount = 0;                 ///< Number of bits not written to the output yet
+    };
+
+    /// Writes a literal or length symbol with the fixed Huffman codes of deflate
+    void WriteFixedLiteral(DeflateBitWriter& writer, int symbol)
+    {
+        if (symbol < 144)
+            writer.WriteCode(0x30 + symbol, 8);
+        else if (symbol < 256)
+            writer.WriteCode(0x190 + symbol - 144, 9);
+        else if (symbol < 280)
+            writer.WriteCode(symbol - 256, 7);
+        else
+            writer.WriteCode(0xC0 + symbol - 280, 8);
+    }
+
+    /// Compresses the data into a zlib stream. One deflate block with the fixed Huffman codes and greedy hash chain
+    /// matching. Far from what zlib achieves, but Tiled writes the same container and Inflate takes the same path
+    std::vector<std::byte> CompressZlib(const std::vector<std::byte>& data)
+    {
+        static constexpr int kLengthBase[] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        static constexpr int kLengthExtraBits[] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+        static constexpr int kDistanceBase[] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+        static constexpr int kDistanceExtraBits[] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+        constexpr size_t kWindowSize = 32768;
+        constexpr size_t kMinMatch = 3;
+        constexpr size_t kMaxMatch = 258;
+        constexpr int kHashBits = 15;
+        constexpr int kMaxChainLength = 16;
+        constexpr size_t kNoPosition = ~size_t(0);
+
+        // zlib header: deflate with a 32K window, no dictionary, fastest compression
+        std::vector<std::byte> output = { std::byte{ 0x78 }, std::byte{ 0x01 } };
+        DeflateBitWriter writer(output);
+        writer.Write(1, 1);     // Final block
+        writer.Write(1, 2);     // Fixed Huffman codes
+
+        auto hashAt = [&data](size_t position)
+        {
+            uint32_t value = static_cast<uint32_t>(data[position]) | (static_cast<uint32_t>(data[position + 1]) << 8) | (static_cast<uint32_t>(data[position + 2]) << 16);
+            return (value * 2654435761u) >> (32 - kHashBits);
+        };
+
+        // Chains only reach a window back, so the previous positions fit in a ring of the window size
+        std::vector<size_t> head(size_t(1) << kHashBits, kNoPosition);
+        std::vector<size_t> previous(kWindowSize, kNoPosition);
+        auto insert = [&](size_t position)
+        {
+            if (position + kMinMatch > data.size())
+                return;
+
+            uint32_t hash = hashAt(position);
+            previous[position % kWindowSize] = head[hash];
+            head[hash] = position;
+        };
+
+        for (size_t position = 0; position < data.size();)
+        {
+            size_t bestLength = 0;
+            size_t bestDistance = 0;
+            if (position + kMinMatch <= data.size())
+            {
+                size_t maxLength = std::min(kMaxMatch, data.size() - position);
+                size_t candidate = head[hashAt(position)];
+                for (int chain = 0; chain < kMaxChainLength && candidate != kNoPosition && position - candidate < kWindowSize; ++chain)
+                {
+                    size_t length = 0;
+                    while (length < maxLength && data[candidate + length] == data[position + length])
+                    {
+                        ++length;
+                    }
+
+                    if (length > bestLength)
+                    {
+                        bestLength = length;
+                        bestDistance = position - candidate;
+                        if (length == maxLength)
+                            break;
+                    }
+                    candidate = previous[candidate % kWindowSize];
+                }
+            }
+
+            if (bestLength < kMinMatch)
+            {
+                WriteFixedLiteral(writer, static_cast<int>(data[position]));
+                insert(position);
+                ++position;
+                continue;
+            }
+
+            int lengthCode = static_cast<int>(std::upper_bound(std::begin(kLengthBase), std::end(kLengthBase), static_cast<int>(bestLength)) - std::begin(kLengthBase)) - 1;
+            WriteFixedLiteral(writer, 257 + lengthCode);
+            writer.Write(static_cast<uint32_t>(bestLength - kLengthBase[lengthCode]), kLengthExtraBits[lengthCode]);
+
+            int distanceCode = static_cast<int>(std::upper_bound(std::begin(kDistanceBase), std::end(kDistanceBase), static_cast<int>(bestDistance)) - std::begin(kDistanceBase)) - 1;
+            writer.WriteCode(static_cast<uint32_t>(distanceCode), 5);
+            writer.Write(static_cast<uint32_t>(bestDistance - kDistanceBase[distanceCode]), kDistanceExtraBits[distanceCode]);
+
+            for (size_t i = 0; i < bestLength; ++i)
+            {
+                insert(position + i);
+            }
+            position += bestLength;
+        }
+
+        WriteFixedLiteral(writer, 256);
+        writer.Flush();
+
+        // Adler-32 of the uncompressed data, big endian
+        uint32_t sumA = 1;
+        uint32_t sumB = 0;
+        for (std::byte value : data)
+        {
+            sumA = (sumA + static_cast<uint32_t>(value)) % 65521;
+            sumB = (sumB + sumA) % 65521;
+        }
+        uint32_t adler = (sumB << 16) | sumA;
+        for (int shift = 24; shift >= 0; shift -= 8)
+        {
+            output.push_back(static_cast<std::byte>((adler >> shift) & 0xFF));
+        }
+        return output;
+    }
+
+    /// Picks the global tile ID of a map tile, 0 for no tile. Called for every layer in the row order
+    using TileGenerator = std::function<uint32_t(int layer, int x, int y)>;
+
+    /// Number of tiles in the sprite sheet tileset
+    constexpr int kSheetTileCount = (kSheetSize / kTileSize) * (kSheetSize / kTileSize);
+
+    /// Picks uniformly random tiles of the sprite sheet
+    TileGenerator RandomTiles(std::mt19937& random)
+    {
+        return [&random, tileId = std::uniform_int_distribution<uint32_t>(1, kSheetTileCount)](int, int, int) mutable { return tileId(random); };
+    }
+
+    /// Picks random tiles of the sprite sheet like RandomTiles, and gives one tile in eight random flip flags.
+    /// Tiled stores them in the top 3 bits of the global tile ID
+    TileGenerator FlippedTiles(std::mt19937& random)
+    {
+        return [&random, tileId = std::uniform_int_distribution<uint32_t>(1, kSheetTileCount), flags = std::uniform_int_distribution<uint32_t>(1, 7)](int, int, int) mutable
+            {
+                uint32_t id = tileId(random);
+                return (random() % 8 == 0) ? id | (flags(random) << 29) : id;
+            };
+    }
+
+    /// Compares the tiles of a loaded map with the generator that wrote it
+    /// \return true if every tile has the generated ID and flip flags
+    bool CheckDecodedTiles(const yang::TiledMap& map, int size, int layerCount, const TileGenerator& tileAt)
+    {
+        for (int layer = 0; layer < layerCount; ++layer)
+        {
+            for (int y = 0; y < size; ++y)
+            {
+                for (int x = 0; x < size; ++x)
+                {
+                    uint32_t gid = tileAt(layer, x, y);
+                    size_t index = static_cast<size_t>(y) * size + x;
+                    if (map.GetTileIdFromIndex(layer, index) + 1 != (gid & yang::TiledMap::kTileIdMask) || map.GetTileFlipsFromIndex(layer, index) != (gid >> 29))
+                    {
+                        std::printf("Layer %d tile %d, %d decoded as %zu with flips %u, expected %u\n", layer, x, y, map.GetTileIdFromIndex(layer, index) + 1,
+                            static_cast<unsigned>(map.GetTileFlipsFromIndex(layer, index)), gid);
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    /// Writes a Tiled map with the tiles of the generator. Every layer is encoded the same way
+    bool GenerateMap(const fs::path& path, const char* pTilesetName, int size, int layerCount, LayerEncoding encoding, const TileGenerator& tileAt)
+    {
+        std::string text;
+        text.reserve(static_cast<size_t>(size) * size * layerCount * 6 + 1024);
+
+        char line[256];
+        std::snprintf(line, sizeof(line), "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<map version=\"1.2\" orientation=\"orthogonal\" renderorder=\"right-down\" width=\"%d\" height=\"%d\" tilewidth=\"%d\" tileheight=\"%d\">\n"
+            " <tileset firstgid=\"1\" source=\"%s\"/>\n", size, size, kTileSize, kTileSize, pTilesetName);
+        text += line;
+
+        static constexpr const char* kDataAttributes[] = { "encoding=\"csv\"", "encoding=\"base64\"", "encoding=\"base64\" compression=\"zlib\"" };
+        for (int layer = 0; layer < layerCount; ++layer)
+        {
+            std::snprintf(line, sizeof(line), " <layer id=\"%d\" name=\"Layer %d\" width=\"%d\" height=\"%d\">\n  <data %s>\n",
+                layer + 1, layer + 1, size, size, kDataAttributes[static_cast<size_t>(encoding)]);
+            text += line;
+
+            if (encoding == LayerEncoding::kCsv)
+            {
+                for (int y = 0; y < size; ++y)
+                {
+                    for (int x = 0; x < size; ++x)
+                    {
+                        text += std::to_string(tileAt(layer, x, y));
+                        if (x + 1 < size || y + 1 < size)
+                        {
+                            text += ',';
+                        }
+                    }
+                    text += '\n';
+                }
+            }
+            else
+            {
+                // Little endian 32 bit global tile IDs
+                std::vector<std::byte> tiles;
+                tiles.reserve(static_cast<size_t>(size) * size * 4);
+                for (int y = 0; y < size; ++y)
+                {
+                    for (int x = 0; x < size; ++x)
+                    {
+                        uint32_t id = tileAt(layer, x, y);
+                        for (int shift = 0; shift < 32; shift += 8)
+                        {
+                            tiles.push_back(static_cast<std::byte>((id >> shift) & 0xFF));
+                        }
+                    }
+                }
+
+                text += "   ";
+                text += EncodeBase64(encoding == LayerEncoding::kBase64Zlib ? CompressZlib(tiles) : tiles);
+                text += '\n';
+            }
+            text += "  </data>\n </layer>\n";
+        }
+        text += "</map>\n";
+
+        return WriteFile(path, text.data(), text.size());
+    }
+
+    /// Generates the sprite sheet, its tileset, the map and the cooked map if they don't exist yet
+    /// \return false if generating failed
+    bool PrepareMaps(const fs::path& workDirectory, MapAssets& assets)
+    {
+        fs::path directory = workDirectory / "maps";
+        assets.m_sheetPath = (directory / "sheet.png").generic_string();
+        assets.m_tilesetPath = (directory / "sheet.tsx").generic_string();
+        assets.m_mapPath = (directory / "large.tmx").generic_string();
+        // The format version is in the name, so a cooked map of an older engine is cooked again
+        assets.m_cookedMapPath = (directory / ("large_cooked_v" + std::to_string(yang::TiledMap::kCookedMapVersion) + ".tmx")).generic_string();
+
+        std::error_code error;
+        fs::create_directories(directory, error);
+
+        std::mt19937 random(kSeed);
+        if (!fs::exists(assets.m_sheetPath) && !GenerateTexture(assets.m_sheetPath, kSheetSize, random))
+            return false;
+
+        if (!fs::exists(assets.m_tilesetPath))
+        {
+            char text[512];
+            int columns = kSheetSize / kTileSize;
+            int length = std::snprintf(text, sizeof(text), "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                "<tileset version=\"1.2\" name=\"sheet\" tilewidth=\"%d\" tileheight=\"%d\" tilecount=\"%d\" columns=\"%d\">\n"
+                " <image source=\"sheet.png\" width=\"%d\" height=\"%d\"/>\n</tileset>\n",
+                kTileSize, kTileSize, columns * columns, columns, kSheetSize, kSheetSize);
+            if (!WriteFile(assets.m_tilesetPath, text, static_cast<size_t>(length)))
+                return false;
+        }
+
+        if (!fs::exists(assets.m_mapPath) && !GenerateMap(assets.m_mapPath, "sheet.tsx", kMapSize, kMapLayerCount, LayerEncoding::kCsv, RandomTiles(random)))
+            return false;
+
+        if (!fs::exists(assets.m_cookedMapPath))
+        {
+            std::vector<std::byte> cookedMap;
+            bool isCooked = yang::TiledMap::CookMap(assets.m_mapPath.c_str(), cookedMap);
+            yang::ResourceCache::Get()->Cleanup();
+            if (!isCooked || !WriteFile(assets.m_cookedMapPath, cookedMap.data(), cookedMap.size()))
+                return false;
+        }
+
+        return true;
+    }
+
+    /// Loads the sprite sheet, then the map and the cooked map, each timed separately. Starts from an empty resource cache
+    /// \param isCold - drop the files from the OS file cache first
+    MapLoadResult LoadMaps(const MapAssets& assets, yang::IGraphics* pGraphics, bool isMapped, bool isCold)
+    {
+        yang::ResourceCache* pCache = yang::ResourceCache::Get();
+        pCache->Init(pGraphics, nullptr, nullptr);
+        pCache->SetUseMappedFiles(isMapped);
+
+        if (isCold)
+        {
+            for (const std::string* pPath : { &assets.m_sheetPath, &assets.m_tilesetPath, &assets.m_mapPath, &assets.m_cookedMapPath })
+            {
+                DropFileCache(*pPath);
+            }
+        }
+
+        MapLoadResult result;
+        {
+            auto startTime = Clock::now();
+            auto pSheet = pCache->Load<yang::ITexture>(assets.m_sheetPath.c_str());
+            result.m_sheetMs = ToMs(Clock::now() - startTime);
+
+            startTime = Clock::now();
+            yang::TiledMap map;
+            map.LoadMap(assets.m_mapPath.c_str());
+            result.m_mapMs = ToMs(Clock::now() - startTime);
+
+            startTime = Clock::now();
+            yang::TiledMap cookedMap;
+            cookedMap.LoadMap(assets.m_cookedMapPath.c_str());
+            result.m_cookedMapMs = ToMs(Clock::now() - startTime);
+        }
+
+        pCache->Cleanup();
+        pCache->SetUseMappedFiles(true);
+        return result;
+    }
+
+    /// Runs the map pass
+    bool RunMapPass(const Options& options, yang::IGraphics* pGraphics)
+    {
+        MapAssets assets;
+        if (!PrepareMaps(options.m_workDirectory, assets))
+            return false;
+
+        auto fileMb = [](const std::string& path)
+        {
+            std::error_code error;
+            return static_cast<double>(fs::file_size(path, error)) / (1024.0 * 1024.0);
+        };
+
+        std::printf("%d x %d map of %d layers (%.1f MB tmx, %.1f MB cooked), %d x %d sprite sheet (%.1f MB png), best of %d runs\n",
+            kMapSize, kMapSize, kMapLayerCount, fileMb(assets.m_mapPath), fileMb(assets.m_cookedMapPath), kSheetSize, kSheetSize,
+            fileMb(assets.m_sheetPath), kMapRuns);
+        std::printf("  %-8s %-6s %10s %10s %14s\n", "files", "cache", "sheet ms", "tmx ms", "cooked ms");
+
+        // Warms the OS file cache up
+        LoadMaps(assets, pGraphics, false, false);
+
+        for (bool isMapped : { false, true })
+        {
+            for (bool isCold : { true, false })
+            {
+                MapLoadResult best;
+                for (int run = 0; run < kMapRuns; ++run)
+                {
+                    MapLoadResult result = LoadMaps(assets, pGraphics, isMapped, isCold);
+                    best.m_sheetMs = (run == 0) ? result.m_sheetMs : std::min(best.m_sheetMs, result.m_sheetMs);
+                    best.m_mapMs = (run == 0) ? result.m_mapMs : std::min(best.m_mapMs, result.m_mapMs);
+                    best.m_cookedMapMs = (run == 0) ? result.m_cookedMapMs : std::min(best.m_cookedMapMs, result.m_cookedMapMs);
+                }
+
+                std::printf("  %-8s %-6s %10.2f %10.2f %14.2f\n", isMapped ? "mapped" : "copied", isCold ? "cold" : "warm",
+                    best.m_sheetMs, best.m_mapMs, best.m_cookedMapMs);
+            }
+        }
+        return true;
+    }
+
+    /// Runs the layer decoding pass. The maps stay in the resource cache between the runs, so only decoding is timed
+    bool RunDecodePass(const Options& options, yang::IGraphics* pGraphics)
+    {
+        MapAssets assets;
+        if (!PrepareMaps(options.m_workDirectory, assets))
+            return false;
+
+        static constexpr const char* kEncodingNames[] = { "csv", "base64", "zlib" };
+        static_assert(std::size(kEncodingNames) == static_cast<size_t>(LayerEncoding::kMaxEncodings), "Every encoding needs a name");
+
+        // Same seed for every encoding, so the maps have the same tiles. Some of them are flipped, which every encoding keeps in the IDs
+        std::vector<std::string> paths;
+        for (size_t encoding = 0; encoding < std::size(kEncodingNames); ++encoding)
+        {
+            fs::path path = options.m_workDirectory / "maps" / (std::string("decode_flipped_") + kEncodingNames[encoding] + ".tmx");
+            std::mt19937 random(kSeed);
+            if (!fs::exists(path) && !GenerateMap(path, "sheet.tsx", kMapSize, kMapLayerCount, static_cast<LayerEncoding>(encoding), FlippedTiles(random)))
+                return false;
+
+            paths.emplace_back(path.generic_string());
+        }
+
+        double tileMillions = static_cast<double>(kMapSize) * kMapSize * kMapLayerCount / 1000000.0;
+        std::printf("%d x %d map of %d layers, %.2f million tiles, best of %d runs\n", kMapSize, kMapSize, kMapLayerCount, tileMillions, kDecodeRuns);
+        std::printf("  %-8s %10s %10s %16s\n", "encoding", "file MB", "decode ms", "ms per M tiles");
+
+        yang::ResourceCache* pCache = yang::ResourceCache::Get();
+        pCache->Init(pGraphics, nullptr, nullptr);
+
+        bool succeeded = true;
+        for (size_t encoding = 0; encoding < paths.size(); ++encoding)
+        {
+            double bestMs = 0.0;
+            for (int run = 0; run <= kDecodeRuns; ++run)
+            {
+                yang::TiledMap map;
+                if (!map.LoadMap(paths[encoding].c_str()))
+                {
+                    succeeded = false;
+                    break;
+                }
+
+                // The first run reads the file into the resource cache and isn't counted, it checks the tiles instead
+                if (run == 0)
+                {
+                    std::mt19937 random(kSeed);
+                    if (!CheckDecodedTiles(map, kMapSize, kMapLayerCount, FlippedTiles(random)))
+                    {
+                        std::printf("%s layer data decoded wrong\n", kEncodingNames[encoding]);
+                        succeeded = false;
+                        break;
+                    }
+                }
+
+                double decodeMs = map.GetLayerDecodeMs();
+                if (run == 1 || (run > 1 && decodeMs < bestMs))
+                {
+                    bestMs = decodeMs;
+                }
+            }
+
+            std::error_code error;
+            double fileMb = static_cast<double>(fs::file_size(paths[encoding], error)) / (1024.0 * 1024.0);
+            std::printf("  %-8s %10.1f %10.2f %16.2f\n", kEncodingNames[encoding], fileMb, bestMs, bestMs / tileMillions);
+        }
+
+        pCache->Cleanup();
+        return succeeded;
+    }
+
+    /// Frame times of the world pass
+    struct WorldFrameResult
+    {
+        double m_totalMs = 0.0;             ///< Time of all frames
+        double m_maxMs = 0.0;               ///< Time of the slowest frame
+        size_t m_drawnCount = 0;            ///< Objects drawn or found visible by all frames
+        size_t m_culledCount = 0;           ///< Objects skipped by all frames
+
+        /// Adds the time of a frame
+        void AddFrame(double frameMs)
+        {
+            m_totalMs += frameMs;
+            m_maxMs = std::max(m_maxMs, frameMs);
+        }
+    };
+
+    /// Generates the world map if it doesn't exist yet. The ground layer is patches of a few terrain tiles, the second
+    /// layer has a decoration on every tenth tile. Layers are zlib compressed, like Tiled saves large maps
+    /// \return path of the map, empty if generating failed
+    std::string PrepareWorld(const fs::path& workDirectory)
+    {
+        MapAssets assets;
+        if (!PrepareMaps(workDirectory, assets))
+            return {};
+
+        fs::path path = workDirectory / "maps" / "world.tmx";
+        if (fs::exists(path))
+            return path.generic_string();
+
+        constexpr uint32_t kTerrainTileCount = 16;
+        std::mt19937 random(kSeed);
+        std::uniform_int_distribution<uint32_t> decoration(kTerrainTileCount + 1, kSheetTileCount);
+        std::uniform_int_distribution<int> chance(0, 9);
+        auto tileAt = [&](int layer, int x, int y) -> uint32_t
+        {
+            if (layer == 0)
+            {
+                uint32_t patch = static_cast<uint32_t>(x / kTerrainPatchSize) * 73856093u ^ static_cast<uint32_t>(y / kTerrainPatchSize) * 19349663u;
+                return 1 + patch % kTerrainTileCount;
+            }
+            return chance(random) == 0 ? decoration(random) : 0;
+        };
+
+        if (!GenerateMap(path, "sheet.tsx", kWorldSize, 2, LayerEncoding::kBase64Zlib, tileAt))
+            return {};
+
+        return path.generic_string();
+    }
+
+    /// Spreads the actors over the world and adds their render bounds to the spatial index
+    void CreateWorldActors(std::vector<std::unique_ptr<yang::Actor>>& actors, std::vector<yang::FRect>& bounds, yang::SceneSpatialIndex& spatialIndex)
+    {
+        constexpr float kWorldPixels = static_cast<float>(kWorldSize * kTileSize);
+        std::mt19937 random(kSeed);
+        std::uniform_real_distribution<float> position(0.f, kWorldPixels);
+        std::uniform_real_distribution<float> size(16.f, 128.f);
+
+        for (int i = 0; i < kWorldActorCount; ++i)
+        {
+            actors.emplace_back(std::make_unique<yang::Actor>(static_cast<yang::Id>(i + 1), nullptr));
+            bounds.emplace_back(position(random), position(random), size(random), size(random));
+            spatialIndex.Add(actors.back().get(), bounds.back());
+        }
+    }
+
+    /// Runs the world pass. The viewport moves diagonally across the world and back, every frame renders the map and
+    /// finds the visible actors twice, through the spatial index and by testing the bounds of every actor
+    bool RunWorldPass(const Options& options, yang::IGraphics* pGraphics)
+    {
+        std::string mapPath = PrepareWorld(options.m_workDirectory);
+        if (mapPath.empty())
+            return false;
+
+        yang::ResourceCache* pCache = yang::ResourceCache::Get();
+        pCache->Init(pGraphics, nullptr, nullptr);
+
+        bool succeeded = false;
+        {
+            auto loadStartTime = Clock::now();
+            yang::TiledMap map;
+            if (!map.LoadMap(mapPath.c_str()))
+            {
+                pCache->Cleanup();
+                return false;
+            }
+            double loadMs = ToMs(Clock::now() - loadStartTime);
+
+            std::vector<std::unique_ptr<yang::Actor>> actors;
+            std::vector<yang::FRect> actorBounds;
+            yang::SceneSpatialIndex spatialIndex;
+            CreateWorldActors(actors, actorBounds, spatialIndex);
+
+            yang::Viewport& viewport = yang::GetGlobalViewport();
+            yang::Viewport savedViewport = viewport;
+
+            WorldFrameResult mapResult;
+            WorldFrameResult indexResult;
+            WorldFrameResult scanResult;
+            std::vector<yang::Actor*> visibleActors;
+            size_t mismatchCount = 0;
+            succeeded = true;
+
+            float worldPixels = static_cast<float>(kWorldSize * kTileSize);
+            yang::FVec2 halfScreen = viewport.GetDimensions() / 2.f;
+            for (int frame = 0; frame < kWorldFrames && succeeded; ++frame)
+            {
+                // There and back again, so chunks that left the screen are drawn once more after they were released
+                float progress = static_cast<float>(frame) / (kWorldFrames / 2);
+                progress = progress <= 1.f ? progress : 2.f - progress;
+                viewport.FocusOn(halfScreen + (yang::FVec2(worldPixels, worldPixels) - halfScreen * 2.f) * progress);
+
+                auto startTime = Clock::now();
+                pGraphics->StartDrawing(0, 0, 0, 255);
+                succeeded = map.Render(pGraphics);
+                pGraphics->EndDrawing();
+                mapResult.AddFrame(ToMs(Clock::now() - startTime));
+                mapResult.m_drawnCount += map.GetDrawnChunkCount();
+                mapResult.m_culledCount += map.GetCulledChunkCount();
+
+                yang::FVec2 topLeft = viewport.TopLeft();
+                yang::FVec2 bottomRight = viewport.BottomRight();
+                yang::FRect screenRect(topLeft.x, topLeft.y, bottomRight.x - topLeft.x, bottomRight.y - topLeft.y);
+
+                startTime = Clock::now();
+                visibleActors.clear();
+                spatialIndex.Query(screenRect, visibleActors);
+                indexResult.AddFrame(ToMs(Clock::now() - startTime));
+                indexResult.m_drawnCount += visibleActors.size();
+                indexResult.m_culledCount += actors.size() - visibleActors.size();
+
+                startTime = Clock::now();
+                size_t visibleCount = std::count_if(actorBounds.begin(), actorBounds.end(), [&screenRect](const yang::FRect& bounds) { return bounds.Collide(screenRect); });
+                scanResult.AddFrame(ToMs(Clock::now() - startTime));
+                scanResult.m_drawnCount += visibleCount;
+                scanResult.m_culledCount += actors.size() - visibleCount;
+
+                if (visibleCount != visibleActors.size())
+                {
+                    ++mismatchCount;
+                }
+            }
+
+            viewport = savedViewport;
+
+            std::printf("%d x %d tile world of 2 layers (loaded in %.0f ms), %d actors, %d frames of %.0f x %.0f pixels\n", kWorldSize, kWorldSize,
+                loadMs, kWorldActorCount, kWorldFrames, halfScreen.x * 2.f, halfScreen.y * 2.f);
+            std::printf("  %-14s %10s %10s %14s %14s\n", "pass", "avg ms", "max ms", "avg drawn", "avg culled");
+            auto printResult = [](const char* pName, const WorldFrameResult& result)
+            {
+                std::printf("  %-14s %10.3f %10.3f %14.1f %14.1f\n", pName, result.m_totalMs / kWorldFrames, result.m_maxMs,
+                    static_cast<double>(result.m_drawnCount) / kWorldFrames, static_cast<double>(result.m_culledCount) / kWorldFrames);
+            };
+            printResult("map chunks", mapResult);
+            printResult("actor index", indexResult);
+            printResult("actor scan", scanResult);
+
+            if (mismatchCount > 0)
+            {
+                std::printf("  the spatial index and the scan disagreed on %zu frames\n", mismatchCount);
+                succeeded = false;
+            }
+        }
+
+        pCache->Cleanup();
+        return succeeded;
+    }
+
+    /// Reads the command line
+    /// \return false if an option is unknown
+    bool ParseOptions(int argc, const char** argv, Options& options)
+    {
+        constexpr const char* kWorkDirectoryOption = "--work-dir=";
+        bool isAnyPass = false;
+        for (int i = 1; i < argc; ++i)
+        {
+            if (std::strcmp(argv[i], "--textures") == 0)
+            {
+                options.m_isTexturePass = true;
+                isAnyPass = true;
+            }
+            else if (std::strcmp(argv[i], "--maps") == 0)
+            {
+                options.m_isMapPass = true;
+                isAnyPass = true;
+            }
+            else if (std::strcmp(argv[i], "--decode") == 0)
+            {
+                options.m_isDecodePass = true;
+                isAnyPass = true;
+            }
+            else if (std::strcmp(argv[i], "--world") == 0)
+            {
+                options.m_isWorldPass = true;
+                isAnyPass = true;
+            }
+            else if (std::strncmp(argv[i], kWorkDirectoryOption, std::strlen(kWorkDirectoryOption)) == 0)
+            {
+                options.m_workDirectory = argv[i] + std::strlen(kWorkDirectoryOption);
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        if (!isAnyPass)
+        {
+            options.m_isTexturePass = true;
+            options.m_isMapPass = true;
+            options.m_isDecodePass = true;
+            options.m_isWorldPass = true;
+        }
+        return true;
+    }
+}
+
+int main(int argc, const char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        std::printf("Usage: EngineBenchmark [--textures] [--maps] [--decode] [--world] [--work-dir=<path>]\n");
+        return 1;
+    }
+
+    auto pSystem = yang::IOpSys::Create();
+    if (!pSystem)
+        return 1;
+
+    yang::Logger::Get()->Init(pSystem.get());
+    LOG_CATEGORY(Error, 0, Red, Light);
+    LOG_CATEGORY(Warning, 0, Yellow, Light);
+
+    yang::NullWindow window;
+    window.Init("EngineBenchmark", 1280, 720);
+    auto pGraphics = yang::IGraphics::CreateHeadless();
+    if (!pGraphics || !pGraphics->Initialize(&window))
+    {
+        yang::Logger::Get()->Finish();
+        return 1;
+    }
+
+    bool succeeded = true;
+    if (options.m_isTexturePass)
+    {
+        succeeded = RunTexturePass(options, pGraphics.get()) && succeeded;
+    }
+
+    if (options.m_isMapPass)
+    {
+        succeeded = RunMapPass(options, pGraphics.get()) && succeeded;
+    }
+
+    if (options.m_isDecodePass)
+    {
+        succeeded = RunDecodePass(options, pGraphics.get()) && succeeded;
+    }
+
+    if (options.m_isWorldPass)
+    {
+        succeeded = RunWorldPass(options, pGraphics.get()) && succeeded;
+    }
+
+    IMG_Quit();
+    yang::Logger::Get()->Finish();
+    return succeeded ? 0 : 1;
+}
@@ -0,0 +1,301 @@
+// Benchmarks GridPathfinder and FlowFieldCache on generated maps.
+// Usage: PathfindingBenchmark [query count] [--weighted]
+// Every map size gets random walls, then the same random queries are answered with the flat search, the hierarchical
+// search, and from the path cache. The abstraction build time is reported separately. The last pass blocks a cell
+// on every cached path and queries again to measure the repair.
+// Flow fields are then built towards a random goal on one thread and on the thread pool, compared cell by cell,
+// repaired after single cell changes, and sampled by a crowd of agents.
+// --weighted also gives the open cells random costs, so A* runs instead of Jump Point Search
+
+#include <Logic/Pathfinding/GridPathfinder.h>
+#include <Logic/Pathfinding/FlowFieldCache.h>
+#include <Application/ApplicationConstants.h>
+#include <Application/OS/IOpSys.h>
+#include <Utils/Logger.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+#ifdef _DEBUG
+#include <VLD/vld.h>
+#endif
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int kMapSizes[] = { 256, 1024, 4096 };     ///< Width and height of the benchmarked maps
+    constexpr unsigned kSeed = 1234;                    ///< Seed of the map and query generator, so runs are comparable
+    constexpr int kFlowFieldChanges = 100;              ///< Cells blocked and opened again to measure the flow field repair
+    constexpr int kAgentCount = 10000;                  ///< Agents sampling the flow field
+    constexpr int kAgentFrames = 100;                   ///< Frames every agent samples the flow field
+    constexpr int kTileSize = 32;                       ///< Size of a cell in pixels, for the agent positions
+
+    /// Timings of a benchmark pass
+    struct PassResult
+    {
+        double m_totalMs = 0.0;             ///< Time of all queries
+        double m_maxMs = 0.0;               ///< Time of the slowest query
+        size_t m_foundCount = 0;            ///< Number of queries that found a path
+        size_t m_expandedNodeCount = 0;     ///< Search nodes expanded by all queries
+        size_t m_pathLength = 0;            ///< Cells of all found paths
+    };
+
+    /// Fills the grid with random walls of random lengths, a tenth of the cells end up blocked
+    void GenerateGrid(yang::NavGrid& grid, int size, bool isWeighted, std::mt19937& random)
+    {
+        grid.Init(yang::IVec2(size, size));
+
+        std::uniform_int_distribution<int> coordinate(0, size - 1);
+        std::uniform_int_distribution<int> length(4, 24);
+        size_t blockedCount = 0;
+        size_t targetCount = static_cast<size_t>(size) * size / 10;
+        while (blockedCount < targetCount)
+        {
+            int x = coordinate(random);
+            int y = coordinate(random);
+            int wallLength = length(random);
+            bool isHorizontal = (random() & 1) != 0;
+            for (int i = 0; i < wallLength; ++i)
+            {
+                yang::IVec2 cell = isHorizontal ? yang::IVec2(std::min(x + i, size - 1), y) : yang::IVec2(x, std::min(y + i, size - 1));
+                if (grid.IsWalkable(cell.x, cell.y))
+                {
+                    grid.SetCost(cell, yang::NavGrid::kBlocked);
+                    ++blockedCount;
+                }
+            }
+        }
+
+        if (!isWeighted)
+            return;
+
+        std::uniform_int_distribution<int> cost(1, 8);
+        for (int y = 0; y < size; ++y)
+        {
+            for (int x = 0; x < size; ++x)
+            {
+                if (grid.IsWalkable(x, y))
+                {
+                    grid.SetCost(yang::IVec2(x, y), static_cast<uint8_t>(cost(random)));
+                }
+            }
+        }
+    }
+
+    /// Picks random pairs of open cells
+    std::vector<std::pair<yang::IVec2, yang::IVec2>> GenerateQueries(const yang::NavGrid& grid, int queryCount, std::mt19937& random)
+    {
+        std::uniform_int_distribution<int> coordinate(0, grid.GetSize().x - 1);
+        auto randomOpenCell = [&grid, &coordinate, &random]()
+        {
+            yang::IVec2 cell;
+            do
+            {
+                cell = yang::IVec2(coordinate(random), coordinate(random));
+            } while (!grid.IsWalkable(cell.x, cell.y));
+            return cell;
+        };
+
+        std::vector<std::pair<yang::IVec2, yang::IVec2>> queries;
+        for (int i = 0; i < queryCount; ++i)
+        {
+            yang::IVec2 start = randomOpenCell();
+            queries.emplace_back(start, randomOpenCell());
+        }
+        return queries;
+    }
+
+    /// Runs every query once
+    PassResult RunPass(yang::GridPathfinder& pathfinder, const std::vector<std::pair<yang::IVec2, yang::IVec2>>& queries, yang::GridPathfinder::SearchMode mode)
+    {
+        PassResult result;
+        std::vector<yang::IVec2> path;
+        for (const auto& [start, goal] : queries)
+        {
+            auto startTime = Clock::now();
+            bool isFound = pathfinder.FindPath(start, goal, path, mode);
+            double queryMs = std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+
+            result.m_totalMs += queryMs;
+            result.m_maxMs = std::max(result.m_maxMs, queryMs);
+            result.m_expandedNodeCount += pathfinder.GetExpandedNodeCount();
+            if (isFound)
+            {
+                ++result.m_foundCount;
+                result.m_pathLength += path.size();
+            }
+        }
+        return result;
+    }
+
+    /// Compares two fields built towards the same goal cell by cell
+    /// \return true if every cell has the same integration cost and direction
+    bool IsSameField(const yang::FlowField& left, const yang::FlowField& right)
+    {
+        if (!(left.GetSize() == right.GetSize()) || !(left.GetGoal() == right.GetGoal()))
+            return false;
+
+        yang::IVec2 size = left.GetSize();
+        for (int y = 0; y < size.y; ++y)
+        {
+            for (int x = 0; x < size.x; ++x)
+            {
+                if (left.GetIntegrationCost(x, y) != right.GetIntegrationCost(x, y) || !(left.GetDirection(x, y) == right.GetDirection(x, y)))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    /// Builds, repairs and samples flow fields towards a random goal
+    void RunFlowFieldPasses(yang::NavGrid&& grid, std::mt19937& random)
+    {
+        auto queries = GenerateQueries(grid, kFlowFieldChanges + kAgentCount, random);
+        yang::IVec2 goal = queries[0].second;
+
+        yang::FlowFieldCache cache;
+        if (!cache.Init(std::move(grid)))
+            return;
+
+        auto buildStartTime = Clock::now();
+        const yang::FlowField* pField = cache.GetField(goal);
+        double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - buildStartTime).count();
+        if (!pField)
+            return;
+
+        // The sectors only split the passes between the threads, the result has to be the same
+        yang::FlowField singleThreadedField = *pField;
+        cache.Clear();
+        cache.SetMultithreaded(true);
+        buildStartTime = Clock::now();
+        pField = cache.GetField(goal);
+        double threadedBuildMs = std::chrono::duration<double, std::milli>(Clock::now() - buildStartTime).count();
+        bool isSameField = pField && IsSameField(singleThreadedField, *pField);
+
+        // Every change is undone right away, so the repairs don't pile up into a different map
+        double maxRepairMs = 0.0;
+        auto repairStartTime = Clock::now();
+        for (int i = 0; i < kFlowFieldChanges; ++i)
+        {
+            yang::IVec2 cell = queries[i].first;
+            uint8_t cost = cache.GetNavGrid().GetCost(cell.x, cell.y);
+
+            auto changeStartTime = Clock::now();
+            cache.SetCellCost(cell, yang::NavGrid::kBlocked);
+            maxRepairMs = std::max(maxRepairMs, std::chrono::duration<double, std::milli>(Clock::now() - changeStartTime).count());
+            cache.SetCellCost(cell, cost);
+        }
+        double repairMs = std::chrono::duration<double, std::milli>(Clock::now() - repairStartTime).count();
+
+        std::vector<yang::FVec2> positions;
+        for (int i = kFlowFieldChanges; i < kFlowFieldChanges + kAgentCount; ++i)
+        {
+            positions.emplace_back((queries[i].first.x + 0.5f) * kTileSize, (queries[i].first.y + 0.5f) * kTileSize);
+        }
+
+        pField = cache.GetField(goal);
+        yang::FVec2 directionSum(0.f, 0.f);
+        auto sampleStartTime = Clock::now();
+        for (int frame = 0; frame < kAgentFrames; ++frame)
+        {
+            for (yang::FVec2& position : positions)
+            {
+                yang::FVec2 direction = pField->SampleDirection(position, yang::IVec2(kTileSize, kTileSize));
+                position += direction;
+                directionSum += direction;
+            }
+        }
+        double sampleNs = std::chrono::duration<double, std::nano>(Clock::now() - sampleStartTime).count() / (static_cast<double>(kAgentCount) * kAgentFrames);
+
+        std::printf("  flow field build %.3f ms, on the thread pool %.3f ms (%zu workers), %s\n", buildMs, threadedBuildMs, yang::kNumThreads,
+            isSameField ? "same field" : "DIFFERENT FIELD");
+        std::printf("  flow field repair %.3f ms avg, %.3f ms max per changed cell\n", repairMs / (2 * kFlowFieldChanges), maxRepairMs);
+        std::printf("  flow field sample %.2f ns per agent per frame (%d agents, checksum %.1f)\n", sampleNs, kAgentCount, directionSum.x + directionSum.y);
+    }
+
+    /// Prints a line of the result table
+    void PrintResult(const char* pName, const PassResult& result, size_t queryCount)
+    {
+        std::printf("  %-14s %10.3f %10.3f %10.3f %12zu %10zu %8zu/%zu\n", pName, result.m_totalMs, result.m_totalMs / queryCount, result.m_maxMs,
+            result.m_expandedNodeCount / queryCount, result.m_foundCount ? result.m_pathLength / result.m_foundCount : 0, result.m_foundCount, queryCount);
+    }
+}
+
+int main(int argc, const char** argv)
+{
+    int queryCount = 200;
+    bool isWeighted = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--weighted") == 0)
+        {
+            isWeighted = true;
+        }
+        else if (std::atoi(argv[i]) > 0)
+        {
+            queryCount = std::atoi(argv[i]);
+        }
+        else
+        {
+            std::printf("Usage: PathfindingBenchmark [query count] [--weighted]\n");
+            return 1;
+        }
+    }
+
+    auto pSystem = yang::IOpSys::Create();
+    if (!pSystem)
+        return 1;
+
+    yang::Logger::Get()->Init(pSystem.get());
+    LOG_CATEGORY(Error, 0, Red, Light);
+    LOG_CATEGORY(Warning, 0, Yellow, Light);
+
+    std::mt19937 random(kSeed);
+    for (int mapSize : kMapSizes)
+    {
+        yang::NavGrid grid;
+        GenerateGrid(grid, mapSize, isWeighted, random);
+        auto queries = GenerateQueries(grid, queryCount, random);
+
+        yang::NavGrid fieldGrid = grid;
+        yang::GridPathfinder pathfinder;
+        if (!pathfinder.Init(std::move(grid)))
+            continue;
+
+        std::printf("%d x %d %s map, %d queries\n", mapSize, mapSize, isWeighted ? "weighted" : "uniform", queryCount);
+        std::printf("  %-14s %10s %10s %10s %12s %10s %10s\n", "pass", "total ms", "avg ms", "max ms", "avg expanded", "avg length", "found");
+
+        PrintResult(isWeighted ? "flat A*" : "flat JPS", RunPass(pathfinder, queries, yang::GridPathfinder::SearchMode::kFlat), queries.size());
+
+        auto buildStartTime = Clock::now();
+        pathfinder.BuildAbstraction();
+        std::printf("  %-14s %10.3f\n", "abstraction", std::chrono::duration<double, std::milli>(Clock::now() - buildStartTime).count());
+
+        pathfinder.ClearPathCache();
+        PrintResult("hpa*", RunPass(pathfinder, queries, yang::GridPathfinder::SearchMode::kHierarchical), queries.size());
+        PrintResult("cached", RunPass(pathfinder, queries, yang::GridPathfinder::SearchMode::kHierarchical), queries.size());
+
+        // Block a cell in the middle of every path, so the next queries repair the clusters and search again
+        std::vector<yang::IVec2> path;
+        for (const auto& [start, goal] : queries)
+        {
+            if (pathfinder.FindPath(start, goal, path) && path.size() > 2)
+            {
+                pathfinder.SetCellCost(path[path.size() / 2], yang::NavGrid::kBlocked);
+            }
+        }
+        PrintResult("after repair", RunPass(pathfinder, queries, yang::GridPathfinder::SearchMode::kAuto), queries.size());
+
+        RunFlowFieldPasses(std::move(fieldGrid), random);
+    }
+
+    yang::Logger::Get()->Finish();
+    return 0;
+}
@@ -1,9 +1,11 @@
 #pragma once
+#include <algorithm>
 #include <thread>
 
 namespace yang
 {
     static constexpr size_t kWindowWidth = 1280;
     static constexpr size_t kWindowHeight = 720;
-    static const size_t kNumThreads = std::thread::hardware_concurrency() - 1;
+    static const size_t kNumThreads = std::max<size_t>(std::thread::hardware_concurrency(), 2) - 1;     ///< At least one worker, async loads never finish without one
+    static constexpr bool kUseRenderThread = false;     ///< Present the frames on another thread than the game runs on, a render thread or the main one, see IGraphics::SetRenderThreadEnabled
 }
\ No newline at end of file
@@ -6,8 +6,11 @@
 
 // TODO: remove after doing all implementation
 #include <Application/Graphics/Fonts/SDLFontLoader.h>
+#include <Application/Window/NullWindow.h>
 
 #include <cassert>
+#include <cstring>
+#include <thread>
 
 using yang::ApplicationLayer;
 
@@ -20,9 +23,50 @@ ApplicationLayer::~ApplicationLayer()
 	
 }
 
-void yang::ApplicationLayer::Run()
+bool yang::ApplicationLayer::Run()
 {
 	LOG(Boot, "Running...");
+
+    if (m_runnerOptions.m_frameCount > 0)
+    {
+        HeadlessRunner runner(m_runnerOptions);
+        return runner.Run(*this);
+    }
+
+    InputStream recordedInput;
+    size_t frame = 0;
+
+    if (m_pGraphics->IsRenderLoopHosted())
+    {
+        // The renderer and the window have to stay on this thread, so the game loop moves to another one.
+        // Its frames are presented here while it simulates the next one
+        m_pWindow->SetEventsPumpedElsewhere(true);
+        std::thread gameThread([this, &recordedInput, &frame]()
+        {
+            frame = RunGameLoop(recordedInput);
+            m_pGraphics->StopRenderLoop();
+        });
+        m_pGraphics->RunRenderLoop([this]() { m_pWindow->PumpEvents(); });
+        gameThread.join();
+        m_pWindow->SetEventsPumpedElsewhere(false);
+    }
+    else
+    {
+        frame = RunGameLoop(recordedInput);
+    }
+
+    if (!m_recordInputPath.empty() && recordedInput.Save(m_recordInputPath))
+    {
+        LOG(Info, "Recorded %zu input changes over %zu frames to %s", recordedInput.GetChangeCount(), frame, m_recordInputPath.c_str());
+    }
+
+    return true;
+}
+
+size_t yang::ApplicationLayer::RunGameLoop(InputStream& recordedInput)
+{
+    size_t frame = 0;
+
     using namespace std::chrono;
     time_point<steady_clock> last = steady_clock::now();
 
@@ -33,12 +77,58 @@ void yang::ApplicationLayer::Run()
         duration<float> deltaTime = now - last;
         float deltaSeconds = deltaTime.count();
 
+        // Create resources that finished loading on worker threads
+        ResourceCache::Get()->ProcessAsyncLoads();
+
         // Update Game (Input)
         m_pGameLayer->Update(deltaSeconds);
+
+        // Evict resources released this frame if the cache is over its memory budget
+        ResourceCache::Get()->TrimToBudget();
+
+        if (!m_recordInputPath.empty())
+        {
+            recordedInput.Record(frame, GetKeyboard(), GetMouse());
+        }
         m_pWindow->NextFrame();
 
         last = now;
+        ++frame;
 	}
+
+    return frame;
+}
+
+bool yang::ApplicationLayer::Init(int argc, const char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--headless") == 0)
+        {
+            m_isHeadless = true;
+        }
+        else if (std::strcmp(argv[i], "--headless-raster") == 0)
+        {
+            m_isHeadless = true;
+            m_isHeadlessRasterizing = true;
+        }
+        else if (std::strncmp(argv[i], "--record-input=", 15) == 0)
+        {
+            m_recordInputPath = argv[i] + 15;
+        }
+        else if (!m_runnerOptions.ParseArgument(argv[i]))
+        {
+            m_unknownOptions.emplace_back(argv[i]);
+        }
+    }
+
+    // Load tests run without a window so they don't wait on vsync or the display
+    if (m_runnerOptions.m_frameCount > 0)
+    {
+        m_isHeadless = true;
+    }
+
+    return Init();
 }
 
 bool yang::ApplicationLayer::Init()
@@ -49,6 +139,7 @@ bool yang::ApplicationLayer::Init()
     LOG_CATEGORY(Warning, 3, Yellow, Light);
     LOG_CATEGORY(TODO, 9, Magenta, Light);
 	LOG_CATEGORY(Test, 3, White, Dark);
+    LOG_CATEGORY(Stats, 3, White, Light);
 
 	m_pSystem = IOpSys::Create();
 
@@ -60,6 +151,19 @@ bool yang::ApplicationLayer::Init()
 
 	Logger::Get()->Init(m_pSystem.get());
 
+    if (!m_unknownOptions.empty())
+    {
+        for (const std::string& option : m_unknownOptions)
+        {
+            LOG(Error, "Unknown command line option %s", option.c_str());
+        }
+
+        // Nothing but the logger is up yet
+        Logger::Get()->Finish();
+        m_pSystem.reset();
+        return false;
+    }
+
 	m_pGameLayer = CreateGameLayer();
 
 	if (!m_pGameLayer)
@@ -70,9 +174,18 @@ bool yang::ApplicationLayer::Init()
 	}
 	LOG(Info, "Game: %s", m_pGameLayer->GetGameName());
 
-	m_pWindow = m_pSystem->CreateSystemWindow(m_pGameLayer->GetGameName(), kWindowWidth, kWindowHeight);
+    if (m_isHeadless)
+    {
+        m_pWindow = std::make_unique<NullWindow>();
+        m_pWindow->Init(m_pGameLayer->GetGameName(), kWindowWidth, kWindowHeight);
+        m_pGraphics = IGraphics::CreateHeadless(m_isHeadlessRasterizing);
+    }
+    else
+    {
+        m_pWindow = m_pSystem->CreateSystemWindow(m_pGameLayer->GetGameName(), kWindowWidth, kWindowHeight);
+        m_pGraphics = IGraphics::Create();
+    }
 
-	m_pGraphics = IGraphics::Create();
 	if (!m_pGraphics)
 	{
 		LOG(Error, "IGraphics::Create() failed.");
@@ -87,6 +200,11 @@ bool yang::ApplicationLayer::Init()
 		return false;
     }
 
+    if (kUseRenderThread)
+    {
+        m_pGraphics->SetRenderThreadEnabled(true);
+    }
+
     /////////////////////////////////////////////////////////////////////////////////////////
     // Init font loader after graphics. TODO: Actually implement it                       ///
     m_pFontLoader = std::make_unique<SDLFontLoader>(); // Change later to IFontLoader::Create()
@@ -98,7 +216,7 @@ bool yang::ApplicationLayer::Init()
 	}
     /////////////////////////////////////////////////////////////////////////////////////////
 
-    m_pAudio = IAudio::Create();
+    m_pAudio = m_isHeadless ? IAudio::CreateNull() : IAudio::Create();
 
     if (!m_pAudio || !m_pAudio->Init())
     {
@@ -5,6 +5,8 @@
 #include <Application/Graphics/IGraphics.h>
 #include <Application/Graphics/Fonts/IFontLoader.h>
 #include <Application/Audio/IAudio.h>
+#include <Application/HeadlessRunner.h>
+#include <Application/Input/InputStream.h>
 #include <Logic/IGameLayer.h>
 #include <Utils/Logger.h>
 #include <Utils/Vector2.h>
@@ -35,12 +37,24 @@ public:
 	~ApplicationLayer();
 
     /// \brief Run the game until the exit event happens
-	void Run();
+    /// \return false if the load test run (--frames) failed, so the process can report it in its exit code
+	bool Run();
 	
     /// \brief Initializes the application
     /// \return true if all systems initialized successfully
 	bool Init();
 
+    /// \brief Initializes the application with the command line options
+    /// --headless runs without a window, GPU or audio device: HeadlessRenderer counts the draws, NullWindow and NullAudio stand in for the rest.
+    /// --headless-raster does the same and also rasterizes the frames into an in-memory surface.
+    /// --frames=N runs N fixed frames headless as fast as possible and reports the stats, \see HeadlessRunner::Options for the rest of its options.
+    /// --record-input=path records the keyboard and mouse of a normal run into an input stream the runner can replay
+    /// Unknown options fail the initialization, so a mistyped option doesn't start a different run
+    /// \param argc - number of command line arguments
+    /// \param argv - command line arguments, the first one is the executable
+    /// \return true if all systems initialized successfully
+	bool Init(int argc, const char** argv);
+
     /// \brief Cleans up the memory used by application
 	void Cleanup();
 
@@ -63,10 +77,21 @@ private:
     std::unique_ptr<IAudio> m_pAudio;                   ///< Audio subsystem
     std::unique_ptr<IFontLoader> m_pFontLoader;         ///< Font loader subsystem
 
+    bool m_isHeadless = false;                          ///< Run without a window, GPU or audio device
+    bool m_isHeadlessRasterizing = false;               ///< Rasterize the headless frames into an in-memory surface
+    HeadlessRunner::Options m_runnerOptions;            ///< Load test run, used when its frame count is set
+    std::string m_recordInputPath;                      ///< Where to save the recorded input, empty to not record
+    std::vector<std::string> m_unknownOptions;          ///< Command line options that were not recognized, reported once the logger is up
+
 	// --------------------------------------------------------------------- //
 	// Private Member Functions
 	// --------------------------------------------------------------------- //
 
+    /// \brief Update the game every frame until the window is closed. Runs on its own thread when the render loop is hosted
+    /// \param recordedInput - stream the input is recorded into when --record-input is given
+    /// \return number of frames run
+    size_t RunGameLoop(InputStream& recordedInput);
+
 public:
 	// --------------------------------------------------------------------- //
 	// Accessors & Mutators
@@ -76,6 +101,10 @@ public:
     /// \return raw pointer to graphics system
     IGraphics* GetGraphics() const { return m_pGraphics.get(); }
 
+    /// \brief Get the associated window
+    /// \return raw pointer to the window
+    IWindow* GetWindow() const { return m_pWindow.get(); }
+
     /// \brief Get the associated mouse object
     /// \return raw pointer to associated mouse object
     IMouse* GetMouse() const { return m_pWindow->GetMouse(); }
@@ -96,5 +125,8 @@ public:
     /// \return raw pointer to font loader system
     IFontLoader* GetFontLoader() const { return m_pFontLoader.get(); }
 
+    /// \brief Is the application running without a window, GPU or audio device
+    bool IsHeadless() const { return m_isHeadless; }
+
 };
 }
\ No newline at end of file
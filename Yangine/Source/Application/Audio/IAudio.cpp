@@ -1,6 +1,7 @@
 #include "IAudio.h"
 
 #include "SDLAudio.h"
+#include "NullAudio.h"
 
 using yang::IAudio;
 
@@ -18,3 +19,8 @@ std::unique_ptr<IAudio> yang::IAudio::Create()
 {
 	return std::make_unique<SDLAudio>();
 }
+
+std::unique_ptr<IAudio> yang::IAudio::CreateNull()
+{
+	return std::make_unique<NullAudio>();
+}
\ No newline at end of file
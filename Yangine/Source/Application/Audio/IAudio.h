@@ -82,6 +82,10 @@ public:
 	/// \return unique_ptr to Audio system
 	static std::unique_ptr<IAudio> Create();
 
+    /// Creates the Audio System that plays nothing, for the headless runs
+	/// \return unique_ptr to Audio system
+	static std::unique_ptr<IAudio> CreateNull();
+
     /// Loads sound from raw data resource
     /// \param pResource - Resource to load sound from
     /// \return shared ptr to Sound resource
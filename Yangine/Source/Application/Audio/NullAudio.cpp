@@ -0,0 +1,36 @@
+#include "NullAudio.h"
+
+#include <Application/Resources/Resource.h>
+#include <Application/Audio/Music/IMusic.h>
+#include <Application/Audio/Sound/ISound.h>
+
+using yang::NullAudio;
+
+namespace
+{
+    // Sound that only keeps its raw data
+    class NullSound : public yang::ISound
+    {
+    public:
+        NullSound(yang::IResource* pResource) : ISound(pResource) {}
+        virtual void* GetNativeSound() override final { return nullptr; }
+    };
+
+    // Music that only keeps its raw data
+    class NullMusic : public yang::IMusic
+    {
+    public:
+        NullMusic(yang::IResource* pResource) : IMusic(pResource) {}
+        virtual void* GetNativeMusic() override final { return nullptr; }
+    };
+}
+
+std::shared_ptr<yang::ISound> yang::NullAudio::LoadSound(IResource* pResource)
+{
+    return std::make_shared<NullSound>(pResource);
+}
+
+std::shared_ptr<yang::IMusic> yang::NullAudio::LoadMusic(IResource* pResource)
+{
+    return std::make_shared<NullMusic>(pResource);
+}
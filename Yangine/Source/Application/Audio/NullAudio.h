@@ -0,0 +1,93 @@
+#pragma once
+/** \file NullAudio.h */
+/** IAudio specialization that plays nothing */
+
+#include ".\IAudio.h"
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \class NullAudio */
+/** Audio system of the headless runs. It opens no audio device, the sounds and music it loads hold their raw data only */
+class NullAudio final
+	: public IAudio
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+	/** Default Constructor */
+	NullAudio() = default;
+
+	/** Default Destructor */
+	~NullAudio() = default;
+
+	/// Nothing to initialize
+	/// \return true
+	virtual bool Init() override final { return true; }
+
+	/// Does nothing
+	/// \return true
+	virtual bool PlayMusic(IMusic* /*pMusic*/, i8 /*volume*/ = -1, i8 /*loops*/ = -1) override final { return true; }
+
+	/// Does nothing
+	/// \return channel 0, as if the sound was played
+	virtual int PlaySound(ISound* /*pSound*/, i8 /*volume*/ = -1, i8 /*loops*/ = 0) override final { return 0; }
+
+	/// Does nothing
+	/// \return true
+	virtual bool StopChannel(int /*channel*/ = -1) override final { return true; }
+
+	/// Does nothing
+	/// \return true
+    virtual bool FadeInMusic(IMusic* /*pMusic*/, ui32 /*ms*/, i8 /*volume*/ = -1, i8 /*loops*/ = -1) override final { return true; }
+
+	/// Does nothing
+    virtual void FadeOutMusic(ui32 /*ms*/) override final {}
+
+	/// Does nothing
+    virtual void StopMusic() override final {}
+
+	/// Does nothing
+    virtual void PauseMusic() override final {}
+
+	/// Does nothing
+    virtual void ResumeMusic() override final {}
+
+	/// Does nothing
+    virtual void SetMusicVolume(i8 /*volume*/) override final {}
+
+	/// Wraps the raw data resource into a sound without decoding it
+	/// \param pResource - Resource to load sound from
+	/// \return shared ptr to a sound with no native sound
+    virtual std::shared_ptr<ISound> LoadSound(IResource* pResource) override final;
+
+	/// Wraps the raw data resource into music without decoding it
+	/// \param pResource - Resource to load music from
+	/// \return shared ptr to music with no native music
+    virtual std::shared_ptr<IMusic> LoadMusic(IResource* pResource) override final;
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+
+};
+}
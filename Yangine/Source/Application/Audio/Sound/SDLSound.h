@@ -36,6 +36,10 @@ public:
 	/// \return pointer to a Mix_Chunk
 	virtual void* GetNativeSound() override final { return m_pSound; }
 
+	/// Get approximate memory used by the sound: raw data plus decoded samples
+	/// \return size in bytes
+	virtual size_t GetMemorySize() const override final { return IResource::GetMemorySize() + (m_pSound ? m_pSound->alen : 0); }
+
 
 private:
 	// --------------------------------------------------------------------- //
@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 #include <Application/Graphics/Fonts/FontString.h>
 #include <Utils/Vector2.h>
 
@@ -15,6 +16,7 @@ namespace yang
 	class IGraphics;
 	class ITexture;
 	class Sprite;
+	struct TextureQuad;
 /** \class IFont */
 /** Interface for the Font resource */
 class IFont
@@ -47,6 +49,16 @@ public:
     /// \return shared pointer to a texture resource
 	virtual std::shared_ptr<ITexture> CreateTextureFromString(const std::string& str) const = 0;
 
+    /// Lays out the text as quads of the glyph atlas, with no intermediate texture. Lay the text out once when it changes
+    /// and draw the quads from GetGlyphAtlas() with IGraphics::DrawTextureBatch
+    /// \param str - text to lay out
+    /// \param quads - cleared and filled with one quad per drawn character, relative to the top left corner of the text
+    /// \return width and height of the text
+	virtual IVec2 LayoutString(std::string_view str, std::vector<TextureQuad>& quads) const = 0;
+
+    /// Get the texture all glyphs of the font are drawn from
+	virtual std::shared_ptr<ITexture> GetGlyphAtlas() const = 0;
+
 	virtual FontString CreateFontString(const std::string& str) const = 0;
 	virtual std::shared_ptr<Sprite> SpriteFromChar(char c) const = 0;
 
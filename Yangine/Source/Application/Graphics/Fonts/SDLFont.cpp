@@ -1,11 +1,12 @@
 #include "SDLFont.h"
+#include <algorithm>
 #include <cassert>
 #include <Utils/Logger.h>
 #include <Application/Graphics/IGraphics.h>
-#include <Application/Graphics/SDLRenderer.h>
-#include <Application/Graphics/Textures/SDLTexture.h>
+#include <Application/Graphics/Textures/ITexture.h>
 #include <Application/Graphics/Textures/Sprite.h>
 #include <Application/Graphics/Fonts/FontString.h>
+#include <Utils/RectPacker.h>
 
 using yang::SDLFont;
 
@@ -13,7 +14,7 @@ SDLFont::SDLFont(IResource* pResource, TTF_Font* pFont, int ptSize)
     :IFont(pResource)
 	,m_pFont(pFont)
     ,m_pFontAtlas(nullptr)
-    ,m_pSDLRenderer(nullptr)
+    ,m_pGraphics(nullptr)
 	,m_offset(0)
 {
     m_filepath.append(std::to_string(ptSize));
@@ -31,21 +32,22 @@ bool yang::SDLFont::Init(IGraphics* pGraphics)
 	
 	int textureDimension = 20 * fontLineHeight;
 
-	m_pSDLRenderer = static_cast<SDLRenderer*>(pGraphics);
+	m_pGraphics = pGraphics;
 
-	m_pFontAtlas = m_pSDLRenderer->CreateTexture(IVec2(textureDimension, textureDimension));
-	if (!m_pSDLRenderer->SetRenderTarget(m_pFontAtlas.get()))
+	m_pFontAtlas = m_pGraphics->CreateTexture(IVec2(textureDimension, textureDimension));
+	IGraphics::RenderTargetScope targetScope(m_pGraphics, m_pFontAtlas.get());
+	if (!targetScope.IsTargetSet())
 	{
 		// Graphics already logged an error
 		return false;
 	}
 
-	int startX = 0;
-	int startY = 0;
-
 	// Hardcoded offset to 4
 	m_offset = 4;
 
+	// A pixel between the glyphs keeps filtering from sampling the neighbours
+	RectPacker packer(IVec2(textureDimension, textureDimension), 1);
+
 	m_glyphs.reserve(255-32);
 
 	for (unsigned char c = 32; c < 255; ++c)
@@ -59,29 +61,35 @@ bool yang::SDLFont::Init(IGraphics* pGraphics)
 		glyph.m_srcRect.width = pGlyphSurface->w;// +m_offset;
 		glyph.m_srcRect.height = pGlyphSurface->h;// +m_offset;
 
-		SDLTexture* pGlyphTexture = new SDLTexture();
-		pGlyphTexture->Init(static_cast<SDL_Renderer*>(m_pSDLRenderer->GetNativeRenderer()), pGlyphSurface);
+		// Every SDL based graphics system decodes images into SDL_Surfaces, so the glyph goes through the same path
+		IResource glyphResource(m_filepath, std::vector<std::byte>());
+		std::shared_ptr<ITexture> pGlyphTexture = m_pGraphics->CreateTextureFromImage(&glyphResource, pGlyphSurface);
 
-		if (startX + glyph.m_srcRect.width >= textureDimension)
+		IRect placedRect;
+		bool isPlaced = packer.Insert(IVec2(glyph.m_srcRect.width, glyph.m_srcRect.height), placedRect);
+		if (isPlaced)
 		{
-			startX = 0;
-			startY += fontLineHeight + m_offset;
+			glyph.m_srcRect = placedRect;
+		}
+		else
+		{
+			// Empty glyphs (width 0) don't need space, others are not drawn
+			glyph.m_srcRect = IRect(0, 0, 0, 0);
+			if (pGlyphSurface->w > 0)
+			{
+				LOG(Warning, "Glyph %d of font %s doesn't fit the glyph atlas", c, m_filepath.c_str());
+			}
 		}
-
-		glyph.m_srcRect.x = startX;
-		glyph.m_srcRect.y = startY;
 		m_glyphs.push_back(glyph);
 
 		SDL_FreeSurface(pGlyphSurface);
 
-		m_pSDLRenderer->DrawTexture(pGlyphTexture, glyph.m_srcRect);
-
-		startX += glyph.m_srcRect.width;
-		delete pGlyphTexture;
+		if (pGlyphTexture && isPlaced)
+		{
+			m_pGraphics->DrawTexture(pGlyphTexture.get(), glyph.m_srcRect);
+		}
 	}
 
-	m_pSDLRenderer->SetRenderTarget(nullptr);
-
     return true;
 }
 
@@ -89,8 +97,10 @@ std::shared_ptr<yang::ITexture> yang::SDLFont::CreateTextureFromString(const std
 {
 	IVec2 textureDimensions;
 	TTF_SizeText(m_pFont, str.c_str(), &textureDimensions.x, &textureDimensions.y);
-	auto pTexture = m_pSDLRenderer->CreateTexture(textureDimensions + IVec2(m_offset, m_offset));
-	m_pSDLRenderer->SetRenderTarget(pTexture.get());
+	auto pTexture = m_pGraphics->CreateTexture(textureDimensions + IVec2(m_offset, m_offset));
+	IGraphics::RenderTargetScope targetScope(m_pGraphics, pTexture.get());
+	if (!targetScope.IsTargetSet())
+		return nullptr;
 
 	IRect dest{0,0,0,0};
 	int currentX = 0;
@@ -102,15 +112,39 @@ std::shared_ptr<yang::ITexture> yang::SDLFont::CreateTextureFromString(const std
 		dest.width = glyph.m_srcRect.width;
 		dest.height = glyph.m_srcRect.height;
 
-		m_pSDLRenderer->DrawTexture(m_pFontAtlas.get(), glyph.m_srcRect, dest);
+		m_pGraphics->DrawTexture(m_pFontAtlas.get(), glyph.m_srcRect, dest);
 		currentX += glyph.m_advance;
 	}
 
-	m_pSDLRenderer->SetRenderTarget(nullptr);
-
 	return pTexture;
 }
 
+yang::IVec2 yang::SDLFont::LayoutString(std::string_view str, std::vector<TextureQuad>& quads) const
+{
+	quads.clear();
+	quads.reserve(str.size());
+
+	int currentX = 0;
+	int right = 0;
+	for (unsigned char c : str)
+	{
+		// Control characters have no glyphs
+		if (c < 32 || static_cast<size_t>(c) - 32 >= m_glyphs.size())
+			continue;
+
+		const Glyph& glyph = m_glyphs[static_cast<size_t>(c) - 32];
+		if (glyph.m_srcRect.width > 0 && glyph.m_srcRect.height > 0)
+		{
+			FRect dest(static_cast<float>(currentX + glyph.m_minX), 0.f, static_cast<float>(glyph.m_srcRect.width), static_cast<float>(glyph.m_srcRect.height));
+			quads.push_back(TextureQuad{ glyph.m_srcRect, dest, TextureDrawParams{} });
+			right = std::max(right, currentX + glyph.m_minX + glyph.m_srcRect.width);
+		}
+		currentX += glyph.m_advance;
+	}
+
+	return IVec2(std::max(currentX, right), TTF_FontHeight(m_pFont));
+}
+
 yang::FontString yang::SDLFont::CreateFontString(const std::string& str) const
 {
 	FontString result;
@@ -164,4 +198,9 @@ SDLFont::~SDLFont()
 {
 	TTF_CloseFont(m_pFont);
 	m_pFont = nullptr;
+}
+
+size_t yang::SDLFont::GetMemorySize() const
+{
+    return IResource::GetMemorySize() + (m_pFontAtlas ? m_pFontAtlas->GetMemorySize() : 0);
 }
\ No newline at end of file
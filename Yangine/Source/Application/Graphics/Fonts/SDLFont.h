@@ -12,7 +12,7 @@
 //! \namespace yang Contains all Yangine code
 namespace yang
 {
-    class SDLRenderer;
+    class IGraphics;
     class ITexture;
 /** \class SDLFont */
 /** SDL Font resource */
@@ -36,7 +36,7 @@ public:
 	SDLFont(IResource* pResource, TTF_Font* pFont, int ptSize);
 
     /// Initializes the resource
-    /// \param pGraphics - pointer to a SDLRenderer
+    /// \param pGraphics - graphics system to create the glyph atlas with
     /// \return true if initialized successfully
     virtual bool Init(IGraphics* pGraphics) override final;
 
@@ -45,6 +45,15 @@ public:
     /// \return shared pointer to a texture resource
 	virtual std::shared_ptr<ITexture> CreateTextureFromString(const std::string& str) const override final;
 
+    /// Lays out the text as quads of the glyph atlas, with no intermediate texture
+    /// \param str - text to lay out
+    /// \param quads - cleared and filled with one quad per drawn character, relative to the top left corner of the text
+    /// \return width and height of the text
+	virtual IVec2 LayoutString(std::string_view str, std::vector<TextureQuad>& quads) const override final;
+
+    /// Get the texture all glyphs of the font are drawn from
+	virtual std::shared_ptr<ITexture> GetGlyphAtlas() const override final { return m_pFontAtlas; }
+
 	virtual FontString CreateFontString(const std::string& str) const override final;
 	virtual std::shared_ptr<Sprite> SpriteFromChar(char c) const override final;
 	virtual int GetXOffset(char c) const override final;
@@ -56,11 +65,15 @@ public:
 	/** Default Destructor */
 	~SDLFont();
 
+    /// Get approximate memory used by the font: raw data plus the glyph atlas
+    /// \return size in bytes
+    virtual size_t GetMemorySize() const override final;
+
 private:
 	// --------------------------------------------------------------------- //
 	// Private Member Variables
 	// --------------------------------------------------------------------- //
-	SDLRenderer* m_pSDLRenderer;            ///< SDLRenderer to create textures
+	IGraphics* m_pGraphics;                 ///< Graphics system to create textures
 	TTF_Font* m_pFont;                      ///< TTF_Font that is used to create textures
     std::shared_ptr<ITexture> m_pFontAtlas; ///< Texture containing chars from 32 to 127
 
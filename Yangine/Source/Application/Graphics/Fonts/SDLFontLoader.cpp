@@ -5,7 +5,6 @@
 #include <Utils/Logger.h>
 #include <Application/Resources/Resource.h>
 #include <Application/Graphics/Fonts/SDLFont.h>
-#include <Application/Graphics/SDLRenderer.h>
 using yang::SDLFontLoader;
 
 SDLFontLoader::SDLFontLoader()
@@ -50,6 +49,6 @@ bool yang::SDLFontLoader::Init(IGraphics* pGraphics)
         LOG(Error, "Failed to initialize TTF: %s", TTF_GetError());
         return false;
     }
-    m_pGraphics = static_cast<SDLRenderer*>(pGraphics);
+    m_pGraphics = pGraphics;
     return true;
 }
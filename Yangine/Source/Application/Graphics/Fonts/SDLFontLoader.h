@@ -8,7 +8,6 @@
 namespace yang
 {
     class IGraphics;
-    class SDLRenderer;
 /** \class SDLFontLoader */
 /** Loads TTF_Fonts */
 class SDLFontLoader
@@ -44,7 +43,7 @@ private:
 	// --------------------------------------------------------------------- //
 	// Private Member Variables
 	// --------------------------------------------------------------------- //
-    SDLRenderer* m_pGraphics;   ///< SDL graphics system
+    IGraphics* m_pGraphics;     ///< Graphics system the fonts create their atlases with
 
 	// --------------------------------------------------------------------- //
 	// Private Member Functions
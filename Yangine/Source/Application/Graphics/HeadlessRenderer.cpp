@@ -0,0 +1,327 @@
+#include "HeadlessRenderer.h"
+#include <Utils/Logger.h>
+#include <Application/Window/IWindow.h>
+#include <Application/Graphics/Textures/HeadlessTexture.h>
+#include <Application/Graphics/RenderQueue.h>
+#include <algorithm>
+
+using yang::HeadlessRenderer;
+
+yang::HeadlessRenderer::Counters& yang::HeadlessRenderer::Counters::operator+=(const Counters& other)
+{
+    m_frameCount += other.m_frameCount;
+    m_clearCount += other.m_clearCount;
+    m_textureBatchCount += other.m_textureBatchCount;
+    m_textureQuadCount += other.m_textureQuadCount;
+    m_rectCount += other.m_rectCount;
+    m_fillRectCount += other.m_fillRectCount;
+    m_fillCallCount += other.m_fillCallCount;
+    m_lineCount += other.m_lineCount;
+    m_lineCallCount += other.m_lineCallCount;
+    m_drawColorCount += other.m_drawColorCount;
+    m_renderTargetCount += other.m_renderTargetCount;
+    m_textureCreateCount += other.m_textureCreateCount;
+    return *this;
+}
+
+HeadlessRenderer::HeadlessRenderer(bool isRasterizing)
+    : m_isRasterizing(isRasterizing)
+    , m_pSurface(nullptr, &SDL_FreeSurface)
+{
+
+}
+
+HeadlessRenderer::~HeadlessRenderer()
+{
+	SetRenderThreadEnabled(false);
+	ReleaseRetiredResources();
+
+	// The software renderer draws into the surface, it goes first
+	m_pRenderer.reset();
+}
+
+bool yang::HeadlessRenderer::Initialize(IWindow* pWindow)
+{
+    InitImageLoaders();
+
+    if (!m_isRasterizing)
+    {
+        LOG(Info, "Headless renderer initialized, counting draws only");
+        return true;
+    }
+
+    IVec2 dimensions = pWindow->GetDimensions();
+    m_pSurface.reset(SDL_CreateRGBSurfaceWithFormat(0, dimensions.x, dimensions.y, 32, SDL_PIXELFORMAT_RGBA8888));
+    if (!m_pSurface)
+    {
+        LOG(Error, "Unable to create %dx%d headless surface, %s", dimensions.x, dimensions.y, SDL_GetError());
+        return false;
+    }
+
+    m_pRenderer.reset(SDL_CreateSoftwareRenderer(m_pSurface.get()));
+    if (!m_pRenderer)
+    {
+        LOG(Error, "SDL software renderer failed to initialize, %s", SDL_GetError());
+        return false;
+    }
+
+    LOG(Info, "Headless renderer initialized, rasterizing into a %dx%d surface", dimensions.x, dimensions.y);
+	return true;
+}
+
+bool yang::HeadlessRenderer::StartDrawing(uint8_t red, uint8_t green, uint8_t blue, uint8_t /*alpha*/)
+{
+	BeginFrame(IColor(red, green, blue, SDL_ALPHA_OPAQUE));
+	return true;
+}
+
+void yang::HeadlessRenderer::EndDrawing()
+{
+	EndFrame();
+}
+
+void yang::HeadlessRenderer::ClearFrame(const IColor& color)
+{
+    ++m_frameCounters.m_clearCount;
+    if (m_pRenderer)
+    {
+        SDLRendererBase::ClearFrame(color);
+    }
+}
+
+void yang::HeadlessRenderer::PresentFrame()
+{
+    // The software renderer batches its commands too, presenting flushes them into the surface
+    if (m_pRenderer)
+    {
+        SDL_RenderPresent(m_pRenderer.get());
+    }
+
+    ++m_frameCounters.m_frameCount;
+    m_lastFrameCounters = m_frameCounters;
+    m_totalCounters += m_frameCounters;
+    m_frameCounters = Counters();
+}
+
+std::shared_ptr<yang::ITexture> yang::HeadlessRenderer::CreateTextureFromImage(IResource* pResource, void* pImage)
+{
+    std::shared_ptr<HeadlessTexture> pTexture = std::make_shared<HeadlessTexture>(pResource);
+    auto rendererLock = LockRenderer();
+
+    if (!pTexture->Init(m_pRenderer.get(), reinterpret_cast<SDL_Surface*>(pImage)))
+    {
+        LOG(Error, "Unable to init HeadlessTexture");
+        return nullptr;
+    }
+
+    ++m_frameCounters.m_textureCreateCount;
+    return pTexture;
+}
+
+bool yang::HeadlessRenderer::DrawNativeTextureBatch(void* pNativeTexture, const IColor& modulation, const TextureQuad* pQuads, size_t count)
+{
+	auto rendererLock = LockRenderer();
+    ++m_frameCounters.m_textureBatchCount;
+    m_frameCounters.m_textureQuadCount += count;
+
+    // Without a surface the native texture is only an identity, it may not be alive anymore
+    if (!m_pRenderer)
+        return true;
+
+	return SDLRendererBase::DrawNativeTextureBatch(pNativeTexture, modulation, pQuads, count);
+}
+
+bool yang::HeadlessRenderer::DrawRect(const FRect& rect)
+{
+	if (RenderQueue* pQueue = GetRecordingQueue(); pQueue != nullptr)
+	{
+		pQueue->AddRect(rect);
+		return true;
+	}
+
+	auto rendererLock = LockRenderer();
+    ++m_frameCounters.m_rectCount;
+	SDL_FRect toDraw = ToSDLFRect(rect);
+    if (m_pRenderer && SDL_RenderDrawRectF(m_pRenderer.get(), &toDraw))
+    {
+        LOG(Error, "Unable to draw SDL_Rect. Error: %s", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+bool yang::HeadlessRenderer::FillRect(const FRect& rect)
+{
+	if (RenderQueue* pQueue = GetRecordingQueue(); pQueue != nullptr)
+	{
+		pQueue->AddFillRect(rect);
+		return true;
+	}
+
+	auto rendererLock = LockRenderer();
+    ++m_frameCounters.m_fillRectCount;
+    ++m_frameCounters.m_fillCallCount;
+	SDL_FRect toDraw = ToSDLFRect(rect);
+    if (m_pRenderer && SDL_RenderFillRectF(m_pRenderer.get(), &toDraw))
+    {
+        LOG(Error, "Unable to fill SDL_Rect. Error: %s", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+bool yang::HeadlessRenderer::FillNativeRects(const FRect* pRects, size_t count)
+{
+	auto rendererLock = LockRenderer();
+    m_frameCounters.m_fillRectCount += count;
+    ++m_frameCounters.m_fillCallCount;
+	if (m_pRenderer && SDL_RenderFillRectsF(m_pRenderer.get(), reinterpret_cast<const SDL_FRect*>(pRects), static_cast<int>(count)))
+	{
+		LOG(Error, "Unable to fill SDL_Rects. Error: %s", SDL_GetError());
+		return false;
+	}
+	return true;
+}
+
+bool yang::HeadlessRenderer::DrawNativeLines(const FVec2* pPoints, size_t count)
+{
+	auto rendererLock = LockRenderer();
+    m_frameCounters.m_lineCount += count / 2;
+    ++m_frameCounters.m_lineCallCount;
+	for (size_t i = 0; m_pRenderer && i + 1 < count; i += 2)
+	{
+		if (SDL_RenderDrawLineF(m_pRenderer.get(), pPoints[i].x, pPoints[i].y, pPoints[i + 1].x, pPoints[i + 1].y))
+		{
+			LOG(Error, "Unable to draw line. Error: %s", SDL_GetError());
+			return false;
+		}
+	}
+	return true;
+}
+
+bool yang::HeadlessRenderer::DrawLine(const FVec2& start, const FVec2& end)
+{
+	if (RenderQueue* pQueue = GetRecordingQueue(); pQueue != nullptr)
+	{
+		pQueue->AddLine(start, end);
+		return true;
+	}
+
+	auto rendererLock = LockRenderer();
+    ++m_frameCounters.m_lineCount;
+    ++m_frameCounters.m_lineCallCount;
+	if (m_pRenderer && SDL_RenderDrawLineF(m_pRenderer.get(), start.x, start.y, end.x, end.y))
+	{
+		LOG(Error, "Unable to draw line. Error: %s", SDL_GetError());
+		return false;
+	}
+	return true;
+}
+
+bool yang::HeadlessRenderer::DrawLines(const std::vector<FVec2>& points)
+{
+	if (RenderQueue* pQueue = GetRecordingQueue(); pQueue != nullptr)
+	{
+		for (size_t i = 1; i < points.size(); ++i)
+		{
+			pQueue->AddLine(points[i - 1], points[i]);
+		}
+		return true;
+	}
+
+	auto rendererLock = LockRenderer();
+    m_frameCounters.m_lineCount += points.empty() ? 0 : points.size() - 1;
+    ++m_frameCounters.m_lineCallCount;
+	if (m_pRenderer && SDL_RenderDrawLinesF(m_pRenderer.get(), reinterpret_cast<const SDL_FPoint*>(points.data()), static_cast<int>(points.size())))
+	{
+		LOG(Error, "Unable to draw lines. Error: %s", SDL_GetError());
+		return false;
+	}
+	return true;
+}
+
+bool yang::HeadlessRenderer::SetRenderTarget(ITexture* pTarget)
+{
+	if (!CanChangeRenderTarget(pTarget != nullptr))
+		return false;
+
+	auto rendererLock = LockRenderer();
+    ++m_frameCounters.m_renderTargetCount;
+    if (m_pRenderer)
+    {
+        SDL_Texture* pTargetNativeTexture = pTarget ? reinterpret_cast<SDL_Texture*>(pTarget->GetNativeTexture()) : nullptr;
+        if (GetStateCache().ChangeRenderTarget(pTargetNativeTexture) && SDL_SetRenderTarget(m_pRenderer.get(), pTargetNativeTexture))
+        {
+            GetStateCache().Reset();
+            LOG(Error, "Unable to set render target. Error: %s", SDL_GetError());
+            return false;
+        }
+    }
+
+	// Draws into the texture happen right away, they have to be done before the texture is drawn to the surface
+	OnRenderTargetChanged(pTarget != nullptr);
+	return true;
+}
+
+bool yang::HeadlessRenderer::SetDrawColor(const IColor& color)
+{
+	if (RenderQueue* pQueue = GetRecordingQueue(); pQueue != nullptr)
+	{
+		pQueue->SetColor(color);
+		return true;
+	}
+
+	auto rendererLock = LockRenderer();
+    ++m_frameCounters.m_drawColorCount;
+	if (m_pRenderer && GetStateCache().ChangeDrawColor(color) && SDL_SetRenderDrawColor(m_pRenderer.get(), color.Red(), color.Green(), color.Blue(), color.Alpha()))
+	{
+		GetStateCache().Reset();
+		LOG(Error, "Unable to set RenderColor. Error: %s", SDL_GetError());
+		return false;
+	}
+	return true;
+}
+
+std::shared_ptr<yang::ITexture> yang::HeadlessRenderer::CreateTexture(IVec2 dimensions)
+{
+	auto rendererLock = LockRenderer();
+    ++m_frameCounters.m_textureCreateCount;
+    if (!m_pRenderer)
+        return std::make_shared<HeadlessTexture>(dimensions, nullptr);
+
+	SDL_Texture* pTexture = CreateTargetTexture(dimensions);
+    if (!pTexture)
+        return nullptr;
+
+	return std::make_shared<HeadlessTexture>(dimensions, pTexture);
+}
+
+bool yang::HeadlessRenderer::SaveSurface(const std::string& filepath)
+{
+    if (!m_pSurface)
+    {
+        LOG(Error, "Headless renderer has no surface to save, it was created without rasterizing");
+        return false;
+    }
+
+	auto rendererLock = LockRenderer();
+    SDL_RenderFlush(m_pRenderer.get());
+    if (SDL_SaveBMP(m_pSurface.get(), filepath.c_str()))
+    {
+        LOG(Error, "Unable to save the headless surface to %s. Error: %s", filepath.c_str(), SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+yang::HeadlessRenderer::Counters yang::HeadlessRenderer::GetLastFrameCounters()
+{
+	auto rendererLock = LockRenderer();
+    return m_lastFrameCounters;
+}
+
+yang::HeadlessRenderer::Counters yang::HeadlessRenderer::GetTotalCounters()
+{
+	auto rendererLock = LockRenderer();
+    return m_totalCounters;
+}
@@ -0,0 +1,184 @@
+#pragma once
+/** \file HeadlessRenderer.h */
+/** Graphics system without a window, for benchmarks and servers */
+
+#include ".\SDLRendererBase.h"
+#include <string>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \class HeadlessRenderer */
+/** IGraphics implementation that needs neither a window nor a GPU. Every draw call is counted, so benchmarks and tests
+    can compare the work a frame submits deterministically. Optionally the draws are rasterized by the SDL software
+    renderer into an in-memory surface that can be read back or saved.
+    Images are decoded and textures drawn by SDLRendererBase like in SDLRenderer, so the loaders and fonts work the same on both */
+class HeadlessRenderer
+	: public SDLRendererBase
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+    /// \struct Counters
+    /// Number of native calls the draws turned into
+    struct Counters
+    {
+        size_t m_frameCount = 0;                ///< Frames presented
+        size_t m_clearCount = 0;                ///< Screen clears
+        size_t m_textureBatchCount = 0;         ///< Texture draw calls, a batch of quads counts as one
+        size_t m_textureQuadCount = 0;          ///< Texture quads drawn
+        size_t m_rectCount = 0;                 ///< Rectangle borders drawn
+        size_t m_fillRectCount = 0;             ///< Filled rectangles drawn
+        size_t m_fillCallCount = 0;             ///< Fill draw calls, a batch of rectangles counts as one
+        size_t m_lineCount = 0;                 ///< Lines drawn, connected lines count one per segment
+        size_t m_lineCallCount = 0;             ///< Line draw calls, connected lines or a batch of lines count as one
+        size_t m_drawColorCount = 0;            ///< Draw color changes
+        size_t m_renderTargetCount = 0;         ///< Render target changes
+        size_t m_textureCreateCount = 0;        ///< Textures loaded or created
+
+        /// Adds the counters of another frame
+        Counters& operator+=(const Counters& other);
+    };
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+	/// Constructor
+    /// \param isRasterizing - true to draw into an in-memory surface, false to only count the draws
+	HeadlessRenderer(bool isRasterizing = false);
+
+	/** Destructor. Stops the render thread and destroys the retired textures */
+	~HeadlessRenderer();
+
+    /// Initialize the renderer. Creates the surface and the software renderer when rasterizing
+    /// \param pWindow - Window to take the surface dimensions from. Its native window is not used
+    /// \return true if initialized successfully
+	virtual bool Initialize(IWindow* pWindow) override final;
+
+    /// Start the frame
+    /// \param red - red component of the color - int in range [0-255]
+    /// \param green - green component of the color - int in range [0-255]
+    /// \param blue - blue component of the color - int in range [0-255]
+    /// \param alpha - alpha component of the color - int in range [0-255]
+    /// \return true if successful
+	virtual bool StartDrawing(uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha) override final;
+
+    /// Finish the frame
+	virtual void EndDrawing() override final;
+
+    /// Create the texture from a SDL_Surface decoded by DecodeImage
+    /// \param pResource - Pointer to raw data resource the image was decoded from
+    /// \param pImage - Pointer to a SDL_Surface. Still owned by the caller
+    /// \return Shared pointer to texture resource
+    virtual std::shared_ptr<ITexture> CreateTextureFromImage(IResource* pResource, void* pImage) override final;
+
+    /// Draw the rectangle borders with the current draw color. Floating point version.
+    /// \param rect - The rectangle to draw (in pixels)
+    /// \return true if successful
+	virtual bool DrawRect(const FRect& rect) override final;
+
+    /// Draw a filled rectangle with the current draw color. Floating point version.
+    /// \param rect - The rectangle to draw (in pixels)
+    /// \return true if successful
+	virtual bool FillRect(const FRect& rect) override final;
+
+    /// Draw a line with the current draw color. Floating point version.
+    /// \param start - Position of the start point in pixels
+    /// \param end - Position of the end point in pixels
+    /// \return true if successful
+	virtual bool DrawLine(const FVec2& start, const FVec2& end) override final;
+
+    /// Draw connected lines with the current draw color. Floating point version.
+    /// \param points - std::vector of point positions.
+    /// \return true if successful
+	virtual bool DrawLines(const std::vector<FVec2>& points) override final;
+
+    using SDLRendererBase::DrawRect;
+    using SDLRendererBase::FillRect;
+    using SDLRendererBase::DrawLine;
+    using SDLRendererBase::DrawLines;
+
+    /// Set the render target to a texture. Nullptr resets the render target to the surface
+    /// \param pTarget - Texture to set the render target to.
+    /// \return true if successful
+	virtual bool SetRenderTarget(ITexture* pTarget) override final;
+
+    /// Set the render draw color.
+    /// \param color - color to set.
+    /// \return true if successful
+	virtual bool SetDrawColor(const IColor& color) override final;
+
+    /// Create a texture with given dimensions
+    /// \param dimensions - width and height in pixels of a new texture
+    /// \return Shared pointer to a created texture
+	virtual std::shared_ptr<ITexture> CreateTexture(IVec2 dimensions) override final;
+
+    /// Save the surface as a BMP image. Only available when rasterizing
+    /// \param filepath - path of the image to write
+    /// \return true if successful
+    bool SaveSurface(const std::string& filepath);
+
+protected:
+	// --------------------------------------------------------------------- //
+	// Protected Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Count the clear, and clear the surface when rasterizing
+    /// \param color - color to clear to
+    virtual void ClearFrame(const IColor& color) override final;
+
+    /// Finish the counters of the frame, and flush the software renderer into the surface when rasterizing
+    virtual void PresentFrame() override final;
+
+    /// Count the batch, and draw its quads into the surface when rasterizing
+    /// \param pNativeTexture - native texture of a HeadlessTexture
+    /// \param modulation - tint in red, green and blue, opacity in alpha
+    /// \param pQuads - array of the portions to draw
+    /// \param count - number of quads in the array
+    /// \return true if successful
+    virtual bool DrawNativeTextureBatch(void* pNativeTexture, const IColor& modulation, const TextureQuad* pQuads, size_t count) override final;
+
+    /// Count the rectangles as one fill call, and fill them into the surface when rasterizing
+    /// \param pRects - array of the rectangles to fill
+    /// \param count - number of rectangles in the array
+    /// \return true if successful
+    virtual bool FillNativeRects(const FRect* pRects, size_t count) override final;
+
+    /// Count the lines as one line call, and draw them into the surface when rasterizing
+    /// \param pPoints - array of line points, every two points are the start and the end of one line
+    /// \param count - number of points in the array, even
+    /// \return true if successful
+    virtual bool DrawNativeLines(const FVec2* pPoints, size_t count) override final;
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+    bool m_isRasterizing;                                                       ///< Are the draws rasterized into the surface
+	std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> m_pSurface;        ///< Surface the frames are drawn to, null when only counting
+
+    Counters m_frameCounters;                                                   ///< Counters of the frame being drawn
+    Counters m_lastFrameCounters;                                               ///< Counters of the last presented frame
+    Counters m_totalCounters;                                                   ///< Counters of every presented frame
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Get counters of the last presented frame
+    Counters GetLastFrameCounters();
+
+    /// Get counters of every frame presented so far
+    Counters GetTotalCounters();
+
+    /// Get the surface the frames are drawn to. Null when only counting
+    const SDL_Surface* GetSurface() const { return m_pSurface.get(); }
+
+    /// Are the draws rasterized into the surface
+    bool IsRasterizing() const { return m_isRasterizing; }
+};
+}
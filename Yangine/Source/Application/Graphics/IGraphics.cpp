@@ -1,6 +1,15 @@
 #include "IGraphics.h"
 #include <Application/Graphics/SDLRenderer.h>
+#include <Application/Graphics/HeadlessRenderer.h>
 #include <Application/Graphics/Textures/Sprite.h>
+#include <Application/Graphics/RenderQueue.h>
+#include <Application/Graphics/Textures/ITexture.h>
+#include <Utils/Logger.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
 
 using yang::IGraphics;
 
@@ -11,7 +20,8 @@ IGraphics::IGraphics()
 
 IGraphics::~IGraphics()
 {
-	
+	// Implementations stop the render thread in their destructor, it calls their functions
+	assert(!m_renderThread.joinable() && "Render thread is still running");
 }
 
 std::unique_ptr<IGraphics> yang::IGraphics::Create()
@@ -19,6 +29,11 @@ std::unique_ptr<IGraphics> yang::IGraphics::Create()
 	return std::make_unique<SDLRenderer>();
 }
 
+std::unique_ptr<IGraphics> yang::IGraphics::CreateHeadless(bool isRasterizing)
+{
+	return std::make_unique<HeadlessRenderer>(isRasterizing);
+}
+
 bool yang::IGraphics::DrawCircle(const FVec2& center, float radius, const IColor& color, uint8_t segments)
 {
 	// Those functions should handle logging errors
@@ -59,6 +74,227 @@ bool yang::IGraphics::FillTriangle(FVec2 points[3], const IColor& color)
 	return FillTriangle(points);
 }
 
+bool yang::IGraphics::FillCircles(const Circle* pCircles, size_t count, const IColor& color, uint8_t segments)
+{
+	// Those functions should handle logging errors
+	if (!SetDrawColor(color))
+	{
+		return false;
+	}
+	return FillCircles(pCircles, count, segments);
+}
+
+bool yang::IGraphics::DrawCircles(const Circle* pCircles, size_t count, const IColor& color, uint8_t segments)
+{
+	// Those functions should handle logging errors
+	if (!SetDrawColor(color))
+	{
+		return false;
+	}
+	return DrawCircles(pCircles, count, segments);
+}
+
+bool yang::IGraphics::DrawCircle(const FVec2& center, float radius, uint8_t segments)
+{
+	BuildCirclePoints(center, radius, segments);
+
+	// Closing the polygon with its first point draws the whole circle in one call
+	m_shapePoints.push_back(m_shapePoints.front());
+	return DrawLines(m_shapePoints);
+}
+
+bool yang::IGraphics::DrawPolygon(const std::vector<FVec2>& points)
+{
+	return DrawLines(points) && DrawLine(points[points.size() - 1], points[0]);
+}
+
+bool yang::IGraphics::FillTriangle(FVec2 points[3])
+{
+	m_spans.clear();
+	AppendConvexSpans(points, 3);
+	return FillRects(m_spans.data(), m_spans.size());
+}
+
+bool yang::IGraphics::FillCircle(const FVec2& center, float radius, uint8_t segments)
+{
+	m_spans.clear();
+	BuildCirclePoints(center, radius, segments);
+	AppendConvexSpans(m_shapePoints.data(), m_shapePoints.size());
+	return FillRects(m_spans.data(), m_spans.size());
+}
+
+bool yang::IGraphics::FillCircles(const Circle* pCircles, size_t count, uint8_t segments)
+{
+	m_spans.clear();
+	for (size_t i = 0; i < count; ++i)
+	{
+		BuildCirclePoints(pCircles[i].m_center, pCircles[i].m_radius, segments);
+		AppendConvexSpans(m_shapePoints.data(), m_shapePoints.size());
+	}
+	return FillRects(m_spans.data(), m_spans.size());
+}
+
+bool yang::IGraphics::DrawCircles(const Circle* pCircles, size_t count, uint8_t segments)
+{
+	bool success = true;
+	for (size_t i = 0; i < count; ++i)
+	{
+		success = DrawCircle(pCircles[i].m_center, pCircles[i].m_radius, segments) && success;
+	}
+	return success;
+}
+
+bool yang::IGraphics::FillRects(const FRect* pRects, size_t count, const IColor& color)
+{
+	// Those functions should handle logging errors
+	if (!SetDrawColor(color))
+	{
+		return false;
+	}
+	return FillRects(pRects, count);
+}
+
+bool yang::IGraphics::FillRectsColored(const FRect* pRects, const IColor* pColors, size_t count)
+{
+	// SDL can't color the rectangles of one call differently, so every run of one color is a call
+	bool success = true;
+	for (size_t runStart = 0; runStart < count;)
+	{
+		size_t runEnd = runStart + 1;
+		while (runEnd < count && pColors[runEnd].m_color == pColors[runStart].m_color)
+		{
+			++runEnd;
+		}
+
+		success = FillRects(pRects + runStart, runEnd - runStart, pColors[runStart]) && success;
+		runStart = runEnd;
+	}
+	return success;
+}
+
+bool yang::IGraphics::DrawLineList(const FVec2* pPoints, size_t count, const IColor& color)
+{
+	// Those functions should handle logging errors
+	if (!SetDrawColor(color))
+	{
+		return false;
+	}
+	return DrawLineList(pPoints, count);
+}
+
+bool yang::IGraphics::DrawLineList(const FVec2* pPoints, size_t count)
+{
+	// Lines need both of their points
+	count -= count % 2;
+	if (count == 0)
+		return true;
+
+	if (RenderQueue* pQueue = GetRecordingQueue(); pQueue != nullptr)
+	{
+		for (size_t i = 0; i < count; i += 2)
+		{
+			pQueue->AddLine(pPoints[i], pPoints[i + 1]);
+		}
+		return true;
+	}
+
+	return DrawNativeLines(pPoints, count);
+}
+
+bool yang::IGraphics::FillRects(const FRect* pRects, size_t count)
+{
+	if (count == 0)
+		return true;
+
+	if (RenderQueue* pQueue = GetRecordingQueue(); pQueue != nullptr)
+	{
+		pQueue->AddFillRects(pRects, count);
+		return true;
+	}
+
+	return FillNativeRects(pRects, count);
+}
+
+void yang::IGraphics::AppendConvexSpans(const FVec2* pPoints, size_t count)
+{
+	if (count < 3)
+		return;
+
+	float minY = pPoints[0].y;
+	float maxY = pPoints[0].y;
+	for (size_t i = 1; i < count; ++i)
+	{
+		minY = std::min(minY, pPoints[i].y);
+		maxY = std::max(maxY, pPoints[i].y);
+	}
+
+	// A row is covered if its center is inside of the polygon. Edges include their top point and exclude the bottom one,
+	// so a row through a vertex crosses the outline exactly twice
+	int lastRow = static_cast<int>(std::ceil(maxY - 0.5f));
+	for (int row = static_cast<int>(std::ceil(minY - 0.5f)); row < lastRow; ++row)
+	{
+		float sampleY = static_cast<float>(row) + 0.5f;
+		float left = std::numeric_limits<float>::max();
+		float right = std::numeric_limits<float>::lowest();
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const FVec2& start = pPoints[i];
+			const FVec2& end = pPoints[(i + 1) % count];
+			if ((start.y <= sampleY) == (end.y <= sampleY))
+				continue;
+
+			float x = start.x + (sampleY - start.y) * (end.x - start.x) / (end.y - start.y);
+			left = std::min(left, x);
+			right = std::max(right, x);
+		}
+
+		if (left < right)
+		{
+			m_spans.emplace_back(left, static_cast<float>(row), right - left, 1.f);
+		}
+	}
+}
+
+void yang::IGraphics::BuildCirclePoints(const FVec2& center, float radius, uint8_t segments)
+{
+	// Fewer than 3 segments is not a polygon
+	segments = std::max<uint8_t>(segments, 3);
+
+	m_shapePoints.clear();
+	for (size_t i = 0; i < segments; ++i)
+	{
+		m_shapePoints.emplace_back(center.x + radius * std::cosf(2 * Math::kPi * i / segments), center.y + radius * std::sinf(2 * Math::kPi * i / segments));
+	}
+}
+
+bool yang::IGraphics::DrawSprites(ITexture* pTexture, const IRect* pSources, const FRect* pDests, size_t count)
+{
+	m_quads.clear();
+	for (size_t i = 0; i < count; ++i)
+	{
+		m_quads.push_back(TextureQuad{ pSources[i], pDests[i], TextureDrawParams{} });
+	}
+	return DrawTextureBatch(pTexture, m_quads.data(), m_quads.size());
+}
+
+bool yang::IGraphics::DrawSprites(std::shared_ptr<Sprite> pSprite, const FRect* pDests, size_t count)
+{
+	if (!pSprite)
+		return false;
+
+	if (auto pTexture = pSprite->GetSourceTexture().lock(); pTexture != nullptr)
+	{
+		m_quads.clear();
+		for (size_t i = 0; i < count; ++i)
+		{
+			m_quads.push_back(TextureQuad{ pSprite->GetSourceRect(), pDests[i], pSprite->GetDrawParams() });
+		}
+		return DrawTextureBatch(pTexture.get(), m_quads.data(), m_quads.size());
+	}
+	return false;
+}
+
 bool yang::IGraphics::DrawSprite(std::shared_ptr<Sprite> pSprite, const IRect& dst)
 {
 	if (!pSprite)
@@ -178,4 +414,429 @@ bool yang::IGraphics::DrawLines(const std::vector<FVec2>& points, const IColor&
 		return false;
 	}
 	return DrawLines(points);
-}
\ No newline at end of file
+}
+
+bool yang::IGraphics::DrawTextureBatch(ITexture* pTexture, const TextureQuad* pQuads, size_t count)
+{
+    if (!pTexture)
+    {
+        LOG(Error, "Texture was nullptr");
+        return false;
+    }
+
+    if (RenderQueue* pQueue = GetRecordingQueue(); pQueue != nullptr)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            pQueue->AddTexture(pTexture, pQuads[i].m_src, pQuads[i].m_dst, pQuads[i].m_drawParams);
+        }
+        return true;
+    }
+
+    return DrawNativeTextureBatch(pTexture->GetNativeTexture(), pTexture->GetModulation(), pQuads, count);
+}
+
+void yang::IGraphics::SetRenderQueueEnabled(bool isEnabled)
+{
+    if (isEnabled == (m_pRenderQueue != nullptr))
+        return;
+
+    if (!isEnabled)
+    {
+        SetRenderThreadEnabled(false);
+    }
+
+    // Draws recorded so far this frame are not lost
+    if (!isEnabled && m_isRecording)
+    {
+        m_isRecording = false;
+        m_pRenderQueue->Submit(this);
+    }
+
+    m_pRenderQueue = isEnabled ? std::make_unique<RenderQueue>() : nullptr;
+}
+
+void yang::IGraphics::SetRenderThreadEnabled(bool isEnabled)
+{
+    if (isEnabled == IsRenderThreadEnabled())
+        return;
+
+    if (m_isFrameStarted)
+    {
+        LOG(Error, "Render thread can't be %s in the middle of a frame", isEnabled ? "started" : "stopped");
+        return;
+    }
+
+    if (isEnabled)
+    {
+        SetRenderQueueEnabled(true);
+        m_pSubmitQueue = std::make_unique<RenderQueue>();
+        m_isRenderThreadExiting = false;
+
+        // The renderer can't leave this thread, the game has to leave it instead
+        if (!IsRenderThreadSupported())
+        {
+            m_isRenderLoopHosted = true;
+            m_rendererThreadId = std::this_thread::get_id();
+            LOG(Info, "Render loop hosted, this thread presents the frames in RunRenderLoop while the game runs on another one");
+            return;
+        }
+
+        m_renderThread = std::thread(&IGraphics::RenderThreadMain, this, std::function<void()>());
+        LOG(Info, "Render thread started");
+        return;
+    }
+
+    if (m_isRenderLoopHosted)
+    {
+        // RunRenderLoop has returned, the frame in flight was presented
+        m_isRenderLoopHosted = false;
+    }
+    else
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_frameMutex);
+            m_isRenderThreadExiting = true;
+        }
+        m_frameCondition.notify_all();
+        m_renderThread.join();
+    }
+    m_pSubmitQueue.reset();
+
+    // Nothing is in flight anymore
+    ReleaseRetiredResources();
+    LOG(Info, "Render thread stopped");
+}
+
+void yang::IGraphics::SetDrawLayer(uint8_t layer)
+{
+    if (m_pRenderQueue)
+    {
+        m_pRenderQueue->SetLayer(layer);
+    }
+}
+
+void yang::IGraphics::SetDrawDepth(float depth)
+{
+    if (m_pRenderQueue)
+    {
+        m_pRenderQueue->SetDepth(depth);
+    }
+}
+
+void yang::IGraphics::RunRenderLoop(const std::function<void()>& betweenFrames)
+{
+    if (!m_isRenderLoopHosted || !IsOnRendererThread())
+    {
+        LOG(Error, "Render loop has to be run by the thread that enabled the render thread for a graphics system bound to its thread");
+        return;
+    }
+
+    LOG(Info, "Render loop started");
+    RenderThreadMain(betweenFrames);
+    LOG(Info, "Render loop stopped");
+}
+
+void yang::IGraphics::StopRenderLoop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_frameMutex);
+        m_isRenderThreadExiting = true;
+    }
+    m_frameCondition.notify_all();
+}
+
+void yang::IGraphics::BeginFrame(const IColor& clearColor)
+{
+    m_frameStartTime = Clock::now();
+    m_isFrameStarted = true;
+
+    if (IsRenderThreadEnabled())
+    {
+        m_clearColor = clearColor;
+    }
+    else
+    {
+        ClearFrame(clearColor);
+    }
+
+    if (m_pRenderQueue)
+    {
+        m_pRenderQueue->Clear();
+        m_isRecording = true;
+    }
+}
+
+void yang::IGraphics::EndFrame()
+{
+    if (!m_isFrameStarted)
+        return;
+
+    m_isFrameStarted = false;
+    m_isRecording = false;
+
+    // The frame would be presented from the target
+    if (m_isTargetSet)
+    {
+        LOG(Error, "Render target is still set at the end of the frame");
+        SetRenderTarget(nullptr);
+    }
+
+    if (IsRenderThreadEnabled())
+    {
+        Clock::time_point waitStartTime = Clock::now();
+        WaitForRenderThread();
+        m_renderWaitTotal += Clock::now() - waitStartTime;
+
+        // The render thread is idle, nothing it drew is in use anymore
+        ReleaseRetiredResources();
+        ReportFrameStats(m_pSubmitQueue.get());
+
+        {
+            std::lock_guard<std::mutex> lock(m_frameMutex);
+            std::swap(m_pRenderQueue, m_pSubmitQueue);
+            m_submitClearColor = m_clearColor;
+            m_submitFrameStartTime = m_frameStartTime;
+            m_hasSubmitFrame = true;
+        }
+        m_frameCondition.notify_all();
+        return;
+    }
+
+    if (m_pRenderQueue)
+    {
+        m_pRenderQueue->Submit(this);
+    }
+    PresentFrame();
+    ReleaseRetiredResources();
+
+    {
+        std::lock_guard<std::mutex> lock(m_frameMutex);
+        m_lastLatency = Clock::now() - m_frameStartTime;
+        m_latencyTotal += m_lastLatency;
+        ++m_presentedFrameCount;
+    }
+    ReportFrameStats(m_pRenderQueue.get());
+}
+
+bool yang::IGraphics::CanChangeRenderTarget(bool isTargetSet) const
+{
+    // The render thread could draw into the target between the calls
+    if (isTargetSet && m_targetScopeCount == 0 && IsRenderThreadEnabled())
+    {
+        LOG(Error, "Render target has to be set through RenderTargetScope while the render thread runs");
+        return false;
+    }
+
+    return true;
+}
+
+void yang::IGraphics::OnRenderTargetChanged(bool isTargetSet)
+{
+    // Draws into the target are made right away
+    m_isRecording = m_pRenderQueue && m_isFrameStarted && !isTargetSet;
+    m_isTargetSet = isTargetSet;
+}
+
+float yang::IGraphics::GetLastFrameLatency()
+{
+    std::lock_guard<std::mutex> lock(m_frameMutex);
+    return std::chrono::duration<float, std::milli>(m_lastLatency).count();
+}
+
+yang::IGraphics::RenderTargetScope::RenderTargetScope(IGraphics* pGraphics, ITexture* pTarget)
+    : m_pGraphics(pGraphics)
+    , m_rendererLock(pGraphics->LockRenderer())
+    , m_isTargetSet(false)
+{
+    {
+        // A hosted render loop doesn't take the renderer lock, it waits for the scope to end before it submits a frame
+        std::lock_guard<std::mutex> lock(m_pGraphics->m_frameMutex);
+        ++m_pGraphics->m_targetScopeCount;
+    }
+    m_isTargetSet = pTarget && m_pGraphics->SetRenderTarget(pTarget);
+}
+
+yang::IGraphics::RenderTargetScope::~RenderTargetScope()
+{
+    Reset();
+    {
+        std::lock_guard<std::mutex> lock(m_pGraphics->m_frameMutex);
+        --m_pGraphics->m_targetScopeCount;
+    }
+    m_pGraphics->m_frameCondition.notify_all();
+}
+
+bool yang::IGraphics::RenderTargetScope::Reset()
+{
+    if (!m_isTargetSet)
+        return true;
+
+    m_isTargetSet = false;
+    return m_pGraphics->SetRenderTarget(nullptr);
+}
+
+bool yang::IGraphics::RenderTargetScope::Clear()
+{
+    if (!m_isTargetSet)
+        return false;
+
+    m_pGraphics->ClearFrame(IColor(0, 0, 0, 0));
+    return true;
+}
+
+std::unique_lock<std::recursive_mutex> yang::IGraphics::LockRenderer()
+{
+    if (m_renderThread.joinable())
+        return std::unique_lock<std::recursive_mutex>(m_rendererMutex);
+
+    return std::unique_lock<std::recursive_mutex>(m_rendererMutex, std::defer_lock);
+}
+
+bool yang::IGraphics::IsOnRendererThread() const
+{
+    return !m_isRenderLoopHosted || std::this_thread::get_id() == m_rendererThreadId;
+}
+
+void yang::IGraphics::RunOnRendererThread(const std::function<void()>& function)
+{
+    RendererTask task{ &function };
+    std::unique_lock<std::mutex> lock(m_frameMutex);
+    m_rendererTasks.push_back(&task);
+    m_frameCondition.notify_all();
+    m_frameCondition.wait(lock, [&task]() { return task.m_isDone; });
+}
+
+namespace
+{
+    // The render thread submits through the same draw functions, those have to reach the renderer
+    thread_local bool t_isRenderThread = false;
+}
+
+yang::RenderQueue* yang::IGraphics::GetRecordingQueue() const
+{
+    return (!t_isRenderThread && m_isRecording) ? m_pRenderQueue.get() : nullptr;
+}
+
+void yang::IGraphics::RenderThreadMain(const std::function<void()>& betweenFrames)
+{
+    t_isRenderThread = true;
+
+    // A frame is drawn into the window, the render target of a live scope would catch it
+    auto isWorkReady = [this]() { return !m_rendererTasks.empty() || (m_hasSubmitFrame && m_targetScopeCount == 0) || m_isRenderThreadExiting; };
+
+    std::unique_lock<std::mutex> lock(m_frameMutex);
+    while (true)
+    {
+        if (betweenFrames)
+        {
+            // Wakes up anyway to keep the window responsive while the game thread is busy, loading a scene for example
+            m_frameCondition.wait_for(lock, kRenderLoopIdleInterval, isWorkReady);
+        }
+        else
+        {
+            m_frameCondition.wait(lock, isWorkReady);
+        }
+
+        // The game thread waits for its native calls, they go before the frame
+        if (!m_rendererTasks.empty())
+        {
+            std::vector<RendererTask*> tasks;
+            tasks.swap(m_rendererTasks);
+            lock.unlock();
+            for (RendererTask* pTask : tasks)
+            {
+                (*pTask->m_pFunction)();
+            }
+            lock.lock();
+
+            for (RendererTask* pTask : tasks)
+            {
+                pTask->m_isDone = true;
+            }
+            m_frameCondition.notify_all();
+            continue;
+        }
+
+        if (m_hasSubmitFrame && m_targetScopeCount == 0)
+        {
+            // The game thread doesn't touch the submit queue until the frame is marked as presented
+            lock.unlock();
+            {
+                std::lock_guard<std::recursive_mutex> rendererLock(m_rendererMutex);
+                ClearFrame(m_submitClearColor);
+                m_pSubmitQueue->Submit(this);
+                PresentFrame();
+            }
+            Clock::time_point presentTime = Clock::now();
+            lock.lock();
+
+            m_lastLatency = presentTime - m_submitFrameStartTime;
+            m_latencyTotal += m_lastLatency;
+            ++m_presentedFrameCount;
+            m_hasSubmitFrame = false;
+            m_frameCondition.notify_all();
+        }
+        else if (m_isRenderThreadExiting)
+        {
+            break;
+        }
+
+        if (betweenFrames)
+        {
+            lock.unlock();
+            betweenFrames();
+            lock.lock();
+        }
+    }
+
+    t_isRenderThread = false;
+}
+
+void yang::IGraphics::WaitForRenderThread()
+{
+    std::unique_lock<std::mutex> lock(m_frameMutex);
+    m_frameCondition.wait(lock, [this]() { return !m_hasSubmitFrame; });
+}
+
+void yang::IGraphics::ReportFrameStats(const RenderQueue* pSubmittedQueue)
+{
+    Clock::time_point now = Clock::now();
+    if (m_frameCount > 0)
+    {
+        m_frameTimeTotal += now - m_lastFrameEndTime;
+    }
+    m_lastFrameEndTime = now;
+
+    ++m_frameCount;
+    if (m_frameCount % kRenderStatsReportInterval != 0)
+        return;
+
+    using Milliseconds = std::chrono::duration<float, std::milli>;
+    {
+        std::lock_guard<std::mutex> lock(m_frameMutex);
+        m_frameTiming.m_frameTime = Milliseconds(m_frameTimeTotal).count() / kRenderStatsReportInterval;
+        m_frameTiming.m_latency = m_presentedFrameCount > 0 ? Milliseconds(m_latencyTotal).count() / m_presentedFrameCount : 0.f;
+        m_frameTiming.m_renderWaitTime = Milliseconds(m_renderWaitTotal).count() / kRenderStatsReportInterval;
+        m_frameTimeTotal = Clock::duration::zero();
+        m_latencyTotal = Clock::duration::zero();
+        m_renderWaitTotal = Clock::duration::zero();
+        m_presentedFrameCount = 0;
+    }
+
+    LOG(Stats, "Frame timing (%s): %.2f ms per frame (%.1f fps), %.2f ms from StartDrawing to present, %.2f ms waiting for the render thread",
+        m_isRenderLoopHosted ? "game thread" : (m_renderThread.joinable() ? "render thread" : "single thread"), m_frameTiming.m_frameTime,
+        m_frameTiming.m_frameTime > 0.f ? 1000.f / m_frameTiming.m_frameTime : 0.f, m_frameTiming.m_latency, m_frameTiming.m_renderWaitTime);
+
+    if (pSubmittedQueue)
+    {
+        const RenderQueue::Stats& stats = pSubmittedQueue->GetStats();
+        LOG(Stats, "Render queue last frame: %zu draws, %zu texture switches unsorted -> %zu draw calls, %zu texture switches, %zu color changes sorted",
+            stats.m_commandCount, stats.m_unsortedTextureSwitchCount, stats.m_drawCallCount, stats.m_textureSwitchCount, stats.m_colorChangeCount);
+    }
+
+    const RenderStateCache::Stats& stateStats = m_stateCache.GetStats();
+    LOG(Stats, "Render state changes made/skipped so far: draw color %zu/%zu, render target %zu/%zu, texture modulation %zu/%zu",
+        stateStats.m_drawColorCount, stateStats.m_elidedDrawColorCount, stateStats.m_renderTargetCount, stateStats.m_elidedRenderTargetCount,
+        stateStats.m_modulationCount, stateStats.m_elidedModulationCount);
+}
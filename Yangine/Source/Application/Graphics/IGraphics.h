@@ -2,11 +2,18 @@
 #include <memory>
 #include <vector>
 #include <optional>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
 
 #include <Utils/Matrix.h>
 #include <Utils/Vector2.h>
 #include <Utils/Rectangle.h>
 #include <Utils/Color.h>
+#include <Application/Graphics/RenderStateCache.h>
 
 #include <memory>
 /** \file IGraphics.h */
@@ -20,6 +27,7 @@ namespace yang
     class ITexture;
     class IResource;
     class Sprite;
+    class RenderQueue;
 
 /** \enum FlipDirection */
 /** Specifies the flip configuration of TextureDrawParams */
@@ -40,6 +48,23 @@ struct TextureDrawParams
 	FlipDirection m_flip = FlipDirection::kNone;    ///< How to flip the texture
 };
 
+/** \struct TextureQuad */
+/** One portion of a texture drawn by IGraphics::DrawTextureBatch */
+struct TextureQuad
+{
+	IRect m_src;                        ///< Rectangle to use from the texture (in pixels)
+	FRect m_dst;                        ///< Rectangle on the screen to draw the texture to (in pixels)
+	TextureDrawParams m_drawParams;     ///< Parameters to draw the texture
+};
+
+/** \struct Circle */
+/** One circle drawn by IGraphics::FillCircles or IGraphics::DrawCircles */
+struct Circle
+{
+	FVec2 m_center;                     ///< Center of the circle position in pixels
+	float m_radius = 0.f;               ///< Radius of the circle in pixels
+};
+
 /** \class IGraphics */
 /** Interface for graphics system wrappers */
 class IGraphics
@@ -49,6 +74,8 @@ public:
 	// Public Member Variables
 	// --------------------------------------------------------------------- //
 
+    static constexpr size_t kRenderStatsReportInterval = 300;  ///< How often (in frames) the render queue counters are logged
+    static constexpr std::chrono::milliseconds kRenderLoopIdleInterval{ 10 };  ///< How long RunRenderLoop waits for work before it calls betweenFrames anyway
 
 	// --------------------------------------------------------------------- //
 	// Public Member Functions
@@ -81,6 +108,21 @@ public:
     /// \return Shared pointer to texture resource
     virtual std::shared_ptr<ITexture> LoadTexture(IResource* pResource) = 0;
 
+    /// Decode the image from a raw data resource into CPU memory. Safe to call from worker threads
+    /// \param pResource - Pointer to raw data resource
+    /// \return Pointer to a native decoded image, that has to be passed to CreateTextureFromImage or FreeImage. Null if decoding failed
+    virtual void* DecodeImage(IResource* pResource) = 0;
+
+    /// Create the texture from an image decoded by DecodeImage. Main thread only
+    /// \param pResource - Pointer to raw data resource the image was decoded from
+    /// \param pImage - Pointer to a native decoded image. Still owned by the caller
+    /// \return Shared pointer to texture resource
+    virtual std::shared_ptr<ITexture> CreateTextureFromImage(IResource* pResource, void* pImage) = 0;
+
+    /// Release an image decoded by DecodeImage
+    /// \param pImage - Pointer to a native decoded image
+    virtual void FreeImage(void* pImage) = 0;
+
     /// Draw the texture at specified position
     /// \param pTexture - texture to draw
     /// \param position - position where to draw the texture. Defaulted to {0,0}
@@ -111,6 +153,28 @@ public:
     /// \return true if successful
     virtual bool DrawTexture(ITexture* pTexture, const IRect& src, const FRect& dest, const TextureDrawParams& drawParams = {}) = 0;
 
+    /// Draw several portions of one texture. The texture state (tint, alpha) is the same for every quad
+    /// \param pTexture - texture to draw
+    /// \param pQuads - array of the portions to draw
+    /// \param count - number of quads in the array
+    /// \return true if successful
+    bool DrawTextureBatch(ITexture* pTexture, const TextureQuad* pQuads, size_t count);
+
+    /// Draw several portions of one texture without rotation or flip, in one batch
+    /// \param pTexture - texture to draw
+    /// \param pSources - array of rectangles to use from the texture (in pixels)
+    /// \param pDests - array of rectangles on the screen to draw the portions to (in pixels), one per source
+    /// \param count - number of rectangles in each array
+    /// \return true if successful
+    bool DrawSprites(ITexture* pTexture, const IRect* pSources, const FRect* pDests, size_t count);
+
+    /// Draw the sprite at several positions, in one batch
+    /// \param pSprite - sprite to draw
+    /// \param pDests - array of destination rectangles where to draw
+    /// \param count - number of rectangles in the array
+    /// \return true if successful
+    bool DrawSprites(std::shared_ptr<Sprite> pSprite, const FRect* pDests, size_t count);
+
     /// Draw the the sprite at specified position
     /// \param pSprite - sprite to draw;
     /// \param dst - destination rectangle where to draw
@@ -176,6 +240,41 @@ public:
     /// \return true if successful
 	bool DrawLines(const std::vector<FVec2>& points, const IColor& color);
 
+    /// Draw several filled rectangles of one color on the screen in one draw call
+    /// \param pRects - array of the rectangles to draw (in pixels)
+    /// \param count - number of rectangles in the array
+    /// \param color - integer color to fill the rectangles
+    /// \return true if successful
+    bool FillRects(const FRect* pRects, size_t count, const IColor& color);
+
+    /// Draw several filled rectangles, each in its own color. Every run of rectangles with the same color is one draw call,
+    /// and the render queue merges the runs of a color further
+    /// \param pRects - array of the rectangles to draw (in pixels)
+    /// \param pColors - array of the colors, one per rectangle
+    /// \param count - number of rectangles and colors
+    /// \return true if successful
+    bool FillRectsColored(const FRect* pRects, const IColor* pColors, size_t count);
+
+    /// Draw separate lines on the screen in one draw call
+    /// \param pPoints - array of line points, every two points are the start and the end of one line
+    /// \param count - number of points in the array, an odd last point is ignored
+    /// \param color - integer color of the lines
+    /// \return true if successful
+    bool DrawLineList(const FVec2* pPoints, size_t count, const IColor& color);
+
+    /// Draw several filled rectangles on the screen in one draw call. Version without color. The current renderer color is used to draw the rectangles.
+    /// Records them as one command when recording, fills them with FillNativeRects otherwise
+    /// \param pRects - array of the rectangles to draw (in pixels)
+    /// \param count - number of rectangles in the array
+    /// \return true if successful
+    bool FillRects(const FRect* pRects, size_t count);
+
+    /// Draw separate lines on the screen in one draw call. Version without color. The current renderer color is used to draw lines.
+    /// \param pPoints - array of line points, every two points are the start and the end of one line
+    /// \param count - number of points in the array, an odd last point is ignored
+    /// \return true if successful
+    bool DrawLineList(const FVec2* pPoints, size_t count);
+
     /// Draw the rectangle borders on the screen. Version without color. The current renderer color is used to draw the rectangle.
     /// \param rect - The rectangle to draw (in pixels)
     /// \return true if successful
@@ -237,14 +336,16 @@ public:
     /// \param radius - Radius of the circle in pixels.
     /// \param segments - Number of line segments used to draw the circle. Defaulted to 16
     /// \return true if successful
-	virtual bool DrawCircle(const FVec2& center, float radius, uint8_t segments = 16) = 0;
+	virtual bool DrawCircle(const FVec2& center, float radius, uint8_t segments = 16);
 
     /// Draw the polygon on the screen. Colorless version. The current renderer color is used to draw lines.
+    /// Implementations without a native polygon draw it with DrawLines
     /// \param points - std::vector of polygon vertices positions (in pixels) to draw
     /// \return true if successful
-	virtual bool DrawPolygon(const std::vector<FVec2>& points) = 0;
+	virtual bool DrawPolygon(const std::vector<FVec2>& points);
 
-	/// Set the render target to a texture. Nullptr resets the render target to the screen
+	/// Set the render target to a texture. Nullptr resets the render target to the screen.
+    /// While the render thread runs the targets can only be set inside a RenderTargetScope
     /// \param pTarget - Texture to set the render target to.
     /// \return true if successful
 	virtual bool SetRenderTarget(ITexture* pTarget) = 0;
@@ -264,15 +365,19 @@ public:
     /// \return Unique pointer to the graphics system
 	static std::unique_ptr<IGraphics> Create();
 
+    /// Create the graphics system without a window or GPU. It counts the draw calls, and optionally
+    /// rasterizes them into an in-memory surface. \see yang::HeadlessRenderer
+    /// \param isRasterizing - true to draw into the surface, false to only count the draws
+    /// \return Unique pointer to the graphics system
+	static std::unique_ptr<IGraphics> CreateHeadless(bool isRasterizing = false);
+
     /// Draw a filled triangle on the screen
-    /// Note: That function is slow, so prefer to use for debug purposes only.
     /// \param points - Array of triangle vertices position in pixels.
     /// \param color - color to draw the triangle
     /// \return true if successful
 	bool FillTriangle(FVec2 points[3], const IColor& color);
 
     /// Draw a filled circle on the screen
-    /// Note: That function is slow, so prefer to use for debug purposes only.
     /// \param center - Center of the circle position in pixels.
     /// \param radius - Radius of the circle in pixels.
     /// \param segments - Number of circle segments used to draw the circle. Defaulted to 16
@@ -280,41 +385,330 @@ public:
     /// \return true if successful
 	bool FillCircle(const FVec2& center, float radius, const IColor& color, uint8_t segments = 16);
 
-    /// Draw a filled circle on the screen. Colorless version. The current renderer color is used to draw lines.
-    /// Note: That function is slow, so prefer to use for debug purposes only.
+    /// Draw several filled circles on the screen in one draw call
+    /// \param pCircles - array of the circles to draw
+    /// \param count - number of circles in the array
+    /// \param color - color to draw the circles
+    /// \param segments - Number of circle segments used to draw every circle. Defaulted to 16
+    /// \return true if successful
+	bool FillCircles(const Circle* pCircles, size_t count, const IColor& color, uint8_t segments = 16);
+
+    /// Draw borders of several circles on the screen
+    /// \param pCircles - array of the circles to draw
+    /// \param count - number of circles in the array
+    /// \param color - color to draw the circles
+    /// \param segments - Number of line segments used to draw every circle. Defaulted to 16
+    /// \return true if successful
+	bool DrawCircles(const Circle* pCircles, size_t count, const IColor& color, uint8_t segments = 16);
+
+    /// Draw a filled circle on the screen. Colorless version. The current renderer color is used to draw the circle.
+    /// The polygon of the circle is scan converted into one filled rectangle per row, and the rows are drawn in one FillRects call
     /// \param center - Center of the circle position in pixels.
     /// \param radius - Radius of the circle in pixels.
     /// \param segments - Number of circle segments used to draw the circle. Defaulted to 16
     /// \return true if successful
-	virtual bool FillCircle(const FVec2& center, float radius, uint8_t segments = 16) = 0;
+	virtual bool FillCircle(const FVec2& center, float radius, uint8_t segments = 16);
 
-    /// Draw a filled triangle on the screen. Colorless version. The current renderer color is used to draw lines.
-    /// Note: That function is slow, so prefer to use for debug purposes only.
+    /// Draw a filled triangle on the screen. Colorless version. The current renderer color is used to draw the triangle.
+    /// It is scan converted into one filled rectangle per row, and the rows are drawn in one FillRects call
     /// \param points - Array of triangle vertices position in pixels.
     /// \return true if successful
-	virtual bool FillTriangle(FVec2 points[3]) = 0;
+	virtual bool FillTriangle(FVec2 points[3]);
+
+    /// Draw several filled circles on the screen. Colorless version. The current renderer color is used to draw the circles.
+    /// The rows of every circle go into one FillRects call
+    /// \param pCircles - array of the circles to draw
+    /// \param count - number of circles in the array
+    /// \param segments - Number of circle segments used to draw every circle. Defaulted to 16
+    /// \return true if successful
+	virtual bool FillCircles(const Circle* pCircles, size_t count, uint8_t segments = 16);
+
+    /// Draw borders of several circles on the screen. Colorless version. The current renderer color is used to draw the circles.
+    /// \param pCircles - array of the circles to draw
+    /// \param count - number of circles in the array
+    /// \param segments - Number of line segments used to draw every circle. Defaulted to 16
+    /// \return true if successful
+	virtual bool DrawCircles(const Circle* pCircles, size_t count, uint8_t segments = 16);
 
     /// Return the underlying renderer system, depending on the used library.
     /// \return Pointer to a native renderer
     virtual void* GetNativeRenderer() = 0;
 
+    /// Record the draws between StartDrawing and EndDrawing into a RenderQueue and submit them sorted and batched
+    /// at EndDrawing. Draws into render targets are never recorded. Textures drawn while recording have to stay alive until EndDrawing
+    /// \param isEnabled - true to record the draws, false to draw right away. Disabling stops the render thread
+    void SetRenderQueueEnabled(bool isEnabled);
+
+    /// Submit and present the recorded frames on a dedicated render thread. EndDrawing hands the frame over and returns,
+    /// so the game simulates the next frame while the previous one is drawn and waits for vsync. Enables the render queue.
+    /// Has to be called outside of StartDrawing and EndDrawing. Graphics systems bound to the thread that created them
+    /// (\see IsRenderThreadSupported) start no thread: the calling thread keeps the renderer and presents the frames in
+    /// RunRenderLoop while the game runs on another thread, \see IsRenderLoopHosted
+    /// \param isEnabled - true to start the render thread, false to finish the frame in flight and stop it
+    void SetRenderThreadEnabled(bool isEnabled);
+
+    /// Submit and present the frames handed over by the game thread on this thread until StopRenderLoop. Makes the native calls
+    /// the game thread routes here in the meantime. Only for a hosted render loop, called by the thread that enabled it
+    /// \param betweenFrames - called on this thread after every presented frame, and every kRenderLoopIdleInterval while there is no work.
+    /// Pumps the window events
+    void RunRenderLoop(const std::function<void()>& betweenFrames);
+
+    /// Make RunRenderLoop return once the frame in flight is presented. Called by the game thread when its loop ends
+    void StopRenderLoop();
+
+    /// Set the layer of the next recorded draws, see RenderQueue layer constants. Does nothing when the queue is disabled
+    /// \param layer - higher layers are drawn on top
+    void SetDrawLayer(uint8_t layer);
+
+    /// Set the depth of the next recorded draws. Does nothing when the queue is disabled
+    /// \param depth - inside a layer the higher depths are drawn on top. Draws with the same depth have no guaranteed order
+    void SetDrawDepth(float depth);
+
+    /// \class RenderTargetScope
+    /// Draws into a texture for the lifetime of the scope. Sets the render target on construction and resets it to the screen
+    /// when the scope ends, also on early returns. While the render thread runs the scope holds the renderer lock from the first
+    /// to the last call, so the render thread can't draw between them into the target. Scopes don't nest
+    class RenderTargetScope
+    {
+    public:
+        /// Constructor
+        /// \param pGraphics - graphics system to draw with
+        /// \param pTarget - texture to draw into
+        RenderTargetScope(IGraphics* pGraphics, ITexture* pTarget);
+
+        /// Destructor, resets the render target to the screen
+        ~RenderTargetScope();
+
+        RenderTargetScope(const RenderTargetScope&) = delete;
+        RenderTargetScope& operator=(const RenderTargetScope&) = delete;
+
+        /// Resets the render target to the screen before the scope ends
+        /// \return true if the target was reset, or was never set
+        bool Reset();
+
+        /// Clears the target to transparent. Render targets keep their content, a texture drawn into again starts from it
+        /// \return true if the target is set and was cleared
+        bool Clear();
+
+        /// Was the render target set. Draws go to the screen otherwise
+        bool IsTargetSet() const { return m_isTargetSet; }
+
+    private:
+        IGraphics* m_pGraphics;                                 ///< Graphics system the target is set on
+        std::unique_lock<std::recursive_mutex> m_rendererLock;  ///< Renderer lock held while the render thread runs
+        bool m_isTargetSet;                                     ///< Is the target still set
+    };
+
+    /// \struct FrameTiming
+    /// Frame timings averaged over the last kRenderStatsReportInterval frames
+    struct FrameTiming
+    {
+        float m_frameTime = 0.f;        ///< Time between EndDrawing calls (ms), the game thread frame time
+        float m_latency = 0.f;          ///< Time from StartDrawing until the frame is presented (ms)
+        float m_renderWaitTime = 0.f;   ///< Time EndDrawing spent waiting for the render thread to finish the previous frame (ms)
+    };
+
 protected:
 	// --------------------------------------------------------------------- //
 	// Protected Member Functions
 	// --------------------------------------------------------------------- //
+
+    /// Starts the frame. Clears the screen right away, or hands the clear color to the render thread with the frame.
+    /// Starts recording if the queue is enabled. Called by StartDrawing implementations
+    /// \param clearColor - background color of the frame
+    void BeginFrame(const IColor& clearColor);
+
+    /// Finishes the frame. Submits the recorded draws and presents, or waits for the render thread to finish
+    /// the previous frame and hands this one over. Called by EndDrawing implementations
+    void EndFrame();
+
+    /// Clear the screen. Called from the render thread when it is enabled
+    /// \param color - color to clear to
+    virtual void ClearFrame(const IColor& color) = 0;
+
+    /// Present the drawn frame to the window. Called from the render thread when it is enabled
+    virtual void PresentFrame() = 0;
+
+    /// Draw several portions of one texture from the native texture. Called directly or by RenderQueue on submission
+    /// \param pNativeTexture - native texture to draw
+    /// \param modulation - tint in red, green and blue, opacity in alpha
+    /// \param pQuads - array of the portions to draw
+    /// \param count - number of quads in the array
+    /// \return true if successful
+    virtual bool DrawNativeTextureBatch(void* pNativeTexture, const IColor& modulation, const TextureQuad* pQuads, size_t count) = 0;
+
+    /// Fill several rectangles in the current draw color with one native call. Called directly or by RenderQueue on submission
+    /// \param pRects - array of the rectangles to fill
+    /// \param count - number of rectangles in the array
+    /// \return true if successful
+    virtual bool FillNativeRects(const FRect* pRects, size_t count) = 0;
+
+    /// Draw separate lines in the current draw color with one native submission. Called directly or by RenderQueue on submission
+    /// \param pPoints - array of line points, every two points are the start and the end of one line
+    /// \param count - number of points in the array, even
+    /// \return true if successful
+    virtual bool DrawNativeLines(const FVec2* pPoints, size_t count) = 0;
+
+    /// Destroy the native resources released since the last call. Called at the end of every frame once no frame in flight uses them
+    virtual void ReleaseRetiredResources() {}
+
+    /// Can the frames be submitted and presented from another thread than the one that created the graphics system
+    virtual bool IsRenderThreadSupported() const { return true; }
+
+    /// Checks that a target is not set past the renderer lock. Called by SetRenderTarget implementations before the native call
+    /// \param isTargetSet - true if a render target is about to be set, false if it is reset to the screen
+    /// \return false if the target is set outside of a RenderTargetScope while the render thread runs
+    bool CanChangeRenderTarget(bool isTargetSet) const;
+
+    /// Suspends or resumes recording while a render target is set. Called by SetRenderTarget implementations
+    /// \param isTargetSet - true if the draws go into a render target now
+    void OnRenderTargetChanged(bool isTargetSet);
+
+    /// Lock the native renderer against the render thread. Every native call made outside of the render thread takes it
+    /// \return held lock while the render thread runs, an empty one otherwise. A hosted render loop makes every native call
+    /// on its own thread instead, \see CallOnRendererThread
+    std::unique_lock<std::recursive_mutex> LockRenderer();
+
+    /// Is this the thread the native renderer is bound to. Always true unless the render loop is hosted
+    bool IsOnRendererThread() const;
+
+    /// Make a native call on the thread the renderer is bound to. While the render loop is hosted, the calls of the game thread
+    /// wait until RunRenderLoop makes them, after the frame it is presenting. Implementations route their native calls through it
+    /// when IsOnRendererThread is false
+    /// \param function - the native call
+    /// \return what the function returned
+    template <class Function>
+    auto CallOnRendererThread(Function&& function) -> decltype(function());
+
+    /// Get the shadow copy of the native renderer state. Only used under the renderer lock
+    RenderStateCache& GetStateCache() { return m_stateCache; }
+
+    /// Get the queue the draws have to be recorded into
+    /// \return the queue if recording on this thread, nullptr if the draws have to be made right away
+    RenderQueue* GetRecordingQueue() const;
+
 private:
 	// --------------------------------------------------------------------- //
 	// Private Member Variables
 	// --------------------------------------------------------------------- //
 
+    using Clock = std::chrono::steady_clock;
+
+    std::unique_ptr<RenderQueue> m_pRenderQueue;    ///< Queue of the recorded draws, null when disabled
+    std::unique_ptr<RenderQueue> m_pSubmitQueue;    ///< Queue of the frame handed to the render thread, null without the render thread
+    bool m_isFrameStarted = false;                  ///< Is the frame between BeginFrame and EndFrame
+    bool m_isRecording = false;                     ///< Are the draws recorded into the queue right now
+    IColor m_clearColor;                            ///< Background color of the frame being recorded
+    Clock::time_point m_frameStartTime;             ///< When the frame being recorded started
+
+    // Render thread
+    std::thread m_renderThread;                     ///< Thread that submits and presents the frames, not joinable when disabled
+    std::mutex m_frameMutex;                        ///< Guards the frame hand-over and the render thread timings
+    std::condition_variable m_frameCondition;       ///< Signals a handed-over frame to the render thread and its completion back
+    bool m_hasSubmitFrame = false;                  ///< Is there a frame handed over and not yet presented
+    bool m_isRenderThreadExiting = false;           ///< Should the render thread stop after the frame in flight
+    IColor m_submitClearColor;                      ///< Background color of the frame handed over
+    Clock::time_point m_submitFrameStartTime;       ///< When the frame handed over started
+    std::recursive_mutex m_rendererMutex;           ///< Serializes the native renderer calls between the threads
+    bool m_isTargetSet = false;                     ///< Do the draws go into a render target
+    size_t m_targetScopeCount = 0;                  ///< Live RenderTargetScopes, a frame isn't submitted while there are any
+
+    // Hosted render loop
+    /// \struct RendererTask
+    /// Native call of the game thread waiting for the render loop
+    struct RendererTask
+    {
+        const std::function<void()>* m_pFunction;   ///< Call to make, owned by the waiting thread
+        bool m_isDone = false;                      ///< Was the call made
+    };
+    bool m_isRenderLoopHosted = false;              ///< Are the frames presented by RunRenderLoop instead of the render thread
+    std::thread::id m_rendererThreadId;             ///< Thread that runs the hosted render loop and makes the native calls
+    std::vector<RendererTask*> m_rendererTasks;     ///< Native calls waiting for the render loop, guarded by m_frameMutex
+
+    // Frame timing
+    size_t m_frameCount = 0;                        ///< Frames finished
+    Clock::time_point m_lastFrameEndTime;           ///< When the previous EndFrame was called
+    Clock::duration m_frameTimeTotal{};             ///< Sum of the frame times since the last report
+    Clock::duration m_latencyTotal{};               ///< Sum of the latencies since the last report
+    Clock::duration m_renderWaitTotal{};            ///< Sum of the render thread waits since the last report
+    Clock::duration m_lastLatency{};                ///< Latency of the frame presented last
+    size_t m_presentedFrameCount = 0;               ///< Frames presented since the last report
+    FrameTiming m_frameTiming;                      ///< Averages of the last report
+
+    RenderStateCache m_stateCache;                  ///< Native state set last, lets the implementations skip redundant changes
+
+    std::vector<FRect> m_spans;                     ///< Rows of the shapes being filled
+    std::vector<FVec2> m_shapePoints;               ///< Vertices of the shape being drawn
+    std::vector<TextureQuad> m_quads;               ///< Quads of the sprites being drawn
 
 	// --------------------------------------------------------------------- //
 	// Private Member Functions
 	// --------------------------------------------------------------------- //
 
+    /// Waits for the handed-over frames and submits them until told to exit. Also makes the native calls of the game thread
+    /// \param betweenFrames - called after every presented frame and when waiting for work times out, empty on the render thread
+    void RenderThreadMain(const std::function<void()>& betweenFrames);
+
+    /// Hands a native call to the hosted render loop and waits until it is made
+    /// \param function - the native call
+    void RunOnRendererThread(const std::function<void()>& function);
+
+    /// Blocks until the render thread has presented the frame handed over
+    void WaitForRenderThread();
+
+    /// Appends one filled rectangle per pixel row of the convex polygon to m_spans. Rows are sampled at their centers
+    /// \param pPoints - vertices of the polygon in order, clockwise or counter clockwise
+    /// \param count - number of vertices
+    void AppendConvexSpans(const FVec2* pPoints, size_t count);
+
+    /// Fills m_shapePoints with the vertices of the circle polygon
+    void BuildCirclePoints(const FVec2& center, float radius, uint8_t segments);
+
+    /// Averages the frame timings and logs them with the render queue and state cache counters every kRenderStatsReportInterval frames
+    void ReportFrameStats(const RenderQueue* pSubmittedQueue);
+
+    // RenderQueue draws the recorded batches through DrawNativeTextureBatch
+    friend class RenderQueue;
+
 public:
 	// --------------------------------------------------------------------- //
 	// Accessors & Mutators
 	// --------------------------------------------------------------------- //
+
+    /// Get the render queue, null when disabled
+    const RenderQueue* GetRenderQueue() const { return m_pRenderQueue.get(); }
+
+    /// Are the frames handed over to the render thread or the hosted render loop
+    bool IsRenderThreadEnabled() const { return m_renderThread.joinable() || m_isRenderLoopHosted; }
+
+    /// Do the frames have to be presented by RunRenderLoop, with the game running on another thread
+    bool IsRenderLoopHosted() const { return m_isRenderLoopHosted; }
+
+    /// Get native state changes made and skipped by the state cache so far
+    const RenderStateCache::Stats& GetStateChangeStats() const { return m_stateCache.GetStats(); }
+
+    /// Get frame timings averaged over the last kRenderStatsReportInterval frames
+    const FrameTiming& GetFrameTiming() const { return m_frameTiming; }
+
+    /// Get time from StartDrawing until the frame presented last was presented (ms). With the render thread it is the previous frame
+    float GetLastFrameLatency();
 };
-}
\ No newline at end of file
+
+template <class Function>
+inline auto IGraphics::CallOnRendererThread(Function&& function) -> decltype(function())
+{
+    if (IsOnRendererThread())
+        return function();
+
+    if constexpr (std::is_void_v<decltype(function())>)
+    {
+        RunOnRendererThread(function);
+    }
+    else
+    {
+        decltype(function()) result{};
+        RunOnRendererThread([&result, &function]() { result = function(); });
+        return result;
+    }
+}
+}
@@ -0,0 +1,265 @@
+#include "RenderQueue.h"
+#include <Application/Graphics/Textures/ITexture.h>
+#include <cstring>
+#include <optional>
+#include <utility>
+
+using yang::RenderQueue;
+
+namespace
+{
+    // Key layout from the highest bits: layer (8 bits), depth (24 bits), material (24 bits). The material groups the
+    // commands of one layer and depth by texture or color, it doesn't keep the order they were recorded in
+    constexpr int kLayerShift = 56;
+    constexpr int kDepthShift = 32;
+    constexpr uint32_t kMaterialMask = 0xFFFFFF;
+
+    // Colors take the upper half of the materials, so they never share one with a texture
+    constexpr uint32_t kColorMaterialFlag = 0x800000;
+
+    constexpr size_t kRadixBucketCount = 256;
+    constexpr size_t kKeyByteCount = sizeof(uint64_t);
+}
+
+void yang::RenderQueue::Clear()
+{
+    m_commands.clear();
+    m_keys.clear();
+    m_rects.clear();
+    m_textureMaterials.clear();
+    m_colorMaterials.clear();
+    m_layer = kBackgroundLayer;
+    m_depth = 0.f;
+    m_color = IColor();
+}
+
+void yang::RenderQueue::AddTexture(ITexture* pTexture, const IRect& src, const FRect& dest, const TextureDrawParams& drawParams)
+{
+    void* pNativeTexture = pTexture->GetNativeTexture();
+    AddCommand(Command{ CommandType::kTexture, pNativeTexture, pTexture->GetModulation(), src, dest, drawParams }, GetTextureMaterial(pNativeTexture));
+}
+
+void yang::RenderQueue::AddFillRect(const FRect& rect)
+{
+    AddCommand(Command{ CommandType::kFillRect, nullptr, m_color, IRect(), rect, TextureDrawParams{} }, GetColorMaterial(m_color));
+}
+
+void yang::RenderQueue::AddFillRects(const FRect* pRects, size_t count)
+{
+    if (count == 0)
+        return;
+
+    IRect range(static_cast<int>(m_rects.size()), static_cast<int>(count), 0, 0);
+    m_rects.insert(m_rects.end(), pRects, pRects + count);
+    AddCommand(Command{ CommandType::kFillRects, nullptr, m_color, range, FRect(), TextureDrawParams{} }, GetColorMaterial(m_color));
+}
+
+void yang::RenderQueue::AddRect(const FRect& rect)
+{
+    AddCommand(Command{ CommandType::kRect, nullptr, m_color, IRect(), rect, TextureDrawParams{} }, GetColorMaterial(m_color));
+}
+
+void yang::RenderQueue::AddLine(const FVec2& start, const FVec2& end)
+{
+    FRect points(start.x, start.y, end.x, end.y);
+    AddCommand(Command{ CommandType::kLine, nullptr, m_color, IRect(), points, TextureDrawParams{} }, GetColorMaterial(m_color));
+}
+
+bool yang::RenderQueue::Submit(IGraphics* pGraphics)
+{
+    m_stats = Stats();
+    m_stats.m_commandCount = m_commands.size();
+    if (m_commands.empty())
+    {
+        Clear();
+        return true;
+    }
+
+    // Texture switches the same draws would have made without the queue
+    const void* pLastTexture = nullptr;
+    for (const Command& command : m_commands)
+    {
+        if (command.m_type == CommandType::kTexture && command.m_pNativeTexture != pLastTexture)
+        {
+            ++m_stats.m_unsortedTextureSwitchCount;
+            pLastTexture = command.m_pNativeTexture;
+        }
+    }
+
+    SortCommands();
+
+    bool success = true;
+    pLastTexture = nullptr;
+    std::optional<uint32_t> lastColor;
+    size_t commandCount = m_order.size();
+    for (size_t orderIndex = 0; orderIndex < commandCount;)
+    {
+        const Command& command = m_commands[m_order[orderIndex]];
+
+        if (command.m_type == CommandType::kTexture)
+        {
+            // Every following quad of the same texture, tint and alpha goes into the batch
+            m_batch.clear();
+            for (; orderIndex < commandCount; ++orderIndex)
+            {
+                const Command& batchCommand = m_commands[m_order[orderIndex]];
+                if (batchCommand.m_type != CommandType::kTexture || batchCommand.m_pNativeTexture != command.m_pNativeTexture
+                    || batchCommand.m_color.m_color != command.m_color.m_color)
+                    break;
+
+                m_batch.push_back(TextureQuad{ batchCommand.m_src, batchCommand.m_dest, batchCommand.m_drawParams });
+            }
+
+            if (command.m_pNativeTexture != pLastTexture)
+            {
+                ++m_stats.m_textureSwitchCount;
+                pLastTexture = command.m_pNativeTexture;
+            }
+
+            ++m_stats.m_drawCallCount;
+            success = pGraphics->DrawNativeTextureBatch(command.m_pNativeTexture, command.m_color, m_batch.data(), m_batch.size()) && success;
+            continue;
+        }
+
+        if (lastColor != command.m_color.m_color)
+        {
+            ++m_stats.m_colorChangeCount;
+            lastColor = command.m_color.m_color;
+            success = pGraphics->SetDrawColor(command.m_color) && success;
+        }
+
+        if (command.m_type == CommandType::kFillRect || command.m_type == CommandType::kFillRects)
+        {
+            // Every following filled rectangle of the same color goes into the batch
+            m_rectBatch.clear();
+            for (; orderIndex < commandCount; ++orderIndex)
+            {
+                const Command& batchCommand = m_commands[m_order[orderIndex]];
+                if (batchCommand.m_color.m_color != command.m_color.m_color)
+                    break;
+
+                if (batchCommand.m_type == CommandType::kFillRect)
+                    m_rectBatch.push_back(batchCommand.m_dest);
+                else if (batchCommand.m_type == CommandType::kFillRects)
+                    m_rectBatch.insert(m_rectBatch.end(), m_rects.begin() + batchCommand.m_src.x, m_rects.begin() + batchCommand.m_src.x + batchCommand.m_src.y);
+                else
+                    break;
+            }
+
+            ++m_stats.m_drawCallCount;
+            success = pGraphics->FillNativeRects(m_rectBatch.data(), m_rectBatch.size()) && success;
+            continue;
+        }
+
+        if (command.m_type == CommandType::kLine)
+        {
+            // Every following line of the same color goes into the batch
+            m_lineBatch.clear();
+            for (; orderIndex < commandCount; ++orderIndex)
+            {
+                const Command& batchCommand = m_commands[m_order[orderIndex]];
+                if (batchCommand.m_type != CommandType::kLine || batchCommand.m_color.m_color != command.m_color.m_color)
+                    break;
+
+                m_lineBatch.emplace_back(batchCommand.m_dest.x, batchCommand.m_dest.y);
+                m_lineBatch.emplace_back(batchCommand.m_dest.width, batchCommand.m_dest.height);
+            }
+
+            ++m_stats.m_drawCallCount;
+            success = pGraphics->DrawNativeLines(m_lineBatch.data(), m_lineBatch.size()) && success;
+            continue;
+        }
+
+        ++m_stats.m_drawCallCount;
+        if (command.m_type == CommandType::kRect)
+        {
+            success = pGraphics->DrawRect(command.m_dest) && success;
+        }
+        ++orderIndex;
+    }
+
+    Clear();
+    return success;
+}
+
+void yang::RenderQueue::AddCommand(Command&& command, uint32_t material)
+{
+    uint64_t key = (static_cast<uint64_t>(m_layer) << kLayerShift)
+        | (static_cast<uint64_t>(GetOrderedBits(m_depth) >> 8) << kDepthShift)
+        | (material & kMaterialMask);
+
+    m_commands.push_back(std::move(command));
+    m_keys.push_back(key);
+}
+
+uint32_t yang::RenderQueue::GetTextureMaterial(const void* pNativeTexture)
+{
+    auto [it, isInserted] = m_textureMaterials.try_emplace(pNativeTexture, static_cast<uint32_t>(m_textureMaterials.size()));
+    return it->second;
+}
+
+uint32_t yang::RenderQueue::GetColorMaterial(const IColor& color)
+{
+    auto [it, isInserted] = m_colorMaterials.try_emplace(color.m_color, static_cast<uint32_t>(m_colorMaterials.size()) | kColorMaterialFlag);
+    return it->second;
+}
+
+void yang::RenderQueue::SortCommands()
+{
+    size_t commandCount = m_keys.size();
+    m_order.resize(commandCount);
+    m_orderBuffer.resize(commandCount);
+    m_keyBuffer.resize(commandCount);
+    m_sortKeys.assign(m_keys.begin(), m_keys.end());
+    for (size_t i = 0; i < commandCount; ++i)
+    {
+        m_order[i] = static_cast<uint32_t>(i);
+    }
+
+    // Histograms of every byte in one pass over the keys
+    size_t counts[kKeyByteCount][kRadixBucketCount] = {};
+    for (uint64_t key : m_sortKeys)
+    {
+        for (size_t byteIndex = 0; byteIndex < kKeyByteCount; ++byteIndex)
+        {
+            ++counts[byteIndex][(key >> (byteIndex * 8)) & 0xFF];
+        }
+    }
+
+    for (size_t byteIndex = 0; byteIndex < kKeyByteCount; ++byteIndex)
+    {
+        size_t* pCounts = counts[byteIndex];
+
+        // Every key has the same byte, the pass wouldn't move anything
+        if (pCounts[(m_sortKeys[0] >> (byteIndex * 8)) & 0xFF] == commandCount)
+            continue;
+
+        size_t offset = 0;
+        for (size_t bucket = 0; bucket < kRadixBucketCount; ++bucket)
+        {
+            size_t count = pCounts[bucket];
+            pCounts[bucket] = offset;
+            offset += count;
+        }
+
+        for (size_t i = 0; i < commandCount; ++i)
+        {
+            uint64_t key = m_sortKeys[i];
+            size_t destination = pCounts[(key >> (byteIndex * 8)) & 0xFF]++;
+            m_keyBuffer[destination] = key;
+            m_orderBuffer[destination] = m_order[i];
+        }
+
+        std::swap(m_sortKeys, m_keyBuffer);
+        std::swap(m_order, m_orderBuffer);
+    }
+}
+
+uint32_t yang::RenderQueue::GetOrderedBits(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    // Negative floats order backwards, so all of their bits flip. Positive ones only move above them
+    return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+}
@@ -0,0 +1,169 @@
+#pragma once
+/** \file RenderQueue.h */
+/** Sorted and batched draw command queue */
+
+#include <Application/Graphics/IGraphics.h>
+#include <Utils/Color.h>
+#include <Utils/Rectangle.h>
+#include <Utils/Vector2.h>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+    class ITexture;
+
+/** \class RenderQueue */
+/** Records the draw calls of a frame instead of drawing them right away. On submission the commands are radix sorted
+    by layer, depth and material (texture or draw color), so consecutive quads of the same texture go to the graphics
+    system as one batch and every texture or color is switched to once per run instead of once per call.
+    The material only breaks ties inside a layer and depth, so draws with the same layer and depth have no guaranteed
+    order between each other. Put draws that overlap on different depths.
+    Commands keep the native texture and its tint and alpha from the time they were recorded, so a recorded queue
+    can be submitted on another thread while the textures change or get released */
+class RenderQueue
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+    static constexpr uint8_t kBackgroundLayer = 0;      ///< Layer of the draws before the map, and the layer every frame starts with
+    static constexpr uint8_t kMapLayer = 32;            ///< Layer of the first map layer, the next map layers go above it
+    static constexpr uint8_t kActorLayer = 128;         ///< Layer of the scene actors
+    static constexpr uint8_t kOverlayLayer = 224;       ///< Layer of the draws after the actors
+
+    /// \struct Stats
+    /// Counters of the last submission
+    struct Stats
+    {
+        size_t m_commandCount = 0;                  ///< Recorded commands. Without the queue every one of them is a draw call
+        size_t m_unsortedTextureSwitchCount = 0;    ///< Texture switches the commands would make in recording order
+        size_t m_drawCallCount = 0;                 ///< Calls made to the graphics system, a batch of quads, filled rectangles or lines counts as one
+        size_t m_textureSwitchCount = 0;            ///< Texture switches after sorting
+        size_t m_colorChangeCount = 0;              ///< Draw color changes after sorting
+    };
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Drops every recorded command and resets the layer, depth and color
+    void Clear();
+
+    /// Set the layer of the next commands. Higher layers are drawn on top
+    void SetLayer(uint8_t layer) { m_layer = layer; }
+
+    /// Set the depth of the next commands. Inside a layer the higher depths are drawn on top, equal depths in any order
+    void SetDepth(float depth) { m_depth = depth; }
+
+    /// Set the color of the next untextured commands
+    void SetColor(const IColor& color) { m_color = color; }
+
+    /// Records a textured quad
+    /// \param pTexture - texture to draw
+    /// \param src - rectangle to use from the texture (in pixels)
+    /// \param dest - rectangle on the screen to draw the texture to (in pixels)
+    /// \param drawParams - rotation and flip of the quad
+    void AddTexture(ITexture* pTexture, const IRect& src, const FRect& dest, const TextureDrawParams& drawParams);
+
+    /// Records a filled rectangle in the current color
+    void AddFillRect(const FRect& rect);
+
+    /// Records filled rectangles in the current color as one command
+    /// \param pRects - array of the rectangles
+    /// \param count - number of rectangles in the array
+    void AddFillRects(const FRect* pRects, size_t count);
+
+    /// Records rectangle borders in the current color
+    void AddRect(const FRect& rect);
+
+    /// Records a line in the current color
+    void AddLine(const FVec2& start, const FVec2& end);
+
+    /// Sorts the recorded commands and draws them. The queue is cleared afterwards
+    /// \param pGraphics - graphics system to draw with. It must not be recording into this queue on the calling thread
+    /// \return true if every draw call succeeded
+    bool Submit(IGraphics* pGraphics);
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+
+    /// \enum CommandType
+    /// What a command draws
+    enum class CommandType : uint8_t
+    {
+        kTexture,       ///< Textured quad
+        kFillRect,      ///< Filled rectangle
+        kFillRects,     ///< Filled rectangles, the source rectangle holds the first one in m_rects in x and their count in y
+        kRect,          ///< Rectangle borders
+        kLine           ///< Line, the rectangle holds the start point in x, y and the end point in width, height
+    };
+
+    /// \struct Command
+    /// Recorded draw call
+    struct Command
+    {
+        CommandType m_type;                 ///< What to draw
+        void* m_pNativeTexture;             ///< Native texture of the quads, null otherwise
+        IColor m_color;                     ///< Color of the untextured commands, texture tint and alpha of the quads
+        IRect m_src;                        ///< Source rectangle of the quads
+        FRect m_dest;                       ///< Destination rectangle, or the line points
+        TextureDrawParams m_drawParams;     ///< Rotation and flip of the quads
+    };
+
+    std::vector<Command> m_commands;                        ///< Commands in recording order
+    std::vector<uint64_t> m_keys;                           ///< Sort key of every command
+    std::vector<uint32_t> m_order;                          ///< Command indices in drawing order
+    std::vector<uint64_t> m_sortKeys;                       ///< Keys of the radix sort pass in progress
+    std::vector<uint64_t> m_keyBuffer;                      ///< Radix sort scratch keys
+    std::vector<uint32_t> m_orderBuffer;                    ///< Radix sort scratch indices
+    std::vector<FRect> m_rects;                             ///< Rectangles of the kFillRects commands
+    std::vector<TextureQuad> m_batch;                       ///< Quads of the batch being submitted
+    std::vector<FRect> m_rectBatch;                         ///< Filled rectangles of the batch being submitted
+    std::vector<FVec2> m_lineBatch;                         ///< Line points of the batch being submitted
+
+    std::unordered_map<const void*, uint32_t> m_textureMaterials;       ///< Material of every native texture recorded this frame
+    std::unordered_map<uint32_t, uint32_t> m_colorMaterials;            ///< Material of every color recorded this frame
+
+    uint8_t m_layer = kBackgroundLayer;     ///< Layer of the next commands
+    float m_depth = 0.f;                    ///< Depth of the next commands
+    IColor m_color;                         ///< Color of the next untextured commands
+
+    Stats m_stats;                          ///< Counters of the last submission
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Records a command with the key of the current layer, depth and the material
+    void AddCommand(Command&& command, uint32_t material);
+
+    /// Get material of the native texture, assigning the next one on first use this frame
+    uint32_t GetTextureMaterial(const void* pNativeTexture);
+
+    /// Get material of the color, assigning the next one on first use this frame
+    uint32_t GetColorMaterial(const IColor& color);
+
+    /// Sorts m_order by m_keys with a stable LSD radix sort, one byte per pass. Bytes that are equal in every key are skipped
+    void SortCommands();
+
+    /// Maps the float to an unsigned integer with the same order
+    static uint32_t GetOrderedBits(float value);
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Get counters of the last submission
+    const Stats& GetStats() const { return m_stats; }
+
+    /// Get number of commands recorded since the last submission
+    size_t GetCommandCount() const { return m_commands.size(); }
+};
+}
@@ -0,0 +1,60 @@
+#include "RenderStateCache.h"
+
+using yang::RenderStateCache;
+
+namespace
+{
+    // Records the value and counts the change as made or skipped
+    template <class T>
+    bool ChangeState(std::optional<T>& state, T value, size_t& madeCount, size_t& elidedCount)
+    {
+        if (state == value)
+        {
+            ++elidedCount;
+            return false;
+        }
+
+        state = value;
+        ++madeCount;
+        return true;
+    }
+}
+
+bool yang::RenderStateCache::ChangeDrawColor(const IColor& color)
+{
+    return ChangeState(m_drawColor, color.m_color, m_stats.m_drawColorCount, m_stats.m_elidedDrawColorCount);
+}
+
+bool yang::RenderStateCache::ChangeRenderTarget(const void* pNativeTarget)
+{
+    return ChangeState(m_pRenderTarget, pNativeTarget, m_stats.m_renderTargetCount, m_stats.m_elidedRenderTargetCount);
+}
+
+bool yang::RenderStateCache::ChangeColorModulation(const void* pNativeTexture, const IColor& tint)
+{
+    uint32_t tintBits = tint.m_color & 0xFFFFFF00;
+    return ChangeState(m_textureStates[pNativeTexture].m_tint, tintBits, m_stats.m_modulationCount, m_stats.m_elidedModulationCount);
+}
+
+bool yang::RenderStateCache::ChangeAlphaModulation(const void* pNativeTexture, uint8_t alpha)
+{
+    return ChangeState(m_textureStates[pNativeTexture].m_alpha, alpha, m_stats.m_modulationCount, m_stats.m_elidedModulationCount);
+}
+
+void yang::RenderStateCache::ForgetTexture(const void* pNativeTexture)
+{
+    m_textureStates.erase(pNativeTexture);
+
+    // Destroying the target makes the native renderer draw to the screen again
+    if (m_pRenderTarget == pNativeTexture)
+    {
+        m_pRenderTarget.reset();
+    }
+}
+
+void yang::RenderStateCache::Reset()
+{
+    m_drawColor.reset();
+    m_pRenderTarget.reset();
+    m_textureStates.clear();
+}
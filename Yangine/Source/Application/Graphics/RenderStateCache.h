@@ -0,0 +1,100 @@
+#pragma once
+/** \file RenderStateCache.h */
+/** Shadow copy of the native renderer state */
+
+#include <Utils/Color.h>
+#include <unordered_map>
+#include <optional>
+#include <cstdint>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \class RenderStateCache */
+/** Remembers the draw color, the render target and the texture modulations last set on the native renderer, so the
+    graphics system can skip the calls that wouldn't change anything. Every Change function returns true if the native call
+    has to be made and records the new state. Accessed under the renderer lock, by whichever thread makes the native calls */
+class RenderStateCache
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+    /// \struct Stats
+    /// Native state changes since the graphics system was created
+    struct Stats
+    {
+        size_t m_drawColorCount = 0;                ///< Draw color changes made
+        size_t m_elidedDrawColorCount = 0;          ///< Draw color changes skipped
+        size_t m_renderTargetCount = 0;             ///< Render target changes made
+        size_t m_elidedRenderTargetCount = 0;       ///< Render target changes skipped
+        size_t m_modulationCount = 0;               ///< Texture color or alpha modulation changes made
+        size_t m_elidedModulationCount = 0;         ///< Texture color or alpha modulation changes skipped
+    };
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Records the draw color
+    /// \param color - color about to be set
+    /// \return true if it differs from the current one and has to be set
+    bool ChangeDrawColor(const IColor& color);
+
+    /// Records the render target
+    /// \param pNativeTarget - native texture about to become the target, null for the screen
+    /// \return true if it differs from the current one and has to be set
+    bool ChangeRenderTarget(const void* pNativeTarget);
+
+    /// Records the color modulation of a texture, the alpha of the color is ignored
+    /// \param pNativeTexture - native texture
+    /// \param tint - red, green and blue modulation about to be set
+    /// \return true if it differs from the current one and has to be set
+    bool ChangeColorModulation(const void* pNativeTexture, const IColor& tint);
+
+    /// Records the alpha modulation of a texture
+    /// \param pNativeTexture - native texture
+    /// \param alpha - alpha modulation about to be set
+    /// \return true if it differs from the current one and has to be set
+    bool ChangeAlphaModulation(const void* pNativeTexture, uint8_t alpha);
+
+    /// Forgets the state of a destroyed texture, its address can be reused by the next one
+    /// \param pNativeTexture - native texture being destroyed
+    void ForgetTexture(const void* pNativeTexture);
+
+    /// Forgets every state, the next changes are all made. Used when a native call failed or changed the state behind the cache
+    void Reset();
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+
+    /// \struct TextureState
+    /// Modulation last set on a texture
+    struct TextureState
+    {
+        std::optional<uint32_t> m_tint;     ///< Red, green and blue of the color modulation, alpha bits cleared
+        std::optional<uint8_t> m_alpha;     ///< Alpha modulation
+    };
+
+    std::optional<uint32_t> m_drawColor;                            ///< Current draw color, empty if unknown
+    std::optional<const void*> m_pRenderTarget;                     ///< Current render target, empty if unknown
+    std::unordered_map<const void*, TextureState> m_textureStates;  ///< Modulation of every texture drawn
+    Stats m_stats;                                                  ///< Changes made and skipped
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Get changes made and skipped so far
+    const Stats& GetStats() const { return m_stats; }
+};
+}
@@ -2,26 +2,28 @@
 #include <Utils/Logger.h>
 #include <Application/Window/SDLWindow.h>
 #include <Application/Graphics/Textures/SDLTexture.h>
-#include <SDL/SDL_image.h>
+#include <Application/Graphics/RenderQueue.h>
 #include <cassert>
 
 using yang::SDLRenderer;
 
 SDLRenderer::SDLRenderer()
-	:m_pRenderer(nullptr, &SDL_DestroyRenderer)
 {
 	
 }
 
 SDLRenderer::~SDLRenderer()
 {
-	
+	SetRenderThreadEnabled(false);
+	ReleaseRetiredResources();
 }
 
 bool yang::SDLRenderer::Initialize(IWindow* pWindow)
 {
 	SDL_Window* pSDLWindow = reinterpret_cast<SDL_Window*>(pWindow->GetNativeWindow());
 
+	// Consecutive copies of the same texture are merged into one draw call, the render queue submits them in that order
+	SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
 	m_pRenderer.reset(SDL_CreateRenderer(pSDLWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC));
 
 	if (!m_pRenderer)
@@ -30,23 +32,27 @@ bool yang::SDLRenderer::Initialize(IWindow* pWindow)
 		return false;
 	}
 
+	InitImageLoaders();
 	return true;
 }
 
 bool yang::SDLRenderer::StartDrawing(uint8_t red, uint8_t green, uint8_t blue, uint8_t /*alpha*/)
 {
-	SDL_SetRenderDrawColor(m_pRenderer.get(), red, green, blue, SDL_ALPHA_OPAQUE);
-	SDL_RenderClear(m_pRenderer.get());
-	// TODO: Check for SDL errors
+	BeginFrame(IColor(red, green, blue, SDL_ALPHA_OPAQUE));
 	return true;
 }
 
 void yang::SDLRenderer::EndDrawing()
+{
+	EndFrame();
+}
+
+void yang::SDLRenderer::PresentFrame()
 {
 	SDL_RenderPresent(m_pRenderer.get());
 }
 
-std::shared_ptr<yang::ITexture> yang::SDLRenderer::LoadTexture(IResource* pResource)
+std::shared_ptr<yang::ITexture> yang::SDLRenderer::CreateTextureFromImage(IResource* pResource, void* pImage)
 {
     if (!m_pRenderer)
     {
@@ -54,18 +60,13 @@ std::shared_ptr<yang::ITexture> yang::SDLRenderer::LoadTexture(IResource* pResou
         return nullptr;
     }
 
-    SDL_RWops* pOps = SDL_RWFromConstMem(pResource->GetData().data(), static_cast<int>(pResource->GetData().size()));
-    SDL_Surface* pSurface = IMG_Load_RW(pOps, 0);
-    
-    if (!pSurface)
-    {
-        LOG(Error, "Unable to load image. Error: %s", SDL_GetError());
-        return nullptr;
-    }
+	if (!IsOnRendererThread())
+		return CallOnRendererThread([&]() { return CreateTextureFromImage(pResource, pImage); });
 
     std::shared_ptr<ITexture> pTexture = std::make_shared<SDLTexture>(pResource);
-    
-    if (!static_cast<SDLTexture*>(pTexture.get())->Init(m_pRenderer.get(), pSurface))
+    auto rendererLock = LockRenderer();
+
+    if (!static_cast<SDLTexture*>(pTexture.get())->Init(m_pRenderer.get(), reinterpret_cast<SDL_Surface*>(pImage)))
     {
         LOG(Error, "Unable to init SDLTexture");
         return nullptr;
@@ -73,284 +74,77 @@ std::shared_ptr<yang::ITexture> yang::SDLRenderer::LoadTexture(IResource* pResou
     return pTexture;
 }
 
-bool yang::SDLRenderer::DrawTexture(ITexture* pTexture, IVec2 position, const TextureDrawParams& drawParams)
-{
-	if (!pTexture)
-	{
-		LOG(Error, "Texture was nullptr");
-		return false;
-	}
-
-	SDL_Texture* pSDLTexture = reinterpret_cast<SDL_Texture*>(pTexture->GetNativeTexture());
-
-	SDL_FPoint pointToRotate;
-	if (drawParams.m_pointToRotate.has_value())
-	{
-		pointToRotate.x = (float)drawParams.m_pointToRotate.value().x;
-		pointToRotate.y = (float)drawParams.m_pointToRotate.value().y;
-	}
-
-	//FVec2 transformedPosition = m_cameraTransform.TransformPoint(FVec2(position));
-	IVec2 dimensions = pTexture->GetDimensions();
-	/*SDL_FRect dstRect{transformedPosition.x, transformedPosition.y, (float)dimensions.x, (float)dimensions.y};*/
-	SDL_FRect dstRect{ (float)position.x, (float)position.y, (float)dimensions.x, (float)dimensions.y };
-
-	if (SDL_RenderCopyExF(m_pRenderer.get(), pSDLTexture, nullptr, &dstRect, drawParams.m_angle,
-		(drawParams.m_pointToRotate ? &pointToRotate : nullptr), ToRendererFlip(drawParams.m_flip)))
-    {
-        LOG(Error, "Unable to draw SDL_Texture. Error: %s", SDL_GetError());
-        return false;
-    }
-    return true;
-}
-
-bool yang::SDLRenderer::DrawTexture(ITexture* pTexture, const IRect& dest, const TextureDrawParams& drawParams)
+bool yang::SDLRenderer::FillNativeRects(const FRect* pRects, size_t count)
 {
-    if (!pTexture)
-    {
-        LOG(Error, "Texture was nullptr");
-        return false;
-    }
-
-    /*SDL_FRect destination = ToSDLFRect(m_cameraTransform.TransformAARect(dest));*/
-	SDL_FRect destination = ToSDLFRect(dest);
-    SDL_Texture* pSDLTexture = reinterpret_cast<SDL_Texture*>(pTexture->GetNativeTexture());
-
-	SDL_FPoint pointToRotate;
-	if (drawParams.m_pointToRotate.has_value())
-	{
-		pointToRotate.x = (float)drawParams.m_pointToRotate.value().x;
-		pointToRotate.y = (float)drawParams.m_pointToRotate.value().y;
-	}
-
-    if (SDL_RenderCopyExF(m_pRenderer.get(), pSDLTexture, nullptr, &destination, drawParams.m_angle, 
-		(drawParams.m_pointToRotate ? &pointToRotate : nullptr), ToRendererFlip(drawParams.m_flip)))
-    {
-        LOG(Error, "Unable to draw SDL_Texture. Error: %s", SDL_GetError());
-        return false;
-    }
-    return true;
-}
-
-bool yang::SDLRenderer::DrawTexture(ITexture* pTexture, const IRect& src, const IRect& dest, const TextureDrawParams& drawParams)
-{
-    if (!pTexture)
-    {
-        LOG(Error, "Texture was nullptr");
-        return false;
-    }
-
-    SDL_Rect source = ToSDLRect(src);
-	//FVec2 destOrigin = m_cameraTransform.TransformPoint(FVec2((float)dest.x, (float)dest.y));
-    //SDL_FRect destination = ToSDLFRect(m_cameraTransform.TransformAARect(dest));
-	//SDL_FRect destination {destOrigin.x, destOrigin.y, (float)dest.width * m_cameraScaleFactors.x, (float)dest.height * m_cameraScaleFactors.y};
-    SDL_Texture* pSDLTexture = reinterpret_cast<SDL_Texture*>(pTexture->GetNativeTexture());
-	SDL_FRect destination = { (float)dest.x, (float)dest.y, (float)dest.width, (float)dest.height };
+	if (!IsOnRendererThread())
+		return CallOnRendererThread([&]() { return FillNativeRects(pRects, count); });
 
-	SDL_FPoint pointToRotate;
-	if (drawParams.m_pointToRotate.has_value())
+	auto rendererLock = LockRenderer();
+	// Same trick as in DrawLines, FRect is 'x, y, width, height' floats just like SDL_FRect
+	static_assert(sizeof(FRect) == sizeof(SDL_FRect), "FRect has to match SDL_FRect");
+	if (SDL_RenderFillRectsF(m_pRenderer.get(), reinterpret_cast<const SDL_FRect*>(pRects), static_cast<int>(count)))
 	{
-		pointToRotate.x = (float)drawParams.m_pointToRotate.value().x;
-		pointToRotate.y = (float)drawParams.m_pointToRotate.value().y;
-	}
-
-    if (SDL_RenderCopyExF(m_pRenderer.get(), pSDLTexture, &source, &destination, drawParams.m_angle,
-		(drawParams.m_pointToRotate ? &pointToRotate : nullptr), ToRendererFlip(drawParams.m_flip)))
-    {
-        LOG(Error, "Unable to draw SDL_Texture. Error: %s", SDL_GetError());
-        return false;
-    }
-    return true;
-}
-
-bool yang::SDLRenderer::DrawLines(const std::vector<IVec2>& points)
-{
-	std::vector<FVec2> fpoints(points.size());
-	//std::transform(points.cbegin(), points.cend(), fpoints.begin(), [this](const IVec2& point){ return m_cameraTransform.TransformPoint(FVec2(point)); });
-	// On one hand, I probably shouldn't do this. On the other - what can go wrong? Both are just structs with 'int x' and 'int y' members. Making a new vector and copying data is too expensive
-	assert(sizeof(FVec2) == sizeof(SDL_FPoint));
-	if (SDL_RenderDrawLinesF(m_pRenderer.get(), reinterpret_cast<const SDL_FPoint*>(fpoints.data()), static_cast<int>(fpoints.size())))
-	{
-		LOG(Error, "Unable to draw lines. Error: %s", SDL_GetError());
+		LOG(Error, "Unable to fill SDL_Rects. Error: %s", SDL_GetError());
 		return false;
-	};
-	
-	return true;
-}
-
-bool yang::SDLRenderer::DrawCircle(const FVec2& center, float radius, uint8_t segments)
-{
-	std::vector<FVec2> points;
-	points.reserve(segments);
-
-	for (size_t i = 0; i < segments; ++i)
-	{
-		points.emplace_back(center.x + radius * std::cosf(2 * Math::kPi * i / segments), center.y +  radius * std::sinf(2 * Math::kPi * i / segments));
-	}
-	
-	return DrawPolygon(points);
-}
-
-bool yang::SDLRenderer::DrawPolygon(const std::vector<FVec2>& points)
-{
-	assert(sizeof(FVec2) == sizeof(SDL_FPoint));
-	return DrawLines(points) && DrawLine(points[points.size() - 1], points[0]);
-}
-
-bool yang::SDLRenderer::FillTriangle(FVec2 points[3])
-{
-	// I want a local copy, we might not want to modify the incoming array
-	FVec2 vertices[3];
-	memcpy(vertices, points, sizeof(FVec2) * 3);
-
-	// Start to draw at top point
-	std::sort(vertices, vertices + 3, [](const FVec2& first, const FVec2& second) {return first.y < second.y; });
-
-	const FVec2* pRightVertex;
-	const FVec2* pLeftVertex;
-
-	// We need to know which one is left and which one is right
-	if (vertices[1].x > vertices[0].x)
-	{
-		pRightVertex = &vertices[1];
-		pLeftVertex = &vertices[2];
-	}
-	else
-	{
-		pRightVertex = &vertices[2];
-		pLeftVertex = &vertices[1];
-	}
-
-	// Initial delta's. 
-	Vector2 leftDelta = vertices[0] - *pLeftVertex;
-	Vector2 rightDelta = vertices[0] - *pRightVertex;
-
-	int y = static_cast<int>(vertices[0].y);
-	float deltaLeftX = 0;
-	float deltaRightX = 0;
-
-	// Consider storing all lines and draw them all in a one bunch.
-	// Starting drawing from the top vertex until we reach next vertex
-	for (; y < static_cast<int>(vertices[1].y); ++y)
-	{
-		FVec2 p1(vertices[0].x - deltaLeftX, static_cast<float>(y));
-		FVec2 p2(vertices[0].x + deltaRightX, static_cast<float>(y));
-
-		if (!DrawLine(p1, p2))
-		{
-			return false;
-		}
-
-		deltaLeftX -= leftDelta.x / leftDelta.y;
-		deltaRightX += rightDelta.x / rightDelta.y;
 	}
-
-	// We reached next vertex. Now we should determine if the vertex was left or right and do stuff according to that information
-	if (pRightVertex->y < pLeftVertex->y)
-	{
-		rightDelta = vertices[1] - vertices[2];
-		deltaRightX = 0;
-		deltaLeftX += vertices[1].x - vertices[0].x;
-	}
-	else
-	{
-		leftDelta = vertices[2] - vertices[1];
-		deltaLeftX = 0;
-		deltaRightX += vertices[0].x - vertices[1].x;
-	}
-
-	// TODO: Get rid of those static casts ?
-	// Doing the same as in prev loop but from second vertex to third.
-	for (; y < static_cast<int>(vertices[2].y); ++y)
-	{
-		FVec2 p1(vertices[1].x - deltaLeftX, static_cast<float>(y));
-		FVec2 p2(vertices[1].x + deltaRightX, static_cast<float>(y));
-
-		if (!DrawLine(p1, p2))
-		{
-			return false;
-		}
-
-		deltaLeftX -= leftDelta.x / leftDelta.y;
-		deltaRightX += rightDelta.x / rightDelta.y;
-
-	}
-
 	return true;
 }
 
-bool yang::SDLRenderer::FillCircle(const FVec2& center, float radius, uint8_t segments)
+bool yang::SDLRenderer::DrawNativeLines(const FVec2* pPoints, size_t count)
 {
-	// Starting at top point, so initial angle is pi/2
-	FVec2 currentLeft = center - FVec2(0, radius);
-	FVec2 currentRight = currentLeft;
-	float currentAngle = Math::kPi / 2;
+	if (!IsOnRendererThread())
+		return CallOnRendererThread([&]() { return DrawNativeLines(pPoints, count); });
 
-	// Starting at top point. Also rounding number of segments to be an even number
-	for (int i = 0; i <= segments / 2; ++i)
+	auto rendererLock = LockRenderer();
+	for (size_t i = 0; i + 1 < count; i += 2)
 	{
-		FVec2 delta(std::cosf(currentAngle), std::sinf(currentAngle));
-
-		FVec2 nextLeft = center - radius * delta;
-		FVec2 nextRight = center + radius * delta;
-
-		float cumulativeDeltaX = currentLeft.x - nextLeft.x;
-		float stepDeltaX = cumulativeDeltaX / (nextLeft.y - currentLeft.y);
-
-		// TODO: Get rid of those static_casts ?
-		for (size_t y = static_cast<size_t>(currentLeft.y); y < static_cast<size_t>(nextLeft.y); ++y)
+		if (SDL_RenderDrawLineF(m_pRenderer.get(), pPoints[i].x, pPoints[i].y, pPoints[i + 1].x, pPoints[i + 1].y))
 		{
-			// TODO: think if it's better to draw all lines at once (but there will be twice as more lines then)
-
-			FVec2 p1(nextLeft.x + cumulativeDeltaX, static_cast<float>(y));
-			FVec2 p2(nextRight.x - cumulativeDeltaX, static_cast<float>(y));
-			cumulativeDeltaX -= stepDeltaX;
-			if (!DrawLine(p1, p2))
-			{
-				return false;
-			}
+			LOG(Error, "Unable to draw line. Error: %s", SDL_GetError());
+			return false;
 		}
-
-		currentLeft = nextLeft;
-		currentRight = nextRight;
-		currentAngle += 2 * Math::kPi / segments;
 	}
-
 	return true;
 }
 
-SDL_RendererFlip yang::SDLRenderer::ToRendererFlip(FlipDirection flip)
-{
-	switch (flip)
-	{
-	case FlipDirection::kVertical:
-		return SDL_RendererFlip::SDL_FLIP_VERTICAL;
-	case FlipDirection::kHorizontal:
-		return SDL_RendererFlip::SDL_FLIP_HORIZONTAL;
-	case FlipDirection::kNone:
-		return SDL_RendererFlip::SDL_FLIP_NONE;
-	default:
-		return SDL_RendererFlip::SDL_FLIP_NONE;
-	}
-}
-
 bool yang::SDLRenderer::SetRenderTarget(ITexture* pTarget)
 {
+	if (!CanChangeRenderTarget(pTarget != nullptr))
+		return false;
+
+	if (!IsOnRendererThread())
+		return CallOnRendererThread([&]() { return SetRenderTarget(pTarget); });
 
 	SDL_Texture* pTargetNativeTexture = pTarget ? reinterpret_cast<SDL_Texture*>(pTarget->GetNativeTexture()) : nullptr;
 
-	if (SDL_SetRenderTarget(m_pRenderer.get(), pTargetNativeTexture))
+	auto rendererLock = LockRenderer();
+	if (GetStateCache().ChangeRenderTarget(pTargetNativeTexture) && SDL_SetRenderTarget(m_pRenderer.get(), pTargetNativeTexture))
 	{
+		GetStateCache().Reset();
 		LOG(Error, "Unable to set render target. Error: %s", SDL_GetError());
 		return false;
 	}
+
+	// Draws into the texture happen right away, they have to be done before the texture is drawn to the screen
+	OnRenderTargetChanged(pTarget != nullptr);
 	return true;
 }
 
 bool yang::SDLRenderer::SetDrawColor(const IColor& color)
 {
-	if (SDL_SetRenderDrawColor(m_pRenderer.get(), color.Red(), color.Green(), color.Blue(), color.Alpha()))
+	if (RenderQueue* pQueue = GetRecordingQueue(); pQueue != nullptr)
+	{
+		pQueue->SetColor(color);
+		return true;
+	}
+
+	if (!IsOnRendererThread())
+		return CallOnRendererThread([&]() { return SetDrawColor(color); });
+
+	auto rendererLock = LockRenderer();
+	if (GetStateCache().ChangeDrawColor(color) && SDL_SetRenderDrawColor(m_pRenderer.get(), color.Red(), color.Green(), color.Blue(), color.Alpha()))
 	{
+		GetStateCache().Reset();
 		LOG(Error, "Unable to set RenderColor. Error: %s", SDL_GetError());
 		return false;
 	}
@@ -359,12 +153,15 @@ bool yang::SDLRenderer::SetDrawColor(const IColor& color)
 
 std::shared_ptr<yang::ITexture> yang::SDLRenderer::CreateTexture(IVec2 dimensions)
 {
-	SDL_Texture* pTexture = SDL_CreateTexture(m_pRenderer.get(), SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, dimensions.x, dimensions.y);
-	SDL_SetTextureBlendMode(pTexture, SDL_BLENDMODE_BLEND);
-	SDL_SetRenderTarget(m_pRenderer.get(), pTexture);
-	SDL_SetRenderDrawColor(m_pRenderer.get(), 0, 0, 0, 0);
-	SDL_RenderClear(m_pRenderer.get());
-	SDL_SetRenderTarget(m_pRenderer.get(), nullptr);
+	if (!IsOnRendererThread())
+		return CallOnRendererThread([&]() { return CreateTexture(dimensions); });
+
+	auto rendererLock = LockRenderer();
+	SDL_Texture* pTexture = CreateTargetTexture(dimensions);
+	if (!pTexture)
+	{
+		return nullptr;
+	}
 
 	// some evil actions here. We want to access private constructor of SDL_Texture, and std::make_shared cannot do that.
 	SDLTexture* pRetVal = new SDLTexture(pTexture);
@@ -375,6 +172,16 @@ std::shared_ptr<yang::ITexture> yang::SDLRenderer::CreateTexture(IVec2 dimension
 bool yang::SDLRenderer::DrawRect(const FRect& rect)
 {
 	//SDL_FRect toDraw = ToSDLFRect(m_cameraTransform.TransformAARect(rect));
+	if (RenderQueue* pQueue = GetRecordingQueue(); pQueue != nullptr)
+	{
+		pQueue->AddRect(rect);
+		return true;
+	}
+
+	if (!IsOnRendererThread())
+		return CallOnRendererThread([&]() { return DrawRect(rect); });
+
+	auto rendererLock = LockRenderer();
 	SDL_FRect toDraw = ToSDLFRect(rect);
 
     if (SDL_RenderDrawRectF(m_pRenderer.get(), &toDraw))
@@ -388,6 +195,16 @@ bool yang::SDLRenderer::DrawRect(const FRect& rect)
 bool yang::SDLRenderer::FillRect(const FRect& rect)
 {
     //SDL_FRect toDraw = ToSDLFRect(m_cameraTransform.TransformAARect(rect));
+	if (RenderQueue* pQueue = GetRecordingQueue(); pQueue != nullptr)
+	{
+		pQueue->AddFillRect(rect);
+		return true;
+	}
+
+	if (!IsOnRendererThread())
+		return CallOnRendererThread([&]() { return FillRect(rect); });
+
+	auto rendererLock = LockRenderer();
 	SDL_FRect toDraw = ToSDLFRect(rect);
 
     if (SDL_RenderFillRectF(m_pRenderer.get(), &toDraw))
@@ -403,6 +220,16 @@ bool yang::SDLRenderer::DrawLine(const FVec2& start, const FVec2& end)
 	//FVec2 _start = m_cameraTransform.TransformPoint(start);
 	//FVec2 _end = m_cameraTransform.TransformPoint(end);
 
+	if (RenderQueue* pQueue = GetRecordingQueue(); pQueue != nullptr)
+	{
+		pQueue->AddLine(start, end);
+		return true;
+	}
+
+	if (!IsOnRendererThread())
+		return CallOnRendererThread([&]() { return DrawLine(start, end); });
+
+	auto rendererLock = LockRenderer();
 	if (SDL_RenderDrawLineF(m_pRenderer.get(), start.x, start.y, end.x, end.y))
 	{
 		LOG(Error, "Unable to draw line. Error: %s", SDL_GetError());
@@ -415,6 +242,19 @@ bool yang::SDLRenderer::DrawLines(const std::vector<FVec2>& points)
 {
 	//std::vector<FVec2> transformedPoints(points.size());
 	//std::transform(points.cbegin(), points.cend(), transformedPoints.begin(), [this](const FVec2& point) {return m_cameraTransform.TransformPoint(point); });
+	if (RenderQueue* pQueue = GetRecordingQueue(); pQueue != nullptr)
+	{
+		for (size_t i = 1; i < points.size(); ++i)
+		{
+			pQueue->AddLine(points[i - 1], points[i]);
+		}
+		return true;
+	}
+
+	if (!IsOnRendererThread())
+		return CallOnRendererThread([&]() { return DrawLines(points); });
+
+	auto rendererLock = LockRenderer();
 	// On one hand, I probably shouldn't do this. On the other - what can go wrong? Both are just structs with 'float x' and 'float y' members.
 	assert(sizeof(FVec2) == sizeof(SDL_FPoint));
 	if (SDL_RenderDrawLinesF(m_pRenderer.get(), reinterpret_cast<const SDL_FPoint*>(points.data()), static_cast<int>(points.size())))
@@ -426,47 +266,3 @@ bool yang::SDLRenderer::DrawLines(const std::vector<FVec2>& points)
 	return true;
 }
 
-bool yang::SDLRenderer::DrawTexture(ITexture* pTexture, const IRect& src, const FRect& dest, const TextureDrawParams& drawParams)
-{
-	if (!pTexture)
-	{
-		LOG(Error, "Texture was nullptr");
-		return false;
-	}
-
-	SDL_Rect source = ToSDLRect(src);
-	//FVec2 destOrigin = m_cameraTransform.TransformPoint(FVec2(dest.x, dest.y));
-	//SDL_FRect destination = ToSDLFRect(m_cameraTransform.TransformAARect(dest));
-	SDL_FRect destination = ToSDLFRect(dest);
-	SDL_Texture* pSDLTexture = reinterpret_cast<SDL_Texture*>(pTexture->GetNativeTexture());
-
-	SDL_FPoint pointToRotate;
-	if (drawParams.m_pointToRotate.has_value())
-	{
-		pointToRotate.x = (float)drawParams.m_pointToRotate.value().x;
-		pointToRotate.y = (float)drawParams.m_pointToRotate.value().y;
-	}
-
-	if (SDL_RenderCopyExF(m_pRenderer.get(), pSDLTexture, &source, &destination, drawParams.m_angle,
-		(drawParams.m_pointToRotate ? &pointToRotate : nullptr), ToRendererFlip(drawParams.m_flip)))
-	{
-		LOG(Error, "Unable to draw SDL_Texture. Error: %s", SDL_GetError());
-		return false;
-	}
-	return true;
-}
-
-bool yang::SDLRenderer::DrawRect(const IRect& rect)
-{
-	return yang::SDLRenderer::DrawRect(FRect(rect));
-}
-
-bool yang::SDLRenderer::FillRect(const IRect& rect)
-{
-	return yang::SDLRenderer::FillRect(FRect(rect));
-}
-
-bool yang::SDLRenderer::DrawLine(const IVec2& start, const IVec2& end)
-{
-	return yang::SDLRenderer::DrawLine(yang::FVec2(start), yang::FVec2(end));
-}
@@ -2,16 +2,15 @@
 /** \file SDLRenderer.h */
 /** SDL Renderer graphics */
 
-#include ".\IGraphics.h"
-#include <SDL/SDL_render.h>
+#include ".\SDLRendererBase.h"
 
 //! \namespace yang Contains all Yangine code
 namespace yang
 {
 /** \class SDLRenderer */
-/** SDL_Renderer wrapper for IGraphics interface specialization */
+/** SDL_Renderer wrapper for IGraphics interface specialization. Draws into the window, \see yang::SDLRendererBase */
 class SDLRenderer
-	: public IGraphics
+	: public SDLRendererBase
 {
 public:
 	// --------------------------------------------------------------------- //
@@ -26,7 +25,7 @@ public:
 	/** Default Constructor */
 	SDLRenderer();
 
-	/** Default Destructor */
+	/** Destructor. Stops the render thread and destroys the retired textures */
 	~SDLRenderer();
 
     /// Initialize the SDL_Renderer
@@ -45,61 +44,11 @@ public:
     /// Finalize the frame by presenting to the window.
 	virtual void EndDrawing() override final;
 
-    /// Load the SDL_Texture from a raw data resource
-    /// \param pResource - Pointer to raw data resource
+    /// Create the SDL_Texture from an SDL_Surface decoded by DecodeImage. Main thread only
+    /// \param pResource - Pointer to raw data resource the image was decoded from
+    /// \param pImage - Pointer to SDL_Surface. Still owned by the caller
     /// \return Shared pointer to texture resource
-    virtual std::shared_ptr<ITexture> LoadTexture(IResource* pResource) override final;
-
-    /// Draw the texture at specified position
-    /// \param pTexture - texture to draw
-    /// \param position - position where to draw the texture. Defaulted to {0,0}
-    /// \param drawParams - parameters to draw the texture. Defaulted to a default constructed TextureDrawParams. \see yang::IGraphics::TextureDrawParams. 
-    /// \return true if successful
-	virtual bool DrawTexture(ITexture* pTexture, IVec2 position = { 0,0 }, const TextureDrawParams & drawParams = {}) override final;
-
-    /// Draw the texture at specified position
-    /// \param pTexture - texture to draw
-    /// \param dest - rectangle on the screen to draw the texture to (in pixels). \see yang::Rectangle
-    /// \param drawParams - parameters to draw the texture. Defaulted to a default constructed TextureDrawParams. \see yang::IGraphics::TextureDrawParams. 
-    /// \return true if successful
-	virtual bool DrawTexture(ITexture* pTexture, const IRect& dest, const TextureDrawParams& drawParams = {}) override final;
-
-    /// Draw the portion of a texture at specified position
-    /// \param pTexture - texture to draw
-    /// \param src - rectangle to use from the texture (in pixels). \see yang::Rectangle
-    /// \param dest - rectangle on the screen to draw the texture to (in pixels). \see yang::Rectangle
-    /// \param drawParams - parameters to draw the texture. Defaulted to a default constructed TextureDrawParams. \see yang::IGraphics::TextureDrawParams. 
-    /// \return true if successful
-	virtual bool DrawTexture(ITexture* pTexture, const IRect& src, const IRect& dest, const TextureDrawParams& drawParams = {}) override final;
-
-    /// Draw the portion of a texture at specified position
-    /// \param pTexture - texture to draw
-    /// \param src - rectangle to use from the texture (in pixels). \see yang::Rectangle
-    /// \param dest - rectangle on the screen to draw the texture to (in pixels). \see yang::Rectangle
-    /// \param drawParams - parameters to draw the texture. Defaulted to a default constructed TextureDrawParams. \see yang::IGraphics::TextureDrawParams. 
-    /// \return true if successful
-    virtual bool DrawTexture(ITexture* pTexture, const IRect& src, const FRect& dest, const TextureDrawParams& drawParams = {}) override final;
-
-    /// Draw the rectangle borders on the screen
-    /// \param rect - The rectangle to draw (in pixels)
-    /// \return true if successful
-    virtual bool DrawRect(const IRect& rect) override final;
-
-    /// Draw a filled rectangle on the screen
-    /// \param rect - The rectangle to draw (in pixels)
-    /// \return true if successful
-    virtual bool FillRect(const IRect& rect) override final;
-
-    /// Draw a line on the screen
-    /// \param start - Position of the start point in pixels
-    /// \param end - Position of the end point in pixels
-    /// \return true if successful
-    virtual bool DrawLine(const IVec2& start, const IVec2& end) override final;
-
-    /// Draw connected lines on the screen
-    /// \param points - std::vector of point positions.
-    /// \return true if successful
-	virtual bool DrawLines(const std::vector<IVec2>& points) override final;
+    virtual std::shared_ptr<ITexture> CreateTextureFromImage(IResource* pResource, void* pImage) override final;
 
     /// Draw the rectangle borders on the screen. Floating point version.
     /// \param rect - The rectangle to draw (in pixels)
@@ -122,17 +71,10 @@ public:
     /// \return true if successful
 	virtual bool DrawLines(const std::vector<FVec2>& points) override final;
 
-    /// Draw the circle on the screen
-    /// \param center - Center of the circle position in pixels.
-    /// \param radius - Radius of the circle in pixels.
-    /// \param segments - Number of line segments used to draw the circle. Defaulted to 16
-    /// \return true if successful
-	virtual bool DrawCircle(const FVec2& center, float radius, uint8_t segments) override final;
-
-    /// Draw the polygon borders on the screen
-    /// \param points - std::vector of polygon vertices positions (in pixels) to draw
-    /// \return true if successful
-	virtual bool DrawPolygon(const std::vector<FVec2>& points) override final;
+    using SDLRendererBase::DrawRect;
+    using SDLRendererBase::FillRect;
+    using SDLRendererBase::DrawLine;
+    using SDLRendererBase::DrawLines;
 
     /// Set the render target to a texture. Nullptr resets the render target to the screen
     /// \param pTarget - Texture to set the render target to.
@@ -149,74 +91,33 @@ public:
     /// \return Shared pointer to a created texture
 	virtual std::shared_ptr<ITexture> CreateTexture(IVec2 dimensions) override final;
 
-    /// Return the underlying renderer system.
-    /// \return Pointer to the SDL_Renderer
-    virtual void* GetNativeRenderer() override final { return m_pRenderer.get(); }
+protected:
+	// --------------------------------------------------------------------- //
+	// Protected Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Present the frame with SDL_RenderPresent. Blocks on vsync
+    virtual void PresentFrame() override final;
 
-    /// Draw a filled triangle on the screen
-    /// Note: That function is slow, so prefer to use for debug purposes only.
-    /// \param points - Array of triangle vertices position in pixels.
+    /// Fill the rectangles with one SDL_RenderFillRectsF call
+    /// \param pRects - array of the rectangles to fill
+    /// \param count - number of rectangles in the array
     /// \return true if successful
-    virtual bool FillTriangle(FVec2 points[3]) override final;
+    virtual bool FillNativeRects(const FRect* pRects, size_t count) override final;
 
-    /// Draw a filled circle on the screen
-    /// Note: That function is slow, so prefer to use for debug purposes only.
-    /// \param center - Center of the circle position in pixels.
-    /// \param radius - Radius of the circle in pixels.
-    /// \param segments - Number of circle segments used to draw the circle. Defaulted to 16
+    /// Draw the lines back to back under one renderer lock, so SDL's render batching merges them
+    /// \param pPoints - array of line points, every two points are the start and the end of one line
+    /// \param count - number of points in the array, even
     /// \return true if successful
-    virtual bool FillCircle(const FVec2& center, float radius, uint8_t segments) override final;
-private:
-	// --------------------------------------------------------------------- //
-	// Private Member Variables
-	// --------------------------------------------------------------------- //
-	std::unique_ptr<SDL_Renderer, decltype(&SDL_DestroyRenderer)> m_pRenderer;  ///< Unique pointer to the SDL_Renderer
+    virtual bool DrawNativeLines(const FVec2* pPoints, size_t count) override final;
 
-	// --------------------------------------------------------------------- //
-	// Private Member Functions
-	// --------------------------------------------------------------------- //
+    /// SDL 2.0.10 renderers have to be used on the thread that created them, the GL ones fail on any other
+    virtual bool IsRenderThreadSupported() const override final { return false; }
 
-    /// Helper function to convert rectangle to SDL_Rect. Truncates floating point values
-    /// \param rect - rectangle to convert
-    /// \return corresponding SDL_Rect
-    template <class T>
-    SDL_Rect ToSDLRect(const Rectangle<T>& rect);
-
-    /// Helper function to convert rectangle to SDL_Rect.
-    /// \param rect - rectangle to convert
-    /// \return corresponding SDL_Rect
-	template <class T>
-	SDL_FRect ToSDLFRect(const Rectangle<T>& rect);
-
-	/// Helper function to convert FlipDirection to SDL_RendererFlip. \see FlipDirection
-    /// \param flip - FlipDirection to convert
-    /// \return corresponding SDL_RendererFlip
-	SDL_RendererFlip ToRendererFlip(FlipDirection flip);
 public:
 	// --------------------------------------------------------------------- //
 	// Accessors & Mutators
 	// --------------------------------------------------------------------- //
 
 };
-template<class T>
-inline SDL_Rect SDLRenderer::ToSDLRect(const Rectangle<T>& rect)
-{
-    return {
-        static_cast<i32>(rect.x),
-        static_cast<i32>(rect.y),
-        static_cast<i32>(rect.width),
-        static_cast<i32>(rect.height)
-    };
-}
-template<class T>
-inline SDL_FRect SDLRenderer::ToSDLFRect(const Rectangle<T>& rect)
-{
-	return
-	{
-		static_cast<f32>(rect.x),
-		static_cast<f32>(rect.y),
-		static_cast<f32>(rect.width),
-		static_cast<f32>(rect.height)
-	};
-}
 }
\ No newline at end of file
@@ -0,0 +1,274 @@
+#include "SDLRendererBase.h"
+#include <Utils/Logger.h>
+#include <Application/Graphics/RenderQueue.h>
+#include <Application/Graphics/Textures/ITexture.h>
+#include <SDL/SDL_image.h>
+#include <algorithm>
+
+using yang::SDLRendererBase;
+
+std::mutex SDLRendererBase::s_retiredTextureMutex;
+std::vector<SDL_Texture*> SDLRendererBase::s_retiredTextures;
+
+SDLRendererBase::SDLRendererBase()
+	:m_pRenderer(nullptr, &SDL_DestroyRenderer)
+{
+
+}
+
+void yang::SDLRendererBase::ReleaseNativeTexture(SDL_Texture* pTexture)
+{
+	if (!pTexture)
+		return;
+
+	std::lock_guard<std::mutex> lock(s_retiredTextureMutex);
+	s_retiredTextures.push_back(pTexture);
+}
+
+void yang::SDLRendererBase::InitImageLoaders()
+{
+    constexpr int kImageFlags = IMG_INIT_PNG | IMG_INIT_JPG;
+    if ((IMG_Init(kImageFlags) & kImageFlags) != kImageFlags)
+    {
+        LOG(Warning, "SDL_image failed to initialize some of the loaders, %s", IMG_GetError());
+    }
+}
+
+void yang::SDLRendererBase::ClearFrame(const IColor& color)
+{
+	if (!IsOnRendererThread())
+	{
+		CallOnRendererThread([&]() { SDLRendererBase::ClearFrame(color); });
+		return;
+	}
+
+	if (GetStateCache().ChangeDrawColor(color))
+	{
+		SDL_SetRenderDrawColor(m_pRenderer.get(), color.Red(), color.Green(), color.Blue(), color.Alpha());
+	}
+	SDL_RenderClear(m_pRenderer.get());
+	// TODO: Check for SDL errors
+}
+
+void yang::SDLRendererBase::ReleaseRetiredResources()
+{
+	std::vector<SDL_Texture*> retiredTextures;
+	{
+		std::lock_guard<std::mutex> lock(s_retiredTextureMutex);
+		retiredTextures.swap(s_retiredTextures);
+	}
+
+	if (retiredTextures.empty())
+		return;
+
+	CallOnRendererThread([this, &retiredTextures]()
+	{
+		auto rendererLock = LockRenderer();
+		for (SDL_Texture* pTexture : retiredTextures)
+		{
+			GetStateCache().ForgetTexture(pTexture);
+			SDL_DestroyTexture(pTexture);
+		}
+	});
+}
+
+std::shared_ptr<yang::ITexture> yang::SDLRendererBase::LoadTexture(IResource* pResource)
+{
+    void* pImage = DecodeImage(pResource);
+    if (!pImage)
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<ITexture> pTexture = CreateTextureFromImage(pResource, pImage);
+    FreeImage(pImage);
+    return pTexture;
+}
+
+void* yang::SDLRendererBase::DecodeImage(IResource* pResource)
+{
+    SDL_RWops* pOps = SDL_RWFromConstMem(pResource->GetData().data(), static_cast<int>(pResource->GetData().size()));
+    SDL_Surface* pSurface = IMG_Load_RW(pOps, 1);
+
+    if (!pSurface)
+    {
+        LOG(Error, "Unable to load image %s. Error: %s", pResource->GetName().c_str(), IMG_GetError());
+        return nullptr;
+    }
+
+    return pSurface;
+}
+
+void yang::SDLRendererBase::FreeImage(void* pImage)
+{
+    SDL_FreeSurface(reinterpret_cast<SDL_Surface*>(pImage));
+}
+
+bool yang::SDLRendererBase::DrawTexture(ITexture* pTexture, IVec2 position, const TextureDrawParams& drawParams)
+{
+	if (!pTexture)
+	{
+		LOG(Error, "Texture was nullptr");
+		return false;
+	}
+
+	IVec2 dimensions = pTexture->GetDimensions();
+	return CopyTexture(pTexture, nullptr, FRect((float)position.x, (float)position.y, (float)dimensions.x, (float)dimensions.y), drawParams);
+}
+
+bool yang::SDLRendererBase::DrawTexture(ITexture* pTexture, const IRect& dest, const TextureDrawParams& drawParams)
+{
+	return CopyTexture(pTexture, nullptr, FRect(dest), drawParams);
+}
+
+bool yang::SDLRendererBase::DrawTexture(ITexture* pTexture, const IRect& src, const IRect& dest, const TextureDrawParams& drawParams)
+{
+	return CopyTexture(pTexture, &src, FRect(dest), drawParams);
+}
+
+bool yang::SDLRendererBase::DrawTexture(ITexture* pTexture, const IRect& src, const FRect& dest, const TextureDrawParams& drawParams)
+{
+	return CopyTexture(pTexture, &src, dest, drawParams);
+}
+
+bool yang::SDLRendererBase::DrawNativeTextureBatch(void* pNativeTexture, const IColor& modulation, const TextureQuad* pQuads, size_t count)
+{
+	if (!IsOnRendererThread())
+		return CallOnRendererThread([&]() { return SDLRendererBase::DrawNativeTextureBatch(pNativeTexture, modulation, pQuads, count); });
+
+	auto rendererLock = LockRenderer();
+	SDL_Texture* pSDLTexture = reinterpret_cast<SDL_Texture*>(pNativeTexture);
+	ApplyModulation(pSDLTexture, modulation);
+	for (size_t i = 0; i < count; ++i)
+	{
+		const TextureQuad& quad = pQuads[i];
+		SDL_Rect source = ToSDLRect(quad.m_src);
+		SDL_FRect destination = ToSDLFRect(quad.m_dst);
+		const TextureDrawParams& drawParams = quad.m_drawParams;
+
+		int result;
+		if (drawParams.m_angle == 0 && drawParams.m_flip == FlipDirection::kNone)
+		{
+			result = SDL_RenderCopyF(m_pRenderer.get(), pSDLTexture, &source, &destination);
+		}
+		else
+		{
+			SDL_FPoint pointToRotate;
+			if (drawParams.m_pointToRotate.has_value())
+			{
+				pointToRotate.x = (float)drawParams.m_pointToRotate.value().x;
+				pointToRotate.y = (float)drawParams.m_pointToRotate.value().y;
+			}
+
+			result = SDL_RenderCopyExF(m_pRenderer.get(), pSDLTexture, &source, &destination, drawParams.m_angle,
+				(drawParams.m_pointToRotate ? &pointToRotate : nullptr), ToRendererFlip(drawParams.m_flip));
+		}
+
+		if (result)
+		{
+			LOG(Error, "Unable to draw SDL_Texture. Error: %s", SDL_GetError());
+			return false;
+		}
+	}
+	return true;
+}
+
+bool yang::SDLRendererBase::CopyTexture(ITexture* pTexture, const IRect* pSource, const FRect& dest, const TextureDrawParams& drawParams)
+{
+	if (!pTexture)
+	{
+		LOG(Error, "Texture was nullptr");
+		return false;
+	}
+
+    IVec2 dimensions = pTexture->GetDimensions();
+    IRect source = pSource ? *pSource : IRect(0, 0, dimensions.x, dimensions.y);
+	if (RenderQueue* pQueue = GetRecordingQueue(); pQueue != nullptr)
+	{
+		pQueue->AddTexture(pTexture, source, dest, drawParams);
+		return true;
+	}
+
+    // A single draw is a batch of one, so the derived renderer sees every texture draw in one place
+    TextureQuad quad{ source, dest, drawParams };
+    return DrawNativeTextureBatch(pTexture->GetNativeTexture(), pTexture->GetModulation(), &quad, 1);
+}
+
+bool yang::SDLRendererBase::DrawRect(const IRect& rect)
+{
+	return DrawRect(FRect(rect));
+}
+
+bool yang::SDLRendererBase::FillRect(const IRect& rect)
+{
+	return FillRect(FRect(rect));
+}
+
+bool yang::SDLRendererBase::DrawLine(const IVec2& start, const IVec2& end)
+{
+	return DrawLine(FVec2(start), FVec2(end));
+}
+
+bool yang::SDLRendererBase::DrawLines(const std::vector<IVec2>& points)
+{
+	std::vector<FVec2> fpoints(points.size());
+	std::transform(points.cbegin(), points.cend(), fpoints.begin(), [](const IVec2& point) { return FVec2(point); });
+	return DrawLines(fpoints);
+}
+
+SDL_Texture* yang::SDLRendererBase::CreateTargetTexture(IVec2 dimensions)
+{
+	SDL_Texture* pTexture = SDL_CreateTexture(m_pRenderer.get(), SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, dimensions.x, dimensions.y);
+    if (!pTexture)
+    {
+        LOG(Error, "Unable to create %dx%d texture. Error: %s", dimensions.x, dimensions.y, SDL_GetError());
+        return nullptr;
+    }
+
+	SDL_SetTextureBlendMode(pTexture, SDL_BLENDMODE_BLEND);
+
+	RenderStateCache& stateCache = GetStateCache();
+	if (stateCache.ChangeRenderTarget(pTexture))
+	{
+		SDL_SetRenderTarget(m_pRenderer.get(), pTexture);
+	}
+	if (stateCache.ChangeDrawColor(IColor(0, 0, 0, 0)))
+	{
+		SDL_SetRenderDrawColor(m_pRenderer.get(), 0, 0, 0, 0);
+	}
+	SDL_RenderClear(m_pRenderer.get());
+	if (stateCache.ChangeRenderTarget(nullptr))
+	{
+		SDL_SetRenderTarget(m_pRenderer.get(), nullptr);
+	}
+	return pTexture;
+}
+
+void yang::SDLRendererBase::ApplyModulation(SDL_Texture* pTexture, const IColor& modulation)
+{
+	// The tiles of a map layer or the glyphs of a text share the texture and its modulation, only the first one sets it
+	RenderStateCache& stateCache = GetStateCache();
+	if (stateCache.ChangeColorModulation(pTexture, modulation))
+	{
+		SDL_SetTextureColorMod(pTexture, modulation.Red(), modulation.Green(), modulation.Blue());
+	}
+	if (stateCache.ChangeAlphaModulation(pTexture, modulation.Alpha()))
+	{
+		SDL_SetTextureAlphaMod(pTexture, modulation.Alpha());
+	}
+}
+
+SDL_RendererFlip yang::SDLRendererBase::ToRendererFlip(FlipDirection flip)
+{
+	switch (flip)
+	{
+	case FlipDirection::kVertical:
+		return SDL_RendererFlip::SDL_FLIP_VERTICAL;
+	case FlipDirection::kHorizontal:
+		return SDL_RendererFlip::SDL_FLIP_HORIZONTAL;
+	case FlipDirection::kNone:
+		return SDL_RendererFlip::SDL_FLIP_NONE;
+	default:
+		return SDL_RendererFlip::SDL_FLIP_NONE;
+	}
+}
@@ -0,0 +1,214 @@
+#pragma once
+/** \file SDLRendererBase.h */
+/** Code shared by the graphics systems that draw with an SDL_Renderer */
+
+#include ".\IGraphics.h"
+#include <SDL/SDL_render.h>
+#include <mutex>
+#include <vector>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \class SDLRendererBase */
+/** Base of the IGraphics implementations that draw with an SDL_Renderer, SDLRenderer and HeadlessRenderer.
+    Decodes the images with SDL_image, draws the textures and the shape overloads, creates the render target textures
+    and destroys the released SDL_Textures at the end of the frame. The derived classes create the renderer and present */
+class SDLRendererBase
+	: public IGraphics
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Deleter of the native textures of SDLTexture and HeadlessTexture. The texture is destroyed at the end of the frame,
+    /// once the render thread can't be drawing it anymore. Safe to call from any thread
+    /// \param pTexture - texture to destroy
+    static void ReleaseNativeTexture(SDL_Texture* pTexture);
+
+    /// Load the texture from a raw data resource
+    /// \param pResource - Pointer to raw data resource
+    /// \return Shared pointer to texture resource
+    virtual std::shared_ptr<ITexture> LoadTexture(IResource* pResource) override final;
+
+    /// Decode the image from a raw data resource into an SDL_Surface. Safe to call from worker threads
+    /// \param pResource - Pointer to raw data resource
+    /// \return Pointer to SDL_Surface, null if decoding failed
+    virtual void* DecodeImage(IResource* pResource) override final;
+
+    /// Free an SDL_Surface decoded by DecodeImage
+    /// \param pImage - Pointer to SDL_Surface
+    virtual void FreeImage(void* pImage) override final;
+
+    /// Draw the texture at specified position
+    /// \param pTexture - texture to draw
+    /// \param position - position where to draw the texture. Defaulted to {0,0}
+    /// \param drawParams - parameters to draw the texture. Defaulted to a default constructed TextureDrawParams. \see yang::IGraphics::TextureDrawParams.
+    /// \return true if successful
+	virtual bool DrawTexture(ITexture* pTexture, IVec2 position = { 0,0 }, const TextureDrawParams & drawParams = {}) override final;
+
+    /// Draw the texture at specified position
+    /// \param pTexture - texture to draw
+    /// \param dest - rectangle on the screen to draw the texture to (in pixels). \see yang::Rectangle
+    /// \param drawParams - parameters to draw the texture. Defaulted to a default constructed TextureDrawParams. \see yang::IGraphics::TextureDrawParams.
+    /// \return true if successful
+	virtual bool DrawTexture(ITexture* pTexture, const IRect& dest, const TextureDrawParams& drawParams = {}) override final;
+
+    /// Draw the portion of a texture at specified position
+    /// \param pTexture - texture to draw
+    /// \param src - rectangle to use from the texture (in pixels). \see yang::Rectangle
+    /// \param dest - rectangle on the screen to draw the texture to (in pixels). \see yang::Rectangle
+    /// \param drawParams - parameters to draw the texture. Defaulted to a default constructed TextureDrawParams. \see yang::IGraphics::TextureDrawParams.
+    /// \return true if successful
+	virtual bool DrawTexture(ITexture* pTexture, const IRect& src, const IRect& dest, const TextureDrawParams& drawParams = {}) override final;
+
+    /// Draw the portion of a texture at specified position
+    /// \param pTexture - texture to draw
+    /// \param src - rectangle to use from the texture (in pixels). \see yang::Rectangle
+    /// \param dest - rectangle on the screen to draw the texture to (in pixels). \see yang::Rectangle
+    /// \param drawParams - parameters to draw the texture. Defaulted to a default constructed TextureDrawParams. \see yang::IGraphics::TextureDrawParams.
+    /// \return true if successful
+    virtual bool DrawTexture(ITexture* pTexture, const IRect& src, const FRect& dest, const TextureDrawParams& drawParams = {}) override final;
+
+    /// Draw the rectangle borders on the screen
+    /// \param rect - The rectangle to draw (in pixels)
+    /// \return true if successful
+    virtual bool DrawRect(const IRect& rect) override final;
+
+    /// Draw a filled rectangle on the screen
+    /// \param rect - The rectangle to draw (in pixels)
+    /// \return true if successful
+    virtual bool FillRect(const IRect& rect) override final;
+
+    /// Draw a line on the screen
+    /// \param start - Position of the start point in pixels
+    /// \param end - Position of the end point in pixels
+    /// \return true if successful
+    virtual bool DrawLine(const IVec2& start, const IVec2& end) override final;
+
+    /// Draw connected lines on the screen
+    /// \param points - std::vector of point positions.
+    /// \return true if successful
+	virtual bool DrawLines(const std::vector<IVec2>& points) override final;
+
+    using IGraphics::DrawRect;
+    using IGraphics::FillRect;
+    using IGraphics::DrawLine;
+    using IGraphics::DrawLines;
+
+    /// Return the underlying renderer system.
+    /// \return Pointer to the SDL_Renderer, null if there is none
+    virtual void* GetNativeRenderer() override final { return m_pRenderer.get(); }
+
+protected:
+	// --------------------------------------------------------------------- //
+	// Protected Member Variables
+	// --------------------------------------------------------------------- //
+	std::unique_ptr<SDL_Renderer, decltype(&SDL_DestroyRenderer)> m_pRenderer;  ///< Unique pointer to the SDL_Renderer, created by the derived class
+
+	// --------------------------------------------------------------------- //
+	// Protected Member Functions
+	// --------------------------------------------------------------------- //
+
+	/** Default Constructor */
+    SDLRendererBase();
+
+    /// Initialize the SDL_image loaders up front. They are initialized lazily on first use otherwise,
+    /// which would race when decoding on worker threads
+    static void InitImageLoaders();
+
+    /// Clear the current render target with SDL_RenderClear
+    /// \param color - color to clear to
+    virtual void ClearFrame(const IColor& color) override;
+
+    /// Draw several portions of one SDL_Texture. The quads go to SDL back to back, so its render batching merges them
+    /// \param pNativeTexture - SDL_Texture to draw
+    /// \param modulation - tint in red, green and blue, opacity in alpha
+    /// \param pQuads - array of the portions to draw
+    /// \param count - number of quads in the array
+    /// \return true if successful
+    virtual bool DrawNativeTextureBatch(void* pNativeTexture, const IColor& modulation, const TextureQuad* pQuads, size_t count) override;
+
+    /// Destroy the SDL_Textures released since the last call
+    virtual void ReleaseRetiredResources() override final;
+
+    /// Create a render target SDL_Texture cleared to transparent. The clear goes through the state cache,
+    /// so it knows the target and color it ends with. The caller holds the renderer lock
+    /// \param dimensions - width and height in pixels of a new texture
+    /// \return The new SDL_Texture, null if SDL failed to create it
+    SDL_Texture* CreateTargetTexture(IVec2 dimensions);
+
+    /// Helper function to convert rectangle to SDL_Rect. Truncates floating point values
+    /// \param rect - rectangle to convert
+    /// \return corresponding SDL_Rect
+    template <class T>
+    static SDL_Rect ToSDLRect(const Rectangle<T>& rect);
+
+    /// Helper function to convert rectangle to SDL_FRect.
+    /// \param rect - rectangle to convert
+    /// \return corresponding SDL_FRect
+	template <class T>
+	static SDL_FRect ToSDLFRect(const Rectangle<T>& rect);
+
+	/// Helper function to convert FlipDirection to SDL_RendererFlip. \see FlipDirection
+    /// \param flip - FlipDirection to convert
+    /// \return corresponding SDL_RendererFlip
+	static SDL_RendererFlip ToRendererFlip(FlipDirection flip);
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+    static std::mutex s_retiredTextureMutex;                                    ///< Guards the retired textures
+    static std::vector<SDL_Texture*> s_retiredTextures;                         ///< Textures released since the end of the last frame
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Draws or records the portion of a texture. Shared by the DrawTexture overloads
+    /// \param pTexture - texture to draw
+    /// \param pSource - rectangle to use from the texture (in pixels), nullptr for the whole texture
+    /// \param dest - rectangle on the screen to draw the texture to (in pixels)
+    /// \param drawParams - parameters to draw the texture
+    /// \return true if successful
+    bool CopyTexture(ITexture* pTexture, const IRect* pSource, const FRect& dest, const TextureDrawParams& drawParams);
+
+    /// Set the texture color and alpha modulation before drawing it
+    /// \param pTexture - texture to draw
+    /// \param modulation - tint in red, green and blue, opacity in alpha
+    void ApplyModulation(SDL_Texture* pTexture, const IColor& modulation);
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+};
+template<class T>
+inline SDL_Rect SDLRendererBase::ToSDLRect(const Rectangle<T>& rect)
+{
+    return {
+        static_cast<i32>(rect.x),
+        static_cast<i32>(rect.y),
+        static_cast<i32>(rect.width),
+        static_cast<i32>(rect.height)
+    };
+}
+template<class T>
+inline SDL_FRect SDLRendererBase::ToSDLFRect(const Rectangle<T>& rect)
+{
+	return
+	{
+		static_cast<f32>(rect.x),
+		static_cast<f32>(rect.y),
+		static_cast<f32>(rect.width),
+		static_cast<f32>(rect.height)
+	};
+}
+}
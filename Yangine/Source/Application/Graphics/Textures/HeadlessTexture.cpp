@@ -0,0 +1,75 @@
+#include "HeadlessTexture.h"
+
+#include <Utils/Logger.h>
+#include <Utils/Color.h>
+#include <Application/Graphics/SDLRendererBase.h>
+
+using yang::HeadlessTexture;
+
+HeadlessTexture::HeadlessTexture(IResource* pResource)
+	: ITexture(pResource)
+    , m_pSurfaceTexture(nullptr, &SDLRendererBase::ReleaseNativeTexture)
+{
+
+}
+
+HeadlessTexture::HeadlessTexture(IVec2 dimensions, SDL_Texture* pSurfaceTexture)
+	: ITexture()
+    , m_pSurfaceTexture(pSurfaceTexture, &SDLRendererBase::ReleaseNativeTexture)
+{
+    SetDimensions(dimensions);
+}
+
+HeadlessTexture::~HeadlessTexture()
+{
+
+}
+
+void* yang::HeadlessTexture::GetNativeTexture() const
+{
+    // Without a surface texture the render queue still needs a distinct pointer per texture to batch by
+    if (!m_pSurfaceTexture)
+        return const_cast<HeadlessTexture*>(this);
+
+	return m_pSurfaceTexture.get();
+}
+
+bool yang::HeadlessTexture::Init(SDL_Renderer* pRenderer, SDL_Surface* pSurface)
+{
+	SetDimensions({ pSurface->w, pSurface->h });
+    if (!pRenderer)
+        return true;
+
+	m_pSurfaceTexture.reset(SDL_CreateTextureFromSurface(pRenderer, pSurface));
+	if (!m_pSurfaceTexture)
+	{
+		LOG(Error, "SDL could not create the surface texture: %s", SDL_GetError());
+		return false;
+	}
+
+    SDL_SetTextureBlendMode(m_pSurfaceTexture.get(), SDL_BlendMode::SDL_BLENDMODE_BLEND);
+	return true;
+}
+
+bool yang::HeadlessTexture::SetTint(const IColor& color)
+{
+    // HeadlessRenderer applies the tint when the texture is drawn
+    m_tint = color;
+    return true;
+}
+
+bool yang::HeadlessTexture::SetTint(const FColor& color)
+{
+    return SetTint(color.ToIColor());
+}
+
+bool yang::HeadlessTexture::SetAlpha(ui8 alpha)
+{
+    m_alpha = static_cast<float>(alpha) / std::numeric_limits<ui8>::max();
+    return true;
+}
+
+bool yang::HeadlessTexture::SetAlpha(float alpha)
+{
+    return SetAlpha(static_cast<ui8>(alpha * std::numeric_limits<ui8>::max()));
+}
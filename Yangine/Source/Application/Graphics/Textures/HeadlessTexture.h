@@ -0,0 +1,88 @@
+#pragma once
+/** \file HeadlessTexture.h */
+/** Specialization of ITexture resource for HeadlessRenderer */
+
+#include ".\ITexture.h"
+
+#include <memory>
+
+#include <SDL/SDL_render.h>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \class HeadlessTexture */
+/** Texture of the HeadlessRenderer. Holds the dimensions only, plus a software renderer texture when the renderer rasterizes */
+class HeadlessTexture
+	: public ITexture
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Constructor
+    /// \param pResource - pointer to a raw resource data
+	HeadlessTexture(IResource* pResource);
+
+    /// Constructor of the textures without resource data
+    /// \param dimensions - width and height in pixels
+    /// \param pSurfaceTexture - software renderer texture to take ownership of, null when only counting
+	HeadlessTexture(IVec2 dimensions, SDL_Texture* pSurfaceTexture);
+
+	/** Default Destructor */
+	~HeadlessTexture();
+
+    /// Get the underlying texture representation
+    /// \return pointer to the software renderer SDL_Texture, or a pointer unique to this texture when only counting
+	virtual void* GetNativeTexture() const override final;
+
+    /// Initializes the texture resource
+    /// \param pRenderer - software renderer to create the texture with, null when only counting
+    /// \param pSurface - pointer to SDL_Surface to make the texture from
+    /// \return true if initialized successfully
+	bool Init(SDL_Renderer* pRenderer, SDL_Surface* pSurface);
+
+    /// Sets the texture tint color
+    /// \param color - integer color to tint \see yang::IColor
+    /// \return true if tint was successfully set
+    virtual bool SetTint(const IColor& color) override final;
+
+    /// Sets the texture tint color
+    /// \param color - float color to tint \see yang::FColor
+    /// \return true if tint was successfully set
+    virtual bool SetTint(const FColor& color) override final;
+
+    /// Sets the texture transparency
+    /// \param alpha - integer in range 0-255 to set transparency
+    /// \return true if transparency was successfully set
+    virtual bool SetAlpha(ui8 alpha) override final;
+
+    /// Sets the texture transparency
+    /// \param alpha - float in range [0.0 - 1.0] to set transparency
+    /// \return true if transparency was successfully set
+    virtual bool SetAlpha(float alpha) override final;
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+	std::unique_ptr<SDL_Texture, void(*)(SDL_Texture*)> m_pSurfaceTexture;  ///< Software renderer texture, released through SDLRendererBase::ReleaseNativeTexture
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+};
+}
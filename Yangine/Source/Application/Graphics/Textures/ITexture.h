@@ -55,6 +55,10 @@ public:
     /// \param alpha - float in range [0.0 - 1.0] to set transparency
     /// \return true if transparency was successfully set
     virtual bool SetAlpha(float alpha) = 0;
+
+    /// Get approximate memory used by the texture: raw data plus 4 bytes per pixel
+    /// \return size in bytes
+    virtual size_t GetMemorySize() const override { return IResource::GetMemorySize() + static_cast<size_t>(m_textureDimensions.x) * m_textureDimensions.y * 4; }
 private:
 	// --------------------------------------------------------------------- //
 	// Private Member Variables
@@ -68,8 +72,8 @@ protected:
 	// --------------------------------------------------------------------- //
 	// Protected Member Variables
 	// --------------------------------------------------------------------- //
-	float m_alpha;				///< Texture opacity;
-	yang::IColor m_tint;
+	float m_alpha = 1.f;								///< Texture opacity;
+	yang::IColor m_tint = yang::IColor::White();		///< Color the texture is multiplied by
 	// --------------------------------------------------------------------- //
 	// Protected Member Functions
 	// --------------------------------------------------------------------- //
@@ -96,5 +100,8 @@ public:
 	float GetAlpha() const { return m_alpha; }
 
 	yang::IColor GetTint() const { return m_tint; }
+
+	/// Get the tint with the opacity in the alpha component, applied by the graphics system when the texture is drawn
+	yang::IColor GetModulation() const { return yang::IColor(m_tint.Red(), m_tint.Green(), m_tint.Blue(), static_cast<ui8>(m_alpha * 255)); }
 };
 }
\ No newline at end of file
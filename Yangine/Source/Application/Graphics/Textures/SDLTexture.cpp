@@ -2,12 +2,13 @@
 
 #include <Utils/Logger.h>
 #include <Utils/Color.h>
+#include <Application/Graphics/SDLRendererBase.h>
 
 using yang::SDLTexture;
 
 SDLTexture::SDLTexture(IResource* pResource)
 	: ITexture(pResource)
-    , m_pTexture(nullptr, &SDL_DestroyTexture)
+    , m_pTexture(nullptr, &SDLRendererBase::ReleaseNativeTexture)
 {
 	
 }
@@ -39,12 +40,7 @@ bool yang::SDLTexture::Init(SDL_Renderer* pRenderer, SDL_Surface* pSurface)
 
 bool yang::SDLTexture::SetTint(const IColor& color)
 {
-    if (SDL_SetTextureColorMod(m_pTexture.get(), color.Red(), color.Green(), color.Blue()))
-    {
-        LOG(Error, "Unable to tint texture. Error: %s", SDL_GetError());
-        return false;
-    }
-
+    // SDLRenderer applies the tint when the texture is drawn, the render thread may be drawing it right now
     m_tint = color;
     return true;
 }
@@ -57,15 +53,7 @@ bool yang::SDLTexture::SetTint(const FColor& color)
 
 bool yang::SDLTexture::SetAlpha(ui8 alpha)
 {
-    if (alpha == m_alpha * std::numeric_limits<ui8>::max())
-    {
-        return true;
-    }
-    if (SDL_SetTextureAlphaMod(m_pTexture.get(), alpha))
-    {
-        LOG(Error, "Unable to set alpha to a texture. Error: %s", SDL_GetError());
-        return false;
-    }
+    // SDLRenderer applies the alpha when the texture is drawn
     m_alpha = static_cast<float>(alpha) / std::numeric_limits<ui8>::max();
     return true;
 }
@@ -78,12 +66,12 @@ bool yang::SDLTexture::SetAlpha(float alpha)
 
 yang::SDLTexture::SDLTexture(SDL_Texture* pTexture)
 	:ITexture()
-	,m_pTexture(pTexture, &SDL_DestroyTexture)
+	,m_pTexture(pTexture, &SDLRendererBase::ReleaseNativeTexture)
 {
 }
 
 yang::SDLTexture::SDLTexture()
 	:ITexture()
-	, m_pTexture(nullptr, &SDL_DestroyTexture)
+	, m_pTexture(nullptr, &SDLRendererBase::ReleaseNativeTexture)
 {
 }
@@ -67,15 +67,14 @@ private:
 	// --------------------------------------------------------------------- //
 	// Private Member Variables
 	// --------------------------------------------------------------------- //
-	std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> m_pTexture;  ///< Actual SDL_Texture resource
+	std::unique_ptr<SDL_Texture, void(*)(SDL_Texture*)> m_pTexture;  ///< Actual SDL_Texture resource, released through SDLRendererBase::ReleaseNativeTexture
 
 	// --------------------------------------------------------------------- //
 	// Private Member Functions
 	// --------------------------------------------------------------------- //
 
-	// Making SDLRenderer and SDLFont a friend, so it has access to private constructor. Inevitable evil.
+	// Making SDLRenderer a friend, so it has access to private constructor. Inevitable evil.
 	friend class SDLRenderer;
-	friend class SDLFont;
 
 	/// Private constructor
 	/// \param pTexture - texture to construct with
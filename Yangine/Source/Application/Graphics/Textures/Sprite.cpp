@@ -1,4 +1,5 @@
 #include "Sprite.h"
+#include "TextureAtlas.h"
 #include <Application/Resources/ResourceCache.h>
 #include <Utils/Logger.h>
 #include <Utils/TinyXml2/tinyxml2.h>
@@ -14,14 +15,15 @@ bool yang::Sprite::Init(std::string_view pathToTexture, IRect sourceRect, Textur
 {
     if (auto pResourceCache = ResourceCache::Get(); pResourceCache != nullptr)
     {
-        m_pSourceTexture = pResourceCache->Load<ITexture>(pathToTexture.data());
+        IRect region;
+        m_pSourceTexture = TextureAtlas::Get()->LoadTexture(pathToTexture.data(), region);
         if (!m_pSourceTexture)
         {
             LOG(Error, "Unable to initialize sprite, ITexture was nullptr");
             return false;
         }
 
-        m_textureSourceRect = sourceRect;
+        m_textureSourceRect = TextureAtlas::ToPageRect(region, sourceRect);
         m_drawParams = params;
         return true;
     }
@@ -34,9 +36,22 @@ bool yang::Sprite::Init(tinyxml2::XMLElement* pData)
     using namespace tinyxml2;
 
     const char* pSourcePath = pData->Attribute("Src");
+    XMLElement* pTint = pData->FirstChildElement("Tint");
+    IRect region;
     if (pSourcePath)
     {
-        m_pSourceTexture = ResourceCache::Get()->Load<ITexture>(pSourcePath);
+        // Tint is set on the whole texture, a tinted sprite can't share an atlas page with others
+        if (pTint)
+        {
+            m_pSourceTexture = ResourceCache::Get()->Load<ITexture>(pSourcePath);
+            IVec2 textureDimensions = m_pSourceTexture ? m_pSourceTexture->GetDimensions() : IVec2(0, 0);
+            region = IRect(0, 0, textureDimensions.x, textureDimensions.y);
+        }
+        else
+        {
+            m_pSourceTexture = TextureAtlas::Get()->LoadTexture(pSourcePath, region);
+        }
+
         if (!m_pSourceTexture)
         {
             LOG(Error, "Failed to initialize sprite: texture failed to load");
@@ -49,7 +64,6 @@ bool yang::Sprite::Init(tinyxml2::XMLElement* pData)
         return false;
     }
 
-    XMLElement* pTint = pData->FirstChildElement("Tint");
     if (pTint)
     {
         IColor tint(pTint->IntAttribute("r"),
@@ -64,18 +78,12 @@ bool yang::Sprite::Init(tinyxml2::XMLElement* pData)
     XMLElement* pSourceRect = pData->FirstChildElement("SourceRect");
     if (pSourceRect)
     {
-        m_textureSourceRect.x = pSourceRect->IntAttribute("x");
-        m_textureSourceRect.y = pSourceRect->IntAttribute("y");
-        m_textureSourceRect.width = pSourceRect->IntAttribute("width");
-        m_textureSourceRect.height = pSourceRect->IntAttribute("height");
+        IRect sourceRect(pSourceRect->IntAttribute("x"), pSourceRect->IntAttribute("y"), pSourceRect->IntAttribute("width"), pSourceRect->IntAttribute("height"));
+        m_textureSourceRect = TextureAtlas::ToPageRect(region, sourceRect);
     }
     else
     {
-        auto textureDimensions = m_pSourceTexture->GetDimensions();
-        m_textureSourceRect.x = 0;
-        m_textureSourceRect.y = 0;
-        m_textureSourceRect.width = textureDimensions.x;
-        m_textureSourceRect.height = textureDimensions.y;
+        m_textureSourceRect = region;
         LOG(Warning, "No source rect for sprite specified. Using whole texture");
     }
 
@@ -0,0 +1,96 @@
+#include "TextureAtlas.h"
+#include "ITexture.h"
+#include <Application/Resources/ResourceCache.h>
+#include <Utils/BinaryXml.h>
+#include <Utils/Logger.h>
+#include <Utils/TinyXml2/tinyxml2.h>
+
+using yang::TextureAtlas;
+
+bool yang::TextureAtlas::Load(const char* scenePath)
+{
+    using namespace tinyxml2;
+
+    std::string atlasPath = std::string(scenePath) + kFileSuffix;
+    ResourceCache* pCache = ResourceCache::Get();
+    if (!pCache->HasResource(atlasPath.c_str()))
+        return false;
+
+    auto pResource = pCache->Load<IResource>(atlasPath.c_str());
+    if (!pResource)
+        return false;
+
+    XMLDocument doc;
+    XMLError error = LoadXmlDocument(pResource->GetData().data(), pResource->GetData().size(), doc);
+    if (error != XML_SUCCESS)
+    {
+        LOG(Error, "Failed to load texture atlas: %s -- %s", atlasPath.c_str(), XMLDocument::ErrorIDToName(error));
+        return false;
+    }
+
+    size_t pageCount = 0;
+    size_t textureCount = 0;
+    for (XMLElement* pPage = doc.RootElement()->FirstChildElement("Page"); pPage != nullptr; pPage = pPage->NextSiblingElement("Page"))
+    {
+        const char* pPageSource = pPage->Attribute("src");
+        if (!pPageSource)
+        {
+            LOG(Warning, "Texture atlas %s has a page without src. Skipping the page", atlasPath.c_str());
+            continue;
+        }
+
+        ++pageCount;
+        ResourceId pageId = pCache->InternPath(pPageSource);
+        for (XMLElement* pTexture = pPage->FirstChildElement("Texture"); pTexture != nullptr; pTexture = pTexture->NextSiblingElement("Texture"))
+        {
+            const char* pSource = pTexture->Attribute("src");
+            if (!pSource)
+            {
+                LOG(Warning, "Texture atlas %s has a texture without src. Skipping the texture", atlasPath.c_str());
+                continue;
+            }
+
+            ResourceId textureId = pCache->InternPath(pSource);
+            if (m_regions.Find(textureId))
+                continue;
+
+            IRect rect(pTexture->IntAttribute("x"), pTexture->IntAttribute("y"), pTexture->IntAttribute("width"), pTexture->IntAttribute("height"));
+            m_regions.Insert(textureId, Region{ pageId, rect });
+            ++textureCount;
+        }
+    }
+
+    LOG(Info, "Loaded texture atlas %s: %zu textures on %zu pages", atlasPath.c_str(), textureCount, pageCount);
+    return true;
+}
+
+std::shared_ptr<yang::ITexture> yang::TextureAtlas::LoadTexture(const char* filepath, IRect& region)
+{
+    ResourceCache* pCache = ResourceCache::Get();
+    ResourceId textureId = pCache->InternPath(filepath);
+
+    if (const Region* pRegion = Find(textureId); pRegion != nullptr)
+    {
+        if (auto pPage = pCache->Load<ITexture>(pRegion->m_pageId); pPage != nullptr)
+        {
+            region = pRegion->m_rect;
+            return pPage;
+        }
+
+        LOG(Warning, "Failed to load the atlas page of %s, loading the texture itself", filepath);
+    }
+
+    auto pTexture = pCache->Load<ITexture>(textureId);
+    if (pTexture)
+    {
+        IVec2 dimensions = pTexture->GetDimensions();
+        region = IRect(0, 0, dimensions.x, dimensions.y);
+    }
+    return pTexture;
+}
+
+/* static */ TextureAtlas* yang::TextureAtlas::Get()
+{
+    static TextureAtlas s_instance;
+    return &s_instance;
+}
@@ -0,0 +1,91 @@
+#pragma once
+/** \file TextureAtlas.h */
+/** Lookup of the textures packed into atlas pages */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Application/Resources/ResourceIdTable.h>
+#include <Utils/Rectangle.h>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+class ITexture;
+
+/** \class TextureAtlas */
+/** Singleton that knows which textures AssetCooker packed into atlas pages and where. Sprites and animations
+    load their textures through it, so a texture that was packed comes from its page and the source rects are moved
+    into the packed region, and every sprite of the page can be drawn in one texture batch. Textures that were not
+    packed load as usual. The atlas file of a scene is next to the scene file:
+    <TextureAtlas><Page src="..."><Texture src="..." x="" y="" width="" height=""/></Page></TextureAtlas> */
+class TextureAtlas
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+    static constexpr const char* kFileSuffix = ".atlas";     ///< Atlas file path is the scene file path with this suffix
+
+    /// \struct Region
+    /// Where a packed texture is
+    struct Region
+    {
+        ResourceId m_pageId;    ///< Resource ID of the page texture
+        IRect m_rect;           ///< Pixels of the packed texture on the page
+    };
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Reads the atlas file of the scene, if there is one, and adds its textures to the lookup.
+    /// A texture that is already in the lookup keeps its first region
+    /// \param scenePath - path to the scene file
+    /// \return true if the atlas file was read
+    bool Load(const char* scenePath);
+
+    /// Forgets every packed texture
+    void Clear() { m_regions.Clear(); }
+
+    /// Finds where the texture was packed
+    /// \param textureId - resource ID of the texture path
+    /// \return pointer to the region, or null if the texture was not packed
+    const Region* Find(ResourceId textureId) const { return m_isEnabled ? m_regions.Find(textureId) : nullptr; }
+
+    /// Loads the texture, or the page it was packed into
+    /// \param filepath - path to the texture
+    /// \param region - pixels of the texture on the returned one. The whole texture if it was not packed
+    /// \return the page or the texture, null if it failed to load
+    std::shared_ptr<ITexture> LoadTexture(const char* filepath, IRect& region);
+
+    /// Moves a rect in texture pixels into the region the texture was packed into
+    /// \param region - region returned from LoadTexture
+    /// \param sourceRect - rect relative to the texture
+    /// \return rect relative to the page
+    static IRect ToPageRect(const IRect& region, const IRect& sourceRect) { return IRect(region.x + sourceRect.x, region.y + sourceRect.y, sourceRect.width, sourceRect.height); }
+
+    /// Singleton getter
+    static TextureAtlas* Get();
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+    ResourceIdTable<Region> m_regions;      ///< Packed textures by the resource ID of their path
+    bool m_isEnabled = true;                ///< Should packed textures be loaded from their pages
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Set whether packed textures are loaded from their pages. Only affects textures loaded afterwards
+    void SetEnabled(bool isEnabled) { m_isEnabled = isEnabled; }
+
+    /// Get number of packed textures in the lookup
+    size_t GetTextureCount() const { return m_regions.GetSize(); }
+};
+}
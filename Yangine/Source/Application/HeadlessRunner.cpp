@@ -0,0 +1,303 @@
+#include "HeadlessRunner.h"
+#include <Application/ApplicationLayer.h>
+#include <Application/Graphics/HeadlessRenderer.h>
+#include <Application/Resources/ResourceCache.h>
+#include <Logic/Scene/Scene.h>
+#include <Utils/FrameProfiler.h>
+#include <Utils/Logger.h>
+#include <Utils/Random.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+using yang::HeadlessRunner;
+
+namespace
+{
+    // Returns the value of "--name=value" if the argument is that option
+    const char* GetOptionValue(const char* pArgument, const char* pPrefix)
+    {
+        size_t prefixLength = std::strlen(pPrefix);
+        return std::strncmp(pArgument, pPrefix, prefixLength) == 0 ? pArgument + prefixLength : nullptr;
+    }
+
+    // Metrics other than the profiler sections, in the order they are sampled
+    enum MetricIndex : size_t
+    {
+        kFrameTime,
+        kLatency,
+        kActors,
+        kDrawnActors,
+        kCulledActors,
+        kTextureQuads,
+        kTextureBatches,
+        kFirstSection
+    };
+}
+
+bool yang::HeadlessRunner::Options::ParseArgument(const char* pArgument)
+{
+    if (const char* pValue = GetOptionValue(pArgument, "--frames="))
+        m_frameCount = std::strtoull(pValue, nullptr, 10);
+    else if (const char* pValue = GetOptionValue(pArgument, "--dt="))
+        m_deltaSeconds = std::strtof(pValue, nullptr);
+    else if (const char* pValue = GetOptionValue(pArgument, "--scene="))
+        m_scenePath = pValue;
+    else if (const char* pValue = GetOptionValue(pArgument, "--input="))
+        m_inputPath = pValue;
+    else if (std::strcmp(pArgument, "--synthetic-input") == 0)
+        m_isSyntheticInput = true;
+    else if (const char* pValue = GetOptionValue(pArgument, "--seed="))
+        m_seed = std::strtoull(pValue, nullptr, 10);
+    else if (const char* pValue = GetOptionValue(pArgument, "--stats="))
+        m_statsPath = pValue;
+    else if (std::strcmp(pArgument, "--render-thread") == 0)
+        m_isRenderThread = true;
+    else
+        return false;
+
+    return true;
+}
+
+yang::HeadlessRunner::HeadlessRunner(const Options& options)
+    : m_options(options)
+{
+
+}
+
+bool yang::HeadlessRunner::Run(ApplicationLayer& app)
+{
+    IGameLayer* pGameLayer = app.GetGameLayer();
+    IWindow* pWindow = app.GetWindow();
+    if (!pGameLayer || !pWindow)
+    {
+        LOG(Error, "Headless runner needs an initialized application");
+        return false;
+    }
+
+    if (m_options.m_deltaSeconds <= 0.f)
+    {
+        LOG(Error, "Headless runner delta has to be positive, got %f", m_options.m_deltaSeconds);
+        return false;
+    }
+
+    XorshiftRNG::GlobalRNG.Seed(m_options.m_seed);
+
+    if (!m_options.m_inputPath.empty())
+    {
+        if (!m_input.Load(m_options.m_inputPath))
+            return false;
+    }
+    else if (m_options.m_isSyntheticInput)
+    {
+        m_input.GenerateSynthetic(m_options.m_seed, m_options.m_frameCount, app.GetWindowDimensions());
+    }
+
+    if (!m_options.m_scenePath.empty() && !pGameLayer->LoadSceneAndSwitch(m_options.m_scenePath))
+    {
+        LOG(Error, "Headless runner failed to load scene %s", m_options.m_scenePath.c_str());
+        return false;
+    }
+
+    m_metrics.clear();
+    for (const char* pName : { "frame_ms", "latency_ms", "actors", "drawn_actors", "culled_actors", "texture_quads", "texture_batches" })
+    {
+        m_metrics.push_back(Metric{ pName, {} });
+    }
+    for (size_t section = 0; section < static_cast<size_t>(FrameProfiler::Section::kMaxSections); ++section)
+    {
+        m_metrics.push_back(Metric{ std::string(FrameProfiler::GetSectionName(static_cast<FrameProfiler::Section>(section))) + "_ms", {} });
+    }
+    for (Metric& metric : m_metrics)
+    {
+        metric.m_values.reserve(m_options.m_frameCount);
+    }
+
+    // The application only knows it is headless, the graphics are the HeadlessRenderer then
+    HeadlessRenderer* pHeadlessRenderer = app.IsHeadless() ? static_cast<HeadlessRenderer*>(app.GetGraphics()) : nullptr;
+    FrameProfiler* pProfiler = FrameProfiler::Get();
+    pProfiler->SetEnabled(true);
+
+    IGraphics* pGraphics = app.GetGraphics();
+    if (m_options.m_isRenderThread)
+    {
+        pGraphics->SetRenderThreadEnabled(true);
+    }
+
+    LOG(Info, "Headless run: %zu frames of %.4f s, %zu input changes", m_options.m_frameCount, m_options.m_deltaSeconds, m_input.GetChangeCount());
+
+    using Clock = FrameProfiler::Clock;
+    Clock::time_point runStart = Clock::now();
+
+    size_t frame = 0;
+    for (; frame < m_options.m_frameCount && pWindow->ProcessEvents(); ++frame)
+    {
+        Clock::time_point frameStart = Clock::now();
+        pProfiler->BeginFrame();
+
+        m_input.Replay(frame, app.GetKeyboard(), app.GetMouse());
+
+        {
+            FrameProfiler::ScopedSection section(FrameProfiler::Section::kResources);
+            ResourceCache::Get()->ProcessAsyncLoads();
+        }
+
+        pGameLayer->Update(m_options.m_deltaSeconds);
+
+        {
+            FrameProfiler::ScopedSection section(FrameProfiler::Section::kResources);
+            ResourceCache::Get()->TrimToBudget();
+        }
+
+        pWindow->NextFrame();
+
+        m_metrics[kFrameTime].m_values.push_back(std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count());
+        m_metrics[kLatency].m_values.push_back(pGraphics->GetLastFrameLatency());
+
+        std::shared_ptr<Scene> pScene = pGameLayer->GetCurrentScene();
+        m_metrics[kActors].m_values.push_back(pScene ? static_cast<double>(pScene->GetActors().size()) : 0.0);
+        m_metrics[kDrawnActors].m_values.push_back(pScene ? static_cast<double>(pScene->GetDrawnActorCount()) : 0.0);
+        m_metrics[kCulledActors].m_values.push_back(pScene ? static_cast<double>(pScene->GetCulledActorCount()) : 0.0);
+
+        // With the render thread these are the counters of the previous frame
+        HeadlessRenderer::Counters counters = pHeadlessRenderer ? pHeadlessRenderer->GetLastFrameCounters() : HeadlessRenderer::Counters();
+        m_metrics[kTextureQuads].m_values.push_back(static_cast<double>(counters.m_textureQuadCount));
+        m_metrics[kTextureBatches].m_values.push_back(static_cast<double>(counters.m_textureBatchCount));
+
+        for (size_t section = 0; section < static_cast<size_t>(FrameProfiler::Section::kMaxSections); ++section)
+        {
+            m_metrics[kFirstSection + section].m_values.push_back(pProfiler->GetSectionTime(static_cast<FrameProfiler::Section>(section)));
+        }
+    }
+
+    // The last frame is presented before the run counts as done
+    if (m_options.m_isRenderThread)
+    {
+        pGraphics->SetRenderThreadEnabled(false);
+    }
+    m_wallSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+    pProfiler->SetEnabled(false);
+
+    double simulatedSeconds = static_cast<double>(frame) * m_options.m_deltaSeconds;
+    LOG(Stats, "Headless run: %zu frames, %.2f s simulated in %.2f s, %.1fx realtime", frame, simulatedSeconds, m_wallSeconds,
+        m_wallSeconds > 0.0 ? simulatedSeconds / m_wallSeconds : 0.0);
+    LogStats();
+
+    bool isSuccess = (frame == m_options.m_frameCount);
+    if (!isSuccess)
+    {
+        LOG(Warning, "Headless run stopped after %zu of %zu frames", frame, m_options.m_frameCount);
+    }
+
+    const std::string& statsPath = m_options.m_statsPath;
+    if (!statsPath.empty())
+    {
+        constexpr std::string_view kJsonExtension = ".json";
+        bool isJson = statsPath.size() >= kJsonExtension.size() && statsPath.compare(statsPath.size() - kJsonExtension.size(), kJsonExtension.size(), kJsonExtension) == 0;
+        isSuccess = (isJson ? WriteJson(statsPath) : WriteCsv(statsPath)) && isSuccess;
+    }
+
+    return isSuccess;
+}
+
+HeadlessRunner::Summary yang::HeadlessRunner::Summarize(const std::vector<double>& values)
+{
+    Summary summary;
+    if (values.empty())
+        return summary;
+
+    std::vector<double> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+
+    auto percentile = [&sorted](double fraction)
+    {
+        size_t rank = static_cast<size_t>(fraction * static_cast<double>(sorted.size()) + 0.999999);
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    };
+
+    double sum = 0.0;
+    for (double value : sorted)
+    {
+        sum += value;
+    }
+
+    summary.m_mean = sum / static_cast<double>(sorted.size());
+    summary.m_p50 = percentile(0.5);
+    summary.m_p90 = percentile(0.9);
+    summary.m_p99 = percentile(0.99);
+    summary.m_max = sorted.back();
+    return summary;
+}
+
+void yang::HeadlessRunner::LogStats() const
+{
+    for (const Metric& metric : m_metrics)
+    {
+        Summary summary = Summarize(metric.m_values);
+        LOG(Stats, "%-24s mean %10.4f  p50 %10.4f  p90 %10.4f  p99 %10.4f  max %10.4f", metric.m_name.c_str(),
+            summary.m_mean, summary.m_p50, summary.m_p90, summary.m_p99, summary.m_max);
+    }
+}
+
+bool yang::HeadlessRunner::WriteCsv(const std::string& filepath) const
+{
+    std::ofstream outFile(filepath, std::ios::out | std::ios::trunc);
+    if (!outFile.good())
+    {
+        LOG(Error, "Unable to write stats to %s", filepath.c_str());
+        return false;
+    }
+
+    outFile << "metric,mean,p50,p90,p99,max\n";
+    for (const Metric& metric : m_metrics)
+    {
+        Summary summary = Summarize(metric.m_values);
+        outFile << metric.m_name << ',' << summary.m_mean << ',' << summary.m_p50 << ',' << summary.m_p90 << ','
+            << summary.m_p99 << ',' << summary.m_max << '\n';
+    }
+
+    LOG(Info, "Wrote stats to %s", filepath.c_str());
+    return outFile.good();
+}
+
+bool yang::HeadlessRunner::WriteJson(const std::string& filepath) const
+{
+    std::ofstream outFile(filepath, std::ios::out | std::ios::trunc);
+    if (!outFile.good())
+    {
+        LOG(Error, "Unable to write stats to %s", filepath.c_str());
+        return false;
+    }
+
+    size_t frameCount = m_metrics.empty() ? 0 : m_metrics.front().m_values.size();
+    outFile << "{\n  \"frames\": " << frameCount << ",\n  \"delta_seconds\": " << m_options.m_deltaSeconds
+        << ",\n  \"wall_seconds\": " << m_wallSeconds << ",\n  \"seed\": " << m_options.m_seed
+        << ",\n  \"render_thread\": " << (m_options.m_isRenderThread ? "true" : "false") << ",\n  \"summary\": {\n";
+
+    for (size_t i = 0; i < m_metrics.size(); ++i)
+    {
+        Summary summary = Summarize(m_metrics[i].m_values);
+        outFile << "    \"" << m_metrics[i].m_name << "\": { \"mean\": " << summary.m_mean << ", \"p50\": " << summary.m_p50
+            << ", \"p90\": " << summary.m_p90 << ", \"p99\": " << summary.m_p99 << ", \"max\": " << summary.m_max << " }"
+            << (i + 1 < m_metrics.size() ? ",\n" : "\n");
+    }
+
+    outFile << "  },\n  \"per_frame\": {\n";
+    for (size_t i = 0; i < m_metrics.size(); ++i)
+    {
+        outFile << "    \"" << m_metrics[i].m_name << "\": [";
+        const std::vector<double>& values = m_metrics[i].m_values;
+        for (size_t frame = 0; frame < values.size(); ++frame)
+        {
+            outFile << (frame > 0 ? "," : "") << values[frame];
+        }
+        outFile << (i + 1 < m_metrics.size() ? "],\n" : "]\n");
+    }
+    outFile << "  }\n}\n";
+
+    LOG(Info, "Wrote stats to %s", filepath.c_str());
+    return outFile.good();
+}
@@ -0,0 +1,111 @@
+#pragma once
+/** \file HeadlessRunner.h */
+/** Fixed step simulation runner for load testing */
+
+#include <Application/Input/InputStream.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+    class ApplicationLayer;
+
+/** \class HeadlessRunner */
+/** Steps the game layer a fixed number of frames with a fixed delta as fast as possible, replaying a recorded
+    or synthetic input stream, and reports the frame time and present latency percentiles, the time of every engine system (\see FrameProfiler)
+    and the actor and draw counts. The stats are logged and written as CSV (summary table) or JSON (summary and every frame).
+    Selected with --frames on the command line, which also makes the application headless */
+class HeadlessRunner
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+    /// \struct Options
+    /// What to run and where to write the stats
+    struct Options
+    {
+        size_t m_frameCount = 0;                ///< Frames to run, 0 when the runner is not used
+        float m_deltaSeconds = 1.f / 60.f;      ///< Delta passed to every update
+        std::string m_scenePath;                ///< Scene to load and switch to before the first frame, empty to keep the one the game starts with
+        std::string m_inputPath;                ///< Input stream to replay, empty for none
+        bool m_isSyntheticInput = false;        ///< Generate the input stream from m_seed when no stream is given
+        uint64_t m_seed = 1;                    ///< Seed of the global random generator and of the synthetic input
+        std::string m_statsPath;                ///< File to write the stats to, JSON if it ends with .json and CSV otherwise. Empty to only log them
+        bool m_isRenderThread = false;          ///< Submit the frames on the render thread, to compare frame time and latency with the single thread
+
+        /// Reads a runner command line option: --frames=N, --dt=seconds, --scene=path, --input=path, --synthetic-input, --seed=N, --stats=path,
+        /// --render-thread
+        /// \param pArgument - command line argument
+        /// \return true if the argument was a runner option
+        bool ParseArgument(const char* pArgument);
+    };
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Constructor
+    /// \param options - what to run
+    HeadlessRunner(const Options& options);
+
+    /// Runs the frames and reports the stats
+    /// \param app - initialized application
+    /// \return true if every frame ran and the stats were written
+    bool Run(ApplicationLayer& app);
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+
+    /// \struct Metric
+    /// Value of every frame of one measurement
+    struct Metric
+    {
+        std::string m_name;             ///< Name in the stats outputs
+        std::vector<double> m_values;   ///< Value of every frame
+    };
+
+    /// \struct Summary
+    /// Distribution of a metric over the run
+    struct Summary
+    {
+        double m_mean = 0.0;            ///< Average value
+        double m_p50 = 0.0;             ///< Median
+        double m_p90 = 0.0;             ///< 90th percentile
+        double m_p99 = 0.0;             ///< 99th percentile
+        double m_max = 0.0;             ///< Largest value
+    };
+
+    Options m_options;                  ///< What to run
+    InputStream m_input;                ///< Input replayed into the keyboard and mouse
+    std::vector<Metric> m_metrics;      ///< Frame time, system times, actor and draw counts
+    double m_wallSeconds = 0.0;         ///< Real time the frames took
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Computes the distribution of the values with the nearest rank percentiles
+    static Summary Summarize(const std::vector<double>& values);
+
+    /// Logs the summary of every metric
+    void LogStats() const;
+
+    /// Writes the summary table, one metric per row
+    bool WriteCsv(const std::string& filepath) const;
+
+    /// Writes the run parameters, the summaries and the values of every frame
+    bool WriteJson(const std::string& filepath) const;
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+};
+}
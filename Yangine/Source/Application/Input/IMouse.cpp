@@ -67,7 +67,7 @@ void yang::IMouse::ProcessWheelEvent(bool isNormal, i32 horizontalAmount, i32 ve
     EventDispatcher* pDispatcher = EventDispatcher::Get();
     assert(pDispatcher);
 
-    pDispatcher->TriggerEvent(std::make_unique<MouseWheelEvent>(IVec2(horizontalAmount, verticalAmount)));
+    pDispatcher->TriggerEvent(std::make_unique<MouseWheelEvent>(IVec2(horizontalAmount, verticalAmount), m_position));
 }
 
 std::unique_ptr<IMouse> yang::IMouse::Create()
@@ -0,0 +1,192 @@
+#include "InputStream.h"
+#include <Utils/Logger.h>
+#include <Utils/Random.h>
+#include <fstream>
+#include <sstream>
+
+using yang::InputStream;
+
+namespace
+{
+    // Keys most games bind, the synthetic streams press them
+    constexpr yang::IKeyboard::KeyCode kSyntheticKeys[] =
+    {
+        yang::IKeyboard::KeyCode::kUP, yang::IKeyboard::KeyCode::kDOWN, yang::IKeyboard::KeyCode::kLEFT, yang::IKeyboard::KeyCode::kRIGHT,
+        yang::IKeyboard::KeyCode::kW, yang::IKeyboard::KeyCode::kA, yang::IKeyboard::KeyCode::kS, yang::IKeyboard::KeyCode::kD,
+        yang::IKeyboard::KeyCode::kSPACE
+    };
+    constexpr size_t kSyntheticKeyCount = sizeof(kSyntheticKeys) / sizeof(kSyntheticKeys[0]);
+
+    // Chance per frame, in percent, of every kind of synthetic change
+    constexpr uint32_t kKeyToggleChance = 10;
+    constexpr uint32_t kMouseMoveChance = 25;
+    constexpr uint32_t kButtonToggleChance = 3;
+}
+
+bool yang::InputStream::Load(const std::string& filepath)
+{
+    std::ifstream inFile(filepath);
+    if (!inFile.good())
+    {
+        LOG(Error, "Unable to open input stream %s", filepath.c_str());
+        return false;
+    }
+
+    m_changes.clear();
+    m_replayIndex = 0;
+
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(inFile, line))
+    {
+        ++lineNumber;
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream lineStream(line);
+        Change change;
+        std::string type;
+        if (!(lineStream >> change.m_frame >> type >> change.m_code >> change.m_value))
+        {
+            LOG(Error, "Malformed line %zu in input stream %s", lineNumber, filepath.c_str());
+            return false;
+        }
+
+        if (type == "key")
+            change.m_type = ChangeType::kKey;
+        else if (type == "button")
+            change.m_type = ChangeType::kButton;
+        else if (type == "move")
+            change.m_type = ChangeType::kMove;
+        else
+        {
+            LOG(Error, "Unknown change '%s' on line %zu in input stream %s", type.c_str(), lineNumber, filepath.c_str());
+            return false;
+        }
+
+        if (!m_changes.empty() && change.m_frame < m_changes.back().m_frame)
+        {
+            LOG(Error, "Line %zu in input stream %s goes back in frames", lineNumber, filepath.c_str());
+            return false;
+        }
+
+        m_changes.push_back(change);
+    }
+
+    LOG(Info, "Loaded %zu input changes from %s", m_changes.size(), filepath.c_str());
+    return true;
+}
+
+bool yang::InputStream::Save(const std::string& filepath) const
+{
+    std::ofstream outFile(filepath, std::ios::out | std::ios::trunc);
+    if (!outFile.good())
+    {
+        LOG(Error, "Unable to write input stream %s", filepath.c_str());
+        return false;
+    }
+
+    outFile << "# frame key <KeyCode> <0|1> | frame button <MouseButton> <0|1> | frame move <x> <y>\n";
+    for (const Change& change : m_changes)
+    {
+        const char* pType = change.m_type == ChangeType::kKey ? "key" : (change.m_type == ChangeType::kButton ? "button" : "move");
+        outFile << change.m_frame << ' ' << pType << ' ' << change.m_code << ' ' << change.m_value << '\n';
+    }
+
+    return outFile.good();
+}
+
+void yang::InputStream::GenerateSynthetic(uint64_t seed, size_t frameCount, IVec2 screenSize)
+{
+    m_changes.clear();
+    m_replayIndex = 0;
+
+    XorshiftRNG rng(seed);
+    bool keyStates[kSyntheticKeyCount] = {};
+    bool isButtonDown = false;
+    for (size_t frame = 0; frame < frameCount; ++frame)
+    {
+        if (rng.Rand<uint32_t>(100) < kKeyToggleChance)
+        {
+            size_t keyIndex = rng.Rand<size_t>(kSyntheticKeyCount);
+            keyStates[keyIndex] = !keyStates[keyIndex];
+            m_changes.push_back(Change{ frame, ChangeType::kKey, static_cast<int>(kSyntheticKeys[keyIndex]), keyStates[keyIndex] ? 1 : 0 });
+        }
+
+        if (rng.Rand<uint32_t>(100) < kMouseMoveChance && screenSize.x > 0 && screenSize.y > 0)
+        {
+            m_changes.push_back(Change{ frame, ChangeType::kMove, rng.Rand<int>(screenSize.x), rng.Rand<int>(screenSize.y) });
+        }
+
+        if (rng.Rand<uint32_t>(100) < kButtonToggleChance)
+        {
+            isButtonDown = !isButtonDown;
+            m_changes.push_back(Change{ frame, ChangeType::kButton, static_cast<int>(IMouse::MouseButton::kLeft), isButtonDown ? 1 : 0 });
+        }
+    }
+}
+
+void yang::InputStream::Record(size_t frame, IKeyboard* pKeyboard, IMouse* pMouse)
+{
+    if (pKeyboard)
+    {
+        for (int code = 0; code < static_cast<int>(IKeyboard::KeyCode::kMaxCodes); ++code)
+        {
+            IKeyboard::KeyCode key = static_cast<IKeyboard::KeyCode>(code);
+            if (pKeyboard->IsKeyPressed(key) || pKeyboard->IsKeyReleased(key))
+            {
+                m_changes.push_back(Change{ frame, ChangeType::kKey, code, pKeyboard->IsKeyDown(key) ? 1 : 0 });
+            }
+        }
+    }
+
+    if (pMouse)
+    {
+        for (int code = 0; code < static_cast<int>(IMouse::MouseButton::kMaxButtons); ++code)
+        {
+            IMouse::MouseButton button = static_cast<IMouse::MouseButton>(code);
+            if (pMouse->IsButtonPressed(button) || pMouse->IsButtonReleased(button))
+            {
+                m_changes.push_back(Change{ frame, ChangeType::kButton, code, pMouse->IsButtonDown(button) ? 1 : 0 });
+            }
+        }
+
+        IVec2 position = pMouse->GetMousePosition();
+        if (!(position == m_lastMousePosition))
+        {
+            m_changes.push_back(Change{ frame, ChangeType::kMove, position.x, position.y });
+            m_lastMousePosition = position;
+        }
+    }
+}
+
+void yang::InputStream::Replay(size_t frame, IKeyboard* pKeyboard, IMouse* pMouse)
+{
+    for (; m_replayIndex < m_changes.size() && m_changes[m_replayIndex].m_frame <= frame; ++m_replayIndex)
+    {
+        const Change& change = m_changes[m_replayIndex];
+        switch (change.m_type)
+        {
+        case ChangeType::kKey:
+            if (pKeyboard && change.m_code >= 0 && change.m_code < static_cast<int>(IKeyboard::KeyCode::kMaxCodes))
+            {
+                pKeyboard->SetKeyState(static_cast<IKeyboard::KeyCode>(change.m_code), change.m_value != 0);
+            }
+            break;
+        case ChangeType::kButton:
+            if (pMouse && change.m_code >= 0 && change.m_code < static_cast<int>(IMouse::MouseButton::kMaxButtons))
+            {
+                pMouse->SetButtonState(static_cast<IMouse::MouseButton>(change.m_code), change.m_value != 0);
+            }
+            break;
+        case ChangeType::kMove:
+            if (pMouse)
+            {
+                pMouse->SetMousePosition(change.m_code, change.m_value);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+/** \file InputStream.h */
+/** Recorded keyboard and mouse input, frame by frame */
+
+#include <Application/Input/IKeyboard.h>
+#include <Application/Input/IMouse.h>
+#include <Utils/Vector2.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \class InputStream */
+/** Keyboard and mouse changes tagged with the frame they happened on. A stream is recorded from a live run,
+    loaded from a file or generated from a seed, and replayed into the keyboard and mouse to reproduce a run.
+    The file is text, one change per line: "<frame> key <KeyCode> <0|1>", "<frame> button <MouseButton> <0|1>"
+    or "<frame> move <x> <y>". Lines starting with '#' are comments */
+class InputStream
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Loads the changes from a file, replacing the current ones
+    /// \param filepath - path to the stream file
+    /// \return true if successfully loaded
+    bool Load(const std::string& filepath);
+
+    /// Writes the changes to a file
+    /// \param filepath - path to the stream file
+    /// \return true if successfully saved
+    bool Save(const std::string& filepath) const;
+
+    /// Generates random presses and releases of the arrows, WASD and space, mouse moves and clicks, replacing the current changes.
+    /// The same seed always generates the same stream
+    /// \param seed - seed of the generator
+    /// \param frameCount - number of frames to generate changes for
+    /// \param screenSize - mouse positions are generated inside of it
+    void GenerateSynthetic(uint64_t seed, size_t frameCount, IVec2 screenSize);
+
+    /// Appends the changes of the keyboard and the mouse since the previous recorded frame
+    /// \param frame - frame the input belongs to
+    /// \param pKeyboard - keyboard to record, can be null
+    /// \param pMouse - mouse to record, can be null
+    void Record(size_t frame, IKeyboard* pKeyboard, IMouse* pMouse);
+
+    /// Applies the changes of the frame to the keyboard and the mouse. Frames have to be replayed in order
+    /// \param frame - frame to replay
+    /// \param pKeyboard - keyboard to change, can be null
+    /// \param pMouse - mouse to change, can be null
+    void Replay(size_t frame, IKeyboard* pKeyboard, IMouse* pMouse);
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+
+    /// \enum ChangeType
+    /// What a change does
+    enum class ChangeType : uint8_t
+    {
+        kKey,       ///< Key pressed or released
+        kButton,    ///< Mouse button pressed or released
+        kMove       ///< Mouse moved
+    };
+
+    /// \struct Change
+    /// One input change
+    struct Change
+    {
+        size_t m_frame;         ///< Frame the change happens on
+        ChangeType m_type;      ///< What the change does
+        int m_code;             ///< KeyCode or MouseButton, the x position for moves
+        int m_value;            ///< 1 for pressed and 0 for released, the y position for moves
+    };
+
+    std::vector<Change> m_changes;          ///< Changes ordered by frame
+    size_t m_replayIndex = 0;               ///< Next change to replay
+    IVec2 m_lastMousePosition;              ///< Mouse position of the previous recorded frame
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Get number of changes in the stream
+    size_t GetChangeCount() const { return m_changes.size(); }
+};
+}
@@ -3,7 +3,11 @@
 
 // Option 1: Use 'full path'
 // Option 2: Use 'relative path'
+#ifdef _WIN32
 #include "Win32Sys.h"
+#else
+#include "PosixSys.h"
+#endif
 
 using yang::IOpSys;
 
@@ -22,8 +26,7 @@ std::unique_ptr<IOpSys> yang::IOpSys::Create()
 #ifdef _WIN32
 	return std::make_unique<Win32Sys>();
 #else
-	//TODO: ERROR
-	return nullptr;
+	return std::make_unique<PosixSys>();
 #endif
 }
 
@@ -0,0 +1,124 @@
+// Windows builds use Win32Sys, this file only builds on the POSIX systems
+#ifndef _WIN32
+
+#include "PosixSys.h"
+
+#include <Application/Window/SDLWindow.h>
+#include <Utils/Logger.h>
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sys/statvfs.h>
+#include <unistd.h>
+
+using yang::PosixSys;
+
+PosixSys::PosixSys()
+{
+
+}
+
+PosixSys::~PosixSys()
+{
+
+}
+
+const char* yang::PosixSys::GetSystemName() const
+{
+#if defined(__linux__)
+    return "Linux";
+#elif defined(__APPLE__)
+    return "macOS";
+#else
+    return "POSIX";
+#endif
+}
+
+void yang::PosixSys::SetConsoleColor(ConsoleColor color, ColorIntensity intensity) const
+{
+	int consoleColor = kConsoleColors[static_cast<size_t>(color)];
+
+	if (intensity == ColorIntensity::kLight)
+		consoleColor += 60;
+
+    std::cout << "\033[" << consoleColor << 'm';
+}
+
+yang::PosixSys::MemoryInfo yang::PosixSys::GetMemoryInfo() const
+{
+    long pageSize = sysconf(_SC_PAGESIZE);
+    long totalPages = sysconf(_SC_PHYS_PAGES);
+    if (pageSize <= 0 || totalPages <= 0)
+    {
+        LOG(Error, "Unable to retrieve memory information. Error: %s", std::strerror(errno));
+        return { 0,0,0 };
+    }
+
+    uint64_t totalMemory = static_cast<uint64_t>(totalPages) * static_cast<uint64_t>(pageSize) / (1024 * 1024);
+
+    // Not every system reports the available pages, the load is unknown then
+#ifdef _SC_AVPHYS_PAGES
+    long availablePages = sysconf(_SC_AVPHYS_PAGES);
+    uint64_t availableMemory = availablePages > 0 ? static_cast<uint64_t>(availablePages) * static_cast<uint64_t>(pageSize) / (1024 * 1024) : 0;
+#else
+    uint64_t availableMemory = 0;
+#endif
+
+    uint8_t memoryLoad = (availableMemory > 0 && totalMemory > 0) ? static_cast<uint8_t>(100 - availableMemory * 100 / totalMemory) : 0;
+    return { memoryLoad, totalMemory, availableMemory };
+}
+
+std::vector<yang::PosixSys::HDDInfo> yang::PosixSys::GetHDDInfo() const
+{
+    struct statvfs buffer;
+    if (statvfs(".", &buffer) != 0)
+    {
+        LOG(Error, "Unable to retrieve HDD space. Error: %s", std::strerror(errno));
+        return {};
+    }
+
+    uint64_t blockSize = static_cast<uint64_t>(buffer.f_frsize);
+    return { { '/', static_cast<uint64_t>(buffer.f_blocks) * blockSize / (1024 * 1024), static_cast<uint64_t>(buffer.f_bavail) * blockSize / (1024 * 1024) } };
+}
+
+void yang::PosixSys::ListDirectory(const char* directory, bool recursive) const
+{
+    namespace fs = std::filesystem;
+
+    std::error_code error;
+    fs::path root = directory ? fs::path(directory) : fs::current_path(error);
+    if (recursive)
+    {
+        for (const fs::directory_entry& entry : fs::recursive_directory_iterator(root, error))
+        {
+            std::cout << entry.path().string() << '\n';
+        }
+    }
+    else
+    {
+        for (const fs::directory_entry& entry : fs::directory_iterator(root, error))
+        {
+            std::cout << entry.path().filename().string() << '\n';
+        }
+    }
+
+    if (error)
+    {
+        LOG(Error, "Unable to list directory %s. Error: %s", root.string().c_str(), error.message().c_str());
+    }
+}
+
+std::unique_ptr<yang::IWindow> yang::PosixSys::CreateSystemWindow(const char* title, uint32_t width, uint32_t height)
+{
+	std::unique_ptr<IWindow> pWindow = std::make_unique<SDLWindow>();
+	if (pWindow->Init(title, width, height) == false)
+	{
+		LOG(Error, "yang::PosixSys::CreateSystemWindow failed! Error: %s", SDL_GetError());
+		return nullptr;
+	}
+	return pWindow;
+}
+
+#endif
@@ -0,0 +1,90 @@
+#pragma once
+/** \file PosixSys.h */
+/** POSIX OS object specialization for IOpSys */
+
+#include "IOpSys.h"
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \class PosixSys */
+/** POSIX OS object specialization for IOpSys. Lets the engine start on Linux and macOS, mainly for the headless
+    load test runs on build machines. Console colors are ANSI escape codes */
+class PosixSys
+	: public IOpSys
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+	/** Default Constructor */
+	PosixSys();
+
+	/** Default Destructor */
+	~PosixSys();
+
+    /// Request window creation
+    /// \param title The title of the window
+    /// \param width The width of the window (in pixels)
+    /// \param height The height of the window (in pixels)
+    /// \return Unique pointer to the window
+	virtual std::unique_ptr<IWindow> CreateSystemWindow(const char* title, uint32_t width, uint32_t height) override final;
+
+	/// Return the name of operating system
+    /// \return "Linux", "macOS" or "POSIX"
+	virtual const char* GetSystemName() const override final;
+
+    /// Return the information about system RAM
+    /// \return RAM information. \see yang::IOpSys::MemoryInfo
+	virtual MemoryInfo GetMemoryInfo() const override final;
+
+    /// Return the information about the file system of the working directory. The drive letter is '/'
+    /// \return Vector of HDD information. \see yang::IOpSys::HDDInfo
+	virtual std::vector<HDDInfo> GetHDDInfo() const override final;
+
+    /// List the contents of the directory in the console. For debug purposes
+    /// \param directory - path to a directory
+    /// \param recursive - if true also lists the contents of subdirectories
+    virtual void ListDirectory(const char* directory, bool recursive) const override final;
+
+    /// Set the console text color
+    /// \param color - Color to set
+    /// \param intensity - Color intensity to set
+	virtual void SetConsoleColor(ConsoleColor color, ColorIntensity intensity) const override final;
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+
+    /// Array that handles conversion from the ConsoleColor to the ANSI foreground color code. Light colors add 60
+	static constexpr int kConsoleColors[static_cast<size_t>(ConsoleColor::MAX_COLORS)] =
+	{
+		30,
+		31,
+		32,
+		34,
+		33,
+		36,
+		35,
+		37
+	};
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+
+};
+}
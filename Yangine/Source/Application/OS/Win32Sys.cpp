@@ -1,3 +1,6 @@
+// POSIX builds use PosixSys, this file only builds on Windows
+#ifdef _WIN32
+
 #include "Win32Sys.h"
 
 #include <Application/Window/SDLWindow.h>
@@ -103,3 +106,5 @@ std::unique_ptr<yang::IWindow> yang::Win32Sys::CreateSystemWindow(const char* ti
 	}
 	return pWindow;
 }
+
+#endif
@@ -0,0 +1,95 @@
+#include "MappedFile.h"
+#include <Utils/Logger.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using yang::MappedFile;
+
+MappedFile::MappedFile()
+    :m_pData(nullptr)
+    ,m_size(0)
+#ifdef _WIN32
+    ,m_fileHandle(INVALID_HANDLE_VALUE)
+    ,m_mappingHandle(nullptr)
+#endif
+{
+
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+    if (m_pData)
+        UnmapViewOfFile(m_pData);
+    if (m_mappingHandle)
+        CloseHandle(m_mappingHandle);
+    if (m_fileHandle != INVALID_HANDLE_VALUE)
+        CloseHandle(m_fileHandle);
+#else
+    if (m_pData)
+        munmap(const_cast<std::byte*>(m_pData), m_size);
+#endif
+}
+
+std::shared_ptr<MappedFile> yang::MappedFile::Open(const char* filepath)
+{
+    // Private constructor, so no make_shared
+    std::shared_ptr<MappedFile> pFile(new MappedFile());
+
+#ifdef _WIN32
+    pFile->m_fileHandle = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (pFile->m_fileHandle == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(pFile->m_fileHandle, &fileSize) || fileSize.QuadPart == 0)
+        return nullptr;
+
+    pFile->m_size = static_cast<size_t>(fileSize.QuadPart);
+    pFile->m_mappingHandle = CreateFileMappingA(pFile->m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!pFile->m_mappingHandle)
+    {
+        LOG(Warning, "Unable to create file mapping for %s. Error code: %lu", filepath, GetLastError());
+        return nullptr;
+    }
+
+    pFile->m_pData = static_cast<const std::byte*>(MapViewOfFile(pFile->m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+#else
+    int fileDescriptor = open(filepath, O_RDONLY);
+    if (fileDescriptor < 0)
+        return nullptr;
+
+    struct stat fileStat;
+    if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        close(fileDescriptor);
+        return nullptr;
+    }
+
+    pFile->m_size = static_cast<size_t>(fileStat.st_size);
+    void* pMapping = mmap(nullptr, pFile->m_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+    // The mapping keeps its own reference to the file
+    close(fileDescriptor);
+
+    if (pMapping != MAP_FAILED)
+    {
+        pFile->m_pData = static_cast<const std::byte*>(pMapping);
+    }
+#endif
+
+    if (!pFile->m_pData)
+    {
+        LOG(Warning, "Unable to map %s into memory", filepath);
+        return nullptr;
+    }
+
+    return pFile;
+}
@@ -0,0 +1,61 @@
+#pragma once
+/** \file MappedFile.h */
+/** Read-only memory mapped file */
+
+#include <memory>
+#include <cstddef>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \class MappedFile */
+/** Read-only memory mapping of a whole file. Lets resources hand the file contents to parsers without copying them */
+class MappedFile
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /** Default Destructor. Unmaps the file */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Maps the file into memory
+    /// \param filepath - path to the file
+    /// \return shared pointer to the mapping, or null if the file can't be mapped (including empty files)
+    static std::shared_ptr<MappedFile> Open(const char* filepath);
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+    const std::byte* m_pData;       ///< Start of the mapped view
+    size_t m_size;                  ///< Size of the file in bytes
+
+#ifdef _WIN32
+    void* m_fileHandle;             ///< Win32 file handle
+    void* m_mappingHandle;          ///< Win32 file mapping handle
+#endif
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+    /** Default Constructor. Use Open() */
+    MappedFile();
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Get the mapped bytes
+    const std::byte* GetData() const { return m_pData; }
+
+    /// Get the size of the file in bytes
+    size_t GetSize() const { return m_size; }
+};
+}
@@ -1,19 +1,58 @@
 #include "Resource.h"
+#include "MappedFile.h"
 
 using yang::IResource;
 
 IResource::IResource(const std::string& filepath, std::vector<std::byte>&& data)
     :m_filepath(filepath)
     ,m_data(std::move(data))
+    ,m_mappedOffset(0)
+    ,m_mappedSize(0)
 {
 	
 }
 
+yang::IResource::IResource(const std::string& filepath, std::shared_ptr<const MappedFile> pMapping)
+    :m_filepath(filepath)
+    ,m_pMapping(std::move(pMapping))
+    ,m_mappedOffset(0)
+    ,m_mappedSize(m_pMapping ? m_pMapping->GetSize() : 0)
+{
+}
+
+yang::IResource::IResource(const std::string& filepath, std::shared_ptr<const MappedFile> pMapping, size_t offset, size_t size)
+    :m_filepath(filepath)
+    ,m_pMapping(std::move(pMapping))
+    ,m_mappedOffset(offset)
+    ,m_mappedSize(size)
+{
+}
+
 IResource::~IResource()
 {
 	
 }
 
 yang::IResource::IResource()
+    :m_mappedOffset(0)
+    ,m_mappedSize(0)
+{
+}
+
+yang::ByteView yang::IResource::GetData() const
+{
+    if (m_pMapping)
+    {
+        return ByteView{ m_pMapping->GetData() + m_mappedOffset, m_mappedSize };
+    }
+
+    return ByteView{ m_data.data(), m_data.size() };
+}
+
+void yang::IResource::ReleaseData()
 {
+    std::vector<std::byte>().swap(m_data);
+    m_pMapping.reset();
+    m_mappedOffset = 0;
+    m_mappedSize = 0;
 }
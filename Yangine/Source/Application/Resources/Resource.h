@@ -4,11 +4,43 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 #include <Utils/Typedefs.h>
 
 //! \namespace yang Contains all Yangine code
 namespace yang
 {
+    class MappedFile;
+
+    /// Interned resource path. Hash of the normalized path, \see ResourceArchive::HashPath
+    using ResourceId = uint64_t;
+
+    /// Resource ID that no path maps to
+    constexpr ResourceId kInvalidResourceId = kInvalidValue<ResourceId>;
+
+/** \struct ByteView */
+/** Non-owning view over contiguous raw bytes. Mirrors the parts of std::vector interface the parsers use */
+struct ByteView
+{
+    const std::byte* m_pData = nullptr;     ///< First byte
+    size_t m_size = 0;                      ///< Number of bytes
+
+    /// Get pointer to the first byte
+    const std::byte* data() const { return m_pData; }
+
+    /// Get number of bytes
+    size_t size() const { return m_size; }
+
+    /// Is the view empty
+    bool empty() const { return m_size == 0; }
+
+    /// Iterator to the first byte
+    const std::byte* begin() const { return m_pData; }
+
+    /// Iterator past the last byte
+    const std::byte* end() const { return m_pData + m_size; }
+};
+
 /** \class Resource */
 /** Base interface for the data resources */
 class IResource
@@ -28,6 +60,18 @@ public:
     /// \param data - vector of raw bytes representing the data in the file
 	IResource(const std::string& filepath, std::vector<std::byte>&& data);
 
+    /// Constructor. The resource data is a view over the mapped file, nothing is copied
+    /// \param filepath - path to the resource
+    /// \param pMapping - memory mapping of the file
+    IResource(const std::string& filepath, std::shared_ptr<const MappedFile> pMapping);
+
+    /// Constructor. The resource data is a view over a part of the mapped file, used for the entries of packed archives
+    /// \param filepath - path to the resource
+    /// \param pMapping - memory mapping of the file that contains the resource
+    /// \param offset - offset of the resource data in the mapping
+    /// \param size - size of the resource data
+    IResource(const std::string& filepath, std::shared_ptr<const MappedFile> pMapping, size_t offset, size_t size);
+
     /// Explicitly defaulted move constructor
     IResource(IResource&&) = default;
 
@@ -43,11 +87,21 @@ public:
 	/** Default Destructor */
 	virtual ~IResource();
 
+    /// Get approximate memory used by the resource. Used for the resource cache memory accounting
+    /// \return size in bytes
+    virtual size_t GetMemorySize() const { return GetData().size(); }
+
+    /// Drops the raw data bytes. Only for resources that don't need them anymore after being created
+    void ReleaseData();
+
 private:
 	// --------------------------------------------------------------------- //
 	// Private Member Variables
 	// --------------------------------------------------------------------- //
-    std::vector<std::byte> m_data;  ///< Raw bytes of data
+    std::vector<std::byte> m_data;                  ///< Raw bytes of data, if the resource was read into memory
+    std::shared_ptr<const MappedFile> m_pMapping;   ///< Memory mapping of the file, if the resource was mapped instead
+    size_t m_mappedOffset;                          ///< Offset of the resource data in the mapping
+    size_t m_mappedSize;                            ///< Size of the resource data in the mapping
 
 protected:
 	// --------------------------------------------------------------------- //
@@ -68,8 +122,11 @@ public:
 	// --------------------------------------------------------------------- //
 
     /// Get raw data bytes
-    /// \return Vector of bytes
-    const std::vector<std::byte>& GetData() const { return m_data; }
+    /// \return View over the bytes, either read into memory or mapped
+    ByteView GetData() const;
+
+    /// Is the data a view over a memory mapped file
+    bool IsMapped() const { return m_pMapping != nullptr; }
 
     /// Get filepath
     /// \return string that contains path to the resource file
@@ -0,0 +1,129 @@
+#include "ResourceArchive.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <vector>
+
+#include <Utils/Logger.h>
+#include <Utils/StringHash.h>
+#include <Utils/LZCompression.h>
+
+using yang::ResourceArchive;
+
+ResourceArchive::ResourceArchive()
+    :m_pEntries(nullptr)
+    ,m_entryCount(0)
+{
+
+}
+
+ResourceArchive::~ResourceArchive()
+{
+
+}
+
+std::unique_ptr<ResourceArchive> yang::ResourceArchive::Open(const char* filepath)
+{
+    auto pMapping = MappedFile::Open(filepath);
+    if (!pMapping)
+        return nullptr;
+
+    if (pMapping->GetSize() < sizeof(Header))
+    {
+        LOG(Error, "%s is too small to be a resource archive", filepath);
+        return nullptr;
+    }
+
+    Header header;
+    std::memcpy(&header, pMapping->GetData(), sizeof(header));
+    if (header.m_magic != kMagic || header.m_version != kVersion)
+    {
+        LOG(Error, "%s is not a resource archive, or was packed with a different version", filepath);
+        return nullptr;
+    }
+
+    // Compared by division, the multiplication could wrap on 32 bit builds
+    size_t fileSize = pMapping->GetSize();
+    if (header.m_entryCount > (fileSize - sizeof(Header)) / sizeof(Entry))
+    {
+        LOG(Error, "Resource archive %s has a truncated index", filepath);
+        return nullptr;
+    }
+    size_t indexEnd = sizeof(Header) + static_cast<size_t>(header.m_entryCount) * sizeof(Entry);
+
+    // The mapping is page aligned and the header is 16 bytes, so the index can be used in place
+    const Entry* pEntries = reinterpret_cast<const Entry*>(pMapping->GetData() + sizeof(Header));
+    for (size_t i = 0; i < header.m_entryCount; ++i)
+    {
+        const Entry& entry = pEntries[i];
+        // The offset is read from the file, adding the size to it could wrap
+        if (entry.m_offset < indexEnd || entry.m_offset > fileSize || entry.m_storedSize > fileSize - entry.m_offset ||
+            (i > 0 && pEntries[i - 1].m_pathHash >= entry.m_pathHash))
+        {
+            LOG(Error, "Resource archive %s has a corrupted index", filepath);
+            return nullptr;
+        }
+    }
+
+    // Private constructor, so no make_unique
+    std::unique_ptr<ResourceArchive> pArchive(new ResourceArchive());
+    pArchive->m_pEntries = pEntries;
+    pArchive->m_entryCount = header.m_entryCount;
+    pArchive->m_pMapping = std::move(pMapping);
+    pArchive->m_filepath = filepath;
+    return pArchive;
+}
+
+std::string yang::ResourceArchive::NormalizePath(const char* filepath)
+{
+    std::string path = filepath;
+    std::transform(path.begin(), path.end(), path.begin(), [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+    std::replace(path.begin(), path.end(), '\\', '/');
+    return path;
+}
+
+yang::ResourceId yang::ResourceArchive::HashPath(std::string_view filepath)
+{
+    // Same FNV-1a as StringHash64, over the normalized characters
+    uint64_t hash = kVal64;
+    for (char c : filepath)
+    {
+        c = (c == '\\') ? '/' : static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        hash = (hash ^ static_cast<uint64_t>(c)) * kPrime64;
+    }
+
+    return hash != kInvalidResourceId ? hash : hash - 1;
+}
+
+const ResourceArchive::Entry* yang::ResourceArchive::FindEntry(uint64_t pathHash) const
+{
+    const Entry* pEnd = m_pEntries + m_entryCount;
+    const Entry* pEntry = std::lower_bound(m_pEntries, pEnd, pathHash, [](const Entry& entry, uint64_t hash) { return entry.m_pathHash < hash; });
+
+    if (pEntry == pEnd || pEntry->m_pathHash != pathHash)
+        return nullptr;
+
+    return pEntry;
+}
+
+std::shared_ptr<yang::IResource> yang::ResourceArchive::LoadResource(const std::string& normalizedPath) const
+{
+    const Entry* pEntry = FindEntry(HashPath(normalizedPath));
+    if (!pEntry)
+        return nullptr;
+
+    if (!(pEntry->m_flags & kCompressed))
+    {
+        return std::make_shared<IResource>(normalizedPath, m_pMapping, static_cast<size_t>(pEntry->m_offset), pEntry->m_storedSize);
+    }
+
+    std::vector<std::byte> data(pEntry->m_originalSize);
+    if (!LZDecompress(m_pMapping->GetData() + pEntry->m_offset, pEntry->m_storedSize, data.data(), data.size()))
+    {
+        LOG(Error, "Failed to decompress %s from resource archive %s", normalizedPath.c_str(), m_filepath.c_str());
+        return nullptr;
+    }
+
+    return std::make_shared<IResource>(normalizedPath, std::move(data));
+}
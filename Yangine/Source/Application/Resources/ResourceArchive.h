@@ -0,0 +1,121 @@
+#pragma once
+/** \file ResourceArchive.h */
+/** Read-only packed resource archive */
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+#include "Resource.h"
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+    class MappedFile;
+
+/** \class ResourceArchive */
+/** Many resource files packed into one. Layout: Header, Entry index sorted by the path hash, then the payloads aligned to kPayloadAlignment.
+    The archive is memory mapped, so stored entries are handed out as views and only compressed entries are copied.
+    All numbers are little endian. Archives are written by ResourceArchiveWriter */
+class ResourceArchive
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+    static constexpr uint32_t kMagic = 0x4B415059;          ///< "YPAK"
+    static constexpr uint32_t kVersion = 1;                 ///< Format version, bumped on every layout change
+    static constexpr size_t kPayloadAlignment = 16;         ///< Alignment of every payload in the file
+
+    /// Beginning of the file
+    struct Header
+    {
+        uint32_t m_magic;           ///< Must be kMagic
+        uint32_t m_version;         ///< Must be kVersion
+        uint32_t m_entryCount;      ///< Number of entries in the index
+        uint32_t m_reserved;        ///< Padding
+    };
+
+    /// Flags of an index entry
+    enum EntryFlags : uint32_t
+    {
+        kCompressed = 1 << 0,       ///< The payload is compressed with LZCompress
+    };
+
+    /// Index entry. The index follows the header and is sorted by m_pathHash
+    struct Entry
+    {
+        uint64_t m_pathHash;        ///< HashPath() of the resource path
+        uint64_t m_offset;          ///< Offset of the payload from the beginning of the file
+        uint32_t m_storedSize;      ///< Size of the payload in the file
+        uint32_t m_originalSize;    ///< Size of the resource data
+        uint32_t m_flags;           ///< EntryFlags
+        uint32_t m_reserved;        ///< Padding
+    };
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /** Default Destructor */
+    ~ResourceArchive();
+
+    ResourceArchive(const ResourceArchive&) = delete;
+    ResourceArchive& operator=(const ResourceArchive&) = delete;
+
+    /// Maps the archive and validates its header and index
+    /// \param filepath - path to the archive
+    /// \return the archive, or null if the file doesn't exist or isn't a valid archive
+    static std::unique_ptr<ResourceArchive> Open(const char* filepath);
+
+    /// Lowercases the path and converts backslashes. Resources are looked up by normalized paths, both in archives and on disk
+    /// \param filepath - path to normalize
+    /// \return normalized path
+    static std::string NormalizePath(const char* filepath);
+
+    /// Hashes the path, normalizing it on the fly, so HashPath(p) == HashPath(NormalizePath(p)) and nothing is allocated.
+    /// The hash is the ResourceId of the path and is used for the index lookup
+    /// \param filepath - path to hash
+    /// \return 64 bit path hash, never kInvalidResourceId
+    static ResourceId HashPath(std::string_view filepath);
+
+    /// Binary searches the index
+    /// \param pathHash - hash of the normalized path
+    /// \return the entry, or null if the archive doesn't contain the path
+    const Entry* FindEntry(uint64_t pathHash) const;
+
+    /// Creates the resource from the archive entry. Safe to call from worker threads
+    /// \param normalizedPath - path returned from NormalizePath
+    /// \return the resource, or null if the archive doesn't contain the path or the entry is corrupted
+    std::shared_ptr<IResource> LoadResource(const std::string& normalizedPath) const;
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+    std::shared_ptr<const MappedFile> m_pMapping;   ///< Mapping of the whole archive. Shared with the resources that view into it
+    const Entry* m_pEntries;                        ///< Index in the mapping
+    size_t m_entryCount;                            ///< Number of entries in the index
+    std::string m_filepath;                         ///< Path to the archive
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+    /** Default Constructor. Use Open() */
+    ResourceArchive();
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Get number of resources in the archive
+    size_t GetEntryCount() const { return m_entryCount; }
+
+    /// Get path to the archive
+    const std::string& GetPath() const { return m_filepath; }
+};
+}
@@ -0,0 +1,116 @@
+#include "ResourceArchiveWriter.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#include <Utils/Logger.h>
+#include <Utils/LZCompression.h>
+
+using yang::ResourceArchiveWriter;
+
+bool yang::ResourceArchiveWriter::AddFile(const char* filepath, std::vector<std::byte>&& data, bool allowCompression)
+{
+    std::string path = ResourceArchive::NormalizePath(filepath);
+    uint64_t hash = ResourceArchive::HashPath(path);
+
+    if (auto pathIt = m_paths.find(hash); pathIt != m_paths.end())
+    {
+        if (pathIt->second == path)
+        {
+            LOG(Error, "%s is added to the resource archive twice", path.c_str());
+        }
+        else
+        {
+            LOG(Error, "Resource archive path hash collision: %s and %s", path.c_str(), pathIt->second.c_str());
+        }
+        return false;
+    }
+
+    if (data.size() > std::numeric_limits<uint32_t>::max())
+    {
+        LOG(Error, "%s is too big for the resource archive", path.c_str());
+        return false;
+    }
+
+    PendingEntry pending;
+    pending.m_entry.m_pathHash = hash;
+    pending.m_entry.m_offset = 0;
+    pending.m_entry.m_originalSize = static_cast<uint32_t>(data.size());
+    pending.m_entry.m_flags = 0;
+    pending.m_entry.m_reserved = 0;
+
+    if (allowCompression && !data.empty())
+    {
+        std::vector<std::byte> compressed = LZCompress(data.data(), data.size());
+        if (compressed.size() * 100 <= data.size() * (100 - kMinCompressionGainPercent))
+        {
+            pending.m_entry.m_flags |= ResourceArchive::kCompressed;
+            data = std::move(compressed);
+        }
+    }
+
+    pending.m_entry.m_storedSize = static_cast<uint32_t>(data.size());
+    pending.m_payload = std::move(data);
+
+    m_originalBytes += pending.m_entry.m_originalSize;
+    m_storedBytes += pending.m_entry.m_storedSize;
+    m_paths.emplace(hash, std::move(path));
+    m_entries.emplace_back(std::move(pending));
+    return true;
+}
+
+bool yang::ResourceArchiveWriter::Write(const char* filepath)
+{
+    std::sort(m_entries.begin(), m_entries.end(), [](const PendingEntry& left, const PendingEntry& right)
+        {
+            return left.m_entry.m_pathHash < right.m_entry.m_pathHash;
+        });
+
+    auto alignOffset = [](uint64_t offset)
+    {
+        return (offset + ResourceArchive::kPayloadAlignment - 1) & ~static_cast<uint64_t>(ResourceArchive::kPayloadAlignment - 1);
+    };
+
+    // Lay out the payloads after the index
+    uint64_t offset = alignOffset(sizeof(ResourceArchive::Header) + m_entries.size() * sizeof(ResourceArchive::Entry));
+    for (PendingEntry& pending : m_entries)
+    {
+        pending.m_entry.m_offset = offset;
+        offset = alignOffset(offset + pending.m_entry.m_storedSize);
+    }
+
+    std::ofstream outFile(filepath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (outFile.fail())
+    {
+        LOG(Error, "Could not open %s for writing", filepath);
+        return false;
+    }
+
+    ResourceArchive::Header header;
+    header.m_magic = ResourceArchive::kMagic;
+    header.m_version = ResourceArchive::kVersion;
+    header.m_entryCount = static_cast<uint32_t>(m_entries.size());
+    header.m_reserved = 0;
+    outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const PendingEntry& pending : m_entries)
+    {
+        outFile.write(reinterpret_cast<const char*>(&pending.m_entry), sizeof(pending.m_entry));
+    }
+
+    const char padding[ResourceArchive::kPayloadAlignment] = {};
+    for (const PendingEntry& pending : m_entries)
+    {
+        uint64_t position = static_cast<uint64_t>(outFile.tellp());
+        outFile.write(padding, static_cast<std::streamsize>(pending.m_entry.m_offset - position));
+        outFile.write(reinterpret_cast<const char*>(pending.m_payload.data()), pending.m_payload.size());
+    }
+
+    if (outFile.fail())
+    {
+        LOG(Error, "Failed to write resource archive %s", filepath);
+        return false;
+    }
+
+    return true;
+}
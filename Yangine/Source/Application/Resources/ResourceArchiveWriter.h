@@ -0,0 +1,72 @@
+#pragma once
+/** \file ResourceArchiveWriter.h */
+/** Builds packed resource archives */
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+#include "ResourceArchive.h"
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \class ResourceArchiveWriter */
+/** Collects files and writes them as a ResourceArchive. Used by the asset packer tool */
+class ResourceArchiveWriter
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+    static constexpr size_t kMinCompressionGainPercent = 10;     ///< Entries are stored uncompressed unless compression saves at least this much
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Adds the file to the archive
+    /// \param filepath - path the resource is going to be loaded with. Normalized before hashing
+    /// \param data - file contents
+    /// \param allowCompression - should the entry be compressed if it pays off
+    /// \return false if the path is already added or collides with another path hash
+    bool AddFile(const char* filepath, std::vector<std::byte>&& data, bool allowCompression);
+
+    /// Writes all added files to the archive
+    /// \param filepath - path to the archive to write
+    /// \return true if written successfully
+    bool Write(const char* filepath);
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+
+    /// Added file
+    struct PendingEntry
+    {
+        ResourceArchive::Entry m_entry;         ///< Index entry. The offset is filled in when writing
+        std::vector<std::byte> m_payload;       ///< Bytes to store
+    };
+
+    std::vector<PendingEntry> m_entries;                        ///< All added files
+    std::unordered_map<uint64_t, std::string> m_paths;          ///< Normalized paths by hash, to catch collisions
+    size_t m_originalBytes = 0;                                 ///< Total size of the added files
+    size_t m_storedBytes = 0;                                   ///< Total size of the stored payloads
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Get number of added files
+    size_t GetEntryCount() const { return m_entries.size(); }
+
+    /// Get total size of the added files
+    size_t GetOriginalBytes() const { return m_originalBytes; }
+
+    /// Get total size of the stored payloads, after compression
+    size_t GetStoredBytes() const { return m_storedBytes; }
+};
+}
@@ -1,10 +1,12 @@
 #include "ResourceCache.h"
-#include <cctype> // std::tolower
+#include "MappedFile.h"
 #include <algorithm>
 #include <fstream>
 
 #include <Utils/Logger.h>
+#include <Utils/ThreadPool/ThreadPool.h>
 #include <Application/ApplicationLayer.h>
+#include <Application/ApplicationGlobals.h>
 
 using yang::ResourceCache;
 
@@ -12,6 +14,21 @@ ResourceCache::ResourceCache()
     :m_pAudio(nullptr)
     ,m_pFontLoader(nullptr)
     ,m_pGraphics(nullptr)
+    ,m_maxUploadsPerFrame(8)
+    ,m_asyncBatchLoadCount(0)
+    ,m_asyncBatchFrameCount(0)
+    ,m_asyncBatchUploadSeconds(0)
+    ,m_memoryBudget(0)
+    ,m_releaseRawData(false)
+    ,m_useMappedFiles(true)
+    ,m_pRecordedDependencies(nullptr)
+    ,m_mappedBytes(0)
+    ,m_copiedBytes(0)
+    ,m_fileReadMicroseconds(0)
+    ,m_looseFileCount(0)
+    ,m_archiveFileCount(0)
+    ,m_archiveBytes(0)
+    ,m_archiveReadMicroseconds(0)
 {
     
 }
@@ -24,9 +41,37 @@ ResourceCache::~ResourceCache()
 std::shared_ptr<yang::IResource> yang::ResourceCache::LoadResource(const char* filepath)
 {
     // Sanitizing the filepath
-    std::string path = filepath;
-    std::transform(path.begin(), path.end(), path.begin(), std::tolower);
-    std::replace(path.begin(), path.end(), '\\', '/');
+    std::string path = ResourceArchive::NormalizePath(filepath);
+
+    // Mounted archives go first, the last mounted one overrides the others
+    if (!m_archives.empty())
+    {
+        auto archiveStart = std::chrono::steady_clock::now();
+        for (auto archiveIt = m_archives.rbegin(); archiveIt != m_archives.rend(); ++archiveIt)
+        {
+            if (auto pResource = (*archiveIt)->LoadResource(path); pResource != nullptr)
+            {
+                ++m_archiveFileCount;
+                m_archiveBytes += pResource->GetData().size();
+                m_archiveReadMicroseconds += static_cast<size_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - archiveStart).count());
+                return pResource;
+            }
+        }
+    }
+
+    auto readStart = std::chrono::steady_clock::now();
+    ++m_looseFileCount;
+
+    // Map the file if we can, parsers get a view over the mapping and nothing is copied
+    if (m_useMappedFiles)
+    {
+        if (auto pMapping = MappedFile::Open(path.c_str()); pMapping != nullptr)
+        {
+            m_mappedBytes += pMapping->GetSize();
+            m_fileReadMicroseconds += static_cast<size_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - readStart).count());
+            return std::make_shared<IResource>(path, std::move(pMapping));
+        }
+    }
 
     // Load the resource
     // Find the size of the file
@@ -45,21 +90,347 @@ std::shared_ptr<yang::IResource> yang::ResourceCache::LoadResource(const char* f
     inFile.read(reinterpret_cast<char*>(data.data()), length);
     inFile.close();
 
+    m_copiedBytes += length;
+    m_fileReadMicroseconds += static_cast<size_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - readStart).count());
     return std::make_shared<IResource>(path, std::move(data));
 }
 
 bool yang::ResourceCache::Init(const ApplicationLayer& app)
 {
-    m_pAudio = app.GetAudio();
-    m_pFontLoader = app.GetFontLoader();
-    m_pGraphics = app.GetGraphics();
+    return Init(app.GetGraphics(), app.GetAudio(), app.GetFontLoader());
+}
+
+bool yang::ResourceCache::Init(IGraphics* pGraphics, IAudio* pAudio, IFontLoader* pFontLoader)
+{
+    m_pAudio = pAudio;
+    m_pFontLoader = pFontLoader;
+    m_pGraphics = pGraphics;
+
+    // Shipping builds pack the assets, development builds just don't have the archive
+    if (auto pArchive = ResourceArchive::Open(kDefaultArchivePath); pArchive != nullptr)
+    {
+        LOG(Info, "Mounted resource archive %s with %zu resources", kDefaultArchivePath, pArchive->GetEntryCount());
+        m_archives.emplace_back(std::move(pArchive));
+    }
 
     return true;
 }
 
+yang::ResourceId yang::ResourceCache::InternPath(const char* filepath)
+{
+    assert(filepath && "filepath should be valid string");
+
+    ResourceId id = ResourceArchive::HashPath(filepath);
+    if (const std::string* pInterned = m_internedPaths.Find(id); pInterned != nullptr)
+    {
+#ifdef DEBUG
+        if (*pInterned != ResourceArchive::NormalizePath(filepath))
+        {
+            LOG(Error, "Resource path hash collision: %s and %s", filepath, pInterned->c_str());
+        }
+#endif
+        return id;
+    }
+
+    m_internedPaths.Insert(id, ResourceArchive::NormalizePath(filepath));
+    return id;
+}
+
+bool yang::ResourceCache::HasResource(const char* filepath) const
+{
+    std::string path = ResourceArchive::NormalizePath(filepath);
+    ResourceId id = ResourceArchive::HashPath(path);
+
+    for (const auto& pArchive : m_archives)
+    {
+        if (pArchive->FindEntry(id))
+            return true;
+    }
+
+    return std::ifstream(path.c_str()).good();
+}
+
+bool yang::ResourceCache::MountArchive(const char* filepath)
+{
+    auto pArchive = ResourceArchive::Open(filepath);
+    if (!pArchive)
+    {
+        LOG(Error, "Could not mount resource archive %s", filepath);
+        return false;
+    }
+
+    LOG(Info, "Mounted resource archive %s with %zu resources", filepath, pArchive->GetEntryCount());
+    m_archives.emplace_back(std::move(pArchive));
+    return true;
+}
+
 void yang::ResourceCache::Cleanup()
 {
-	m_resourceMap.clear();
+    // Worker jobs reference the requests, let them finish before releasing anything
+    for (auto& pRequest : m_pendingQueue)
+    {
+        pRequest->m_workerJob.wait();
+        if (pRequest->m_pDecodedImage)
+        {
+            m_pGraphics->FreeImage(pRequest->m_pDecodedImage);
+            pRequest->m_pDecodedImage = nullptr;
+        }
+        pRequest->m_isFinished = true;
+    }
+    m_pendingQueue.clear();
+    m_pendingLoads.clear();
+
+    LogStats();
+
+	m_resourceMap.Clear();
+    m_lruList.clear();
+    m_internedPaths.Clear();
+    m_archives.clear();
+    m_stats = ResourceCacheStats();
+}
+
+void yang::ResourceCache::TrimToBudget()
+{
+    if (m_memoryBudget == 0 || m_stats.m_residentBytes <= m_memoryBudget)
+        return;
+
+    // Walk from the least recently used end. Resources referenced by anybody else stay, evicting them wouldn't free anything
+    for (auto lruIt = m_lruList.end(); lruIt != m_lruList.begin() && m_stats.m_residentBytes > m_memoryBudget;)
+    {
+        --lruIt;
+        CacheEntry* pEntry = m_resourceMap.Find(*lruIt);
+        assert(pEntry);
+
+        if (pEntry->m_pResource.use_count() > 1)
+            continue;
+
+        m_stats.m_residentBytes -= pEntry->m_memorySize;
+        m_stats.m_residentBytesByCategory[static_cast<size_t>(pEntry->m_category)] -= pEntry->m_memorySize;
+        ++m_stats.m_evictions;
+
+        m_resourceMap.Erase(*lruIt);
+        lruIt = m_lruList.erase(lruIt);
+    }
+
+    if (m_stats.m_residentBytes > m_memoryBudget)
+    {
+        LOG_ONCE(Warning, ResourceBudgetExceeded, "Resources that are still in use don't fit the resource cache memory budget");
+    }
+}
+
+void yang::ResourceCache::LogStats() const
+{
+    LOG(Stats, "Resource cache: %zu hits, %zu misses, %zu evictions, %zu resident bytes (raw %zu, textures %zu, sounds %zu, music %zu, fonts %zu)",
+        m_stats.m_hits, m_stats.m_misses, m_stats.m_evictions, m_stats.m_residentBytes,
+        GetResidentBytes(ResourceCategory::kRaw), GetResidentBytes(ResourceCategory::kTexture), GetResidentBytes(ResourceCategory::kSound),
+        GetResidentBytes(ResourceCategory::kMusic), GetResidentBytes(ResourceCategory::kFont));
+    LOG(Stats, "Resource file reads: %zu loose files, %zu bytes mapped, %zu bytes copied, %.2f ms spent opening and reading",
+        m_looseFileCount.load(), m_mappedBytes.load(), m_copiedBytes.load(), m_fileReadMicroseconds.load() / 1000.f);
+    LOG(Stats, "Resource archive reads: %zu resources, %zu bytes from %zu mounted archives, %.2f ms spent looking up and decompressing",
+        m_archiveFileCount.load(), m_archiveBytes.load(), m_archives.size(), m_archiveReadMicroseconds.load() / 1000.f);
+}
+
+std::shared_ptr<yang::IResource> yang::ResourceCache::FindInCache(ResourceId key)
+{
+    CacheEntry* pEntry = m_resourceMap.Find(key);
+    if (!pEntry)
+    {
+        ++m_stats.m_misses;
+        return nullptr;
+    }
+
+    ++m_stats.m_hits;
+    m_lruList.splice(m_lruList.begin(), m_lruList, pEntry->m_lruIt);
+    return pEntry->m_pResource;
+}
+
+void yang::ResourceCache::AddToCache(ResourceId key, std::shared_ptr<IResource> pResource, ResourceCategory category)
+{
+    // Music is streamed from the raw bytes, so only fully decoded resources can drop them
+    if (m_releaseRawData && (category == ResourceCategory::kTexture || category == ResourceCategory::kSound))
+    {
+        pResource->ReleaseData();
+    }
+
+    if (CacheEntry* pOldEntry = m_resourceMap.Find(key); pOldEntry != nullptr)
+    {
+        m_stats.m_residentBytes -= pOldEntry->m_memorySize;
+        m_stats.m_residentBytesByCategory[static_cast<size_t>(pOldEntry->m_category)] -= pOldEntry->m_memorySize;
+        m_lruList.erase(pOldEntry->m_lruIt);
+    }
+
+    size_t memorySize = pResource->GetMemorySize();
+    m_lruList.push_front(key);
+    m_resourceMap.Insert(key, CacheEntry{ std::move(pResource), category, memorySize, m_lruList.begin() });
+
+    m_stats.m_residentBytes += memorySize;
+    m_stats.m_residentBytesByCategory[static_cast<size_t>(category)] += memorySize;
+
+    TrimToBudget();
+}
+
+std::shared_ptr<yang::AsyncLoadRequest> yang::ResourceCache::QueueAsyncLoad(ResourceId id, AsyncLoadRequest::Kind kind)
+{
+    const std::string* pPath = m_internedPaths.Find(id);
+    if (!pPath)
+    {
+        LOG(Error, "Asynchronous load requested for a resource ID that was never interned");
+        return nullptr;
+    }
+
+    if (auto pendingIt = m_pendingLoads.find(id); pendingIt != m_pendingLoads.end())
+    {
+        if (pendingIt->second->m_kind == kind)
+        {
+            return pendingIt->second;
+        }
+
+        LOG(Warning, "Resource %s is already being loaded as a different type, waiting for it first", pPath->c_str());
+        WaitForAsyncLoad(pendingIt->second);
+    }
+
+    if (m_pendingQueue.empty())
+    {
+        m_asyncBatchStart = std::chrono::steady_clock::now();
+        m_asyncBatchLoadCount = 0;
+        m_asyncBatchFrameCount = 0;
+        m_asyncBatchUploadSeconds = 0;
+    }
+
+    auto pRequest = std::make_shared<AsyncLoadRequest>();
+    pRequest->m_id = id;
+    pRequest->m_key = *pPath;
+    pRequest->m_kind = kind;
+
+    // The request outlives the job: the cache keeps it until the job is done and waited on
+    AsyncLoadRequest* pJobRequest = pRequest.get();
+    pRequest->m_workerJob = GetThreadPool().enqueue([this, pJobRequest]()
+        {
+            pJobRequest->m_pRawResource = LoadResource(pJobRequest->m_key.c_str());
+            if (pJobRequest->m_pRawResource && pJobRequest->m_kind == AsyncLoadRequest::Kind::kTexture)
+            {
+                pJobRequest->m_pDecodedImage = m_pGraphics->DecodeImage(pJobRequest->m_pRawResource.get());
+            }
+        });
+
+    m_pendingLoads.emplace(id, pRequest);
+    m_pendingQueue.push_back(pRequest);
+    return pRequest;
+}
+
+void yang::ResourceCache::ProcessAsyncLoads()
+{
+    if (m_pendingQueue.empty())
+        return;
+
+    ++m_asyncBatchFrameCount;
+
+    size_t uploads = 0;
+    for (size_t index = 0; index < m_pendingQueue.size() && uploads < m_maxUploadsPerFrame;)
+    {
+        auto pRequest = m_pendingQueue[index];
+        if (pRequest->m_workerJob.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            ++index;
+            continue;
+        }
+
+        FinishAsyncLoad(*pRequest);
+        m_pendingLoads.erase(pRequest->m_id);
+        m_pendingQueue.erase(m_pendingQueue.begin() + index);
+        ++uploads;
+    }
+
+    if (m_pendingQueue.empty())
+    {
+        std::chrono::duration<float> batchTime = std::chrono::steady_clock::now() - m_asyncBatchStart;
+        LOG(Stats, "Async load batch: %zu resources in %.2f ms over %zu frames, main thread upload %.2f ms",
+            m_asyncBatchLoadCount, batchTime.count() * 1000.f, m_asyncBatchFrameCount, m_asyncBatchUploadSeconds * 1000.f);
+    }
+}
+
+std::shared_ptr<yang::IResource> yang::ResourceCache::WaitForAsyncLoad(const std::shared_ptr<AsyncLoadRequest>& pRequest)
+{
+    if (pRequest->m_isFinished)
+    {
+        return pRequest->m_pResult;
+    }
+
+    FinishAsyncLoad(*pRequest);
+
+    // Hold on to the request, erasing it from the containers may release the last cache reference
+    auto pFinished = pRequest;
+    m_pendingLoads.erase(pFinished->m_id);
+    m_pendingQueue.erase(std::remove(m_pendingQueue.begin(), m_pendingQueue.end(), pFinished), m_pendingQueue.end());
+    return pFinished->m_pResult;
+}
+
+void yang::ResourceCache::FinishAsyncLoad(AsyncLoadRequest& request)
+{
+    request.m_workerJob.wait();
+
+    auto uploadStart = std::chrono::steady_clock::now();
+    std::shared_ptr<IResource> pRaw = std::move(request.m_pRawResource);
+
+    if (pRaw)
+    {
+        switch (request.m_kind)
+        {
+        case AsyncLoadRequest::Kind::kTexture:
+        {
+            if (request.m_pDecodedImage)
+            {
+                std::shared_ptr<ITexture> pTexture = m_pGraphics->CreateTextureFromImage(pRaw.get(), request.m_pDecodedImage);
+                m_pGraphics->FreeImage(request.m_pDecodedImage);
+                request.m_pDecodedImage = nullptr;
+
+                if (pTexture)
+                {
+                    AddToCache(request.m_id, pTexture, ResourceCategory::kTexture);
+                }
+                request.m_pResult = pTexture;
+            }
+            break;
+        }
+        case AsyncLoadRequest::Kind::kSound:
+        {
+            std::shared_ptr<ISound> pSound = m_pAudio->LoadSound(pRaw.get());
+            if (pSound)
+            {
+                AddToCache(request.m_id, pSound, ResourceCategory::kSound);
+            }
+            request.m_pResult = pSound;
+            break;
+        }
+        case AsyncLoadRequest::Kind::kMusic:
+        {
+            std::shared_ptr<IMusic> pMusic = m_pAudio->LoadMusic(pRaw.get());
+            if (pMusic)
+            {
+                AddToCache(request.m_id, pMusic, ResourceCategory::kMusic);
+            }
+            request.m_pResult = pMusic;
+            break;
+        }
+        case AsyncLoadRequest::Kind::kRaw:
+        {
+            AddToCache(request.m_id, pRaw, ResourceCategory::kRaw);
+            request.m_pResult = pRaw;
+            break;
+        }
+        }
+    }
+
+    if (!request.m_pResult)
+    {
+        LOG(Error, "Asynchronous load of %s failed", request.m_key.c_str());
+    }
+
+    request.m_isFinished = true;
+
+    std::chrono::duration<float> uploadTime = std::chrono::steady_clock::now() - uploadStart;
+    m_asyncBatchUploadSeconds += uploadTime.count();
+    ++m_asyncBatchLoadCount;
 }
 
 ResourceCache* yang::ResourceCache::Get()
@@ -4,9 +4,15 @@
 #include <unordered_map>
 #include <string>
 #include <memory>
+#include <vector>
+#include <list>
+#include <array>
+#include <chrono>
+#include <atomic>
 #include <type_traits>
 #include <cassert>
 
+#include <Utils/StringHash.h>
 #include <Application/Graphics/IGraphics.h>
 #include <Application/Graphics/Fonts/IFontLoader.h>
 #include <Application/Audio/IAudio.h>
@@ -17,11 +23,47 @@
 #include <Application/Graphics/Fonts/IFont.h>
 
 #include "Resource.h"
+#include "ResourceHandle.h"
+#include "ResourceArchive.h"
+#include "ResourceIdTable.h"
 
 //! \namespace yang Contains all Yangine code
 namespace yang
 {
     class ApplicationLayer;
+
+/** \enum ResourceCategory */
+/** Category of a cached resource, used for memory accounting */
+enum class ResourceCategory
+{
+    kRaw,               ///< Raw file data (XML and such)
+    kTexture,           ///< Textures
+    kSound,             ///< Sound effects
+    kMusic,             ///< Music
+    kFont,              ///< Fonts
+    kMaxCategories      ///< Invalid value
+};
+
+/** \struct ResourceCacheStats */
+/** Resource cache counters */
+struct ResourceCacheStats
+{
+    size_t m_hits = 0;                                                                  ///< Lookups that found the resource in the cache
+    size_t m_misses = 0;                                                                ///< Lookups that had to load the resource
+    size_t m_evictions = 0;                                                             ///< Resources evicted to fit the memory budget
+    size_t m_residentBytes = 0;                                                         ///< Approximate memory used by all cached resources
+    std::array<size_t, static_cast<size_t>(ResourceCategory::kMaxCategories)> m_residentBytesByCategory = {};  ///< Approximate memory used by each category
+};
+
+/** \struct ResourceDependency */
+/** Resource requested from the cache, recorded while dependency recording is on */
+struct ResourceDependency
+{
+    ResourceId m_id = kInvalidResourceId;                   ///< Resource ID of the path
+    ResourceCategory m_category = ResourceCategory::kRaw;   ///< Type of the resource
+    int m_fontSize = 0;                                     ///< Point size, fonts only
+};
+
 /** \class ResourceCache */
 /** Resource storing singleton class */
 class ResourceCache
@@ -31,6 +73,7 @@ public:
 	// Public Member Variables
 	// --------------------------------------------------------------------- //
 
+    static constexpr const char* kDefaultArchivePath = "assets.ypak";        ///< Archive mounted on Init if it exists next to the executable
 
 	// --------------------------------------------------------------------- //
 	// Public Member Functions
@@ -42,22 +85,92 @@ public:
 	/** Default Destructor */
 	~ResourceCache();
 
-    /// Loads the resource, or finds it in the lookup table if it's already loaded.
+    /// Maps the path to its resource ID. Hashes the path without allocating, the normalized path is stored only the first time.
+    /// Resolve paths once, when the data that references them is parsed, and load by ID afterwards. Main thread only
+    /// \param filepath - path to the resource file
+    /// \return resource ID of the path
+    ResourceId InternPath(const char* filepath);
+
+    /// Loads the resource, or finds it in the lookup table if it's already loaded. A cache hit is a single table probe
+    /// \tparam ResourceType - ResourceType to load. Must be child of IResource
+    /// \param id - resource ID returned from InternPath
+    /// \param args - additional arguments needed to load and identify the resource. Example: font size for the Font resource
+    /// \return shared pointer to the resource
+    template <class ResourceType, class... Args>
+    std::shared_ptr<ResourceType> Load(ResourceId id, Args&&... args);
+
+    /// Loads the resource, or finds it in the lookup table if it's already loaded. Interns the path first
     /// \tparam ResourceType - ResourceType to load. Must be child of IResource
     /// \param filepath - path to the resource file
     /// \param args - additional arguments needed to load and identify the resource. Example: font size for the Font resource
     /// \return shared pointer to the resource
     template <class ResourceType, class... Args>
-    std::shared_ptr<ResourceType> Load(const char* filepath, Args&&... args);
+    std::shared_ptr<ResourceType> Load(const char* filepath, Args&&... args) { return Load<ResourceType>(InternPath(filepath), std::forward<Args>(args)...); }
+
+    /// Starts loading the resource on a worker thread, or finds it in the lookup table if it's already loaded.
+    /// File reading and image decoding happen on the worker, the resource itself is created by ProcessAsyncLoads on the main thread.
+    /// \tparam ResourceType - ResourceType to load. IResource, ITexture, ISound or IMusic
+    /// \param id - resource ID returned from InternPath
+    /// \return handle to poll or wait for the resource
+    template <class ResourceType>
+    ResourceHandle<ResourceType> LoadAsync(ResourceId id);
+
+    /// Starts loading the resource on a worker thread. Interns the path first
+    /// \tparam ResourceType - ResourceType to load. IResource, ITexture, ISound or IMusic
+    /// \param filepath - path to the resource file
+    /// \return handle to poll or wait for the resource
+    template <class ResourceType>
+    ResourceHandle<ResourceType> LoadAsync(const char* filepath) { return LoadAsync<ResourceType>(InternPath(filepath)); }
+
+    /// Creates resources whose worker jobs are done, at most GetMaxUploadsPerFrame() of them.
+    /// Not intended to be called manually outside of the main loop.
+    void ProcessAsyncLoads();
+
+    /// Blocks until the request worker job is done and finishes the load on the calling (main) thread
+    /// \param pRequest - request to finish
+    /// \return loaded resource, null if loading failed
+    std::shared_ptr<IResource> WaitForAsyncLoad(const std::shared_ptr<AsyncLoadRequest>& pRequest);
 
     /// Initializes the resource cache
     /// \param app - the application layer
     /// \return true if initialized successfully
     bool Init(const ApplicationLayer& app);
 
+    /// Initializes the resource cache without an application, for tools and benchmarks
+    /// \param pGraphics - creates the textures
+    /// \param pAudio - creates the sounds and music, can be null if none are loaded
+    /// \param pFontLoader - creates the fonts, can be null if none are loaded
+    /// \return true if initialized successfully
+    bool Init(IGraphics* pGraphics, IAudio* pAudio, IFontLoader* pFontLoader);
+
     /// Deallocates all loaded resources
 	void Cleanup();
 
+    /// Mounts the packed archive. Load looks resources up in the mounted archives first, the last mounted one wins, and falls back to loose files.
+    /// Mount archives before loading anything, worker threads read the archive list without locking.
+    /// \param filepath - path to the archive
+    /// \return true if the archive was mounted
+    bool MountArchive(const char* filepath);
+
+    /// Starts appending every resource requested through Load and LoadAsync to the vector, including cache hits
+    /// \param pDependencies - vector to append to. Must outlive the recording
+    void BeginDependencyRecording(std::vector<ResourceDependency>* pDependencies) { m_pRecordedDependencies = pDependencies; }
+
+    /// Stops the dependency recording
+    void EndDependencyRecording() { m_pRecordedDependencies = nullptr; }
+
+    /// Checks whether the resource can be loaded, without loading it
+    /// \param filepath - path to the resource file
+    /// \return true if a mounted archive or the file system has the resource
+    bool HasResource(const char* filepath) const;
+
+    /// Evicts least recently used resources that nobody else references, until the cache fits the memory budget.
+    /// Cheap when the cache is within the budget. Not intended to be called manually outside of the main loop.
+    void TrimToBudget();
+
+    /// Logs the cache statistics
+    void LogStats() const;
+
     /// Singleton getter
     static ResourceCache* Get();
 
@@ -65,12 +178,46 @@ private:
 	// --------------------------------------------------------------------- //
 	// Private Member Variables
 	// --------------------------------------------------------------------- //
-    std::unordered_map<std::string, std::shared_ptr<IResource>> m_resourceMap;  ///< Resource lookup table
+    /// Cached resource
+    struct CacheEntry
+    {
+        std::shared_ptr<IResource> m_pResource;             ///< The resource
+        ResourceCategory m_category = ResourceCategory::kRaw;   ///< Category the resource is accounted in
+        size_t m_memorySize = 0;                            ///< Memory size of the resource when it was cached
+        std::list<ResourceId>::iterator m_lruIt;            ///< Position of the resource key in the LRU list
+    };
+
+    ResourceIdTable<std::string> m_internedPaths;                               ///< Normalized paths by resource ID
+    ResourceIdTable<CacheEntry> m_resourceMap;                                  ///< Resource lookup table
+    std::list<ResourceId> m_lruList;                                            ///< Resource keys, most recently used first
+    ResourceCacheStats m_stats;                                                 ///< Cache counters
+    size_t m_memoryBudget;                                                      ///< Max resident bytes before resources get evicted. 0 means unlimited
+    bool m_releaseRawData;                                                      ///< Should raw file bytes be dropped once a texture or sound is created from them
+    bool m_useMappedFiles;                                                      ///< Should files be memory mapped instead of read into memory
+    std::vector<ResourceDependency>* m_pRecordedDependencies;                   ///< Where requested resources are recorded to, null if not recording
+
+    std::atomic<size_t> m_mappedBytes;                                          ///< Bytes of all files that were memory mapped. Updated from worker threads too
+    std::atomic<size_t> m_copiedBytes;                                          ///< Bytes of all files that were read into memory. Updated from worker threads too
+    std::atomic<size_t> m_fileReadMicroseconds;                                 ///< Time spent opening, mapping and reading files. Updated from worker threads too
+    std::atomic<size_t> m_looseFileCount;                                       ///< Number of resources read from loose files. Updated from worker threads too
+
+    std::vector<std::unique_ptr<ResourceArchive>> m_archives;                   ///< Mounted archives, in the mount order
+    std::atomic<size_t> m_archiveFileCount;                                     ///< Number of resources served from archives. Updated from worker threads too
+    std::atomic<size_t> m_archiveBytes;                                         ///< Bytes of all resources served from archives. Updated from worker threads too
+    std::atomic<size_t> m_archiveReadMicroseconds;                              ///< Time spent looking up and decompressing archive entries. Updated from worker threads too
 
     IGraphics* m_pGraphics;                                                     ///< Loads images
     IAudio* m_pAudio;                                                           ///< Loads audio   
     IFontLoader* m_pFontLoader;                                                 ///< Loads fonts
 
+    std::unordered_map<ResourceId, std::shared_ptr<AsyncLoadRequest>> m_pendingLoads;   ///< Unfinished asynchronous loads by key
+    std::vector<std::shared_ptr<AsyncLoadRequest>> m_pendingQueue;                      ///< Unfinished asynchronous loads in the request order
+    size_t m_maxUploadsPerFrame;                                                        ///< Max number of resources ProcessAsyncLoads creates in one frame
+
+    std::chrono::steady_clock::time_point m_asyncBatchStart;                   ///< When the first load of the current batch was requested
+    size_t m_asyncBatchLoadCount;                                               ///< Number of loads finished in the current batch
+    size_t m_asyncBatchFrameCount;                                              ///< Number of frames the current batch took
+    float m_asyncBatchUploadSeconds;                                            ///< Main thread time spent on creating resources of the current batch
 
 	// --------------------------------------------------------------------- //
 	// Private Member Functions
@@ -81,57 +228,222 @@ private:
     /// \return Shared pointer to a raw resource
     std::shared_ptr<IResource> LoadResource(const char* filepath);
 
+    /// Internal function to start a worker job for the resource
+    /// \param id - interned resource ID
+    /// \param kind - kind of the resource to create
+    /// \return request shared with the handle, or null if the ID was never interned
+    std::shared_ptr<AsyncLoadRequest> QueueAsyncLoad(ResourceId id, AsyncLoadRequest::Kind kind);
+
+    /// Internal function to create the resource from the finished worker job output. Main thread only
+    /// \param request - request to finish
+    void FinishAsyncLoad(AsyncLoadRequest& request);
+
+    /// Internal function to find the resource in the cache. Counts a hit or a miss and marks the resource as recently used
+    /// \param key - resource key
+    /// \return cached resource, or null if it's not in the cache
+    std::shared_ptr<IResource> FindInCache(ResourceId key);
+
+    /// Internal function to add the resource to the cache and account its memory
+    /// \param key - resource key
+    /// \param pResource - resource to add
+    /// \param category - category to account the resource in
+    void AddToCache(ResourceId key, std::shared_ptr<IResource> pResource, ResourceCategory category);
+
+    /// Internal function to get the cache key of a resource loaded with additional arguments, like a font of a certain size
+    /// \param id - resource ID of the path
+    /// \param variants - integral arguments that identify the resource
+    /// \return cache key
+    template <class... Variants>
+    static ResourceId GetCacheKey(ResourceId id, const Variants&... variants);
+
+    /// Internal function to record the requested resource if the recording is on
+    void RecordDependency(ResourceId id, ResourceCategory category, int fontSize = 0) { if (m_pRecordedDependencies) m_pRecordedDependencies->push_back({ id, category, fontSize }); }
+
+    /// Internal function to map the resource type to its category
+    template <class ResourceType>
+    static constexpr ResourceCategory GetCategory();
+
+    /// Internal function to map the resource type to the async request kind
+    template <class ResourceType>
+    static constexpr AsyncLoadRequest::Kind GetAsyncKind();
+
 public:
 	// --------------------------------------------------------------------- //
 	// Accessors & Mutators
 	// --------------------------------------------------------------------- //
 
+    /// Set max number of resources created by ProcessAsyncLoads in one frame
+    void SetMaxUploadsPerFrame(size_t maxUploads) { m_maxUploadsPerFrame = maxUploads; }
+
+    /// Get max number of resources created by ProcessAsyncLoads in one frame
+    size_t GetMaxUploadsPerFrame() const { return m_maxUploadsPerFrame; }
+
+    /// Get number of unfinished asynchronous loads
+    size_t GetPendingLoadCount() const { return m_pendingQueue.size(); }
+
+    /// Set max resident bytes before unused resources get evicted. 0 means unlimited
+    void SetMemoryBudget(size_t bytes) { m_memoryBudget = bytes; }
 
+    /// Get max resident bytes before unused resources get evicted. 0 means unlimited
+    size_t GetMemoryBudget() const { return m_memoryBudget; }
+
+    /// Set whether raw file bytes are dropped once a texture or sound is created from them
+    void SetReleaseRawData(bool release) { m_releaseRawData = release; }
+
+    /// Set whether files are memory mapped instead of read into memory. On by default
+    void SetUseMappedFiles(bool useMappedFiles) { m_useMappedFiles = useMappedFiles; }
+
+    /// Get the normalized path of the resource ID
+    /// \return pointer to the path, or null if the ID was never interned
+    const std::string* GetInternedPath(ResourceId id) const { return m_internedPaths.Find(id); }
+
+    /// Get the cache counters
+    const ResourceCacheStats& GetStats() const { return m_stats; }
+
+    /// Get approximate memory used by the resources of a category
+    size_t GetResidentBytes(ResourceCategory category) const { return m_stats.m_residentBytesByCategory[static_cast<size_t>(category)]; }
 };
 
 template<class ResourceType, class... Args>
-inline std::shared_ptr<ResourceType> ResourceCache::Load(const char* filepath, Args&&... args)
+inline std::shared_ptr<ResourceType> ResourceCache::Load(ResourceId id, Args&&... args)
 {
     static_assert(std::is_base_of_v<IResource, ResourceType>, "ResourceType template parameter must be a child of IResource");
-	assert(filepath && "filepath should be valid string");
 
-    if (m_resourceMap.count(filepath))
+    if constexpr (std::is_same_v<ResourceType, IFont>)
+        RecordDependency(id, ResourceCategory::kFont, static_cast<int>(args)...);
+    else
+        RecordDependency(id, GetCategory<ResourceType>());
+
+    ResourceId key = GetCacheKey(id, args...);
+    if (auto pCached = FindInCache(key); pCached != nullptr)
     {
-        return std::static_pointer_cast<ResourceType>(m_resourceMap[filepath]);
+        return std::static_pointer_cast<ResourceType>(pCached);
     }
 
-    std::shared_ptr<IResource> pLoaded = LoadResource(filepath);
+    if constexpr (!std::is_same_v<ResourceType, IFont>)
+    {
+        // Somebody has already requested it asynchronously, no need to read the file twice
+        if (auto pendingIt = m_pendingLoads.find(id); pendingIt != m_pendingLoads.end() && pendingIt->second->m_kind == GetAsyncKind<ResourceType>())
+        {
+            return std::static_pointer_cast<ResourceType>(WaitForAsyncLoad(pendingIt->second));
+        }
+    }
+
+    const std::string* pPath = m_internedPaths.Find(id);
+    assert(pPath && "Resource ID should be returned from InternPath");
+    if (!pPath)
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<IResource> pLoaded = LoadResource(pPath->c_str());
+    if (!pLoaded)
+    {
+        return nullptr;
+    }
 
     if constexpr (std::is_same_v<ResourceType, ITexture>)
     {
         std::shared_ptr<ITexture> pTexture = m_pGraphics->LoadTexture(pLoaded.get());
-        m_resourceMap[pTexture->GetName()] = pTexture;
+        if (pTexture)
+            AddToCache(key, pTexture, ResourceCategory::kTexture);
         return pTexture;
     }
     else if constexpr (std::is_same_v<ResourceType, ISound>)
     {
         std::shared_ptr<ISound> pSound = m_pAudio->LoadSound(pLoaded.get());
-        m_resourceMap[pSound->GetName()] = pSound;
+        if (pSound)
+            AddToCache(key, pSound, ResourceCategory::kSound);
         return pSound;
     }
     else if constexpr (std::is_same_v<ResourceType, IMusic>)
     {
         std::shared_ptr<IMusic> pMusic = m_pAudio->LoadMusic(pLoaded.get());
-        m_resourceMap[pMusic->GetName()] = pMusic;
+        if (pMusic)
+            AddToCache(key, pMusic, ResourceCategory::kMusic);
         return pMusic;
     }
     else if constexpr (std::is_same_v<ResourceType, IFont>)
     {
         std::shared_ptr<IFont> pFont = m_pFontLoader->LoadFont(pLoaded.get(), std::forward<Args>(args)...);
 		if (pFont)
-			m_resourceMap[pFont->GetName()] = pFont;
+            AddToCache(key, pFont, ResourceCategory::kFont);
         return pFont;
     }
 
-	// Have to construct the string here to avoid compiler warning. Doesn't matter, because the string will be constructed anyway in the [] map operator
-	std::string path(filepath);
-    m_resourceMap[path] = pLoaded;
+    AddToCache(key, pLoaded, ResourceCategory::kRaw);
     return std::static_pointer_cast<ResourceType>(pLoaded);
 }
 
+template<class ResourceType>
+inline ResourceHandle<ResourceType> ResourceCache::LoadAsync(ResourceId id)
+{
+    static_assert(std::is_base_of_v<IResource, ResourceType>, "ResourceType template parameter must be a child of IResource");
+    static_assert(!std::is_same_v<ResourceType, IFont>, "Fonts can't be loaded asynchronously");
+
+    RecordDependency(id, GetCategory<ResourceType>());
+
+    if (auto pCached = FindInCache(id); pCached != nullptr)
+    {
+        auto pRequest = std::make_shared<AsyncLoadRequest>();
+        pRequest->m_id = id;
+        pRequest->m_kind = GetAsyncKind<ResourceType>();
+        pRequest->m_pResult = pCached;
+        pRequest->m_isFinished = true;
+        return ResourceHandle<ResourceType>(pRequest);
+    }
+
+    return ResourceHandle<ResourceType>(QueueAsyncLoad(id, GetAsyncKind<ResourceType>()));
+}
+
+template<class... Variants>
+inline ResourceId ResourceCache::GetCacheKey(ResourceId id, const Variants&... variants)
+{
+    // Keep hashing the same way the path was hashed
+    ((id = (id ^ static_cast<uint64_t>(variants)) * kPrime64), ...);
+    return id;
+}
+
+template<class ResourceType>
+inline constexpr ResourceCategory ResourceCache::GetCategory()
+{
+    if constexpr (std::is_same_v<ResourceType, ITexture>)
+        return ResourceCategory::kTexture;
+    else if constexpr (std::is_same_v<ResourceType, ISound>)
+        return ResourceCategory::kSound;
+    else if constexpr (std::is_same_v<ResourceType, IMusic>)
+        return ResourceCategory::kMusic;
+    else if constexpr (std::is_same_v<ResourceType, IFont>)
+        return ResourceCategory::kFont;
+    else
+        return ResourceCategory::kRaw;
+}
+
+template<class ResourceType>
+inline constexpr AsyncLoadRequest::Kind ResourceCache::GetAsyncKind()
+{
+    if constexpr (std::is_same_v<ResourceType, ITexture>)
+        return AsyncLoadRequest::Kind::kTexture;
+    else if constexpr (std::is_same_v<ResourceType, ISound>)
+        return AsyncLoadRequest::Kind::kSound;
+    else if constexpr (std::is_same_v<ResourceType, IMusic>)
+        return AsyncLoadRequest::Kind::kMusic;
+    else
+        return AsyncLoadRequest::Kind::kRaw;
+}
+
+template<class ResourceType>
+inline std::shared_ptr<ResourceType> ResourceHandle<ResourceType>::Wait()
+{
+    if (!m_pRequest)
+        return nullptr;
+
+    if (!m_pRequest->m_isFinished)
+    {
+        ResourceCache::Get()->WaitForAsyncLoad(m_pRequest);
+    }
+
+    return Get();
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+/** \file ResourceHandle.h */
+/** Handle to a resource that is being loaded asynchronously */
+
+#include <memory>
+#include <string>
+#include <future>
+
+#include "Resource.h"
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \struct AsyncLoadRequest */
+/** Shared state of an asynchronous resource load. Filled by a worker thread first, then finished by ResourceCache on the main thread */
+struct AsyncLoadRequest
+{
+    /// Kind of the resource that is being loaded
+    enum class Kind
+    {
+        kRaw,           ///< Raw IResource
+        kTexture,       ///< ITexture. Decoded on the worker thread, uploaded on the main thread
+        kSound,         ///< ISound
+        kMusic,         ///< IMusic
+    };
+
+    ResourceId m_id = kInvalidResourceId;       ///< Key of the resource in the lookup table
+    std::string m_key;                          ///< Normalized path of the resource
+    Kind m_kind = Kind::kRaw;                   ///< Kind of the resource
+    std::future<void> m_workerJob;              ///< Worker thread job that reads (and decodes) the resource
+
+    std::shared_ptr<IResource> m_pRawResource;  ///< Raw resource read by the worker job
+    void* m_pDecodedImage = nullptr;            ///< Native image decoded by the worker job, textures only
+
+    std::shared_ptr<IResource> m_pResult;       ///< Loaded resource. Null until finished, or if loading failed
+    bool m_isFinished = false;                  ///< Set on the main thread once the resource is created
+};
+
+/** \class ResourceHandle */
+/** Lightweight handle to a resource requested by ResourceCache::LoadAsync. Can be polled every frame or waited on */
+template <class ResourceType>
+class ResourceHandle
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /** Default Constructor. Constructs an invalid handle */
+    ResourceHandle() = default;
+
+    /// Constructor
+    /// \param pRequest - shared state of the load request
+    explicit ResourceHandle(std::shared_ptr<AsyncLoadRequest> pRequest) : m_pRequest(std::move(pRequest)) {}
+
+    /// Blocks until the resource is loaded. Main thread only, since it finishes the load right away
+    /// \return shared pointer to the resource, null if loading failed
+    std::shared_ptr<ResourceType> Wait();
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+    std::shared_ptr<AsyncLoadRequest> m_pRequest;       ///< Shared state of the load request
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Was the handle returned by a load request
+    bool IsValid() const { return m_pRequest != nullptr; }
+
+    /// Is loading finished (successfully or not)
+    bool IsReady() const { return m_pRequest && m_pRequest->m_isFinished; }
+
+    /// Did loading fail
+    bool HasFailed() const { return IsReady() && !m_pRequest->m_pResult; }
+
+    /// Get the loaded resource
+    /// \return shared pointer to the resource, null if it is not ready yet
+    std::shared_ptr<ResourceType> Get() const { return IsReady() ? std::static_pointer_cast<ResourceType>(m_pRequest->m_pResult) : nullptr; }
+};
+}
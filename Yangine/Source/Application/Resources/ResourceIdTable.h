@@ -0,0 +1,178 @@
+#pragma once
+/** \file ResourceIdTable.h */
+/** Open addressing hash table keyed by resource IDs */
+
+#include <vector>
+#include <utility>
+#include <cassert>
+
+#include "Resource.h"
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \class ResourceIdTable */
+/** Linear probing hash table from ResourceId to a value. Resource IDs are hashes already, so a slot is picked with one multiply,
+    and the load factor is kept at or below a half, so a lookup is usually a single probe. Never allocates on lookup */
+template <class ValueType>
+class ResourceIdTable
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Finds the value
+    /// \param id - resource ID
+    /// \return pointer to the value, or null if the table doesn't contain the ID
+    ValueType* Find(ResourceId id);
+
+    /// Finds the value
+    /// \param id - resource ID
+    /// \return pointer to the value, or null if the table doesn't contain the ID
+    const ValueType* Find(ResourceId id) const { return const_cast<ResourceIdTable*>(this)->Find(id); }
+
+    /// Inserts the value, or replaces the value that is already there
+    /// \param id - resource ID, must be valid
+    /// \param value - value to insert
+    /// \return reference to the inserted value
+    ValueType& Insert(ResourceId id, ValueType&& value);
+
+    /// Removes the value
+    /// \param id - resource ID
+    /// \return true if the value was removed
+    bool Erase(ResourceId id);
+
+    /// Removes all values and releases the memory
+    void Clear() { std::vector<Slot>().swap(m_slots); m_size = 0; }
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+
+    static constexpr size_t kMinCapacity = 64;      ///< Capacity of the table after the first insertion
+
+    /// Table slot
+    struct Slot
+    {
+        ResourceId m_id = kInvalidResourceId;       ///< Key, invalid if the slot is empty
+        ValueType m_value;                          ///< Value
+    };
+
+    std::vector<Slot> m_slots;                      ///< Slots, the count is always a power of two
+    size_t m_size = 0;                              ///< Number of occupied slots
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Internal helper function. Get the slot the ID wants to be in
+    size_t GetHomeSlot(ResourceId id) const { return static_cast<size_t>((id * 0x9E3779B97F4A7C15ull) >> 32) & (m_slots.size() - 1); }
+
+    /// Internal helper function. Rehashes all values into a table with the new capacity
+    void Grow(size_t capacity);
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Get number of values in the table
+    size_t GetSize() const { return m_size; }
+};
+
+template<class ValueType>
+inline ValueType* ResourceIdTable<ValueType>::Find(ResourceId id)
+{
+    if (m_slots.empty() || id == kInvalidResourceId)
+        return nullptr;
+
+    for (size_t index = GetHomeSlot(id);; index = (index + 1) & (m_slots.size() - 1))
+    {
+        Slot& slot = m_slots[index];
+        if (slot.m_id == id)
+            return &slot.m_value;
+        if (slot.m_id == kInvalidResourceId)
+            return nullptr;
+    }
+}
+
+template<class ValueType>
+inline ValueType& ResourceIdTable<ValueType>::Insert(ResourceId id, ValueType&& value)
+{
+    assert(id != kInvalidResourceId && "Invalid resource ID can't be a key");
+
+    if ((m_size + 1) * 2 > m_slots.size())
+    {
+        Grow(m_slots.empty() ? kMinCapacity : m_slots.size() * 2);
+    }
+
+    size_t index = GetHomeSlot(id);
+    while (m_slots[index].m_id != kInvalidResourceId && m_slots[index].m_id != id)
+    {
+        index = (index + 1) & (m_slots.size() - 1);
+    }
+
+    Slot& slot = m_slots[index];
+    if (slot.m_id == kInvalidResourceId)
+    {
+        slot.m_id = id;
+        ++m_size;
+    }
+
+    slot.m_value = std::move(value);
+    return slot.m_value;
+}
+
+template<class ValueType>
+inline bool ResourceIdTable<ValueType>::Erase(ResourceId id)
+{
+    if (m_slots.empty() || id == kInvalidResourceId)
+        return false;
+
+    size_t mask = m_slots.size() - 1;
+    size_t index = GetHomeSlot(id);
+    while (m_slots[index].m_id != id)
+    {
+        if (m_slots[index].m_id == kInvalidResourceId)
+            return false;
+        index = (index + 1) & mask;
+    }
+
+    // Backward shift deletion: pull the following slots of the cluster into the hole if that doesn't move them before their home slot
+    for (size_t next = (index + 1) & mask; m_slots[next].m_id != kInvalidResourceId; next = (next + 1) & mask)
+    {
+        size_t home = GetHomeSlot(m_slots[next].m_id);
+        if (((next - home) & mask) >= ((next - index) & mask))
+        {
+            m_slots[index] = std::move(m_slots[next]);
+            index = next;
+        }
+    }
+
+    m_slots[index] = Slot();
+    --m_size;
+    return true;
+}
+
+template<class ValueType>
+inline void ResourceIdTable<ValueType>::Grow(size_t capacity)
+{
+    std::vector<Slot> oldSlots(capacity);
+    oldSlots.swap(m_slots);
+
+    for (Slot& slot : oldSlots)
+    {
+        if (slot.m_id == kInvalidResourceId)
+            continue;
+
+        size_t index = GetHomeSlot(slot.m_id);
+        while (m_slots[index].m_id != kInvalidResourceId)
+        {
+            index = (index + 1) & (m_slots.size() - 1);
+        }
+        m_slots[index] = std::move(slot);
+    }
+}
+}
@@ -41,6 +41,10 @@ public:
     /// \return true if the game should continue to run
     virtual bool ProcessEvents() = 0;
 
+    /// Gather the operating system events into the event queue without handling them. Has to be called on the thread
+    /// that created the window. ProcessEvents does it too, unless the events are pumped by another thread
+    virtual void PumpEvents() {}
+
     /// Get the underlying window object
     /// \return pointer to the underlying window object
     virtual void* GetNativeWindow() const = 0;
@@ -55,6 +59,7 @@ public:
 protected:
     std::unique_ptr<IKeyboard> m_pKeyboard;     ///< Keyboard owned by the window
     std::unique_ptr<IMouse> m_pMouse;           ///< Mouse owned by the window
+    bool m_areEventsPumpedElsewhere = false;    ///< Does another thread call PumpEvents, so ProcessEvents only handles the queued events
 
     /// Convert middleware-specific keycode to yang keycode
     /// \param code - key code returned by middleware
@@ -97,5 +102,9 @@ public:
     /// \return pointer to an associated mouse object
     virtual IMouse* GetMouse() { return m_pMouse.get(); }
 
+    /// Let the thread that created the window pump the events while ProcessEvents runs on the game thread
+    /// \param areEventsPumpedElsewhere - true if another thread calls PumpEvents
+    void SetEventsPumpedElsewhere(bool areEventsPumpedElsewhere) { m_areEventsPumpedElsewhere = areEventsPumpedElsewhere; }
+
 };
 }
\ No newline at end of file
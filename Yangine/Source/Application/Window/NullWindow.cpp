@@ -0,0 +1,11 @@
+#include "NullWindow.h"
+#include <Utils/Logger.h>
+
+using yang::NullWindow;
+
+bool yang::NullWindow::Init(const char* title, uint32_t width, uint32_t height)
+{
+    m_dimensions = IVec2(static_cast<int>(width), static_cast<int>(height));
+    LOG(Info, "Running %s without a window, %ux%u", title, width, height);
+	return true;
+}
@@ -0,0 +1,79 @@
+#pragma once
+/** \file NullWindow.h */
+/** IWindow specialization without an operating system window */
+
+#include ".\IWindow.h"
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \class NullWindow */
+/** Window of the headless runs. It has dimensions for the graphics system and input devices that never receive events,
+    and keeps the game running until RequestClose is called */
+class NullWindow
+	: public IWindow
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+	/** Default Constructor */
+	NullWindow() = default;
+
+	/** Default Destructor */
+	~NullWindow() = default;
+
+    /// Initialize the window dimensions
+    /// \param title - Window title, unused
+    /// \param width - Window width in pixels
+    /// \param height - Window height in pixels
+    /// \return true if successful
+	virtual bool Init(const char* title, uint32_t width, uint32_t height) override final;
+
+    /// There are no events to handle
+    /// \return false once RequestClose has been called
+	virtual bool ProcessEvents() override final { return !m_isCloseRequested; }
+
+    /// There is no native window
+    /// \return nullptr
+	virtual void* GetNativeWindow() const override final { return nullptr; }
+
+	/// \brief Get dimensions of the window
+	/// \return IVec2 that contains window dimensions
+	virtual IVec2 GetDimensions() const override final { return m_dimensions; }
+
+    /// Stop the game at the next ProcessEvents call
+    void RequestClose() { m_isCloseRequested = true; }
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+	IVec2 m_dimensions;                 ///< Width and height passed to Init
+    bool m_isCloseRequested = false;    ///< Should the next ProcessEvents stop the game
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// There are no native key codes
+    /// \return KeyCode::kMaxCodes
+    virtual IKeyboard::KeyCode ConvertKeyCode(uint32_t /*code*/) override final { return IKeyboard::KeyCode::kMaxCodes; }
+
+    /// There are no native mouse buttons
+    /// \return MouseButton::kMaxButtons
+    virtual IMouse::MouseButton ConvertMouseButton(uint32_t /*code*/) override final { return IMouse::MouseButton::kMaxButtons; }
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+};
+}
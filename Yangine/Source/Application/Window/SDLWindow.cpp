@@ -44,8 +44,14 @@ bool yang::SDLWindow::Init(const char* title, uint32_t width, uint32_t height)
 
 bool yang::SDLWindow::ProcessEvents()
 {
+	// SDL_PumpEvents is main thread only, SDL_PeepEvents can read the queue from the game thread
+	if (!m_areEventsPumpedElsewhere)
+	{
+		PumpEvents();
+	}
+
 	SDL_Event event;
-	while (SDL_PollEvent(&event))
+	while (SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT) > 0)
 	{
 		if (event.type == SDL_QUIT ||
 			(event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE))
@@ -82,6 +88,11 @@ bool yang::SDLWindow::ProcessEvents()
 	return true;
 }
 
+void yang::SDLWindow::PumpEvents()
+{
+	SDL_PumpEvents();
+}
+
 void* yang::SDLWindow::GetNativeWindow() const
 {
 	return m_pSDLWindow.get();
@@ -43,6 +43,9 @@ public:
     /// \return true if the game should continue to run
 	virtual bool ProcessEvents() override final;
 
+    /// Gather the events into the SDL event queue with SDL_PumpEvents. Main thread only
+    virtual void PumpEvents() override final;
+
     /// Get the underlying window object representation
     /// \return pointer to the SDL_Window
 	virtual void* GetNativeWindow() const override final;
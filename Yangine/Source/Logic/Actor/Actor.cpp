@@ -1,12 +1,16 @@
 #include "Actor.h"
 #include <Logic/Event/EventDispatcher.h>
 #include <Logic/Event/Events/DestroyActorEvent.h>
+#include <Logic/Scene/Scene.h>
+#include <Application/Graphics/IGraphics.h>
+#include <Application/Graphics/RenderQueue.h>
 #include <Utils/Logger.h>
 #include <Utils/TinyXml2/tinyxml2.h>
 #include <Utils/StringHash.h>
 
 #include <Logic/Scripting/LuaManager.h>
 #include <Lua/lua.hpp>
+#include <algorithm>
 
 using yang::Actor;
 
@@ -41,6 +45,7 @@ bool yang::Actor::Init(tinyxml2::XMLElement* pData)
         m_tag = "Unknown";
     }
     m_hashTag = StringHash32(m_tag.c_str());
+    m_renderDepth = pData->FloatAttribute("depth", 0.f);
 
     return true;
 }
@@ -63,6 +68,16 @@ void yang::Actor::Destroy()
     EventDispatcher::Get()->QueueEvent(std::make_unique<DestroyActorEvent>(m_id));
 }
 
+yang::EventDispatcher* yang::Actor::GetEventDispatcher() const
+{
+    if (auto pScene = m_pOwnerScene.lock(); pScene != nullptr)
+    {
+        return &pScene->GetEventDispatcher();
+    }
+
+    return EventDispatcher::Get();
+}
+
 void yang::Actor::Update(float deltaSeconds)
 {
     for (auto& componentPair : m_components)
@@ -74,12 +89,42 @@ void yang::Actor::Update(float deltaSeconds)
 void yang::Actor::Render(IGraphics* pGraphics)
 {
     LOG_ONCE(TODO, ConstCorrectness, "Function probably should be const");
+    // Components may draw a map on their own layers, so the actor layer is set for every actor
+    pGraphics->SetDrawLayer(RenderQueue::kActorLayer);
+    pGraphics->SetDrawDepth(m_renderDepth);
     for (auto& componentPair : m_components)
     {
         componentPair.second->Render(pGraphics);
     }
 }
 
+bool yang::Actor::GetRenderBounds(FRect& bounds) const
+{
+    bool hasBounds = false;
+    for (auto& componentPair : m_components)
+    {
+        FRect componentBounds;
+        if (!componentPair.second->GetRenderBounds(componentBounds))
+            continue;
+
+        if (!hasBounds)
+        {
+            bounds = componentBounds;
+            hasBounds = true;
+            continue;
+        }
+
+        float right = std::max(bounds.x + bounds.width, componentBounds.x + componentBounds.width);
+        float bottom = std::max(bounds.y + bounds.height, componentBounds.y + componentBounds.height);
+        bounds.x = std::min(bounds.x, componentBounds.x);
+        bounds.y = std::min(bounds.y, componentBounds.y);
+        bounds.width = right - bounds.x;
+        bounds.height = bottom - bounds.y;
+    }
+
+    return hasBounds;
+}
+
 void yang::Actor::AddComponent(std::unique_ptr<IComponent> pComponent)
 {
     if (!pComponent)
@@ -20,6 +20,7 @@ namespace yang
 	class LuaManager;
     class IView;
     class Scene;
+    class EventDispatcher;
 
 /** \class Actor */
 /** Represents an object in the game */
@@ -61,6 +62,11 @@ public:
     /// Renders the actor (calls Render on each component)
     /// \param pGraphics - pointer to renderer to use
     void Render(IGraphics* pGraphics); // TODO: const correctness
+
+    /// Get the union of render bounds of all components
+    /// \param bounds - set to the union
+    /// \return false if none of the components has render bounds. Such actors are never culled
+    bool GetRenderBounds(FRect& bounds) const;
     
     /// Adds the component to an actor
     /// \param pComponent - unique ptr to a component to add
@@ -109,6 +115,7 @@ private:
     std::string m_tag;                                                  ///< Actor name
     uint32_t m_hashTag;
     std::weak_ptr<Scene> m_pOwnerScene;
+    float m_renderDepth = 0.f;                                          ///< Draw order inside the actor layer when the render queue is enabled, higher is on top
 
 	// --------------------------------------------------------------------- //
 	// Private Member Functions
@@ -138,9 +145,20 @@ public:
     /// \return actor's hashed tag
     uint32_t GetHashTag() const { return m_hashTag; }
 
+    /// Get draw order of the actor inside the actor layer
+    float GetRenderDepth() const { return m_renderDepth; }
+
+    /// Set draw order of the actor inside the actor layer. Used only when the render queue is enabled
+    /// \param depth - higher depths are drawn on top, actors with the same depth in any order
+    void SetRenderDepth(float depth) { m_renderDepth = depth; }
+
     /// Get actor's owner scene ID
     /// \return owner scene ID
     std::shared_ptr<Scene> GetOwnerScene() const { return m_pOwnerScene.lock(); }
+
+    /// Get the dispatcher that components of this actor should listen to
+    /// \return owner scene's event dispatcher, or the global one if the actor has no owner scene
+    EventDispatcher* GetEventDispatcher() const;
 };
 
 // this actually doesn't work right now.
@@ -4,6 +4,7 @@
 #include <Logic/Actor/Actor.h>
 #include <Utils/Logger.h>
 #include <Utils/TinyXml2/tinyxml2.h>
+#include <Utils/BinaryXml.h>
 
 #include <Utils/StringHash.h>
 using yang::ActorFactory;
@@ -31,7 +32,7 @@ std::shared_ptr<yang::Actor> yang::ActorFactory::CreateActor(IResource* pActorRe
     using namespace tinyxml2;
 
     XMLDocument doc;
-    XMLError error = doc.Parse(reinterpret_cast<const char*>(pActorResource->GetData().data()), pActorResource->GetData().size());
+    XMLError error = LoadXmlDocument(pActorResource->GetData().data(), pActorResource->GetData().size(), doc);
     if (error != tinyxml2::XML_SUCCESS)
     {
         LOG(Error, "Failed to load actor: %s -- %s", pActorResource->GetName().c_str(), XMLDocument::ErrorIDToName(error));
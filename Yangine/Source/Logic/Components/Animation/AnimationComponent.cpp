@@ -2,6 +2,7 @@
 #include "AnimationComponent.h"
 #include <Logic/Scripting/LuaManager.h>
 #include <Application/Graphics/Textures/Sprite.h>
+#include <Application/Graphics/Textures/TextureAtlas.h>
 #include <Application/Resources/ResourceCache.h>
 #include <Utils/TinyXml2/tinyxml2.h>
 #include <Utils/Logger.h>
@@ -55,7 +56,9 @@ bool yang::AnimationComponent::Init(tinyxml2::XMLElement* pData)
         return false;
     }
 
-    auto pDefaultTexture = ResourceCache::Get()->Load<ITexture>(pDefaultSrcPath);
+    // Frame rects are relative to the textures, the atlas regions move them onto the pages the textures were packed into
+    IRect defaultRegion;
+    auto pDefaultTexture = TextureAtlas::Get()->LoadTexture(pDefaultSrcPath, defaultRegion);
 
     m_defaultFrameRate = pData->FloatAttribute("defaultFrameRate");
     if (m_defaultFrameRate == 0)
@@ -105,10 +108,11 @@ bool yang::AnimationComponent::Init(tinyxml2::XMLElement* pData)
 
         const char* pTextureSrc = pSequence->Attribute("src");
         std::shared_ptr<ITexture> pSequenceTexture = pDefaultTexture;
+        IRect sequenceRegion = defaultRegion;
 
         if (pTextureSrc)
         {
-            pSequenceTexture = ResourceCache::Get()->Load<ITexture>(pTextureSrc);
+            pSequenceTexture = TextureAtlas::Get()->LoadTexture(pTextureSrc, sequenceRegion);
         }
 
         float framerate = pSequence->FloatAttribute("framerate");
@@ -155,10 +159,11 @@ bool yang::AnimationComponent::Init(tinyxml2::XMLElement* pData)
 
             const char* pTextureSrc = pFrame->Attribute("src");
             std::shared_ptr<ITexture> pFrameTexture = pSequenceTexture;
+            IRect frameRegion = sequenceRegion;
 
             if (pTextureSrc)
             {
-                pFrameTexture = ResourceCache::Get()->Load<ITexture>(pTextureSrc);
+                pFrameTexture = TextureAtlas::Get()->LoadTexture(pTextureSrc, frameRegion);
             }
 
             float duration = pFrame->FloatAttribute("duration");
@@ -167,7 +172,7 @@ bool yang::AnimationComponent::Init(tinyxml2::XMLElement* pData)
                 duration = 1.f / sequence.m_framerate;
             }
 
-            sequence.m_frameData.push_back({ std::make_shared<Sprite>(pFrameTexture, frameRect, TextureDrawParams{}), duration });
+            sequence.m_frameData.push_back({ std::make_shared<Sprite>(pFrameTexture, TextureAtlas::ToPageRect(frameRegion, frameRect), TextureDrawParams{}), duration });
         }
 
         m_sequences.emplace(pSeqName, std::move(sequence));
@@ -26,6 +26,7 @@ std::unique_ptr<IComponent> IComponent::CreateComponent<StringHash32(ControllerC
 ControllerComponent::ControllerComponent(yang::Actor* pOwner)
     :IComponent(pOwner, GetName())
     ,m_eventListenerId(kInvalidValue<size_t>)
+    ,m_pEventDispatcher(nullptr)
 {
 	
 }
@@ -160,14 +161,16 @@ bool yang::ControllerComponent::PostInit()
         }
     }
 
-    m_eventListenerId = EventDispatcher::Get()->AddEventListener(KeyboardInputEvent::kEventId, [this](IEvent* pEvent) { HandleKeyInputEvent(pEvent); });
+    m_pEventDispatcher = GetOwner()->GetEventDispatcher();
+    m_eventListenerId = m_pEventDispatcher->AddEventListener(KeyboardInputEvent::kEventId, [this](IEvent* pEvent) { HandleKeyInputEvent(pEvent); });
 
     return true;
 }
 
 ControllerComponent::~ControllerComponent()
 {
-    EventDispatcher::Get()->RemoveEventListener(KeyboardInputEvent::kEventId, m_eventListenerId);
+    if (m_pEventDispatcher && IsValid(m_eventListenerId))
+        m_pEventDispatcher->RemoveEventListener(KeyboardInputEvent::kEventId, m_eventListenerId);
 }
 
 void yang::ControllerComponent::HandleKeyInputEvent(IEvent* pEvent)
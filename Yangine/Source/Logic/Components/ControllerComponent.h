@@ -67,6 +67,7 @@ private:
     KeyActionMap m_keyActionMap;    ///< Lookup table for callbacks
     std::vector<Id> m_targetIds;    ///< Associated components ID's
     size_t m_eventListenerId;       ///< Index of the event listener, associated with the keyboard input event
+    EventDispatcher* m_pEventDispatcher;   ///< Dispatcher the listener is registered to (owner scene's one)
 
 	// --------------------------------------------------------------------- //
 	// Private Member Functions
@@ -3,6 +3,7 @@
 #include <string>
 #include <memory>
 #include <Utils/Typedefs.h>
+#include <Utils/Rectangle.h>
 /** \file IComponent.h */
 /** IComponent interface description */
 
@@ -54,6 +55,11 @@ public:
     /// \return true if render was successful
     virtual bool Render(IGraphics* pGraphics) { return true; }
 
+    /// Get the world rectangle the component draws into. Used to cull actors outside of the viewport
+    /// \param bounds - set to the rectangle if the component knows it
+    /// \return false if the component doesn't draw anything, or can't tell where it draws
+    virtual bool GetRenderBounds(FRect& bounds) const { return false; }
+
     /// Hash the name of the component into a 32-bit integer
     /// \param name - component name
     /// \return hashed value
@@ -5,6 +5,7 @@
 #include <Utils/Logger.h>
 #include <Logic/Components/TransformComponent.h>
 #include <Logic/Actor/Actor.h>
+#include <Logic/Pathfinding/FlowField.h>
 
 #include <cassert>
 
@@ -65,6 +66,15 @@ void KinematicComponent::Stop()
     m_velocity = FVec2(0.f, 0.f);
 }
 
+void KinematicComponent::FollowFlowField(float deltaTime, const yang::FlowField& field, yang::IVec2 tileSize)
+{
+    if (deltaTime <= 0.f)
+        return;
+
+    FVec2 desiredVelocity = field.SampleDirection(m_pTransform->GetPosition(), tileSize) * m_maxSpeed;
+    Accelerate(deltaTime, (desiredVelocity - m_velocity) / deltaTime, 0.f);
+}
+
 bool KinematicComponent::Init(tinyxml2::XMLElement* pData)
 {
     assert(pData);
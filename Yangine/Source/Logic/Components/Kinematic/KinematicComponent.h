@@ -6,6 +6,7 @@
 namespace yang
 {
     class TransformComponent;
+    class FlowField;
 
 class KinematicComponent : public yang::IComponent
 {
@@ -19,6 +20,12 @@ public:
     virtual bool PostInit() override final;
 
     void SetOrientationFromVelocity();
+
+    /// Accelerates towards the direction of the flow field at the owner's position, at maximum speed. Stops at the goal
+    /// \param deltaTime - number of seconds since last frame
+    /// \param field - flow field to follow
+    /// \param tileSize - size of a field cell in pixels
+    void FollowFlowField(float deltaTime, const yang::FlowField& field, yang::IVec2 tileSize);
     
     static constexpr const char* GetName() { return "KinematicComponent"; }
 private:
@@ -1,10 +1,9 @@
 #include "MouseInputListener.h"
 #include <Logic/Actor/Actor.h>
-#include <Logic/Event/EventDispatcher.h>
 #include <Logic/Event/Events/CreateActorEvent.h>
-#include <Logic/Event/Input/MouseMotionEvent.h>
 #include <Logic/Event/Input/MouseButtonEvent.h>
-#include <Logic/Event/Input/MouseWheelEvent.h>
+#include <Logic/Scene/Scene.h>
+#include <Logic/Scene/UIHitTestService.h>
 #include <Logic/Components/TransformComponent.h>
 #include <Logic/Scripting/LuaManager.h>
 #include <Logic/Scripting/LuaState.h>
@@ -44,101 +43,95 @@ std::unique_ptr<IComponent> IComponent::CreateComponent<StringHash32(MouseInputL
 
 MouseInputListener::MouseInputListener(Actor* pOwner)
     :IComponent(pOwner, GetName())
+    ,m_pTransform(nullptr)
     ,m_onClick(nullptr)
     , m_onMouseOver(nullptr)
     , m_onMouseOut(nullptr)
     ,m_onDoubleClick(nullptr)
     ,m_onScrollWheel(nullptr)
-    ,m_mouseMotionListenerIndex(kInvalidValue<size_t>)
-    ,m_clickListenerIndex(kInvalidValue<size_t>)
-    ,m_wheelListenerIndex(kInvalidValue<size_t>)
+    ,m_hitTestRect(0, 0, 0, 0)
+    ,m_pHitTestService(nullptr)
+    ,m_hitTestHandle(kInvalidValue<size_t>)
 {
 	
 }
 
 MouseInputListener::~MouseInputListener()
 {
-    EventDispatcher* pDispatcher = EventDispatcher::Get();
-    assert(pDispatcher);
-
-    if (IsValid(m_mouseMotionListenerIndex))
-        pDispatcher->RemoveEventListener(MouseMotionEvent::kEventId, m_mouseMotionListenerIndex);
-
-    if (IsValid(m_clickListenerIndex))
-        pDispatcher->RemoveEventListener(MouseButtonEvent::kEventId, m_clickListenerIndex);
+    if (m_pHitTestService && IsValid(m_hitTestHandle))
+        m_pHitTestService->RemoveListener(m_hitTestHandle);
 }
 
-void yang::MouseInputListener::HandleMouseMotion(IEvent* pEvent)
+void yang::MouseInputListener::Update(float deltaSeconds)
 {
-    assert(MouseMotionEvent::kEventId == pEvent->GetEventId());
-    MouseMotionEvent* pResult = static_cast<MouseMotionEvent*>(pEvent);
+    if (!m_pHitTestService)
+        return;
 
-    IRect collider(m_pTransform->GetPosition(), m_colliderDimensions);
-    if (!collider.Contains(pResult->GetStartPoint()) &&
-        collider.Contains(pResult->GetEndPoint()))
+    IRect rect = CalculateHitTestRect();
+    if (rect.x != m_hitTestRect.x || rect.y != m_hitTestRect.y || rect.width != m_hitTestRect.width || rect.height != m_hitTestRect.height)
     {
-        LOG(Info, "OnMouseOver triggered at position: x = %d, y = %d", pResult->GetEndPoint().x, pResult->GetEndPoint().y);
-        if (m_onMouseOver)
-        {
-            m_onMouseOver();
-        }
-
-        m_onMouseOverLua.Call<void>();
+        m_hitTestRect = rect;
+        m_pHitTestService->UpdateListener(m_hitTestHandle, m_hitTestRect);
     }
-    else if (collider.Contains(pResult->GetStartPoint()) &&
-             !collider.Contains(pResult->GetEndPoint()))
+}
+
+void yang::MouseInputListener::HandleMouseOver()
+{
+    if (m_onMouseOver)
     {
-        LOG(Info, "OnMouseOut triggered at position: x = %d, y = %d", pResult->GetEndPoint().x, pResult->GetEndPoint().y);
-        if (m_onMouseOut)
-        {
-            m_onMouseOut();
-        }
-        m_onMouseOutLua.Call<void>();
+        m_onMouseOver();
     }
+
+    m_onMouseOverLua.Call<void>();
 }
 
-void yang::MouseInputListener::HandleClick(IEvent* pEvent)
+void yang::MouseInputListener::HandleMouseOut()
 {
-    assert(MouseButtonEvent::kEventId == pEvent->GetEventId());
-    MouseButtonEvent* pResult = static_cast<MouseButtonEvent*>(pEvent);
+    if (m_onMouseOut)
+    {
+        m_onMouseOut();
+    }
+
+    m_onMouseOutLua.Call<void>();
+}
 
-    IRect collider(m_pTransform->GetPosition(), m_colliderDimensions);
-    if (pResult->GetEventType() == MouseButtonEvent::EventType::kButtonPressed &&
-        pResult->GetMouseButton() == IMouse::MouseButton::kLeft)
+void yang::MouseInputListener::HandleClick(MouseButtonEvent* pEvent)
+{
+    if (pEvent->GetEventType() == MouseButtonEvent::EventType::kButtonPressed &&
+        pEvent->GetMouseButton() == IMouse::MouseButton::kLeft)
     {
-        LOG(Info, "OnClick triggered at position: x = %d, y = %d", pResult->GetClickPosition().x, pResult->GetClickPosition().y);
         if (m_onClick)
         {
-            m_onClick(pResult->GetClickPosition());
+            m_onClick(pEvent->GetClickPosition());
         }
-        m_onClickLua.Call<void>(pResult->GetClickPosition());
+        m_onClickLua.Call<void>(pEvent->GetClickPosition());
     }
-    else if (pResult->GetEventType() == MouseButtonEvent::EventType::kButtonPressed &&
-             pResult->GetMouseButton() == IMouse::MouseButton::kRight)
+    else if (pEvent->GetEventType() == MouseButtonEvent::EventType::kButtonPressed &&
+             pEvent->GetMouseButton() == IMouse::MouseButton::kRight)
     {
-        LOG(Info, "OnRightClick triggered at position: x = %d, y = %d", pResult->GetClickPosition().x, pResult->GetClickPosition().y);
         if (m_onRightClick)
         {
-            m_onRightClick(pResult->GetClickPosition());
+            m_onRightClick(pEvent->GetClickPosition());
         }
-        m_onRightClickLua.Call<void>(pResult->GetClickPosition());
+        m_onRightClickLua.Call<void>(pEvent->GetClickPosition());
     }
 
     LOG_ONCE(TODO, ImplementDoubleClick, "");
 }
 
-void yang::MouseInputListener::HandleWheelScroll(IEvent* pEvent)
+void yang::MouseInputListener::HandleWheelScroll(const IVec2& scrollAmount)
 {
-    assert(MouseWheelEvent::kEventId == pEvent->GetEventId());
-    MouseWheelEvent* pResult = static_cast<MouseWheelEvent*>(pEvent);
     if (m_onScrollWheel)
     {
-        LOG(Info, "OnScrollWheel triggered with amount: x = %d, y = %d", pResult->GetScrollAmount().x, pResult->GetScrollAmount().y);
-
         // So this can crash probably
-        m_onScrollWheel(pResult->GetScrollAmount());
+        m_onScrollWheel(scrollAmount);
     }
-    m_onScrollWheelLua.Call<void>(pResult->GetScrollAmount());
+    m_onScrollWheelLua.Call<void>(scrollAmount);
+}
+
+yang::IRect yang::MouseInputListener::CalculateHitTestRect() const
+{
+    return IRect(m_pTransform->GetPosition(), m_colliderDimensions);
 }
 
 void yang::MouseInputListener::RegisterToLua(const LuaManager& manager)
@@ -182,8 +175,6 @@ bool yang::MouseInputListener::Init(tinyxml2::XMLElement* pData)
 
 bool yang::MouseInputListener::PostInit()
 {
-    LOG_ONCE(TODO, MouseInputListenerPostInit, "Change this function, so it registers itself to events event if it doesn't have attached functions. For lua purposes");
-
     m_pTransform = GetOwner()->GetComponent<TransformComponent>();
     if (!m_pTransform)
     {
@@ -191,33 +182,17 @@ bool yang::MouseInputListener::PostInit()
         return false;
     }
 
-    EventDispatcher* pDispatcher = EventDispatcher::Get();
-    assert(pDispatcher);
-
-    bool hasMouseMotion = m_onMouseOver || m_onMouseOut;
-    bool hasClick = m_onClick || m_onRightClick || m_onDoubleClick;
-    bool hasWheel = m_onScrollWheel != nullptr;
-    bool hasNothing = !hasMouseMotion && !hasClick && !hasWheel;
-
-    if (hasMouseMotion)
+    // Registered even without attached callbacks, so Lua can set them later. The service doesn't call anything until the rectangle is hit
+    auto pScene = GetOwner()->GetOwnerScene();
+    if (!pScene)
     {
-        m_mouseMotionListenerIndex = pDispatcher->AddEventListener(MouseMotionEvent::kEventId, [this](IEvent* pEvent) {HandleMouseMotion(pEvent); });
-    }
-    
-    if (hasClick)
-    {
-        m_clickListenerIndex = pDispatcher->AddEventListener(MouseButtonEvent::kEventId, [this](IEvent* pEvent) {HandleClick(pEvent); });
+        LOG(Error, "Mouse input listener needs an owner scene to receive mouse events");
+        return false;
     }
 
-    if (hasWheel)
-    {
-        m_wheelListenerIndex = pDispatcher->AddEventListener(MouseWheelEvent::kEventId, [this](IEvent* pEvent) {HandleWheelScroll(pEvent); });
-    }
-    
-    if (hasNothing)
-    {
-        LOG(Warning, "Listener is deaf, why is it here?");
-    }
+    m_pHitTestService = &pScene->GetUIHitTestService();
+    m_hitTestRect = CalculateHitTestRect();
+    m_hitTestHandle = m_pHitTestService->AddListener(this, m_hitTestRect);
 
     return true;
-}
+}
\ No newline at end of file
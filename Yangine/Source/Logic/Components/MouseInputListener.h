@@ -5,19 +5,22 @@
 #include ".\IComponent.h"
 #include <Logic/Scripting/LuaCallback.h>
 #include <Utils/Math.h>
+#include <Utils/Rectangle.h>
 #include <functional>
 
 //! \namespace yang Contains all Yangine code
 namespace yang
 {
     class TransformComponent;
-    class IEvent;
+    class UIHitTestService;
+    class MouseButtonEvent;
     class LuaManager;
 /** \class MouseInputListener */
-/** Actor component that handle mouse input to control the actor */
+/** Actor component that handle mouse input to control the actor. Mouse events are routed to it by the owner scene's UIHitTestService */
 class MouseInputListener
 	: public IComponent
 {
+    friend class UIHitTestService;
 public:
 	// --------------------------------------------------------------------- //
 	// Public Member Variables
@@ -40,10 +43,14 @@ public:
     /// \return true if initialized successfully
     virtual bool Init(tinyxml2::XMLElement* pData) override final;
 
-    /// Obtains reference to actor's transform component
+    /// Obtains reference to actor's transform component and registers the listener in the scene hit test service
     /// \return true if actor has transform component
     virtual bool PostInit() override final;
 
+    /// Keeps the hit test rectangle in sync with the actor's transform
+    /// \param deltaSeconds - time passed since last frame
+    virtual void Update(float deltaSeconds) override final;
+
     /// Name of this component, used for hashing
     /// \return "MouseInputListener"
     static constexpr const char* GetName() { return "MouseInputListener"; }
@@ -61,6 +68,9 @@ private:
     // TODO: consider just grabbing SpriteComponent? 
     TransformComponent* m_pTransform;                                   ///< Owner actor's transform component
     IVec2 m_colliderDimensions;                                         ///< Dimensions of the actor's collider
+    IRect m_hitTestRect;                                                ///< Rectangle registered in the hit test service
+    UIHitTestService* m_pHitTestService;                                ///< Owner scene's hit test service
+    size_t m_hitTestHandle;                                             ///< Handle of this listener in the hit test service
 
     std::function<void()> m_onMouseOver;                                ///< Callback that is called when mouse cursor is on the actor
     std::function<void()> m_onMouseOut;                                 ///< Callback that is called when mouse cursor leaves the actor
@@ -81,14 +91,13 @@ private:
 	// Private Member Functions
 	// --------------------------------------------------------------------- //
 
-    size_t m_mouseMotionListenerIndex;                                  ///< Index of the event listener, associated with the mouse motion event
-    void HandleMouseMotion(IEvent* pEvent);                             ///< Callback for event system that handles the mouse motion event
-
-    size_t m_clickListenerIndex;                                        ///< Index of the event listener, associated with the mouse click event
-    void HandleClick(IEvent* pEvent);                                   ///< Callback for event system that handles the mouse click event
+    void HandleMouseOver();                                             ///< Called by the hit test service when the cursor enters the listener rectangle
+    void HandleMouseOut();                                              ///< Called by the hit test service when the cursor leaves the listener rectangle
+    void HandleClick(MouseButtonEvent* pEvent);                         ///< Called by the hit test service when a mouse button is clicked inside the listener rectangle
+    void HandleWheelScroll(const IVec2& scrollAmount);                  ///< Called by the hit test service when the wheel is scrolled while the cursor is inside the listener rectangle
 
-    size_t m_wheelListenerIndex;                                        ///< Index of the event listener, associated with the mouse wheel event
-    void HandleWheelScroll(IEvent* pEvent);                             ///< Callback for event system that handles the mouse wheel event
+    /// Get the hit test rectangle from the current transform
+    IRect CalculateHitTestRect() const;
 
 public:
 	// --------------------------------------------------------------------- //
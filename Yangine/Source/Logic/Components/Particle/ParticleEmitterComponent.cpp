@@ -8,6 +8,7 @@
 #include <Application/Graphics/Textures/Sprite.h>
 #include <Logic/Actor/Actor.h>
 #include <Logic/Components/TransformComponent.h>
+#include <algorithm>
 
 using yang::ParticleEmitterComponent;
 using yang::IComponent;
@@ -101,13 +102,13 @@ void yang::ParticleEmitterComponent::Update(float deltaSeconds)
 
 bool yang::ParticleEmitterComponent::Render(yang::IGraphics* pGraphics)
 {
-	bool success = true;
 	yang::FVec2 transformPosition = m_pOwnerTransform->GetPosition();
 	yang::FVec2 scaleFactors = m_pOwnerTransform->GetScaleFactors();
 
 	// may be needed later in refactoring?
 	//float rotationAngle = m_pOwnerTransform->GetRotation();
 
+	m_particleRects.clear();
 	for (const auto& particle : m_particles)
 	{
 		Vector2<float> position = particle.m_positionOffset;
@@ -117,22 +118,50 @@ bool yang::ParticleEmitterComponent::Render(yang::IGraphics* pGraphics)
 		particleTransform.y = transformPosition.y + m_centerOffset.y + position.y;
 		particleTransform.height = m_size.y * scaleFactors.y;	// Particle's height
 		particleTransform.width = m_size.x * scaleFactors.x;	// Particle's width
+		m_particleRects.push_back(particleTransform);
+	}
+
+	if (m_particleRects.empty())
+		return true;
 
-		success = success && std::visit([pGraphics, particleTransform](auto&& drawable) -> bool
+	// Every particle looks the same, so all of them go to the graphics in one batch
+	return std::visit([this, pGraphics](auto&& drawable) -> bool
+		{
+			using Type = std::decay_t<decltype(drawable)>;
+			if constexpr (std::is_same_v<Type, std::shared_ptr<yang::Sprite>>)
+			{
+				return pGraphics->DrawSprites(drawable, m_particleRects.data(), m_particleRects.size());
+			}
+			else if constexpr (std::is_same_v<Type, yang::IColor>)
 			{
-				using Type = std::decay_t<decltype(drawable)>;
-				if constexpr (std::is_same_v<Type, std::shared_ptr<yang::Sprite>>)
-				{
-					return pGraphics->DrawSprite(drawable, particleTransform);
-				}
-				else if constexpr (std::is_same_v<Type, yang::IColor>)
-				{
-					return pGraphics->FillRect(particleTransform, drawable);
-				}
-			}, m_drawable);
+				return pGraphics->FillRects(m_particleRects.data(), m_particleRects.size(), drawable);
+			}
+		}, m_drawable);
+}
+
+bool yang::ParticleEmitterComponent::GetRenderBounds(yang::FRect& bounds) const
+{
+	if (m_particles.empty())
+		return false;
+
+	FVec2 minOffset = m_particles.front().m_positionOffset;
+	FVec2 maxOffset = minOffset;
+	for (const auto& particle : m_particles)
+	{
+		minOffset.x = std::min(minOffset.x, particle.m_positionOffset.x);
+		minOffset.y = std::min(minOffset.y, particle.m_positionOffset.y);
+		maxOffset.x = std::max(maxOffset.x, particle.m_positionOffset.x);
+		maxOffset.y = std::max(maxOffset.y, particle.m_positionOffset.y);
 	}
 
-	return success;
+	// Same placement as in Render: particle rectangles start at their positions
+	yang::FVec2 origin = m_pOwnerTransform->GetPosition() + m_centerOffset;
+	yang::FVec2 scaleFactors = m_pOwnerTransform->GetScaleFactors();
+	bounds.x = origin.x + minOffset.x;
+	bounds.y = origin.y + minOffset.y;
+	bounds.width = maxOffset.x - minOffset.x + m_size.x * scaleFactors.x;
+	bounds.height = maxOffset.y - minOffset.y + m_size.y * scaleFactors.y;
+	return true;
 }
 
 bool yang::ParticleEmitterComponent::PostInit()
@@ -7,6 +7,7 @@
 #include <Utils/Vector2.h>
 #include <Utils/Random.h>
 #include <Utils/Color.h>
+#include <Utils/Rectangle.h>
 #include <vector>
 #include <variant>
 
@@ -54,6 +55,13 @@ public:
 	/// <returns>true if rendered successfully</returns>
 	virtual bool Render(yang::IGraphics* pGraphics) override final;
 
+	/// <summary>
+	/// Gets the rectangle that contains all particles
+	/// </summary>
+	/// <param name="bounds"> set to the rectangle</param>
+	/// <returns>false if there are no particles</returns>
+	virtual bool GetRenderBounds(yang::FRect& bounds) const override final;
+
 	/// <summary>
 	/// Post initializes the component (gets the pointer to an actor's transform component)
 	/// </summary>
@@ -96,6 +104,7 @@ private:
 	FVec2 m_speedRange = { 0,0 };										  ///< Range of starting particle speeds
 	FVec2 m_angleRange = { 0,0 };										  ///< Range of initial spawn angle
 	bool m_isEmitting = false;											  ///< If we are emitting this particle
+	std::vector<FRect> m_particleRects = {};							  ///< Screen rectangles of the particles, refilled by every Render
 
 	yang::TransformComponent* m_pOwnerTransform = nullptr;
 	// --------------------------------------------------------------------- //
@@ -8,6 +8,7 @@
 #include <Logic/Components/TransformComponent.h>
 #include <Logic/Scripting/LuaManager.h>
 #include <cassert>
+#include <cmath>
 
 using yang::SpriteComponent;
 using yang::IComponent;
@@ -82,6 +83,17 @@ bool yang::SpriteComponent::Render(IGraphics* pGraphics)
     return pGraphics->DrawSprite(m_pSprite, dest);
 }
 
+bool yang::SpriteComponent::GetRenderBounds(FRect& bounds) const
+{
+    assert(m_pTransform != nullptr);
+
+    // Same rectangle as in Render. Rotation can swing the corners out of it, so the rectangle is grown to the circle around it
+    const FVec2& position = m_pTransform->GetPosition();
+    float radius = std::sqrt(static_cast<float>(m_spriteDimensions.x * m_spriteDimensions.x + m_spriteDimensions.y * m_spriteDimensions.y));
+    bounds = FRect(position.x - radius, position.y - radius, 2.f * radius, 2.f * radius);
+    return true;
+}
+
 void yang::SpriteComponent::RegisterToLua(const LuaManager& luaManager)
 {
 	luaManager.ExposeToLua("SetRotationAngle", &SpriteComponent::SetRotationAngle);
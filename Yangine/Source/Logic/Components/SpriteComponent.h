@@ -54,6 +54,11 @@ public:
     /// \return true if render was successful
     virtual bool Render(IGraphics* pGraphics) override;
 
+    /// Get the rectangle the sprite is drawn to
+    /// \param bounds - set to the rectangle
+    /// \return true
+    virtual bool GetRenderBounds(FRect& bounds) const override;
+
     /// Registers member functions to Lua environment
     /// Not intended for use outside of IGameLayer::Init
     /// \param luaManager - the Lua environment manager \see yang::LuaManager
@@ -4,6 +4,7 @@
 #include <string_view>
 #include <Utils/TinyXml2/tinyxml2.h>
 #include <Utils/Logger.h>
+#include <Application/Graphics/IGraphics.h>
 #include <Application/Graphics/Fonts/IFont.h>
 #include <Application/Graphics/Textures/ITexture.h>
 #include <Application/Resources/ResourceCache.h>
@@ -23,8 +24,9 @@ std::unique_ptr<IComponent> yang::IComponent::CreateComponent<StringHash32(TextC
 
 TextComponent::TextComponent(yang::Actor* pOwner)
 	:IComponent(pOwner, GetName())
-	,m_pTexture(nullptr)
+	,m_pGlyphAtlas(nullptr)
 	,m_pFont(nullptr)
+	,m_textSize(0, 0)
 	,m_textColor(0xFFFFFFFF)
 	,m_pTransform(nullptr)
 {
@@ -65,7 +67,6 @@ bool yang::TextComponent::Init(tinyxml2::XMLElement* pData)
 	if (!pText)
 	{
 		LOG(Warning, "Failed to found string data, text string is not initialized");
-		m_pTexture = nullptr;
 	}
 	else
 	{
@@ -76,7 +77,7 @@ bool yang::TextComponent::Init(tinyxml2::XMLElement* pData)
 			++pText;
 		}
 
-		m_pTexture = m_pFont->CreateTextureFromString(pText);
+		LayoutText(pText);
 	}
 
 	const char* pColor = pData->Attribute("hexColor");
@@ -110,35 +111,66 @@ bool yang::TextComponent::Render(IGraphics* pGraphics)
 {
 	assert(m_pTransform);
 
-	FVec2 position = m_pTransform->GetPosition();
-	IVec2 dimensions = m_pTexture->GetDimensions();
+	if (m_glyphQuads.empty() || !m_pGlyphAtlas)
+		return true;
 
-	//pGraphics->DrawTexture(m_pTexture.get(), IVec2(position));
-	pGraphics->DrawTexture(m_pTexture.get(), IVec2(position) - dimensions / 2);
+	// The layout only moves when the actor does
+	FVec2 topLeft = FVec2(IVec2(m_pTransform->GetPosition()) - m_textSize / 2);
+	if (m_drawQuads.size() != m_glyphQuads.size() || !(topLeft == m_drawnPosition))
+	{
+		m_drawQuads = m_glyphQuads;
+		for (TextureQuad& quad : m_drawQuads)
+		{
+			quad.m_dst.x += topLeft.x;
+			quad.m_dst.y += topLeft.y;
+		}
+		m_drawnPosition = topLeft;
+	}
+
+	// The atlas is shared by all texts of the font, its tint is only borrowed for this batch
+	IColor atlasTint = m_pGlyphAtlas->GetTint();
+	m_pGlyphAtlas->SetTint(m_textColor);
+	bool isDrawn = pGraphics->DrawTextureBatch(m_pGlyphAtlas.get(), m_drawQuads.data(), m_drawQuads.size());
+	m_pGlyphAtlas->SetTint(atlasTint);
+
+	return isDrawn;
+}
+
+bool yang::TextComponent::GetRenderBounds(FRect& bounds) const
+{
+	assert(m_pTransform);
+
+	if (m_glyphQuads.empty())
+		return false;
 
-	return false;
+	IVec2 topLeft = IVec2(m_pTransform->GetPosition()) - m_textSize / 2;
+	bounds = FRect(IRect(topLeft.x, topLeft.y, m_textSize.x, m_textSize.y));
+	return true;
 }
 
 void yang::TextComponent::UpdateText(const std::string& text)
 {
-	m_pTexture = m_pFont->CreateTextureFromString(text.c_str());
-	m_pTexture->SetTint(m_textColor);
+	LayoutText(text);
 }
 
 void yang::TextComponent::UpdateText(std::string_view text)
 {
-	m_pTexture = m_pFont->CreateTextureFromString(text.data());
-	m_pTexture->SetTint(m_textColor);
+	LayoutText(text);
 }
 
 yang::IVec2 yang::TextComponent::GetTextureDimensions() const
 {
-	return m_pTexture ? m_pTexture->GetDimensions() : IVec2(0, 0);
+	return m_textSize;
 }
 
 void yang::TextComponent::SetColor(IColor color)
 {
 	m_textColor = color;
-	if (m_pTexture)
-		m_pTexture->SetTint(color);
+}
+
+void yang::TextComponent::LayoutText(std::string_view text)
+{
+	m_pGlyphAtlas = m_pFont->GetGlyphAtlas();
+	m_textSize = m_pFont->LayoutString(text, m_glyphQuads);
+	m_drawQuads.clear();
 }
@@ -6,9 +6,11 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 #include <Utils/Math.h>
 #include <Utils/Vector2.h>
 #include <Utils/Color.h>
+#include <Application/Graphics/IGraphics.h>
 
 //! \namespace yang Contains all Yangine code
 namespace yang
@@ -17,7 +19,8 @@ namespace yang
 	class ITexture;
 	class TransformComponent;
 /** \class TextComponent */
-/** Actor component that handles the text data and rendering */
+/** Actor component that handles the text data and rendering. The text is laid out as glyph quads of the font atlas
+	when it changes, and drawn from the atlas in one batch, so changing text every frame doesn't create textures */
 class TextComponent
 	: public IComponent
 {
@@ -51,15 +54,22 @@ public:
 	/// return true if transform component found
 	virtual bool PostInit() override final;
 
-	/// Renders the text to screen
+	/// Renders the text to screen in one batch from the glyph atlas
 	/// \param pGraphics - graphics that will draw the text
 	/// \return true if rendered successfully
 	virtual bool Render(IGraphics* pGraphics) override final;
 
+	/// Get the rectangle the text is drawn to
+	/// \param bounds - set to the rectangle
+	/// \return false if there is no text
+	virtual bool GetRenderBounds(FRect& bounds) const override final;
+
 	/// Updates the text of this component
 	/// \param text - new text to draw
 	void UpdateText(const std::string& text);
 
+	/// Updates the text of this component
+	/// \param text - new text to draw
 	void UpdateText(std::string_view text);
 
 private:
@@ -67,7 +77,11 @@ private:
 	// Private Member Variables
 	// --------------------------------------------------------------------- //
 	std::shared_ptr<IFont> m_pFont;			///< Font to use
-	std::shared_ptr<ITexture> m_pTexture;	///< Texture that contains text
+	std::shared_ptr<ITexture> m_pGlyphAtlas;	///< Texture of the font the glyphs are drawn from
+	std::vector<TextureQuad> m_glyphQuads;		///< Glyphs of the text, relative to its top left corner
+	std::vector<TextureQuad> m_drawQuads;		///< Glyphs of the text at m_drawnPosition
+	IVec2 m_textSize;							///< Width and height of the text
+	FVec2 m_drawnPosition;						///< Top left corner m_drawQuads were moved to
 	TransformComponent* m_pTransform;		///< TransformComponent of the owner actor
 	FVec2 m_relativePosition;				///< Position relative to the owning actor transform
 	IColor m_textColor;					    ///< Color to render the text in
@@ -75,14 +89,18 @@ private:
 	// Private Member Functions
 	// --------------------------------------------------------------------- //
 
+	/// Lays the text out with the font and invalidates the drawn quads
+	/// \param text - text to lay out
+	void LayoutText(std::string_view text);
+
 
 public:
 	// --------------------------------------------------------------------- //
 	// Accessors & Mutators
 	// --------------------------------------------------------------------- //
 
-	/// Getter for texture dimensions
-	/// \return IVec2 that contains width and height of the contained texture
+	/// Getter for text dimensions
+	/// \return IVec2 that contains width and height of the text
 	IVec2 GetTextureDimensions() const;
 
 	/// Getter for relative position
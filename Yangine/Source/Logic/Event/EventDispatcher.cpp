@@ -1,9 +1,13 @@
 #include "EventDispatcher.h"
 #include <Utils/Logger.h>
+#include <algorithm>
 
 using yang::EventDispatcher;
 
 EventDispatcher::EventDispatcher()
+    :m_isEnabled(true)
+    ,m_invocationCount(0)
+    ,m_lastFrameInvocationCount(0)
 {
 	
 }
@@ -59,14 +63,28 @@ void yang::EventDispatcher::QueueEvent(std::unique_ptr<IEvent> pEvent)
 
 void yang::EventDispatcher::TriggerEvent(IEvent* pEvent)
 {
-    auto& listeners = m_eventListeners[pEvent->GetEventId()];
-    for (auto& listener : listeners)
+    // Paused scenes don't pay for their listeners at all
+    if (!m_isEnabled)
+        return;
+
+    if (auto listenersIt = m_eventListeners.find(pEvent->GetEventId()); listenersIt != m_eventListeners.end())
     {
-        if (listener)
+        // Index loop, because a listener is allowed to add another listener for the same event
+        auto& listeners = listenersIt->second;
+        for (size_t index = 0; index < listeners.size(); ++index)
         {
-            listener(pEvent);
+            if (listeners[index])
+            {
+                ++m_invocationCount;
+                listeners[index](pEvent);
+            }
         }
     }
+
+    for (size_t index = 0; index < m_forwardTargets.size(); ++index)
+    {
+        m_forwardTargets[index]->TriggerEvent(pEvent);
+    }
 }
 
 void yang::EventDispatcher::TriggerEvent(std::unique_ptr<IEvent> pEvent)
@@ -84,3 +102,32 @@ void yang::EventDispatcher::ProcessEvents()
         TriggerEvent(pEvent.get());
     }
 }
+
+void yang::EventDispatcher::AddForwardTarget(EventDispatcher* pDispatcher)
+{
+    if (pDispatcher == nullptr || pDispatcher == this)
+    {
+        LOG(Error, "Invalid dispatcher passed as a forward target");
+        return;
+    }
+
+    if (std::find(m_forwardTargets.begin(), m_forwardTargets.end(), pDispatcher) == m_forwardTargets.end())
+    {
+        m_forwardTargets.push_back(pDispatcher);
+    }
+}
+
+void yang::EventDispatcher::RemoveForwardTarget(EventDispatcher* pDispatcher)
+{
+    auto targetIt = std::find(m_forwardTargets.begin(), m_forwardTargets.end(), pDispatcher);
+    if (targetIt != m_forwardTargets.end())
+    {
+        m_forwardTargets.erase(targetIt);
+    }
+}
+
+void yang::EventDispatcher::EndFrame()
+{
+    m_lastFrameInvocationCount = m_invocationCount;
+    m_invocationCount = 0;
+}
@@ -13,7 +13,8 @@
 namespace yang
 {
 /** \class EventDispatcher */
-/** Registers and dispatches events to listeners. Singleton class */
+/** Registers and dispatches events to listeners. The global instance is a singleton that forwards every event
+    it dispatches to the registered scene dispatchers. Each scene owns its own instance, so disabling it skips all of the scene listeners at once */
 class EventDispatcher
 {
 public:
@@ -28,9 +29,15 @@ public:
 	// Public Member Functions
 	// --------------------------------------------------------------------- //
 
+    /** Default Constructor */
+    EventDispatcher();
+
 	/** Default Destructor */
 	~EventDispatcher();
 
+    EventDispatcher(const EventDispatcher&) = delete;
+    EventDispatcher& operator=(const EventDispatcher&) = delete;
+
     /// Get EventDispatcher singleton instance
     static EventDispatcher* Get();
 
@@ -59,6 +66,18 @@ public:
 
     /// Processes all queued events. Not intended to be called manually outside of the game main loop.
     void ProcessEvents();
+
+    /// Adds a dispatcher that receives every event triggered on this one, after this dispatcher's own listeners
+    /// \param pDispatcher - dispatcher to forward events to. Must be removed before it is destroyed
+    void AddForwardTarget(EventDispatcher* pDispatcher);
+
+    /// Stops forwarding events to a dispatcher
+    /// \param pDispatcher - dispatcher to remove
+    void RemoveForwardTarget(EventDispatcher* pDispatcher);
+
+    /// Stores the listener invocation count of the frame that just ended and resets the counter.
+    /// Not intended to be called manually outside of the game main loop.
+    void EndFrame();
 private:
 	// --------------------------------------------------------------------- //
 	// Private Member Variables
@@ -70,17 +89,30 @@ private:
     /// Queue of events that will be handled on the next frame
     std::vector<std::unique_ptr<IEvent>> m_queue;
 
+    /// Dispatchers that receive every event triggered on this one (scene dispatchers for the global instance)
+    std::vector<EventDispatcher*> m_forwardTargets;
+
+    bool m_isEnabled;                           ///< Disabled dispatcher neither calls its listeners nor forwards events
+    size_t m_invocationCount;                   ///< Number of listeners called during the current frame
+    size_t m_lastFrameInvocationCount;          ///< Number of listeners called during the last finished frame
+
 	// --------------------------------------------------------------------- //
 	// Private Member Functions
 	// --------------------------------------------------------------------- //
-    /** Default Constructor */
-    EventDispatcher();
 
 public:
 	// --------------------------------------------------------------------- //
 	// Accessors & Mutators
 	// --------------------------------------------------------------------- //
 
+    /// Enable or disable the dispatcher. Queued events are kept until the dispatcher is enabled and processed again
+    void SetEnabled(bool isEnabled) { m_isEnabled = isEnabled; }
+
+    /// Is the dispatcher enabled
+    bool IsEnabled() const { return m_isEnabled; }
+
+    /// Get the number of listeners called during the last finished frame
+    size_t GetLastFrameInvocationCount() const { return m_lastFrameInvocationCount; }
 
 };
 }
\ No newline at end of file
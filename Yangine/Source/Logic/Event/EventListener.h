@@ -11,37 +11,43 @@ namespace yang
     public:
         EventListener();
 
+        /// \param handler - callback to execute when event triggers
+        /// \param pDispatcher - dispatcher to listen to (scene dispatcher to get muted while the scene is paused). Global one if null
         template <class F>
-        EventListener(F&& handler);
+        EventListener(F&& handler, EventDispatcher* pDispatcher = nullptr);
 
         template <class F>
-        void Register(F&& handler);
+        void Register(F&& handler, EventDispatcher* pDispatcher = nullptr);
 
         void Unregister();
         ~EventListener();
     private:
         size_t m_eventListenerIndex;
+        EventDispatcher* m_pDispatcher;
     };
 
     template<class EventType>
     inline EventListener<EventType>::EventListener()
         :m_eventListenerIndex(kInvalidValue<size_t>)
+        ,m_pDispatcher(nullptr)
     {
     }
 
     template<class EventType>
     template<class F>
-    inline EventListener<EventType>::EventListener(F&& handler)
-        :m_eventListenerIndex(yang::EventDispatcher::Get()->AddEventListener(EventType::kEventId, std::forward<F>(handler)))
+    inline EventListener<EventType>::EventListener(F&& handler, EventDispatcher* pDispatcher)
+        :m_pDispatcher(pDispatcher ? pDispatcher : yang::EventDispatcher::Get())
     {
+        m_eventListenerIndex = m_pDispatcher->AddEventListener(EventType::kEventId, std::forward<F>(handler));
     }
 
     template<class EventType>
     template <class F>
-    inline void EventListener<EventType>::Register(F&& handler)
+    inline void EventListener<EventType>::Register(F&& handler, EventDispatcher* pDispatcher)
     {
         Unregister();
-        m_eventListenerIndex = yang::EventDispatcher::Get()->AddEventListener(EventType::kEventId, std::forward<F>(handler));
+        m_pDispatcher = pDispatcher ? pDispatcher : yang::EventDispatcher::Get();
+        m_eventListenerIndex = m_pDispatcher->AddEventListener(EventType::kEventId, std::forward<F>(handler));
     }
 
     template<class EventType>
@@ -49,7 +55,7 @@ namespace yang
     {
         if (m_eventListenerIndex != kInvalidValue<size_t>)
         {
-            yang::EventDispatcher::Get()->RemoveEventListener(EventType::kEventId, m_eventListenerIndex);
+            m_pDispatcher->RemoveEventListener(EventType::kEventId, m_eventListenerIndex);
             m_eventListenerIndex = kInvalidValue<size_t>;
         }
     }
@@ -2,8 +2,9 @@
 
 using yang::MouseWheelEvent;
 
-MouseWheelEvent::MouseWheelEvent(const yang::IVec2& scrollAmount)
+MouseWheelEvent::MouseWheelEvent(const yang::IVec2& scrollAmount, const yang::IVec2& position)
     :m_scrollAmount(scrollAmount)
+    ,m_position(position)
 {
 	
 }
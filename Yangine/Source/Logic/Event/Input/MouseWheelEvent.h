@@ -29,7 +29,8 @@ public:
 
     /// Constructor
     /// \param scrollAmount - IVec2 representing the amount of scroll
-	MouseWheelEvent(const IVec2& scrollAmount);
+    /// \param position - IVec2 representing the cursor position when the wheel was scrolled
+	MouseWheelEvent(const IVec2& scrollAmount, const IVec2& position);
 
 	/** Default Destructor */
 	~MouseWheelEvent();
@@ -40,6 +41,7 @@ private:
 	// Private Member Variables
 	// --------------------------------------------------------------------- //
     IVec2 m_scrollAmount;   ///< Scroll amount
+    IVec2 m_position;       ///< Cursor position
 
 	// --------------------------------------------------------------------- //
 	// Private Member Functions
@@ -57,6 +59,8 @@ public:
     const char* GetName() const override { return "MouseWheel"; }
     /// Accessor for scroll amount
     const IVec2& GetScrollAmount() const { return m_scrollAmount; }
+    /// Accessor for cursor position
+    const IVec2& GetPosition() const { return m_position; }
 
 };
 }
\ No newline at end of file
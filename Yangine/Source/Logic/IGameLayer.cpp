@@ -2,6 +2,7 @@
 #include <Logic/Actor/Actor.h>
 #include <Application/ApplicationLayer.h>
 #include <Application/Resources/ResourceCache.h>
+#include <Application/Graphics/Textures/TextureAtlas.h>
 
 #include <Logic/Components/TransformComponent.h>
 #include <Logic/Components/SpriteComponent.h>
@@ -26,6 +27,9 @@
 #include <Utils/Random.h>
 #include <Utils/StringHash.h>
 #include <Utils/TinyXml2/tinyxml2.h>
+#include <Utils/BinaryXml.h>
+#include <Utils/FrameProfiler.h>
+#include <chrono>
 
 // Still need it here because of
 #include <Lua/lua.hpp>
@@ -96,15 +100,27 @@ void yang::IGameLayer::AddView(std::unique_ptr<IView>&& pView, std::optional<uin
 
 void yang::IGameLayer::Update(float deltaSeconds)
 {
-    EventDispatcher::Get()->ProcessEvents();
+    {
+        FrameProfiler::ScopedSection section(FrameProfiler::Section::kEvents);
+        EventDispatcher::Get()->ProcessEvents();
+    }
 
     for (auto pScene : m_scenes[(size_t)SceneStatus::kActive])
     {
         pScene->Update(deltaSeconds);
     }
 
-    m_pCurrentScene->Render();
+    {
+        FrameProfiler::ScopedSection section(FrameProfiler::Section::kRender);
+        m_pCurrentScene->Render();
+    }
+
+    {
+        FrameProfiler::ScopedSection section(FrameProfiler::Section::kEvents);
+        EndEventFrame();
+    }
 
+    FrameProfiler::ScopedSection section(FrameProfiler::Section::kSceneBookkeeping);
     for (auto pScene : m_scenes[(size_t)SceneStatus::kUnload])
     {
         m_loadedScenes.erase(pScene->GetHashName());
@@ -307,6 +323,7 @@ std::shared_ptr<yang::Scene> yang::IGameLayer::SwitchScene(uint32_t sceneId, Sce
 
     if (pSceneIt != pausedScenes.end())
     {
+        (*pSceneIt)->GetEventDispatcher().SetEnabled(true);
         (*pSceneIt)->OnSceneResume();
         m_scenes[(size_t)SceneStatus::kActive].push_back(pScene);
         std::iter_swap(pSceneIt, pausedScenes.end() - 1);
@@ -368,10 +385,17 @@ std::shared_ptr<yang::Scene> yang::IGameLayer::LoadScene(std::string_view pathTo
 
     assert((size_t)initialStatus < (size_t)SceneStatus::kMaxStatus);
 
-    auto pResource = ResourceCache::Get()->Load<IResource>(pathToXml.data());
+    auto loadStart = std::chrono::steady_clock::now();
+    ResourceId sceneId = ResourceCache::Get()->InternPath(pathToXml.data());
+    auto pResource = ResourceCache::Get()->Load<IResource>(sceneId);
+    if (!pResource)
+    {
+        LOG(Error, "Failed to load scene: %s", pathToXml.data());
+        return nullptr;
+    }
 
     XMLDocument doc;
-    XMLError error = doc.Parse(reinterpret_cast<const char*>(pResource->GetData().data()), pResource->GetData().size());
+    XMLError error = LoadXmlDocument(pResource->GetData().data(), pResource->GetData().size(), doc);
 
     if (error != tinyxml2::XML_SUCCESS)
     {
@@ -410,7 +434,51 @@ std::shared_ptr<yang::Scene> yang::IGameLayer::LoadScene(std::string_view pathTo
         return nullptr;
     }
 
+    // With a manifest everything the actors need is loaded in parallel up front, without one it is recorded for the next time
+    auto [manifestIt, isNewManifest] = m_sceneManifests.try_emplace(sceneId);
+    SceneManifest& manifest = manifestIt->second;
+    if (isNewManifest)
+    {
+        manifest.Load(pathToXml.data());
+        TextureAtlas::Get()->Load(pathToXml.data());
+    }
+
+    bool usedManifest = m_useSceneManifests && !manifest.IsEmpty();
+    std::vector<std::shared_ptr<IResource>> prefetchedResources;
+    float prefetchSeconds = 0;
+    if (usedManifest)
+    {
+        auto prefetchStart = std::chrono::steady_clock::now();
+        manifest.Prefetch(prefetchedResources);
+        prefetchSeconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - prefetchStart).count();
+    }
+    else
+    {
+        manifest.BeginRecording();
+    }
+
+    // Listeners of a scene that starts paused are not called until it is resumed
+    pScene->GetEventDispatcher().SetEnabled(initialStatus == SceneStatus::kActive);
     pScene->Init(pRoot);
+
+    if (!usedManifest)
+    {
+        manifest.EndRecording();
+#ifdef DEBUG
+        manifest.Save(pathToXml.data());
+#endif
+    }
+
+    std::chrono::duration<float> loadTime = std::chrono::steady_clock::now() - loadStart;
+    if (usedManifest)
+    {
+        LOG(Stats, "Scene %s loaded in %.2f ms with the manifest: %zu resources prefetched in %.2f ms", name, loadTime.count() * 1000.f, prefetchedResources.size(), prefetchSeconds * 1000.f);
+    }
+    else
+    {
+        LOG(Stats, "Scene %s loaded in %.2f ms without a manifest, recorded %zu resources", name, loadTime.count() * 1000.f, manifest.GetResourceCount());
+    }
+
     pScene->OnSceneLoad();
     m_loadedScenes.emplace(pScene->GetHashName(), pScene);
 
@@ -453,6 +521,7 @@ void yang::IGameLayer::PauseScene(uint32_t sceneId)
         return;
     }
 
+    (*pSceneIt)->GetEventDispatcher().SetEnabled(false);
     (*pSceneIt)->OnScenePause();
 
     m_scenes[(size_t)SceneStatus::kPaused].push_back(*pSceneIt);
@@ -485,6 +554,7 @@ void yang::IGameLayer::UnloadScene(uint32_t sceneId)
         return;
     }
 
+    (*pSceneIt)->GetEventDispatcher().SetEnabled(false);
     (*pSceneIt)->OnSceneUnload();
 
     m_scenes[(size_t)SceneStatus::kUnload].push_back(*pSceneIt);
@@ -520,6 +590,35 @@ void yang::IGameLayer::RegisterSceneCreator(uint32_t id, SceneFunction pFunction
     m_sceneCreatorMap[id] = pFunction;
 }
 
+void yang::IGameLayer::EndEventFrame()
+{
+    EventDispatcher* pGlobalDispatcher = EventDispatcher::Get();
+    pGlobalDispatcher->EndFrame();
+
+    for (auto& [sceneId, pScene] : m_loadedScenes)
+    {
+        pScene->GetEventDispatcher().EndFrame();
+    }
+
+    ++m_frameCount;
+    if (m_frameCount % kEventStatsReportInterval != 0)
+        return;
+
+    LOG(Stats, "Event listeners called last frame: global - %zu", pGlobalDispatcher->GetLastFrameInvocationCount());
+    for (auto& [sceneId, pScene] : m_loadedScenes)
+    {
+        LOG(Stats, "Event listeners called last frame: scene %s (%s) - %zu", pScene->GetName().data(),
+            pScene->GetEventDispatcher().IsEnabled() ? "active" : "paused",
+            pScene->GetEventDispatcher().GetLastFrameInvocationCount());
+    }
+
+    if (m_pCurrentScene)
+    {
+        LOG(Stats, "Actors rendered last frame: scene %s - %zu drawn, %zu culled", m_pCurrentScene->GetName().data(),
+            m_pCurrentScene->GetDrawnActorCount(), m_pCurrentScene->GetCulledActorCount());
+    }
+}
+
 std::shared_ptr<yang::Scene> yang::IGameLayer::FindSceneByActorId(Id id) const
 {
     for (auto [sceneId, pScene] : m_loadedScenes)
@@ -4,6 +4,7 @@
 #include <Views/IView.h>
 #include <Logic/Scripting/LuaManager.h>
 #include <Logic/Scene/Scene.h>
+#include <Logic/Scene/SceneManifest.h>
 
 #include <Logic/Actor/ActorFactory.h>
 #include <Views/ViewFactory.h>
@@ -150,11 +151,22 @@ private:
 	// Private Member Variables
 	// --------------------------------------------------------------------- //
 
+    static constexpr size_t kEventStatsReportInterval = 300;   ///< How often (in frames) listener invocation counts are logged
+
+    size_t m_frameCount = 0;                                    ///< Number of frames updated so far
+
+    std::unordered_map<ResourceId, SceneManifest> m_sceneManifests;     ///< Resource manifests of the scenes loaded so far, by scene file resource ID
+    bool m_useSceneManifests = true;                                    ///< Should LoadScene prefetch the scene resources
+
 	// --------------------------------------------------------------------- //
 	// Private Member Functions
 	// --------------------------------------------------------------------- //
 
     std::shared_ptr<Scene> FindSceneByActorId(Id id) const;
+
+    /// Internal helper function. Closes the event dispatcher frame for the global and every loaded scene dispatcher
+    /// and periodically logs how many listeners each of them called
+    void EndEventFrame();
 public:
 	// --------------------------------------------------------------------- //
 	// Accessors & Mutators
@@ -174,6 +186,9 @@ public:
     ViewFactory& GetViewFactory() { return m_viewFactory; }
     CollisionCallbackFactory& GetCollisionCallbackFactory() { return m_collisionCallbackFactory; }
     ProcessFactory& GetProcessFactory() { return m_processFactory; }
+
+    /// Set whether LoadScene prefetches scene resources listed in the scene manifests. On by default, turn off to compare load times
+    void SetUseSceneManifests(bool useSceneManifests) { m_useSceneManifests = useSceneManifests; }
 };
 template<class ActualScene, class ...Args>
 inline void IGameLayer::RegisterScene(Args ...args)
@@ -1,13 +1,35 @@
 #include "TiledMap.h"
 #include <Application/Graphics/IGraphics.h>
+#include <Application/Graphics/RenderQueue.h>
 #include <Application/Graphics/Textures/ITexture.h>
+#include <Application/Graphics/Viewport.h>
+#include <Application/ApplicationGlobals.h>
 #include <Application/Resources/ResourceCache.h>
 #include <Utils/TinyXml2/tinyxml2.h>
+#include <Utils/BinaryXml.h>
+#include <Utils/BinaryStream.h>
+#include <Utils/Base64.h>
+#include <Utils/Inflate.h>
 #include <Utils/Logger.h>
 #include <Utils/StringHash.h>
 
-#include <charconv>
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define YANG_TILED_CSV_SSE2 1
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 using yang::TiledMap;
 
@@ -16,6 +38,240 @@ static constexpr uint32_t kStringProperty = 0;
 static constexpr uint32_t kIntProperty = StringHash32("int");
 static constexpr uint32_t kFloatProperty = StringHash32("float");
 
+namespace
+{
+    /// Index of the lowest set bit of a non zero mask
+    int FindLowestBit(uint32_t mask)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+
+    /// Parses the digits of a global tile ID. IDs are unsigned, Tiled keeps flip flags in the top bits
+    /// \return false if the ID doesn't fit 32 bits
+    bool ParseTileId(const char* pBegin, const char* pEnd, int& id)
+    {
+        if (pEnd - pBegin > 10)
+            return false;
+
+        uint64_t value = 0;
+        for (; pBegin < pEnd; ++pBegin)
+        {
+            value = value * 10 + static_cast<uint64_t>(*pBegin - '0');
+        }
+
+        if (value > UINT32_MAX)
+            return false;
+
+        id = static_cast<int>(static_cast<uint32_t>(value));
+        return true;
+    }
+
+    /// Decodes the CSV layer data in a single pass over the text. Every character that is not a digit separates IDs,
+    /// so commas, new lines and indentation need no special cases. With SSE2 the separators are found 16 characters at a time
+    /// \return false if the text has a different number of tiles
+    bool DecodeCsvTiles(std::string_view text, TiledMap::TileData* pTiles, size_t tileCount)
+    {
+        const char* pCurrent = text.data();
+        const char* pEnd = pCurrent + text.size();
+        const char* pTokenStart = pCurrent;
+        size_t decodedCount = 0;
+
+        auto endToken = [&](const char* pTokenEnd)
+        {
+            if (pTokenEnd != pTokenStart)
+            {
+                if (decodedCount == tileCount || !ParseTileId(pTokenStart, pTokenEnd, pTiles[decodedCount].m_id))
+                    return false;
+                ++decodedCount;
+            }
+            pTokenStart = pTokenEnd + 1;
+            return true;
+        };
+
+#ifdef YANG_TILED_CSV_SSE2
+        const __m128i kZero = _mm_set1_epi8('0');
+        const __m128i kNine = _mm_set1_epi8(9);
+        for (; pEnd - pCurrent >= 16; pCurrent += 16)
+        {
+            // Digits are the bytes that stay at most 9 after subtracting '0' as unsigned
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCurrent));
+            __m128i digitValues = _mm_sub_epi8(chunk, kZero);
+            __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digitValues, kNine), digitValues);
+            uint32_t separatorMask = ~static_cast<uint32_t>(_mm_movemask_epi8(isDigit)) & 0xFFFF;
+
+            while (separatorMask != 0)
+            {
+                if (!endToken(pCurrent + FindLowestBit(separatorMask)))
+                    return false;
+                separatorMask &= separatorMask - 1;
+            }
+        }
+#endif
+
+        for (; pCurrent < pEnd; ++pCurrent)
+        {
+            if (static_cast<unsigned char>(*pCurrent - '0') > 9 && !endToken(pCurrent))
+                return false;
+        }
+
+        return endToken(pEnd) && decodedCount == tileCount;
+    }
+
+    /// Decodes the layer data in any encoding Tiled writes, except zstd compression
+    /// \param pData - data element of the layer
+    /// \param tiles - tiles of the layer, sized to the layer size
+    /// \return true if decoded
+    bool DecodeLayerData(tinyxml2::XMLElement* pData, std::vector<TiledMap::TileData>& tiles)
+    {
+        static_assert(sizeof(TiledMap::TileData) == sizeof(uint32_t), "Base64 layer data is copied straight into the tiles");
+
+        if (!pData)
+        {
+            LOG(Error, "Layer has no data");
+            return false;
+        }
+
+        const char* pEncoding = pData->Attribute("encoding");
+
+        // Tiles stored as <tile gid=""/> elements, the oldest and slowest format
+        if (!pEncoding)
+        {
+            size_t index = 0;
+            for (tinyxml2::XMLElement* pTile = pData->FirstChildElement("tile"); pTile != nullptr && index < tiles.size(); pTile = pTile->NextSiblingElement("tile"))
+            {
+                tiles[index++].m_id = static_cast<int>(pTile->UnsignedAttribute("gid"));
+            }
+            return index == tiles.size();
+        }
+
+        std::string_view text = pData->GetText() ? pData->GetText() : "";
+
+        if (std::strcmp(pEncoding, "csv") == 0)
+        {
+            return DecodeCsvTiles(text, tiles.data(), tiles.size());
+        }
+
+        if (std::strcmp(pEncoding, "base64") != 0)
+        {
+            LOG(Error, "Unsupported layer data encoding %s", pEncoding);
+            return false;
+        }
+
+        // Base64 data is an array of little endian 32 bit global tile IDs, optionally compressed
+        std::vector<std::byte> decoded;
+        if (!yang::DecodeBase64(text, decoded))
+        {
+            LOG(Error, "Layer data is not valid base64");
+            return false;
+        }
+
+        std::byte* pTiles = reinterpret_cast<std::byte*>(tiles.data());
+        size_t tilesSize = tiles.size() * sizeof(TiledMap::TileData);
+        const char* pCompression = pData->Attribute("compression");
+
+        if (!pCompression)
+        {
+            if (decoded.size() != tilesSize)
+                return false;
+
+            std::memcpy(pTiles, decoded.data(), tilesSize);
+            return true;
+        }
+
+        yang::InflateFormat format;
+        if (std::strcmp(pCompression, "zlib") == 0)
+        {
+            format = yang::InflateFormat::kZlib;
+        }
+        else if (std::strcmp(pCompression, "gzip") == 0)
+        {
+            format = yang::InflateFormat::kGzip;
+        }
+        else
+        {
+            LOG(Error, "Unsupported layer data compression %s", pCompression);
+            return false;
+        }
+
+        return yang::Inflate(decoded.data(), decoded.size(), pTiles, tilesSize, format);
+    }
+
+    /// Moves the flip flags out of the decoded global tile IDs, so the IDs can index the tilesets
+    /// \param tiles - decoded tiles of the layer
+    /// \param flips - flip flags of the layer, left empty if no tile is flipped
+    void SplitFlipFlags(std::vector<yang::TiledMap::TileData>& tiles, std::vector<uint8_t>& flips)
+    {
+        constexpr uint32_t kFlagsShift = 29;
+
+        flips.clear();
+        for (size_t i = 0; i < tiles.size(); ++i)
+        {
+            uint32_t gid = static_cast<uint32_t>(tiles[i].m_id);
+            if ((gid & ~yang::TiledMap::kTileIdMask) == 0)
+                continue;
+
+            // Most layers have no flipped tiles, so the flags are allocated by the first one
+            if (flips.empty())
+            {
+                flips.resize(tiles.size(), 0);
+            }
+
+            flips[i] = static_cast<uint8_t>(gid >> kFlagsShift);
+            tiles[i].m_id = static_cast<int>(gid & yang::TiledMap::kTileIdMask);
+        }
+    }
+
+    /// Converts Tiled flip flags to a flip and a rotation. Tiled swaps X and Y first and mirrors after that,
+    /// every combination of it is one mirror and a multiple of 90 degrees. Non square tiles don't fit their cell when swapped
+    /// \param flipFlags - TiledMap::kFlipped* values
+    /// \return parameters to draw the tile with
+    yang::TextureDrawParams GetFlipDrawParams(uint8_t flipFlags)
+    {
+        using yang::TiledMap;
+        using yang::FlipDirection;
+
+        yang::TextureDrawParams drawParams;
+        bool isHorizontal = (flipFlags & TiledMap::kFlippedHorizontally) != 0;
+        bool isVertical = (flipFlags & TiledMap::kFlippedVertically) != 0;
+
+        if ((flipFlags & TiledMap::kFlippedDiagonally) == 0)
+        {
+            // Both mirrors are a half turn
+            if (isHorizontal && isVertical)
+            {
+                drawParams.m_angle = 180.f;
+            }
+            else if (isHorizontal)
+            {
+                drawParams.m_flip = FlipDirection::kHorizontal;
+            }
+            else if (isVertical)
+            {
+                drawParams.m_flip = FlipDirection::kVertical;
+            }
+            return drawParams;
+        }
+
+        // Angles are clockwise and applied after the flip
+        if (isHorizontal == isVertical)
+        {
+            drawParams.m_angle = 90.f;
+            drawParams.m_flip = isHorizontal ? FlipDirection::kHorizontal : FlipDirection::kVertical;
+        }
+        else
+        {
+            drawParams.m_angle = isHorizontal ? 90.f : 270.f;
+        }
+        return drawParams;
+    }
+}
+
 template <>
 void yang::TiledMap::TilesetData::AddProperty<bool>(const char* name, bool value)
 {
@@ -50,16 +306,9 @@ std::optional<bool> yang::TiledMap::TilesetData::GetProperty(int tileId, const c
     assert(tileId < m_tileCount);
     assert(propertyName);
 
-    if (static_cast<size_t>(tileId) >= m_tileProperties.size())
-    {
-        return {};
-    }
-
-    uint32_t hashName = StringHash32(propertyName);
-
-    if (m_tileProperties[tileId].count(hashName))
+    if (const PropertyValue* pValue = FindProperty(tileId, StringHash32(propertyName)); pValue != nullptr)
     {
-        if (const bool* pVal = std::get_if<bool>(&m_tileProperties[tileId].at(hashName)))
+        if (const bool* pVal = std::get_if<bool>(pValue))
         {
             return *pVal;
         }
@@ -79,16 +328,9 @@ std::optional<std::string> yang::TiledMap::TilesetData::GetProperty(int tileId,
     assert(tileId < m_tileCount);
     assert(propertyName);
 
-    if (static_cast<size_t>(tileId) >= m_tileProperties.size())
-    {
-        return {};
-    }
-
-    uint32_t hashName = StringHash32(propertyName);
-
-    if (m_tileProperties[tileId].count(hashName))
+    if (const PropertyValue* pValue = FindProperty(tileId, StringHash32(propertyName)); pValue != nullptr)
     {
-        if (const std::string* pVal = std::get_if<std::string>(&m_tileProperties[tileId].at(hashName)))
+        if (const std::string* pVal = std::get_if<std::string>(pValue))
         {
             return *pVal;
         }
@@ -108,16 +350,9 @@ std::optional<int> yang::TiledMap::TilesetData::GetProperty(int tileId, const ch
     assert(tileId < m_tileCount);
     assert(propertyName);
 
-    if (static_cast<size_t>(tileId) >= m_tileProperties.size())
-    {
-        return {};
-    }
-
-    uint32_t hashName = StringHash32(propertyName);
-
-    if (m_tileProperties[tileId].count(hashName))
+    if (const PropertyValue* pValue = FindProperty(tileId, StringHash32(propertyName)); pValue != nullptr)
     {
-        if (const int* pVal = std::get_if<int>(&m_tileProperties[tileId].at(hashName)))
+        if (const int* pVal = std::get_if<int>(pValue))
         {
             return *pVal;
         }
@@ -137,43 +372,195 @@ std::optional<float> yang::TiledMap::TilesetData::GetProperty(int tileId, const
     assert(tileId < m_tileCount);
     assert(propertyName);
 
+    if (const PropertyValue* pValue = FindProperty(tileId, StringHash32(propertyName)); pValue != nullptr)
+    {
+        if (const float* pVal = std::get_if<float>(pValue))
+        {
+            return *pVal;
+        }
+
+        LOG(Error, "Tile property with name %s is not a float", propertyName);
+        return {};
+    }
+
+    //LOG(Error, "Tile doesn't have property with name %s", propertyName);
+
+    return {};
+}
+
+const yang::TiledMap::TilesetData::PropertyValue* yang::TiledMap::TilesetData::FindProperty(int tileId, uint32_t hashName) const
+{
     if (static_cast<size_t>(tileId) >= m_tileProperties.size())
+        return nullptr;
+
+    auto propertyIt = m_tileProperties[tileId].find(hashName);
+    return propertyIt != m_tileProperties[tileId].end() ? &propertyIt->second : nullptr;
+}
+
+template <typename PropertyType>
+yang::TiledMap::TilePropertyColumn<PropertyType> yang::TiledMap::CompileTileProperty(size_t layerIndex, const char* propertyName, PropertyType defaultValue)
+{
+    static_assert(std::is_same_v<PropertyType, bool> || std::is_same_v<PropertyType, int> || std::is_same_v<PropertyType, float>,
+        "Only bool, int and float tile properties can be compiled");
+
+    if (layerIndex >= m_mapData.m_layerData.size())
     {
+        LOG(Error, "Can't compile tile property %s, layer %zu doesn't exist", propertyName, layerIndex);
         return {};
     }
 
+    // Every tile declaring the property must use the same type, then lookups never have to check it
     uint32_t hashName = StringHash32(propertyName);
-
-    if (m_tileProperties[tileId].count(hashName))
+    for (const TilesetData& tileset : m_tilesetData)
     {
-        if (const float* pVal = std::get_if<float>(&m_tileProperties[tileId].at(hashName)))
+        for (int tileId = 0; tileId < tileset.GetTileCount(); ++tileId)
         {
-            return *pVal;
+            const TilesetData::PropertyValue* pValue = tileset.FindProperty(tileId, hashName);
+            if (pValue && !std::holds_alternative<PropertyType>(*pValue))
+            {
+                LOG(Error, "Can't compile tile property %s, tile %d of tileset %d declares it with another type", propertyName, tileId, tileset.GetFirstGid());
+                return {};
+            }
         }
+    }
 
-        LOG(Error, "Tile property with name %s is not a float", propertyName);
-        return {};
+    const LayerData& layer = m_mapData.m_layerData[layerIndex];
+    PropertyColumnData<PropertyType> column;
+    column.m_layerIndex = layerIndex;
+    column.m_hashName = hashName;
+    column.m_defaultValue = defaultValue;
+    if constexpr (std::is_same_v<PropertyType, bool>)
+    {
+        column.m_values.resize((layer.m_tileData.size() + 63) / 64);
+    }
+    else
+    {
+        column.m_values.resize(layer.m_tileData.size());
     }
 
-    //LOG(Error, "Tile doesn't have property with name %s", propertyName);
+    for (size_t tileIndex = 0; tileIndex < layer.m_tileData.size(); ++tileIndex)
+    {
+        SetColumnValue(column, tileIndex, FindTilePropertyValue(layer.m_tileData[tileIndex].m_id, hashName, defaultValue));
+    }
 
-    return {};
+    auto& columns = std::get<std::vector<PropertyColumnData<PropertyType>>>(m_propertyColumns);
+    columns.emplace_back(std::move(column));
+
+    TilePropertyColumn<PropertyType> handle;
+    handle.m_index = columns.size() - 1;
+    return handle;
+}
+
+template yang::TiledMap::TilePropertyColumn<bool> yang::TiledMap::CompileTileProperty<bool>(size_t, const char*, bool);
+template yang::TiledMap::TilePropertyColumn<int> yang::TiledMap::CompileTileProperty<int>(size_t, const char*, int);
+template yang::TiledMap::TilePropertyColumn<float> yang::TiledMap::CompileTileProperty<float>(size_t, const char*, float);
+
+template <typename PropertyType>
+PropertyType yang::TiledMap::FindTilePropertyValue(int tileId, uint32_t hashName, PropertyType defaultValue) const
+{
+    // if tile id is 0, it is an empty tile
+    if (tileId == 0)
+        return defaultValue;
+
+    const TilesetData& tileset = FindTileset(tileId);
+    const TilesetData::PropertyValue* pValue = tileset.FindProperty(tileId - tileset.GetFirstGid(), hashName);
+    if (const PropertyType* pTypedValue = pValue ? std::get_if<PropertyType>(pValue) : nullptr)
+    {
+        return *pTypedValue;
+    }
+
+    return defaultValue;
+}
+
+void yang::TiledMap::UpdatePropertyColumns(size_t layerIndex, size_t tileIndex)
+{
+    int tileId = m_mapData.m_layerData[layerIndex].m_tileData[tileIndex].m_id;
+    std::apply([this, layerIndex, tileIndex, tileId](auto&... columns)
+        {
+            auto updateColumns = [this, layerIndex, tileIndex, tileId](auto& columnsOfType)
+            {
+                for (auto& column : columnsOfType)
+                {
+                    if (column.m_layerIndex == layerIndex)
+                    {
+                        SetColumnValue(column, tileIndex, FindTilePropertyValue(tileId, column.m_hashName, column.m_defaultValue));
+                    }
+                }
+            };
+
+            (updateColumns(columns), ...);
+        }, m_propertyColumns);
 }
 
 bool yang::TiledMap::LoadMap(const char* filepath)
+{
+    m_layerChunks.clear();
+    m_propertyColumns = {};
+    if (!ReadMap(filepath))
+        return false;
+
+    for (auto& tilesetData : m_tilesetData)
+    {
+        if (!tilesetData.LoadTexture())
+            return false;
+    }
+
+    CreateChunks();
+    return true;
+}
+
+bool yang::TiledMap::CookMap(const char* filepath, std::vector<std::byte>& output)
+{
+    TiledMap map;
+    if (!map.ReadMap(filepath))
+        return false;
+
+    BinaryWriter writer(output);
+    map.WriteCookedMap(writer);
+    return true;
+}
+
+bool yang::TiledMap::ReadMap(const char* filepath)
 {
     using namespace tinyxml2;
-    // Open 2 files:
-    std::string mapFile(filepath);
+
+    m_layerDecodeMs = 0.f;
+
+    // Map and tileset files go through the resource cache, so they can be packed, prefetched and recorded in scene manifests
+    auto pMapResource = ResourceCache::Get()->Load<IResource>(filepath);
+    if (!pMapResource)
+    {
+        LOG(Error, "Failed to load map file. Path: %s", filepath);
+        return false;
+    }
+
+    BinaryReader reader(pMapResource->GetData().data(), pMapResource->GetData().size());
+    uint32_t magic = 0;
+    if (reader.Read(magic) && magic == kCookedMapMagic)
+    {
+        if (!ReadCookedMap(reader))
+        {
+            LOG(Error, "Failed to load cooked map file. Path: %s. The file is corrupted or was cooked by another version", filepath);
+            return false;
+        }
+        return true;
+    }
+
     XMLDocument mapDocument;
-    XMLError error = mapDocument.LoadFile(mapFile.c_str());
+    XMLError error = LoadXmlDocument(pMapResource->GetData().data(), pMapResource->GetData().size(), mapDocument);
     if (error != XML_SUCCESS)
     {
         LOG(Error, "Failed to load map file. Path: %s. Error: %s", filepath, XMLDocument::ErrorIDToName(error));
         return false;
     }
 
-    XMLElement* pMapRoot = mapDocument.RootElement();
+    return ReadXmlMap(mapDocument.RootElement(), filepath);
+}
+
+bool yang::TiledMap::ReadXmlMap(tinyxml2::XMLElement* pMapRoot, const char* filepath)
+{
+    using namespace tinyxml2;
+    std::string mapFile(filepath);
 
     // TODO: Error checks for each (or leave it to tiled?)
     m_mapData.m_mapWidth = pMapRoot->IntAttribute("width");
@@ -207,7 +594,14 @@ bool yang::TiledMap::LoadMap(const char* filepath)
         tilesetFile += tilesetXmlPath;
 
         XMLDocument tilesetDocument;
-        error = tilesetDocument.LoadFile(tilesetFile.c_str());
+        auto pTilesetResource = ResourceCache::Get()->Load<IResource>(tilesetFile.c_str());
+        if (!pTilesetResource)
+        {
+            LOG(Error, "Failed to load tileset file. Path: %s", tilesetFile.c_str());
+            return false;
+        }
+
+        XMLError error = LoadXmlDocument(pTilesetResource->GetData().data(), pTilesetResource->GetData().size(), tilesetDocument);
 
         if (error != XML_SUCCESS)
         {
@@ -222,6 +616,9 @@ bool yang::TiledMap::LoadMap(const char* filepath)
         m_tilesetData.push_back(std::move(tilesetData));
     }
 
+    std::chrono::duration<float> decodeTime{};
+    size_t decodedTileCount = 0;
+
     for (XMLElement* pLayer = pMapRoot->FirstChildElement("layer"); pLayer != nullptr; pLayer = pLayer->NextSiblingElement("layer"))
     {
         LayerData layerData;
@@ -243,98 +640,211 @@ bool yang::TiledMap::LoadMap(const char* filepath)
 
         // TODO: parse properties
 
-        int mapSize = layerData.m_width * layerData.m_height;
+        size_t mapSize = static_cast<size_t>(layerData.m_width) * static_cast<size_t>(layerData.m_height);
+        layerData.m_tileData.resize(mapSize);
 
-        layerData.m_tileData.reserve(mapSize);
+        auto decodeStart = std::chrono::steady_clock::now();
+        if (!DecodeLayerData(pLayer->FirstChildElement("data"), layerData.m_tileData))
+        {
+            LOG(Error, "Failed to decode data of layer %d in map %s", layerData.m_id, filepath);
+            return false;
+        }
+        SplitFlipFlags(layerData.m_tileData, layerData.m_tileFlips);
+        decodeTime += std::chrono::steady_clock::now() - decodeStart;
+        decodedTileCount += mapSize;
 
-        XMLElement* pData = pLayer->FirstChildElement("data");
-        std::string dataString = pData->GetText();
+        m_mapData.m_layerData.push_back(std::move(layerData));
+    }
 
-        // C++17 claims that std::from_chars and to_chars are lightning fast.
-        size_t currentComma = 0;
-        size_t nextComma = dataString.find(",");
-        const char* dataCString = dataString.c_str();
+    m_layerDecodeMs = decodeTime.count() * 1000.f;
+    if (decodedTileCount > 0)
+    {
+        LOG(Stats, "Map %s: decoded %zu tiles in %.2f ms, %.2f ms per million tiles", filepath, decodedTileCount,
+            decodeTime.count() * 1000.f, decodeTime.count() * 1000.f * 1000000.f / static_cast<float>(decodedTileCount));
+    }
 
-        for (int i = 0; i < mapSize; ++i)
-        {
-            // If next comma wasn't found, parse until the end of string - 1 (because of '\n' at the end)
-            if (nextComma == std::string::npos)
-            {
-                nextComma = dataString.size() - 1;
-            }
+    return true;
+}
 
-            // If there is a '\n' character between current and next, we need to increment currentComma ('\n' character is guaranteed to be next after currentComma)
-            // Note that this if should be after the previous if, otherwise it will catch the '\n' at the end of the whole string.
-            if (dataString.find("\n", currentComma) < nextComma)
-            {
-                ++currentComma;
-            }
+void yang::TiledMap::WriteCookedMap(BinaryWriter& writer) const
+{
+    writer.Write(kCookedMapMagic);
+    writer.Write(kCookedMapVersion);
 
-            int id;
-            std::from_chars(dataCString + currentComma, dataCString + nextComma, id);
-            currentComma = nextComma + 1;
-            nextComma = dataString.find(",", currentComma);
+    writer.Write(m_mapData.m_mapWidth);
+    writer.Write(m_mapData.m_mapHeight);
+    writer.Write(m_mapData.m_tileWidth);
+    writer.Write(m_mapData.m_tileHeight);
+    writer.Write(static_cast<uint32_t>(m_mapData.m_mapType));
 
-            layerData.m_tileData.push_back({id});
-        }
-        m_mapData.m_layerData.push_back(std::move(layerData));
+    writer.Write(static_cast<uint32_t>(m_tilesetData.size()));
+    for (const auto& tilesetData : m_tilesetData)
+    {
+        tilesetData.Write(writer);
     }
 
-    return true;
+    writer.Write(static_cast<uint32_t>(m_mapData.m_layerData.size()));
+    for (const auto& layerData : m_mapData.m_layerData)
+    {
+        writer.Write(layerData.m_id);
+        writer.Write(layerData.m_width);
+        writer.Write(layerData.m_height);
+        writer.Write(layerData.m_opacity);
+        writer.Write(layerData.m_hashName);
+        writer.Write(static_cast<uint8_t>(layerData.m_isVisible));
+
+        // Tile IDs are stored as is, so the layer is read with a single copy
+        writer.Write(static_cast<uint32_t>(layerData.m_tileData.size()));
+        writer.WriteBytes(layerData.m_tileData.data(), layerData.m_tileData.size() * sizeof(TileData));
+        writer.Write(static_cast<uint32_t>(layerData.m_tileFlips.size()));
+        writer.WriteBytes(layerData.m_tileFlips.data(), layerData.m_tileFlips.size());
+    }
 }
 
-bool yang::TiledMap::Render(IGraphics* pGraphics)
+bool yang::TiledMap::ReadCookedMap(BinaryReader& reader)
 {
-    bool success = true;
-    for (auto& layer : m_mapData.m_layerData)
+    static_assert(std::is_trivially_copyable_v<TileData>, "Tile data is copied straight from the cooked map");
+
+    uint32_t version = 0;
+    if (!reader.Read(version) || version != kCookedMapVersion)
+        return false;
+
+    uint32_t mapType = 0;
+    reader.Read(m_mapData.m_mapWidth);
+    reader.Read(m_mapData.m_mapHeight);
+    reader.Read(m_mapData.m_tileWidth);
+    reader.Read(m_mapData.m_tileHeight);
+    reader.Read(mapType);
+    m_mapData.m_mapType = mapType < static_cast<uint32_t>(MapType::kMaxTypes) ? static_cast<MapType>(mapType) : MapType::kMaxTypes;
+
+    uint32_t tilesetCount = 0;
+    if (!reader.Read(tilesetCount))
+        return false;
+
+    m_tilesetData.clear();
+    m_tilesetData.reserve(tilesetCount);
+    for (uint32_t i = 0; i < tilesetCount; ++i)
     {
-        if (!layer.m_isVisible)
+        if (!m_tilesetData.emplace_back().Read(reader))
+            return false;
+    }
+
+    uint32_t layerCount = 0;
+    if (!reader.Read(layerCount))
+        return false;
+
+    m_mapData.m_layerData.clear();
+    m_mapData.m_layerData.reserve(layerCount);
+    for (uint32_t i = 0; i < layerCount; ++i)
+    {
+        LayerData layerData;
+        uint8_t isVisible = 0;
+        uint32_t tileCount = 0;
+        reader.Read(layerData.m_id);
+        reader.Read(layerData.m_width);
+        reader.Read(layerData.m_height);
+        reader.Read(layerData.m_opacity);
+        reader.Read(layerData.m_hashName);
+        reader.Read(isVisible);
+        layerData.m_isVisible = isVisible != 0;
+
+        if (!reader.Read(tileCount) || tileCount > reader.GetRemainingSize() / sizeof(TileData))
+            return false;
+
+        const std::byte* pTiles = reader.ReadBytes(tileCount * sizeof(TileData));
+        layerData.m_tileData.resize(tileCount);
+        std::memcpy(layerData.m_tileData.data(), pTiles, tileCount * sizeof(TileData));
+
+        // Flip flags are either absent or stored for every tile
+        uint32_t flipCount = 0;
+        if (!reader.Read(flipCount) || (flipCount != 0 && flipCount != tileCount) || flipCount > reader.GetRemainingSize())
+            return false;
+
+        if (flipCount != 0)
         {
-            continue;
+            const std::byte* pFlips = reader.ReadBytes(flipCount);
+            layerData.m_tileFlips.resize(flipCount);
+            std::memcpy(layerData.m_tileFlips.data(), pFlips, flipCount);
         }
 
-        for (auto tileIt = layer.m_tileData.cbegin(); tileIt != layer.m_tileData.cend(); ++tileIt)
-        {
-            // if tile id is 0, it is an empty tile. We could've ignored them, but this way it is easier to calculate
-            //      world point, and that way we don't store X and Y position of the tile.
-            if (tileIt->m_id == 0)
-            {
-                continue;
-            }
+        m_mapData.m_layerData.push_back(std::move(layerData));
+    }
 
-            // Finding the tileset, where the tile lives. our m_tilesetData is sorted by firstGid (prove me wrong!), 
-            //      so upper_bound will give us iterator to the next tileset (or end if the needed tileset is the last one)
-            auto tilesetIt = std::upper_bound(m_tilesetData.begin(), m_tilesetData.end(), tileIt->m_id, [](int firstgid, const TilesetData& tilesetData)
-                {
-                    return firstgid < tilesetData.GetFirstGid();
-                });
+    return !reader.HasFailed();
+}
 
-            // Getting the needed tileset
-            --tilesetIt;
+bool yang::TiledMap::Render(IGraphics* pGraphics)
+{
+    if (m_layerChunks.size() != m_mapData.m_layerData.size())
+    {
+        CreateChunks();
+    }
 
-            tilesetIt->GetTilesetTexture()->SetAlpha(layer.m_opacity);
+    ++m_renderFrame;
+    m_drawnChunkCount = 0;
+    m_culledChunkCount = 0;
 
-            size_t tileIndex = static_cast<size_t>(tileIt->m_id) - tilesetIt->GetFirstGid();
+    // Visible tile range straight from the viewport corners, clamped to the map
+    const Viewport& viewport = GetGlobalViewport();
+    FVec2 topLeft = viewport.TopLeft();
+    FVec2 bottomRight = viewport.BottomRight();
+    auto toTile = [](float tileCoordinate, int tileCount)
+    {
+        return static_cast<int>(std::clamp(tileCoordinate, 0.f, static_cast<float>(tileCount)));
+    };
 
-            int xCoord = static_cast<int>(tileIt - layer.m_tileData.cbegin()) % m_mapData.m_mapWidth;
-            int yCoord = static_cast<int>(tileIt - layer.m_tileData.cbegin()) / m_mapData.m_mapWidth;
+    int firstColumn = toTile(std::floor(topLeft.x / m_mapData.m_tileWidth), m_mapData.m_mapWidth);
+    int firstRow = toTile(std::floor(topLeft.y / m_mapData.m_tileHeight), m_mapData.m_mapHeight);
+    int endColumn = toTile(std::ceil(bottomRight.x / m_mapData.m_tileWidth), m_mapData.m_mapWidth);
+    int endRow = toTile(std::ceil(bottomRight.y / m_mapData.m_tileHeight), m_mapData.m_mapHeight);
 
-            success = tilesetIt->RenderTile(pGraphics, tileIndex, IVec2(xCoord,yCoord));
+    int firstChunkColumn = firstColumn / kChunkSize;
+    int firstChunkRow = firstRow / kChunkSize;
+    int endChunkColumn = std::min((endColumn + kChunkSize - 1) / kChunkSize, m_chunkColumns);
+    int endChunkRow = std::min((endRow + kChunkSize - 1) / kChunkSize, m_chunkRows);
+    size_t visibleChunkCount = static_cast<size_t>(std::max(endChunkColumn - firstChunkColumn, 0)) * std::max(endChunkRow - firstChunkRow, 0);
 
-            if (!success)
-                break;
+    for (size_t layerIndex = 0; layerIndex < m_mapData.m_layerData.size(); ++layerIndex)
+    {
+        const LayerData& layer = m_mapData.m_layerData[layerIndex];
+        if (!layer.m_isVisible)
+        {
+            continue;
         }
 
-        if (!success)
-            break;
-    }
+        m_culledChunkCount += m_layerChunks[layerIndex].size() - visibleChunkCount;
 
-    for (const auto& tilesetData : m_tilesetData)
-    {
-        tilesetData.GetTilesetTexture()->SetAlpha(1.f);
+        // Every map layer gets its own draw layer below the actors
+        size_t drawLayer = std::min<size_t>(RenderQueue::kMapLayer + layerIndex, RenderQueue::kActorLayer - 1);
+        pGraphics->SetDrawLayer(static_cast<uint8_t>(drawLayer));
+        pGraphics->SetDrawDepth(0.f);
+
+        for (int chunkRow = firstChunkRow; chunkRow < endChunkRow; ++chunkRow)
+        {
+            for (int chunkColumn = firstChunkColumn; chunkColumn < endChunkColumn; ++chunkColumn)
+            {
+                size_t chunkIndex = static_cast<size_t>(chunkRow) * m_chunkColumns + chunkColumn;
+                ChunkData& chunk = m_layerChunks[layerIndex][chunkIndex];
+                if (chunk.m_isDirty && !RenderChunk(pGraphics, layerIndex, chunkIndex))
+                    return false;
+
+                // Chunk without any tiles
+                if (!chunk.m_pTexture)
+                    continue;
+
+                IRect tileRect = GetChunkTileRect(chunkIndex);
+                chunk.m_lastDrawnFrame = m_renderFrame;
+                chunk.m_pTexture->SetAlpha(layer.m_opacity);
+                if (!pGraphics->DrawTexture(chunk.m_pTexture.get(), IVec2(tileRect.x * m_mapData.m_tileWidth, tileRect.y * m_mapData.m_tileHeight)))
+                    return false;
+
+                ++m_drawnChunkCount;
+            }
+        }
     }
 
-    return success;
+    ReleaseOldChunks();
+    return true;
 }
 
 yang::FVec2 yang::TiledMap::GetWorldPointFromTileIndex(size_t index) const
@@ -367,9 +877,84 @@ size_t yang::TiledMap::GetTileIdFromIndex(size_t layerIndex, size_t index) const
     return static_cast<size_t>(m_mapData.m_layerData[layerIndex].m_tileData[index].m_id) - 1;
 }
 
+uint8_t yang::TiledMap::GetTileFlipsFromIndex(size_t layerIndex, size_t tileIndex) const
+{
+    const std::vector<uint8_t>& flips = m_mapData.m_layerData[layerIndex].m_tileFlips;
+    return flips.empty() ? 0 : flips[tileIndex];
+}
+
 void yang::TiledMap::SetTileIdAtIndex(size_t layerIndex, size_t tileIndex, size_t tileId)
 {
-    m_mapData.m_layerData[layerIndex].m_tileData[tileIndex].m_id = static_cast<int>(tileId);
+    int& id = m_mapData.m_layerData[layerIndex].m_tileData[tileIndex].m_id;
+    if (id == static_cast<int>(tileId))
+        return;
+
+    id = static_cast<int>(tileId);
+    UpdatePropertyColumns(layerIndex, tileIndex);
+
+    // A new tile starts without flips
+    std::vector<uint8_t>& flips = m_mapData.m_layerData[layerIndex].m_tileFlips;
+    if (!flips.empty())
+    {
+        flips[tileIndex] = 0;
+    }
+
+    if (layerIndex < m_layerChunks.size())
+    {
+        auto coords = GetCoordsFromIndex(tileIndex);
+        size_t chunkIndex = (coords.y / kChunkSize) * m_chunkColumns + coords.x / kChunkSize;
+        ChunkData& chunk = m_layerChunks[layerIndex][chunkIndex];
+        chunk.m_isDirty = true;
+
+        // Only the changed tile is compiled again
+        int chunkX = static_cast<int>(coords.x % kChunkSize);
+        int chunkY = static_cast<int>(coords.y % kChunkSize);
+        uint16_t chunkTileIndex = static_cast<uint16_t>(chunkY * kChunkSize + chunkX);
+        auto tileIt = std::find_if(chunk.m_tiles.begin(), chunk.m_tiles.end(), [chunkTileIndex](const TileDrawData& drawData)
+            {
+                return drawData.m_chunkTileIndex == chunkTileIndex;
+            });
+
+        if (tileIt != chunk.m_tiles.end())
+        {
+            chunk.m_tiles.erase(tileIt);
+        }
+
+        if (id != 0)
+        {
+            InsertTile(chunk, CompileTile(id, chunkX, chunkY, 0));
+        }
+    }
+
+    // Callbacks can be added or removed while they run, so the vector is walked by index
+    for (size_t i = 0; i < m_tileChangedCallbacks.size(); ++i)
+    {
+        if (m_tileChangedCallbacks[i])
+        {
+            m_tileChangedCallbacks[i](layerIndex, tileIndex);
+        }
+    }
+}
+
+size_t yang::TiledMap::AddTileChangedCallback(TileChangedCallback&& callback)
+{
+    auto freeIt = std::find_if(m_tileChangedCallbacks.begin(), m_tileChangedCallbacks.end(), [](const TileChangedCallback& existing) { return !existing; });
+    if (freeIt != m_tileChangedCallbacks.end())
+    {
+        *freeIt = std::move(callback);
+        return freeIt - m_tileChangedCallbacks.begin();
+    }
+
+    m_tileChangedCallbacks.emplace_back(std::move(callback));
+    return m_tileChangedCallbacks.size() - 1;
+}
+
+void yang::TiledMap::RemoveTileChangedCallback(size_t handle)
+{
+    if (handle < m_tileChangedCallbacks.size())
+    {
+        m_tileChangedCallbacks[handle] = nullptr;
+    }
 }
 
 size_t yang::TiledMap::GetLayerIndex(const char* pName)
@@ -385,6 +970,188 @@ size_t yang::TiledMap::GetLayerIndex(const char* pName)
     return kInvalidValue<size_t>;
 }
 
+const yang::TiledMap::TilesetData& yang::TiledMap::FindTileset(int tileId) const
+{
+    // Our m_tilesetData is sorted by firstGid, so upper_bound gives us the next tileset (or end if the needed tileset is the last one)
+    auto tilesetIt = std::upper_bound(m_tilesetData.begin(), m_tilesetData.end(), tileId, [](int firstgid, const TilesetData& tilesetData)
+        {
+            return firstgid < tilesetData.GetFirstGid();
+        });
+
+    assert(tilesetIt != m_tilesetData.begin());
+    return *(--tilesetIt);
+}
+
+void yang::TiledMap::CreateChunks()
+{
+    m_chunkColumns = (m_mapData.m_mapWidth + kChunkSize - 1) / kChunkSize;
+    m_chunkRows = (m_mapData.m_mapHeight + kChunkSize - 1) / kChunkSize;
+
+    m_layerChunks.clear();
+    m_residentChunks.clear();
+    m_layerChunks.resize(m_mapData.m_layerData.size());
+    for (size_t layerIndex = 0; layerIndex < m_layerChunks.size(); ++layerIndex)
+    {
+        const LayerData& layer = m_mapData.m_layerData[layerIndex];
+        auto& chunks = m_layerChunks[layerIndex];
+        chunks.resize(static_cast<size_t>(m_chunkColumns) * m_chunkRows);
+
+        for (size_t chunkIndex = 0; chunkIndex < chunks.size(); ++chunkIndex)
+        {
+            ChunkData& chunk = chunks[chunkIndex];
+            IRect tileRect = GetChunkTileRect(chunkIndex);
+            for (int y = 0; y < tileRect.height; ++y)
+            {
+                for (int x = 0; x < tileRect.width; ++x)
+                {
+                    // if tile id is 0, it is an empty tile
+                    size_t tileIndex = static_cast<size_t>(tileRect.y + y) * m_mapData.m_mapWidth + tileRect.x + x;
+                    int tileId = layer.m_tileData[tileIndex].m_id;
+                    if (tileId != 0)
+                    {
+                        chunk.m_tiles.push_back(CompileTile(tileId, x, y, layer.m_tileFlips.empty() ? 0 : layer.m_tileFlips[tileIndex]));
+                    }
+                }
+            }
+
+            // Tiles were added in the row order, so a stable sort groups them by texture and keeps that order inside each group
+            std::stable_sort(chunk.m_tiles.begin(), chunk.m_tiles.end(), [](const TileDrawData& left, const TileDrawData& right)
+                {
+                    return std::less<ITexture*>()(left.m_pTexture, right.m_pTexture);
+                });
+        }
+    }
+}
+
+yang::TiledMap::TileDrawData yang::TiledMap::CompileTile(int tileId, int chunkX, int chunkY, uint8_t flipFlags) const
+{
+    const TilesetData& tileset = FindTileset(tileId);
+    TileDrawData drawData;
+    drawData.m_pTexture = tileset.GetTilesetTexture();
+    drawData.m_srcRect = tileset.GetSourceRect(static_cast<size_t>(tileId) - tileset.GetFirstGid());
+    drawData.m_dstRect = IRect(chunkX * m_mapData.m_tileWidth, chunkY * m_mapData.m_tileHeight, drawData.m_srcRect.width, drawData.m_srcRect.height);
+    drawData.m_chunkTileIndex = static_cast<uint16_t>(chunkY * kChunkSize + chunkX);
+    drawData.m_flipFlags = flipFlags;
+    return drawData;
+}
+
+void yang::TiledMap::InsertTile(ChunkData& chunk, const TileDrawData& drawData)
+{
+    auto tileIt = std::upper_bound(chunk.m_tiles.begin(), chunk.m_tiles.end(), drawData, [](const TileDrawData& left, const TileDrawData& right)
+        {
+            if (left.m_pTexture != right.m_pTexture)
+                return std::less<ITexture*>()(left.m_pTexture, right.m_pTexture);
+            return left.m_chunkTileIndex < right.m_chunkTileIndex;
+        });
+
+    chunk.m_tiles.insert(tileIt, drawData);
+}
+
+yang::IRect yang::TiledMap::GetChunkTileRect(size_t chunkIndex) const
+{
+    int x = static_cast<int>(chunkIndex % m_chunkColumns) * kChunkSize;
+    int y = static_cast<int>(chunkIndex / m_chunkColumns) * kChunkSize;
+    return IRect(x, y, std::min(kChunkSize, m_mapData.m_mapWidth - x), std::min(kChunkSize, m_mapData.m_mapHeight - y));
+}
+
+void yang::TiledMap::ReleaseOldChunks()
+{
+    if (m_residentChunks.size() <= kMaxResidentChunks)
+        return;
+
+    // Chunks that became empty since they were added don't hold a texture anymore
+    m_residentChunks.erase(std::remove_if(m_residentChunks.begin(), m_residentChunks.end(), [this](const auto& residentChunk)
+        {
+            ChunkData& chunk = m_layerChunks[residentChunk.first][residentChunk.second];
+            if (chunk.m_pTexture)
+                return false;
+
+            chunk.m_isResident = false;
+            return true;
+        }), m_residentChunks.end());
+
+    if (m_residentChunks.size() <= kMaxResidentChunks)
+        return;
+
+    // Release down to half of the budget, so a camera that keeps moving doesn't sort every frame
+    size_t releaseCount = m_residentChunks.size() - kMaxResidentChunks / 2;
+    auto getLastDrawnFrame = [this](const auto& residentChunk) { return m_layerChunks[residentChunk.first][residentChunk.second].m_lastDrawnFrame; };
+    std::nth_element(m_residentChunks.begin(), m_residentChunks.begin() + releaseCount, m_residentChunks.end(), [&getLastDrawnFrame](const auto& left, const auto& right)
+        {
+            return getLastDrawnFrame(left) < getLastDrawnFrame(right);
+        });
+
+    size_t releasedCount = 0;
+    for (size_t i = 0; i < releaseCount; ++i)
+    {
+        // Chunks drawn this frame are on the screen, keep them
+        ChunkData& chunk = m_layerChunks[m_residentChunks[i].first][m_residentChunks[i].second];
+        if (chunk.m_lastDrawnFrame == m_renderFrame)
+            continue;
+
+        chunk.m_pTexture.reset();
+        chunk.m_isDirty = true;
+        chunk.m_isResident = false;
+        std::swap(m_residentChunks[i], m_residentChunks[releasedCount++]);
+    }
+
+    m_residentChunks.erase(m_residentChunks.begin(), m_residentChunks.begin() + releasedCount);
+}
+
+bool yang::TiledMap::RenderChunk(IGraphics* pGraphics, size_t layerIndex, size_t chunkIndex)
+{
+    ChunkData& chunk = m_layerChunks[layerIndex][chunkIndex];
+    IRect tileRect = GetChunkTileRect(chunkIndex);
+    chunk.m_isDirty = false;
+
+    if (chunk.m_tiles.empty())
+    {
+        chunk.m_pTexture.reset();
+        return true;
+    }
+
+    // A chunk that emptied and got tiles again is still listed
+    if (!chunk.m_isResident)
+    {
+        m_residentChunks.emplace_back(static_cast<uint32_t>(layerIndex), static_cast<uint32_t>(chunkIndex));
+        chunk.m_isResident = true;
+    }
+
+    // A changed chunk keeps its texture and clears it, a texture is only created for a chunk that has none
+    IVec2 dimensions(tileRect.width * m_mapData.m_tileWidth, tileRect.height * m_mapData.m_tileHeight);
+    bool isTextureReused = chunk.m_pTexture && chunk.m_pTexture->GetDimensions() == dimensions;
+    if (!isTextureReused)
+    {
+        chunk.m_pTexture = pGraphics->CreateTexture(dimensions);
+        if (!chunk.m_pTexture)
+            return false;
+    }
+
+    IGraphics::RenderTargetScope targetScope(pGraphics, chunk.m_pTexture.get());
+    if (!targetScope.IsTargetSet() || (isTextureReused && !targetScope.Clear()))
+        return false;
+
+    // Tiles are sorted by texture, so every tileset of the chunk is drawn as one batch
+    std::vector<TextureQuad> quads;
+    quads.reserve(chunk.m_tiles.size());
+
+    bool success = true;
+    for (size_t batchStart = 0; batchStart < chunk.m_tiles.size() && success; batchStart += quads.size())
+    {
+        ITexture* pTexture = chunk.m_tiles[batchStart].m_pTexture;
+        quads.clear();
+        for (size_t i = batchStart; i < chunk.m_tiles.size() && chunk.m_tiles[i].m_pTexture == pTexture; ++i)
+        {
+            const TileDrawData& drawData = chunk.m_tiles[i];
+            quads.push_back(TextureQuad{ drawData.m_srcRect, FRect(drawData.m_dstRect), GetFlipDrawParams(drawData.m_flipFlags) });
+        }
+
+        success = pGraphics->DrawTextureBatch(pTexture, quads.data(), quads.size());
+    }
+
+    return targetScope.Reset() && success;
+}
+
 yang::TiledMap::TilesetData::TilesetData(int firstGid, std::string&& source, tinyxml2::XMLElement* pData)
     :m_firstGid(firstGid)
     ,m_source(std::move(source))
@@ -406,7 +1173,6 @@ void yang::TiledMap::TilesetData::ReadTilesetData(tinyxml2::XMLElement* pData)
     m_source = m_source.substr(0, m_source.rfind('/') + 1) + pTilesetImage->Attribute("source");
     m_imageWidth = pTilesetImage->IntAttribute("width");
     m_imageHeight = pTilesetImage->IntAttribute("height");
-    m_pTilesetTexture = ResourceCache::Get()->Load<ITexture>(m_source.c_str());
 
     for (XMLElement* pTile = pData->FirstChildElement("tile"); pTile != nullptr; pTile = pTile->NextSiblingElement("tile"))
     {
@@ -450,15 +1216,105 @@ void yang::TiledMap::TilesetData::ReadTilesetData(tinyxml2::XMLElement* pData)
 }
 
 bool yang::TiledMap::TilesetData::RenderTile(IGraphics* pGraphics, size_t tileIndex, IVec2 dstPos) const
+{
+    IRect dstRect = { dstPos.x * m_tileWidth, dstPos.y * m_tileHeight, m_tileWidth, m_tileHeight };
+    return pGraphics->DrawTexture(m_pTilesetTexture.get(), GetSourceRect(tileIndex), dstRect);
+}
+
+yang::IRect yang::TiledMap::TilesetData::GetSourceRect(size_t tileIndex) const
 {
     int srcX = (int)tileIndex % m_columns;
     int srcY = (int)tileIndex / m_columns;
-    yang::IRect srcRect(srcX * m_tileWidth, srcY * m_tileHeight, m_tileWidth, m_tileHeight);
-    IRect dstRect = { dstPos.x * m_tileWidth, dstPos.y * m_tileHeight, m_tileWidth, m_tileHeight };
-    return pGraphics->DrawTexture(m_pTilesetTexture.get(), srcRect, dstRect);
+    return IRect(srcX * m_tileWidth, srcY * m_tileHeight, m_tileWidth, m_tileHeight);
 }
 
 yang::ITexture* yang::TiledMap::TilesetData::GetTilesetTexture() const
 {
     return m_pTilesetTexture.get();
 }
+
+bool yang::TiledMap::TilesetData::LoadTexture()
+{
+    m_pTilesetTexture = ResourceCache::Get()->Load<ITexture>(m_source.c_str());
+    if (!m_pTilesetTexture)
+    {
+        LOG(Error, "Failed to load tileset texture. Path: %s", m_source.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void yang::TiledMap::TilesetData::Write(BinaryWriter& writer) const
+{
+    writer.Write(m_firstGid);
+    writer.WriteString(m_source);
+    writer.Write(m_tileWidth);
+    writer.Write(m_tileHeight);
+    writer.Write(m_tileCount);
+    writer.Write(m_columns);
+    writer.Write(m_imageWidth);
+    writer.Write(m_imageHeight);
+
+    // Properties are stored as name hash, variant index and value
+    writer.Write(static_cast<uint32_t>(m_tileProperties.size()));
+    for (const auto& properties : m_tileProperties)
+    {
+        writer.Write(static_cast<uint32_t>(properties.size()));
+        for (const auto& [hashName, value] : properties)
+        {
+            writer.Write(hashName);
+            writer.Write(static_cast<uint8_t>(value.index()));
+            std::visit([&writer](const auto& propertyValue)
+                {
+                    if constexpr (std::is_same_v<std::decay_t<decltype(propertyValue)>, std::string>)
+                        writer.WriteString(propertyValue);
+                    else
+                        writer.Write(propertyValue);
+                }, value);
+        }
+    }
+}
+
+bool yang::TiledMap::TilesetData::Read(BinaryReader& reader)
+{
+    reader.Read(m_firstGid);
+    m_source = reader.ReadString();
+    reader.Read(m_tileWidth);
+    reader.Read(m_tileHeight);
+    reader.Read(m_tileCount);
+    reader.Read(m_columns);
+    reader.Read(m_imageWidth);
+    reader.Read(m_imageHeight);
+
+    uint32_t tileCount = 0;
+    if (!reader.Read(tileCount))
+        return false;
+
+    m_tileProperties.resize(tileCount);
+    for (auto& properties : m_tileProperties)
+    {
+        uint32_t propertyCount = 0;
+        if (!reader.Read(propertyCount))
+            return false;
+
+        for (uint32_t i = 0; i < propertyCount; ++i)
+        {
+            uint32_t hashName = 0;
+            uint8_t type = 0;
+            if (!reader.Read(hashName) || !reader.Read(type))
+                return false;
+
+            switch (type)
+            {
+            case 0: { bool value = false; reader.Read(value); properties[hashName] = value; break; }
+            case 1: { int value = 0; reader.Read(value); properties[hashName] = value; break; }
+            case 2: { float value = 0.f; reader.Read(value); properties[hashName] = value; break; }
+            case 3: properties[hashName] = std::string(reader.ReadString()); break;
+            default: return false;
+            }
+        }
+    }
+
+    return !reader.HasFailed();
+}
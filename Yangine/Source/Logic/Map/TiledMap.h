@@ -5,9 +5,17 @@
 #include <string>
 #include <memory>
 #include <Utils/Vector2.h>
+#include <Utils/Rectangle.h>
 #include <unordered_map>
 #include <variant>
 #include <optional>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <Utils/Typedefs.h>
 
 namespace tinyxml2
 {
@@ -19,6 +27,8 @@ namespace yang
 {
     class ITexture;
     class IGraphics;
+    class BinaryWriter;
+    class BinaryReader;
 /** \class TiledMap */
 /** Class that stores Tiled Map data */
 class TiledMap
@@ -38,12 +48,41 @@ public:
 	/** Default Destructor */
 	virtual ~TiledMap()= default;
 
-    /// Load map from the XML file
-    /// \param filepath - path to the XML file that contains map description
+    /// Magic number at the beginning of the cooked map files, "YMAP"
+    static constexpr uint32_t kCookedMapMagic = 0x50414D59;
+
+    /// Version of the cooked map format, bumped on every layout change
+    static constexpr uint32_t kCookedMapVersion = 2;
+
+    /// Bits of a global tile ID in Tiled layer data that hold the ID itself. The top 3 bits are the flip flags
+    static constexpr uint32_t kTileIdMask = 0x1FFFFFFF;
+
+    /// Flip flags of a tile, the top 3 bits of its global ID in Tiled layer data shifted down to a byte
+    static constexpr uint8_t kFlippedHorizontally = 0x4;   ///< Mirrored along the vertical axis
+    static constexpr uint8_t kFlippedVertically = 0x2;     ///< Mirrored along the horizontal axis
+    static constexpr uint8_t kFlippedDiagonally = 0x1;     ///< X and Y swapped, applied before the other two flips
+
+    /// Width and height of a render chunk in tiles
+    static constexpr int kChunkSize = 16;
+
+    /// Number of chunk textures kept alive. Once exceeded, the chunks that were not drawn for the longest time release theirs
+    static constexpr size_t kMaxResidentChunks = 256;
+
+    /// Load map from the XML file or from the cooked map file
+    /// \param filepath - path to the file that contains map description
     /// \return true if successfully loaded
     virtual bool LoadMap(const char* filepath);
 
-    /// Render the map
+    /// Parses the Tiled map and its tilesets and writes them as one cooked map file, that loads without any text parsing.
+    /// Tileset textures are not loaded
+    /// \param filepath - path to the Tiled XML map
+    /// \param output - cooked bytes are appended here
+    /// \return true if successfully cooked
+    static bool CookMap(const char* filepath, std::vector<std::byte>& output);
+
+    /// Render the map. Every layer is split into chunks of kChunkSize x kChunkSize tiles, each chunk is rendered once into
+    /// its own texture and then drawn with a single draw call. Chunks are rendered again only after SetTileIdAtIndex changes them.
+    /// Only the chunks that overlap the global viewport are visited. The draw data of every tile is compiled when the map is loaded
     /// \param pGraphics - graphics system to use
     /// \return true if successfully rendered
     bool Render(IGraphics* pGraphics);
@@ -74,7 +113,26 @@ public:
     /// \return tile ID
     size_t GetTileIdFromIndex(size_t layerIndex, size_t tileIndex) const;
 
-    /// Sets the tile ID for a tile at specified index in the specified layer
+    /// Get flip flags of the tile from index in the map
+    /// \param layerIndex - index of the layer where tile lives
+    /// \param tileIndex - tile index
+    /// \return kFlipped* values of the tile, 0 if it isn't flipped
+    uint8_t GetTileFlipsFromIndex(size_t layerIndex, size_t tileIndex) const;
+
+    /// Callback called after SetTileIdAtIndex changes a tile
+    using TileChangedCallback = std::function<void(size_t layerIndex, size_t tileIndex)>;
+
+    /// Registers a callback for the tile changes. Used by the systems that compile the map, like pathfinding
+    /// \param callback - callback to call
+    /// \return handle of the callback, used to remove it
+    size_t AddTileChangedCallback(TileChangedCallback&& callback);
+
+    /// Removes the tile change callback
+    /// \param handle - handle returned by AddTileChangedCallback
+    void RemoveTileChangedCallback(size_t handle);
+
+    /// Sets the tile ID for a tile at specified index in the specified layer. Marks the render chunk of the tile dirty
+    /// and notifies the tile change callbacks
     /// \param layerIndex - index of the layer where tiles lives
     /// \param tileIndex - index of the tile in that layer
     /// \param tileId - tile ID to set
@@ -83,6 +141,36 @@ public:
     template <typename PropertyType>
     std::optional<PropertyType> GetTileProperty(size_t tileIndex, const char* propertyName) const;
 
+    /// \struct TilePropertyColumn
+    /// Handle of a tile property compiled by CompileTileProperty
+    /// \tparam PropertyType - bool, int or float
+    template <typename PropertyType>
+    struct TilePropertyColumn
+    {
+        size_t m_index = kInvalidValue<size_t>;    ///< Index of the column among the columns of this type
+
+        /// Was the property compiled
+        bool IsValid() const { return m_index != kInvalidValue<size_t>; }
+    };
+
+    /// Compiles a tile property of the layer into a dense column with one value per tile, so hot code like pathfinding and
+    /// tile collision reads it in O(1) with GetTilePropertyValue. Bools are packed into a bitset, ints and floats into plain arrays.
+    /// Columns follow SetTileIdAtIndex and are dropped by LoadMap
+    /// \tparam PropertyType - bool, int or float
+    /// \param layerIndex - index of the layer to compile
+    /// \param propertyName - name of the property
+    /// \param defaultValue - value of the empty tiles and of the tiles without the property
+    /// \return handle of the column. Invalid if there is no such layer, or any tileset declares the property with another type
+    template <typename PropertyType>
+    TilePropertyColumn<PropertyType> CompileTileProperty(size_t layerIndex, const char* propertyName, PropertyType defaultValue = PropertyType());
+
+    /// Reads the compiled property of the tile
+    /// \param column - handle returned by CompileTileProperty, must be valid
+    /// \param tileIndex - index of the tile in the layer of the column
+    /// \return value of the property
+    template <typename PropertyType>
+    PropertyType GetTilePropertyValue(TilePropertyColumn<PropertyType> column, size_t tileIndex) const;
+
     /// \class TilesetData
     /// Contains information about the tileset used in the map
     class TilesetData
@@ -94,8 +182,33 @@ public:
         /// \param pData - XML element to initialize the tileset from
         TilesetData(int firstGid, std::string&& source, tinyxml2::XMLElement* pData);
 
+        /// Default constructor. Used to read the tileset from a cooked map
+        TilesetData() = default;
+
+        /// Loads the tileset texture from the image path
+        /// \return true if successfully loaded
+        bool LoadTexture();
+
+        /// Writes the tileset to a cooked map
+        /// \param writer - writer to append to
+        void Write(BinaryWriter& writer) const;
+
+        /// Reads the tileset from a cooked map
+        /// \param reader - reader to read from
+        /// \return true if successfully read
+        bool Read(BinaryReader& reader);
+
+        /// alias for the value of a tile property
+        using PropertyValue = std::variant<bool, int, float, std::string>;
+
         /// alias for the map of tile properties
-        using TileProperties = std::unordered_map<uint32_t, std::variant<bool, int, float, std::string>>;
+        using TileProperties = std::unordered_map<uint32_t, PropertyValue>;
+
+        /// Finds the property of the tile
+        /// \param tileId - ID of the tile in this tileset
+        /// \param hashName - StringHash32 of the property name
+        /// \return pointer to the value, or null if the tile doesn't have the property
+        const PropertyValue* FindProperty(int tileId, uint32_t hashName) const;
 
         /// Gets the specified property if it exists
         /// \tparam PropertyType - property type to try to get. Can be one of those: bool, int, float, std::string
@@ -116,22 +229,27 @@ public:
         /// \return true if rendered successfully
         bool RenderTile(IGraphics* pGraphics, size_t tileIndex, IVec2 dstPos) const;
 
+        /// Get rectangle of the tile in the tileset texture
+        /// \param tileIndex - index of the tile in this tileset
+        /// \return the source rectangle
+        IRect GetSourceRect(size_t tileIndex) const;
+
         /// Getter for the texture of this tileset
         /// \return pointer to a texture
         ITexture* GetTilesetTexture() const;
 
         int GetTileCount() const { return m_tileCount; }
     private:
-        int m_firstGid;         ///< The first global tile ID of this tileset (this global ID maps to the first tile in this tileset).
-        std::string m_source;   ///< Path to the image containing this tileset
+        int m_firstGid = 0;         ///< The first global tile ID of this tileset (this global ID maps to the first tile in this tileset).
+        std::string m_source;       ///< Path to the image containing this tileset
 
-        int m_tileWidth;        ///< Width of the single tile
-        int m_tileHeight;       ///< Height of the single tile
-        int m_tileCount;        ///< Total number of tiles in the tileset
-        int m_columns;          ///< Width of the tileset image in tiles (number of tile columns)
+        int m_tileWidth = 0;        ///< Width of the single tile
+        int m_tileHeight = 0;       ///< Height of the single tile
+        int m_tileCount = 0;        ///< Total number of tiles in the tileset
+        int m_columns = 0;          ///< Width of the tileset image in tiles (number of tile columns)
 
-        int m_imageWidth;       ///< Width of the tileset image in pixels
-        int m_imageHeight;      ///< Height of the tileset image in pixels
+        int m_imageWidth = 0;       ///< Width of the tileset image in pixels
+        int m_imageHeight = 0;      ///< Height of the tileset image in pixels
 
         std::shared_ptr<ITexture> m_pTilesetTexture;    ///< Texture that contains this tileset
 
@@ -166,9 +284,46 @@ public:
         float m_opacity;        ///< Layer opacity
         uint32_t m_hashName;    ///< Hash value of the layer's name
         std::vector<TileData> m_tileData;   ///< Vector containing this layer's tiles data. \see yang::TiledMap::TileData
+        std::vector<uint8_t> m_tileFlips;   ///< Flip flags of every tile, kFlipped* values. Empty if no tile of the layer is flipped
         bool m_isVisible;       ///< Is the layer visible?
     };
 
+    /// \struct TileDrawData
+    /// Everything needed to draw a single tile into its chunk, compiled once instead of on every chunk render
+    struct TileDrawData
+    {
+        ITexture* m_pTexture;       ///< Texture of the tileset
+        IRect m_srcRect;            ///< Rectangle of the tile in the tileset texture
+        IRect m_dstRect;            ///< Rectangle of the tile in the chunk texture
+        uint16_t m_chunkTileIndex;  ///< Index of the tile in the chunk (y * kChunkSize + x), used to find the tile when it changes
+        uint8_t m_flipFlags;        ///< Flip flags of the tile, kFlipped* values
+    };
+
+    /// \struct ChunkData
+    /// Cached rendering of a square piece of a layer
+    struct ChunkData
+    {
+        std::vector<TileDrawData> m_tiles;      ///< Non-empty tiles of the chunk, sorted by texture. Tiles of one texture keep the row order
+        std::shared_ptr<ITexture> m_pTexture;   ///< Tiles of the chunk rendered at full opacity. Null if the chunk has no tiles
+        bool m_isDirty = true;                  ///< Do the tiles have to be rendered again before the chunk is drawn
+        bool m_isResident = false;              ///< Is the chunk listed in m_residentChunks. A chunk that became empty stays listed until ReleaseOldChunks
+        uint32_t m_lastDrawnFrame = 0;          ///< Frame when the chunk was drawn last time, used to pick chunks to release
+    };
+
+    /// \struct PropertyColumnData
+    /// Values of a compiled tile property for every tile of a layer
+    template <typename PropertyType>
+    struct PropertyColumnData
+    {
+        /// Bools take a bit per tile, other types are stored as is
+        using StorageType = std::conditional_t<std::is_same_v<PropertyType, bool>, uint64_t, PropertyType>;
+
+        size_t m_layerIndex;                    ///< Index of the compiled layer
+        uint32_t m_hashName;                    ///< Hash value of the property name
+        PropertyType m_defaultValue;            ///< Value of the tiles without the property
+        std::vector<StorageType> m_values;      ///< Value of every tile, or 64 tiles per word for bools
+    };
+
     /// \enum MapType
     /// Type of the map
 	enum class MapType
@@ -199,16 +354,122 @@ protected:
 
     std::vector<TilesetData> m_tilesetData; ///< Tileset data for the map \see yang::TiledMap::TilesetData
 
+    std::vector<std::vector<ChunkData>> m_layerChunks;  ///< Render chunks of every layer, in rows of m_chunkColumns. Created on the first render
+    int m_chunkColumns = 0;                             ///< Number of chunks in a row
+    int m_chunkRows = 0;                                ///< Number of chunk rows
+    std::vector<std::pair<uint32_t, uint32_t>> m_residentChunks;  ///< Layer and chunk index of every chunk that has a texture
+    uint32_t m_renderFrame = 0;                         ///< Number of Render calls
+
+    /// Compiled tile property columns of every supported type
+    std::tuple<std::vector<PropertyColumnData<bool>>, std::vector<PropertyColumnData<int>>, std::vector<PropertyColumnData<float>>> m_propertyColumns;
+
+    std::vector<TileChangedCallback> m_tileChangedCallbacks;   ///< Tile change callbacks, indexed by handle. Removed callbacks are empty
+
+    size_t m_drawnChunkCount = 0;                       ///< Number of chunks drawn by the last Render
+    size_t m_culledChunkCount = 0;                      ///< Number of chunks of visible layers skipped by the last Render, because they were outside of the viewport
+    float m_layerDecodeMs = 0.f;                        ///< Time spent decoding the layer data of the last loaded Tiled map
+
 	// --------------------------------------------------------------------- //
 	// Private Member Functions
 	// --------------------------------------------------------------------- //
 
+    /// Reads the map and tileset data without loading the tileset textures
+    /// \param filepath - path to the XML map or the cooked map
+    /// \return true if successfully read
+    bool ReadMap(const char* filepath);
+
+    /// Reads the map and tileset data from the parsed Tiled XML map
+    /// \param pMapRoot - root element of the map
+    /// \param filepath - path to the map. Tileset paths are relative to it
+    /// \return true if successfully read
+    bool ReadXmlMap(tinyxml2::XMLElement* pMapRoot, const char* filepath);
+
+    /// Finds the tileset that contains the tile
+    /// \param tileId - global ID of the tile, not zero
+    /// \return the tileset
+    const TilesetData& FindTileset(int tileId) const;
+
+    /// Creates the dirty render chunks of every layer and compiles their tiles
+    void CreateChunks();
+
+    /// Compiles draw data of a single tile
+    /// \param tileId - global ID of the tile, not zero
+    /// \param chunkX - column of the tile in its chunk
+    /// \param chunkY - row of the tile in its chunk
+    /// \param flipFlags - flip flags of the tile, kFlipped* values
+    /// \return the draw data
+    TileDrawData CompileTile(int tileId, int chunkX, int chunkY, uint8_t flipFlags) const;
+
+    /// Adds the tile to the chunk's draw data, keeping it sorted by texture and then by the tile index
+    /// \param chunk - chunk to add to
+    /// \param drawData - compiled tile
+    static void InsertTile(ChunkData& chunk, const TileDrawData& drawData);
+
+    /// Get rectangle of the chunk in tiles. Chunks at the right and bottom edges can be smaller than kChunkSize
+    /// \param chunkIndex - index of the chunk in a layer
+    /// \return the rectangle in map coordinates
+    IRect GetChunkTileRect(size_t chunkIndex) const;
+
+    /// Releases the textures of the chunks that were not drawn for the longest time, if there are too many of them
+    void ReleaseOldChunks();
+
+    /// Renders the tiles of the chunk into its texture
+    /// \param pGraphics - graphics system to use
+    /// \param layerIndex - index of the layer
+    /// \param chunkIndex - index of the chunk in the layer
+    /// \return true if successfully rendered
+    bool RenderChunk(IGraphics* pGraphics, size_t layerIndex, size_t chunkIndex);
+
+    /// Looks the property of the tile up in its tileset
+    /// \param tileId - global ID of the tile, 0 for an empty tile
+    /// \param hashName - StringHash32 of the property name
+    /// \param defaultValue - value to return if the tile doesn't have the property
+    /// \return value of the property
+    template <typename PropertyType>
+    PropertyType FindTilePropertyValue(int tileId, uint32_t hashName, PropertyType defaultValue) const;
+
+    /// Stores the value of the tile in the column
+    /// \param column - column to change
+    /// \param tileIndex - index of the tile in the layer
+    /// \param value - value to store
+    template <typename PropertyType>
+    static void SetColumnValue(PropertyColumnData<PropertyType>& column, size_t tileIndex, PropertyType value);
+
+    /// Compiles the tile again in every property column of the layer. Called when the tile ID changes
+    /// \param layerIndex - index of the layer
+    /// \param tileIndex - index of the tile in the layer
+    void UpdatePropertyColumns(size_t layerIndex, size_t tileIndex);
+
+    /// Writes the map and tileset data in the cooked format
+    /// \param writer - writer to append to
+    void WriteCookedMap(BinaryWriter& writer) const;
+
+    /// Reads the map and tileset data from the cooked format
+    /// \param reader - reader positioned after the magic number
+    /// \return true if successfully read
+    bool ReadCookedMap(BinaryReader& reader);
+
 public:
 	// --------------------------------------------------------------------- //
 	// Accessors & Mutators
 	// --------------------------------------------------------------------- //
     size_t GetLayerIndex(const char* pName);
 
+    /// Get map size in tiles
+    IVec2 GetMapSize() const { return IVec2(m_mapData.m_mapWidth, m_mapData.m_mapHeight); }
+
+    /// Get size of a single tile in pixels
+    IVec2 GetTileSize() const { return IVec2(m_mapData.m_tileWidth, m_mapData.m_tileHeight); }
+
+    /// Get number of chunks drawn by the last Render
+    size_t GetDrawnChunkCount() const { return m_drawnChunkCount; }
+
+    /// Get number of chunks skipped by the last Render, because they were outside of the viewport
+    size_t GetCulledChunkCount() const { return m_culledChunkCount; }
+
+    /// Get time spent decoding the layer data of the last loaded map in milliseconds. 0 if it was a cooked map
+    float GetLayerDecodeMs() const { return m_layerDecodeMs; }
+
 };
 template<typename PropertyType>
 inline std::optional<PropertyType> TiledMap::GetTileProperty(size_t tileIndex, const char* propertyName) const
@@ -224,4 +485,33 @@ inline std::optional<PropertyType> TiledMap::GetTileProperty(size_t tileIndex, c
 
     return tilesetIt->GetProperty<PropertyType>(tileId - tilesetIt->GetFirstGid(), propertyName);
 }
+
+template <typename PropertyType>
+inline PropertyType TiledMap::GetTilePropertyValue(TilePropertyColumn<PropertyType> column, size_t tileIndex) const
+{
+    assert(column.IsValid());
+    const auto& columnData = std::get<std::vector<PropertyColumnData<PropertyType>>>(m_propertyColumns)[column.m_index];
+    if constexpr (std::is_same_v<PropertyType, bool>)
+    {
+        return (columnData.m_values[tileIndex / 64] >> (tileIndex % 64)) & 1;
+    }
+    else
+    {
+        return columnData.m_values[tileIndex];
+    }
+}
+
+template <typename PropertyType>
+inline void TiledMap::SetColumnValue(PropertyColumnData<PropertyType>& column, size_t tileIndex, PropertyType value)
+{
+    if constexpr (std::is_same_v<PropertyType, bool>)
+    {
+        uint64_t mask = uint64_t(1) << (tileIndex % 64);
+        column.m_values[tileIndex / 64] = value ? (column.m_values[tileIndex / 64] | mask) : (column.m_values[tileIndex / 64] & ~mask);
+    }
+    else
+    {
+        column.m_values[tileIndex] = value;
+    }
+}
 }
\ No newline at end of file
@@ -0,0 +1,352 @@
+#include "FlowField.h"
+#include <Application/ApplicationConstants.h>
+#include <Application/ApplicationGlobals.h>
+#include <Utils/ThreadPool/ArrayJob.h>
+#include <Utils/Logger.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+
+using yang::FlowField;
+
+namespace
+{
+    /// Steps to the 8 neighbours of a cell, in the order of FlowField::kDirectionVectors
+    constexpr int kDirections[8][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1} };
+
+    /// Index of the first diagonal direction
+    constexpr int kFirstDiagonal = 4;
+
+    /// Index of the opposite of every direction
+    constexpr int kOppositeDirections[8] = { 1, 0, 3, 2, 7, 6, 5, 4 };
+}
+
+bool yang::FlowField::Build(const NavGrid& grid, IVec2 goal, bool isMultithreaded)
+{
+    if (!grid.IsWalkable(goal.x, goal.y))
+    {
+        LOG(Error, "Flow field goal %d, %d is not walkable", goal.x, goal.y);
+        return false;
+    }
+
+    m_size = grid.GetSize();
+    m_goal = goal;
+    m_integration.assign(static_cast<size_t>(m_size.x) * m_size.y, kUnreachable);
+    m_directions.assign(m_integration.size(), kNoDirection);
+    m_stepMasks.resize(m_integration.size());
+
+    // The walkability of the neighbours is checked once per cell, the searches below only test bits
+    ForEachSector(isMultithreaded, [this, &grid](const IRect& rect) { BuildStepMasks(grid, rect); });
+
+    // Dijkstra on a bucket queue: costs are integers and every step costs at most kBucketCount - 1,
+    // so the buckets can be reused in a circle and no heap is needed
+    m_buckets.resize(kBucketCount);
+    uint32_t goalIndex = GetCellIndex(goal.x, goal.y);
+    m_integration[goalIndex] = 0;
+    m_buckets[0].push_back(goalIndex);
+
+    size_t pendingCount = 1;
+    for (uint32_t cost = 0; pendingCount > 0; ++cost)
+    {
+        auto& bucket = m_buckets[cost % kBucketCount];
+        while (!bucket.empty())
+        {
+            uint32_t cellIndex = bucket.back();
+            bucket.pop_back();
+            --pendingCount;
+            if (m_integration[cellIndex] != cost)
+                continue;
+
+            RelaxNeighbours(grid, cellIndex, cost, [this, &pendingCount](uint32_t neighbourIndex, uint32_t newCost)
+                {
+                    m_buckets[newCost % kBucketCount].push_back(neighbourIndex);
+                    ++pendingCount;
+                });
+        }
+    }
+
+    // Every sector only reads the integration field, so they are independent
+    ForEachSector(isMultithreaded, [this, &grid](const IRect& rect) { BuildDirections(grid, rect); });
+    return true;
+}
+
+void yang::FlowField::UpdateCell(const NavGrid& grid, IVec2 cell, uint8_t oldCost)
+{
+    if (m_integration.empty() || cell.x < 0 || cell.y < 0 || cell.x >= m_size.x || cell.y >= m_size.y)
+        return;
+
+    uint8_t newCost = grid.GetCost(cell.x, cell.y);
+    uint32_t cellIndex = GetCellIndex(cell.x, cell.y);
+    m_changedCells.clear();
+
+    // The cell changes the steps into it, out of it and the diagonal steps beside it, all of them start next to it
+    IVec2 maskStart(std::max(cell.x - 1, 0), std::max(cell.y - 1, 0));
+    IVec2 maskEnd(std::min(cell.x + 2, m_size.x), std::min(cell.y + 2, m_size.y));
+    BuildStepMasks(grid, IRect(maskStart.x, maskStart.y, maskEnd.x - maskStart.x, maskEnd.y - maskStart.y));
+
+    auto invalidate = [this](uint32_t index)
+    {
+        if (m_integration[index] == kUnreachable)
+            return;
+
+        m_integration[index] = kUnreachable;
+        m_directions[index] = kNoDirection;
+        m_changedCells.push_back(index);
+        InvalidateDependents(index);
+    };
+
+    // A raised cost only makes the routes through the cell more expensive, so the cells downstream are integrated again.
+    // A lowered cost is handled by the relaxation below alone
+    if (newCost == NavGrid::kBlocked || (oldCost != NavGrid::kBlocked && newCost > oldCost))
+    {
+        if (newCost == NavGrid::kBlocked)
+        {
+            invalidate(cellIndex);
+
+            // The blocked cell also closes the diagonal steps passing beside it
+            for (int direction = kFirstDiagonal; direction < kNoDirection; ++direction)
+            {
+                IVec2 sideUsers[2] = { IVec2(cell.x - kDirections[direction][0], cell.y), IVec2(cell.x, cell.y - kDirections[direction][1]) };
+                for (IVec2 user : sideUsers)
+                {
+                    if (user.x >= 0 && user.y >= 0 && user.x < m_size.x && user.y < m_size.y && m_directions[GetCellIndex(user.x, user.y)] == direction)
+                    {
+                        invalidate(GetCellIndex(user.x, user.y));
+                    }
+                }
+            }
+        }
+        else
+        {
+            InvalidateDependents(cellIndex);
+        }
+    }
+
+    auto pushOpen = [this](uint32_t index, uint32_t cost)
+    {
+        m_openList.emplace_back(cost, index);
+        std::push_heap(m_openList.begin(), m_openList.end(), std::greater<>());
+    };
+
+    m_openList.clear();
+    uint32_t goalIndex = GetCellIndex(m_goal.x, m_goal.y);
+    if (cellIndex == goalIndex && newCost != NavGrid::kBlocked && m_integration[goalIndex] != 0)
+    {
+        m_integration[goalIndex] = 0;
+        m_changedCells.push_back(goalIndex);
+    }
+
+    // Settled cells around the changed area are the sources of the repair. The neighbours of the changed cell are
+    // included, because opening a cell also opens the diagonal steps beside it
+    size_t invalidatedCount = m_changedCells.size();
+    for (size_t i = 0; i <= invalidatedCount; ++i)
+    {
+        IVec2 center = i < invalidatedCount ? GetCell(m_changedCells[i]) : cell;
+        for (int y = std::max(center.y - 1, 0); y <= std::min(center.y + 1, m_size.y - 1); ++y)
+        {
+            for (int x = std::max(center.x - 1, 0); x <= std::min(center.x + 1, m_size.x - 1); ++x)
+            {
+                uint32_t index = GetCellIndex(x, y);
+                if (m_integration[index] != kUnreachable)
+                {
+                    pushOpen(index, m_integration[index]);
+                }
+            }
+        }
+    }
+
+    while (!m_openList.empty())
+    {
+        std::pop_heap(m_openList.begin(), m_openList.end(), std::greater<>());
+        auto [cost, index] = m_openList.back();
+        m_openList.pop_back();
+        if (cost != m_integration[index])
+            continue;
+
+        RelaxNeighbours(grid, index, cost, [this, &pushOpen](uint32_t neighbourIndex, uint32_t newCost)
+            {
+                m_changedCells.push_back(neighbourIndex);
+                pushOpen(neighbourIndex, newCost);
+            });
+    }
+
+    // A cell keeps its direction unless its cost to the goal changed: the cells pointing into raised cells were invalidated,
+    // and the cells pointing into lowered ones were lowered too
+    for (uint32_t index : m_changedCells)
+    {
+        IVec2 changedCell = GetCell(index);
+        m_directions[index] = FindDirection(grid, changedCell.x, changedCell.y);
+    }
+}
+
+yang::FVec2 yang::FlowField::SampleDirection(FVec2 position, IVec2 tileSize) const
+{
+    assert(tileSize.x > 0 && tileSize.y > 0);
+    return GetDirection(static_cast<int>(std::floor(position.x / tileSize.x)), static_cast<int>(std::floor(position.y / tileSize.y)));
+}
+
+uint32_t yang::FlowField::GetStepCost(const NavGrid& grid, int x, int y, int direction)
+{
+    return grid.GetCost(x, y) * (direction < kFirstDiagonal ? kStraightStepCost : kDiagonalStepCost);
+}
+
+uint8_t yang::FlowField::FindDirection(const NavGrid& grid, int x, int y) const
+{
+    uint32_t cost = GetIntegrationCost(x, y);
+    if (cost == 0 || cost == kUnreachable)
+        return kNoDirection;
+
+    uint32_t cellIndex = GetCellIndex(x, y);
+    uint8_t bestDirection = kNoDirection;
+    uint32_t bestCost = kUnreachable;
+    for (int direction = 0; direction < kNoDirection; ++direction)
+    {
+        if (!HasStep(cellIndex, direction))
+            continue;
+
+        int nextX = x + kDirections[direction][0];
+        int nextY = y + kDirections[direction][1];
+        uint32_t nextCost = GetIntegrationCost(nextX, nextY);
+        if (nextCost == kUnreachable)
+            continue;
+
+        nextCost += GetStepCost(grid, nextX, nextY, direction);
+        if (nextCost < bestCost)
+        {
+            bestCost = nextCost;
+            bestDirection = static_cast<uint8_t>(direction);
+        }
+    }
+
+    return bestDirection;
+}
+
+template <class Function>
+void yang::FlowField::ForEachSector(bool isMultithreaded, Function&& function) const
+{
+    std::vector<IRect> sectors;
+    for (int y = 0; y < m_size.y; y += kSectorSize)
+    {
+        for (int x = 0; x < m_size.x; x += kSectorSize)
+        {
+            sectors.emplace_back(x, y, std::min(kSectorSize, m_size.x - x), std::min(kSectorSize, m_size.y - y));
+        }
+    }
+
+    if (isMultithreaded && kNumThreads > 0 && sectors.size() > 1)
+    {
+        auto runSector = [&function](size_t, const IRect& rect) { function(rect); };
+        ArrayJob<std::vector<IRect>> job(sectors, runSector, GetThreadPool(), std::min(kNumThreads, sectors.size()));
+        job.WaitFor();
+    }
+    else
+    {
+        for (const IRect& rect : sectors)
+        {
+            function(rect);
+        }
+    }
+}
+
+void yang::FlowField::BuildStepMasks(const NavGrid& grid, const IRect& rect)
+{
+    for (int y = rect.y; y < rect.y + rect.height; ++y)
+    {
+        // Walkability of the 3 x 3 neighbourhood, indexed by [row][column]. It slides along the row, so every cell reads one new column
+        bool isWalkable[3][3];
+        for (int offsetY = -1; offsetY <= 1; ++offsetY)
+        {
+            isWalkable[offsetY + 1][1] = grid.IsWalkable(rect.x - 1, y + offsetY);
+            isWalkable[offsetY + 1][2] = grid.IsWalkable(rect.x, y + offsetY);
+        }
+
+        for (int x = rect.x; x < rect.x + rect.width; ++x)
+        {
+            for (int offsetY = -1; offsetY <= 1; ++offsetY)
+            {
+                bool* pRow = isWalkable[offsetY + 1];
+                pRow[0] = pRow[1];
+                pRow[1] = pRow[2];
+                pRow[2] = grid.IsWalkable(x + 1, y + offsetY);
+            }
+
+            uint8_t mask = 0;
+            if (isWalkable[1][1])
+            {
+                for (int direction = 0; direction < kNoDirection; ++direction)
+                {
+                    int stepX = kDirections[direction][0];
+                    int stepY = kDirections[direction][1];
+                    bool canStep = isWalkable[stepY + 1][stepX + 1] && (direction < kFirstDiagonal || (isWalkable[1][stepX + 1] && isWalkable[stepY + 1][1]));
+                    mask |= canStep ? static_cast<uint8_t>(1 << direction) : 0;
+                }
+            }
+            m_stepMasks[GetCellIndex(x, y)] = mask;
+        }
+    }
+}
+
+void yang::FlowField::BuildDirections(const NavGrid& grid, const IRect& rect)
+{
+    for (int y = rect.y; y < rect.y + rect.height; ++y)
+    {
+        for (int x = rect.x; x < rect.x + rect.width; ++x)
+        {
+            m_directions[GetCellIndex(x, y)] = FindDirection(grid, x, y);
+        }
+    }
+}
+
+template <class Callback>
+void yang::FlowField::RelaxNeighbours(const NavGrid& grid, uint32_t cellIndex, uint32_t cost, Callback&& onImproved)
+{
+    IVec2 cell = GetCell(cellIndex);
+    uint32_t straightCost = cost + GetStepCost(grid, cell.x, cell.y, 0);
+    uint32_t diagonalCost = cost + GetStepCost(grid, cell.x, cell.y, kFirstDiagonal);
+    for (int direction = 0; direction < kNoDirection; ++direction)
+    {
+        // The neighbour steps into the cell in this direction. Steps are symmetric, so the cell's own mask tells if it can
+        if (!HasStep(cellIndex, kOppositeDirections[direction]))
+            continue;
+
+        int x = cell.x - kDirections[direction][0];
+        int y = cell.y - kDirections[direction][1];
+
+        uint32_t neighbourIndex = GetCellIndex(x, y);
+        uint32_t newCost = direction < kFirstDiagonal ? straightCost : diagonalCost;
+        if (newCost < m_integration[neighbourIndex])
+        {
+            m_integration[neighbourIndex] = newCost;
+            onImproved(neighbourIndex, newCost);
+        }
+    }
+}
+
+void yang::FlowField::InvalidateDependents(uint32_t cellIndex)
+{
+    // The invalidated cells are appended to m_changedCells, which doubles as the queue of this flood
+    size_t nextIndex = m_changedCells.size();
+    for (uint32_t current = cellIndex;; current = m_changedCells[nextIndex++])
+    {
+        IVec2 cell = GetCell(current);
+        for (int direction = 0; direction < kNoDirection; ++direction)
+        {
+            int x = cell.x - kDirections[direction][0];
+            int y = cell.y - kDirections[direction][1];
+            if (x < 0 || y < 0 || x >= m_size.x || y >= m_size.y)
+                continue;
+
+            uint32_t index = GetCellIndex(x, y);
+            if (m_directions[index] == direction)
+            {
+                m_integration[index] = kUnreachable;
+                m_directions[index] = kNoDirection;
+                m_changedCells.push_back(index);
+            }
+        }
+
+        if (nextIndex == m_changedCells.size())
+            break;
+    }
+}
@@ -0,0 +1,147 @@
+#pragma once
+/** \file FlowField.h */
+/** Direction to a shared goal from every cell of a grid */
+
+#include <Logic/Pathfinding/NavGrid.h>
+#include <Utils/Rectangle.h>
+#include <Utils/Vector2.h>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \class FlowField */
+/** Integration field of a NavGrid towards one goal and the direction field derived from it. The integration field holds
+    the cost of walking from every cell to the goal, the direction field holds the step to the cheapest neighbour.
+    Any number of agents heading to the goal sample their direction in O(1) instead of searching a path each.
+    Moves follow the same rules as GridPathfinder: 8-connected, diagonal steps only when both side cells are walkable */
+class FlowField
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+    static constexpr uint32_t kUnreachable = 0xFFFFFFFF;    ///< Integration cost of the cells that can't reach the goal
+    static constexpr uint32_t kStraightStepCost = 10;       ///< Integration cost of a straight step into a cell of cost 1
+    static constexpr uint32_t kDiagonalStepCost = 14;       ///< Integration cost of a diagonal step into a cell of cost 1
+    static constexpr uint8_t kNoDirection = 8;              ///< Direction of the goal and of the unreachable cells
+    static constexpr int kSectorSize = 64;                  ///< Width and height of the sectors the build is split into for the worker threads
+
+    /// Unit vectors of the directions, straight ones first. The last one is kNoDirection
+    static constexpr float kDirectionVectors[kNoDirection + 1][2] =
+    {
+        {1.f, 0.f}, {-1.f, 0.f}, {0.f, 1.f}, {0.f, -1.f},
+        {0.70710678f, 0.70710678f}, {0.70710678f, -0.70710678f}, {-0.70710678f, 0.70710678f}, {-0.70710678f, -0.70710678f},
+        {0.f, 0.f}
+    };
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Builds the integration field from the goal and the direction field from it
+    /// \param grid - navigation grid
+    /// \param goal - goal cell, must be walkable
+    /// \param isMultithreaded - build the per-cell passes sector by sector on the application thread pool
+    /// \return true if successfully built
+    bool Build(const NavGrid& grid, IVec2 goal, bool isMultithreaded = false);
+
+    /// Repairs the fields after the cost of a cell has changed. Only the cells whose cost to the goal
+    /// depends on the changed cell are integrated again
+    /// \param grid - navigation grid, already holding the new cost
+    /// \param cell - changed cell
+    /// \param oldCost - cost of the cell before the change
+    void UpdateCell(const NavGrid& grid, IVec2 cell, uint8_t oldCost);
+
+    /// Get direction to move in from the cell. Cells outside of the field, the goal and the unreachable cells give a zero vector
+    FVec2 GetDirection(int x, int y) const
+    {
+        if (x < 0 || y < 0 || x >= m_size.x || y >= m_size.y)
+            return FVec2(0.f, 0.f);
+
+        const float* pDirection = kDirectionVectors[m_directions[static_cast<size_t>(y) * m_size.x + x]];
+        return FVec2(pDirection[0], pDirection[1]);
+    }
+
+    /// Get direction to move in from the world position
+    /// \param position - position in pixels
+    /// \param tileSize - size of a cell in pixels
+    /// \return direction of the cell that contains the position
+    FVec2 SampleDirection(FVec2 position, IVec2 tileSize) const;
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+
+    /// Integration costs go into buckets by value, a step is never more expensive than the number of buckets
+    static constexpr uint32_t kBucketCount = kDiagonalStepCost * 255 + 1;
+
+    IVec2 m_size;                                               ///< Width and height in cells
+    IVec2 m_goal;                                               ///< Goal cell
+    std::vector<uint32_t> m_integration;                        ///< Cost from every cell to the goal, row by row
+    std::vector<uint8_t> m_directions;                          ///< Index of the direction to move in from every cell, row by row
+    std::vector<uint8_t> m_stepMasks;                           ///< Bit per direction of the steps every cell can take, row by row
+
+    std::vector<std::vector<uint32_t>> m_buckets;               ///< Bucket queue of the full build
+    std::vector<std::pair<uint32_t, uint32_t>> m_openList;      ///< Binary heap of the repair, pairs of cost and cell index
+    std::vector<uint32_t> m_changedCells;                       ///< Cells whose cost to the goal changed during the repair
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Does the step mask of the cell allow the direction
+    bool HasStep(uint32_t cellIndex, int direction) const { return ((m_stepMasks[cellIndex] >> direction) & 1) != 0; }
+
+    /// Calls the function with every sector of the field, on the application thread pool if requested
+    template <class Function>
+    void ForEachSector(bool isMultithreaded, Function&& function) const;
+
+    /// Finds the steps every cell in the rectangle can take
+    void BuildStepMasks(const NavGrid& grid, const IRect& rect);
+
+    /// Get integration cost of stepping into the cell
+    static uint32_t GetStepCost(const NavGrid& grid, int x, int y, int direction);
+
+    /// Finds the neighbour with the lowest cost to the goal
+    /// \return direction to the neighbour, kNoDirection for the goal and the unreachable cells
+    uint8_t FindDirection(const NavGrid& grid, int x, int y) const;
+
+    /// Derives the directions of every cell in the rectangle from the integration field
+    void BuildDirections(const NavGrid& grid, const IRect& rect);
+
+    /// Lowers the cost of the cells that can step into the cell, if it is cheaper than their known cost
+    /// \param cost - cost of the cell
+    /// \param onImproved - called with the cell index and the new cost of every improved cell
+    template <class Callback>
+    void RelaxNeighbours(const NavGrid& grid, uint32_t cellIndex, uint32_t cost, Callback&& onImproved);
+
+    /// Resets the cost of every cell whose direction leads through the cell, and of the cells depending on them
+    /// \param cellIndex - cell whose cost to the goal has increased
+    void InvalidateDependents(uint32_t cellIndex);
+
+    /// Get coordinates from cell index
+    IVec2 GetCell(uint32_t cellIndex) const { return IVec2(static_cast<int>(cellIndex % m_size.x), static_cast<int>(cellIndex / m_size.x)); }
+
+    /// Get cell index from coordinates
+    uint32_t GetCellIndex(int x, int y) const { return static_cast<uint32_t>(y) * m_size.x + x; }
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Get goal cell
+    IVec2 GetGoal() const { return m_goal; }
+
+    /// Get width and height in cells
+    IVec2 GetSize() const { return m_size; }
+
+    /// Get cost of walking from the cell to the goal, kUnreachable if the goal can't be reached. The cell must be inside the field
+    uint32_t GetIntegrationCost(int x, int y) const { return m_integration[static_cast<size_t>(y) * m_size.x + x]; }
+};
+}
@@ -0,0 +1,120 @@
+#include "FlowFieldCache.h"
+#include <Logic/Map/TiledMap.h>
+#include <Utils/Logger.h>
+#include <algorithm>
+#include <cassert>
+
+using yang::FlowFieldCache;
+
+yang::FlowFieldCache::~FlowFieldCache()
+{
+    DetachMap();
+}
+
+bool yang::FlowFieldCache::Init(TiledMap* pMap, size_t layerIndex, const char* pWalkableProperty, const char* pCostProperty)
+{
+    assert(pMap);
+    DetachMap();
+    m_fields.clear();
+
+    if (!m_grid.BuildFromMap(*pMap, layerIndex, pWalkableProperty, pCostProperty))
+    {
+        LOG(Error, "Failed to compile the navigation grid from the map layer %zu", layerIndex);
+        return false;
+    }
+
+    m_pMap = pMap;
+    m_tileChangedHandle = pMap->AddTileChangedCallback([this](size_t changedLayerIndex, size_t tileIndex)
+        {
+            if (changedLayerIndex != m_grid.GetLayerIndex())
+                return;
+
+            IVec2 cell(static_cast<int>(tileIndex % m_grid.GetSize().x), static_cast<int>(tileIndex / m_grid.GetSize().x));
+            uint8_t oldCost = m_grid.GetCost(cell.x, cell.y);
+            if (m_grid.UpdateFromMap(*m_pMap, tileIndex))
+            {
+                OnCellChanged(cell, oldCost);
+            }
+        });
+
+    return true;
+}
+
+bool yang::FlowFieldCache::Init(NavGrid&& grid)
+{
+    DetachMap();
+    m_fields.clear();
+
+    if (grid.GetSize().x <= 0 || grid.GetSize().y <= 0)
+    {
+        LOG(Error, "Navigation grid is not initialized");
+        return false;
+    }
+
+    m_grid = std::move(grid);
+    return true;
+}
+
+const yang::FlowField* yang::FlowFieldCache::GetField(IVec2 goal)
+{
+    if (!m_grid.IsWalkable(goal.x, goal.y))
+        return nullptr;
+
+    uint32_t key = static_cast<uint32_t>(goal.y) * m_grid.GetSize().x + goal.x;
+    if (auto it = m_fields.find(key); it != m_fields.end())
+    {
+        it->second.m_lastUsed = ++m_cacheClock;
+        return &it->second.m_field;
+    }
+
+    if (m_fields.size() >= kMaxCachedFields)
+    {
+        auto oldestIt = std::min_element(m_fields.begin(), m_fields.end(), [](const auto& left, const auto& right)
+            {
+                return left.second.m_lastUsed < right.second.m_lastUsed;
+            });
+        m_fields.erase(oldestIt);
+    }
+
+    CachedField& cachedField = m_fields[key];
+    if (!cachedField.m_field.Build(m_grid, goal, m_isMultithreaded))
+    {
+        m_fields.erase(key);
+        return nullptr;
+    }
+
+    ++m_buildCount;
+    cachedField.m_lastUsed = ++m_cacheClock;
+    return &cachedField.m_field;
+}
+
+void yang::FlowFieldCache::SetCellCost(IVec2 cell, uint8_t cost)
+{
+    IVec2 size = m_grid.GetSize();
+    if (cell.x < 0 || cell.y < 0 || cell.x >= size.x || cell.y >= size.y)
+        return;
+
+    uint8_t oldCost = m_grid.GetCost(cell.x, cell.y);
+    if (oldCost == cost)
+        return;
+
+    m_grid.SetCost(cell, cost);
+    OnCellChanged(cell, oldCost);
+}
+
+void yang::FlowFieldCache::OnCellChanged(IVec2 cell, uint8_t oldCost)
+{
+    for (auto& [key, cachedField] : m_fields)
+    {
+        cachedField.m_field.UpdateCell(m_grid, cell, oldCost);
+    }
+}
+
+void yang::FlowFieldCache::DetachMap()
+{
+    if (m_pMap)
+    {
+        m_pMap->RemoveTileChangedCallback(m_tileChangedHandle);
+        m_pMap = nullptr;
+    }
+}
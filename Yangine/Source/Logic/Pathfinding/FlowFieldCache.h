@@ -0,0 +1,120 @@
+#pragma once
+/** \file FlowFieldCache.h */
+/** Flow fields of the recently used goals */
+
+#include <Logic/Pathfinding/FlowField.h>
+#include <Logic/Pathfinding/NavGrid.h>
+#include <Utils/Vector2.h>
+#include <unordered_map>
+#include <cstdint>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+    class TiledMap;
+
+/** \class FlowFieldCache */
+/** Builds flow fields over a NavGrid and keeps them per goal cell, so every group of agents heading to the same
+    goal shares one field. Cell changes repair the cached fields incrementally. When the grid is compiled from a TiledMap,
+    SetTileIdAtIndex repairs them automatically */
+class FlowFieldCache
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+    static constexpr size_t kMaxCachedFields = 16;      ///< Fields kept in the cache, the least recently used one is dropped first
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /** Default Constructor */
+    FlowFieldCache() = default;
+
+    /** Destructor. Stops listening for the map changes */
+    ~FlowFieldCache();
+
+    FlowFieldCache(const FlowFieldCache&) = delete;
+    FlowFieldCache& operator=(const FlowFieldCache&) = delete;
+
+    /// Compiles the navigation grid from the map layer and listens for the tile changes. The map must outlive the cache
+    /// \param pMap - map to compile
+    /// \param layerIndex - index of the layer to compile
+    /// \param pWalkableProperty - name of the bool tile property that marks walkable tiles
+    /// \param pCostProperty - name of the int tile property with the tile cost, can be null
+    /// \return true if successfully initialized
+    bool Init(TiledMap* pMap, size_t layerIndex, const char* pWalkableProperty, const char* pCostProperty = nullptr);
+
+    /// Uses a grid filled by hand
+    /// \param grid - navigation grid
+    /// \return true if successfully initialized
+    bool Init(NavGrid&& grid);
+
+    /// Get flow field towards the goal, building it if it isn't cached
+    /// \param goal - goal cell
+    /// \return the field, valid until the next GetField or Clear call. Null if the goal is not walkable
+    const FlowField* GetField(IVec2 goal);
+
+    /// Changes the cost of a cell and repairs every cached field. Called automatically for the map tile changes
+    /// \param cell - cell to change
+    /// \param cost - new cost, NavGrid::kBlocked to block the cell
+    void SetCellCost(IVec2 cell, uint8_t cost);
+
+    /// Drops every cached field
+    void Clear() { m_fields.clear(); }
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+
+    /// \struct CachedField
+    /// Field kept in the cache
+    struct CachedField
+    {
+        FlowField m_field;              ///< The field
+        uint32_t m_lastUsed = 0;        ///< Cache clock value of the last use
+    };
+
+    NavGrid m_grid;                                         ///< Grid the fields are built over
+    TiledMap* m_pMap = nullptr;                             ///< Map the grid was compiled from, can be null
+    size_t m_tileChangedHandle = 0;                         ///< Handle of the map tile change callback
+
+    std::unordered_map<uint32_t, CachedField> m_fields;     ///< Cached fields by goal cell index
+    uint32_t m_cacheClock = 0;                              ///< Incremented on every cache use
+    bool m_isMultithreaded = false;                         ///< Are the direction fields built on the application thread pool
+
+    size_t m_buildCount = 0;                                ///< Number of fields built from scratch
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Repairs every cached field after a cell change
+    /// \param cell - changed cell
+    /// \param oldCost - cost of the cell before the change
+    void OnCellChanged(IVec2 cell, uint8_t oldCost);
+
+    /// Stops listening for the map changes
+    void DetachMap();
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Get the navigation grid
+    const NavGrid& GetNavGrid() const { return m_grid; }
+
+    /// Get number of fields built from scratch, the rest of GetField calls were answered from the cache
+    size_t GetBuildCount() const { return m_buildCount; }
+
+    /// Get number of cached fields
+    size_t GetCachedFieldCount() const { return m_fields.size(); }
+
+    /// Set whether the direction fields are built on the application thread pool
+    void SetMultithreaded(bool isMultithreaded) { m_isMultithreaded = isMultithreaded; }
+};
+}
@@ -0,0 +1,876 @@
+#include "GridPathfinder.h"
+#include <Logic/Map/TiledMap.h>
+#include <Utils/Logger.h>
+#include <Utils/Typedefs.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using yang::GridPathfinder;
+
+namespace
+{
+    constexpr float kSqrt2 = 1.41421356f;
+
+    /// Directions to the 8 neighbours of a cell, straight ones first
+    constexpr int kDirections[8][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1} };
+
+    /// Virtual nodes of the abstract search, they never collide with cell indices of a valid grid
+    constexpr uint32_t kAbstractStartNode = 0xFFFFFFFE;
+    constexpr uint32_t kAbstractGoalNode = 0xFFFFFFFD;
+
+    /// Orders an open list as a min heap by the estimate
+    struct GreaterEstimate
+    {
+        template <class OpenNode>
+        bool operator()(const OpenNode& left, const OpenNode& right) const { return left.m_estimate > right.m_estimate; }
+    };
+
+    /// Sign of the value
+    int Sign(int value) { return (value > 0) - (value < 0); }
+
+    /// Are the cells the same
+    bool IsSameCell(yang::IVec2 left, yang::IVec2 right) { return left.x == right.x && left.y == right.y; }
+}
+
+yang::GridPathfinder::~GridPathfinder()
+{
+    if (m_pMap)
+    {
+        m_pMap->RemoveTileChangedCallback(m_tileChangedHandle);
+    }
+}
+
+bool yang::GridPathfinder::Init(TiledMap* pMap, size_t layerIndex, const char* pWalkableProperty, const char* pCostProperty)
+{
+    assert(pMap);
+    if (m_pMap)
+    {
+        m_pMap->RemoveTileChangedCallback(m_tileChangedHandle);
+        m_pMap = nullptr;
+    }
+
+    if (!m_grid.BuildFromMap(*pMap, layerIndex, pWalkableProperty, pCostProperty))
+    {
+        LOG(Error, "Failed to compile the navigation grid from the map layer %zu", layerIndex);
+        return false;
+    }
+
+    m_pMap = pMap;
+    m_tileChangedHandle = pMap->AddTileChangedCallback([this](size_t changedLayerIndex, size_t tileIndex)
+        {
+            if (changedLayerIndex == m_grid.GetLayerIndex() && m_grid.UpdateFromMap(*m_pMap, tileIndex))
+            {
+                OnCellChanged(GetCell(static_cast<uint32_t>(tileIndex)));
+            }
+        });
+
+    ResetSearchData();
+    return true;
+}
+
+bool yang::GridPathfinder::Init(NavGrid&& grid)
+{
+    if (m_pMap)
+    {
+        m_pMap->RemoveTileChangedCallback(m_tileChangedHandle);
+        m_pMap = nullptr;
+    }
+
+    if (grid.GetSize().x <= 0 || grid.GetSize().y <= 0)
+    {
+        LOG(Error, "Navigation grid is not initialized");
+        return false;
+    }
+
+    m_grid = std::move(grid);
+    ResetSearchData();
+    return true;
+}
+
+bool yang::GridPathfinder::FindPath(IVec2 start, IVec2 goal, std::vector<IVec2>& path, SearchMode mode)
+{
+    path.clear();
+    m_expandedNodeCount = 0;
+
+    IVec2 size = m_grid.GetSize();
+    IRect gridBounds(0, 0, size.x, size.y);
+    if (!IsOpen(start.x, start.y, gridBounds) || !IsOpen(goal.x, goal.y, gridBounds))
+        return false;
+
+    // Areas are relabeled lazily: a stale label can only miss a new connection, so only a mismatch has to be checked again
+    uint32_t startCellIndex = GetCellIndex(start.x, start.y);
+    uint32_t goalCellIndex = GetCellIndex(goal.x, goal.y);
+    if (m_areas[startCellIndex] != m_areas[goalCellIndex] && m_areAreasDirty)
+    {
+        LabelAreas();
+    }
+    if (m_areas[startCellIndex] != m_areas[goalCellIndex])
+        return false;
+
+    uint64_t key = (static_cast<uint64_t>(startCellIndex) << 32) | goalCellIndex;
+    if (auto cachedIt = m_pathCache.find(key); cachedIt != m_pathCache.end())
+    {
+        CachedPath& cached = cachedIt->second;
+        bool isValid = std::all_of(cached.m_clusters.begin(), cached.m_clusters.end(), [this](const auto& clusterVersion)
+            {
+                return m_clusters[clusterVersion.first].m_version == clusterVersion.second;
+            });
+
+        // A path through the abstraction can be longer than the optimal one that kFlat promises, the search replaces it then
+        if (isValid && (cached.m_isOptimal || mode != SearchMode::kFlat))
+        {
+            ++m_cacheHitCount;
+            cached.m_lastUsed = ++m_cacheClock;
+            path = cached.m_path;
+            return true;
+        }
+
+        if (!isValid)
+        {
+            m_pathCache.erase(cachedIt);
+        }
+    }
+
+    ++m_cacheMissCount;
+    bool useAbstraction = mode == SearchMode::kHierarchical || (mode == SearchMode::kAuto && GetOctileDistance(start, goal) > kHierarchicalDistance);
+
+    path.push_back(start);
+    bool isFound = useAbstraction && SearchHierarchical(start, goal, path);
+    bool isOptimal = !isFound;
+    if (!isFound)
+    {
+        // The abstraction only crosses cluster borders straight, so it can miss paths squeezing diagonally through a corner
+        path.resize(1);
+        isFound = SearchSegment(start, goal, gridBounds, path);
+    }
+
+    if (!isFound)
+    {
+        // A blocked cell split the area, relabel so the next queries into the other part are rejected right away
+        if (m_areAreasDirty)
+        {
+            LabelAreas();
+        }
+
+        path.clear();
+        return false;
+    }
+
+    CachePath(key, path, isOptimal);
+    return true;
+}
+
+void yang::GridPathfinder::SetCellCost(IVec2 cell, uint8_t cost)
+{
+    if (cell.x < 0 || cell.y < 0 || cell.x >= m_grid.GetSize().x || cell.y >= m_grid.GetSize().y || m_grid.GetCost(cell.x, cell.y) == cost)
+        return;
+
+    m_grid.SetCost(cell, cost);
+    OnCellChanged(cell);
+}
+
+void yang::GridPathfinder::BuildAbstraction()
+{
+    for (size_t i = 0; i < m_clusters.size(); ++i)
+    {
+        GetCluster(i);
+    }
+}
+
+void yang::GridPathfinder::OnCellChanged(IVec2 cell)
+{
+    int clusterX = cell.x / kClusterSize;
+    int clusterY = cell.y / kClusterSize;
+    ClusterData& cluster = m_clusters[static_cast<size_t>(clusterY) * m_clusterColumns + clusterX];
+    ++cluster.m_version;
+    cluster.m_isDirty = true;
+
+    // Cost changes between walkable values keep the areas
+    uint32_t area = m_areas[GetCellIndex(cell.x, cell.y)];
+    m_areAreasDirty = m_areAreasDirty || (area == 0) == m_grid.IsWalkable(cell.x, cell.y);
+
+    // Cells on a border also move the entrances of the neighbour
+    int localX = cell.x % kClusterSize;
+    int localY = cell.y % kClusterSize;
+    if (localX == 0)
+    {
+        MarkClusterDirty(clusterX - 1, clusterY);
+    }
+    if (localX == kClusterSize - 1)
+    {
+        MarkClusterDirty(clusterX + 1, clusterY);
+    }
+    if (localY == 0)
+    {
+        MarkClusterDirty(clusterX, clusterY - 1);
+    }
+    if (localY == kClusterSize - 1)
+    {
+        MarkClusterDirty(clusterX, clusterY + 1);
+    }
+}
+
+void yang::GridPathfinder::ResetSearchData()
+{
+    IVec2 size = m_grid.GetSize();
+
+    m_pageColumns = (size.x + kPageSize - 1) >> kPageShift;
+    int pageRows = (size.y + kPageSize - 1) >> kPageShift;
+    m_nodePages.clear();
+    m_nodePages.resize(static_cast<size_t>(m_pageColumns) * pageRows);
+    m_searchStamp = 0;
+
+    m_clusterColumns = (size.x + kClusterSize - 1) / kClusterSize;
+    m_clusterRows = (size.y + kClusterSize - 1) / kClusterSize;
+    m_clusters.clear();
+    m_clusters.resize(static_cast<size_t>(m_clusterColumns) * m_clusterRows);
+
+    m_pathCache.clear();
+    LabelAreas();
+}
+
+void yang::GridPathfinder::BeginSearch()
+{
+    m_openList.clear();
+
+    // Stamps wrap after 4 billion searches, the pages are cleared then so no stale node matches the new stamp
+    if (++m_searchStamp == 0)
+    {
+        for (auto& pPage : m_nodePages)
+        {
+            pPage.reset();
+        }
+        m_searchStamp = 1;
+    }
+}
+
+GridPathfinder::SearchNode& yang::GridPathfinder::GetNode(int x, int y)
+{
+    auto& pPage = m_nodePages[static_cast<size_t>(y >> kPageShift) * m_pageColumns + (x >> kPageShift)];
+    if (!pPage)
+    {
+        pPage = std::make_unique<SearchNode[]>(kPageSize * kPageSize);
+    }
+
+    SearchNode& node = pPage[((y & (kPageSize - 1)) << kPageShift) | (x & (kPageSize - 1))];
+    if (node.m_stamp != m_searchStamp)
+    {
+        node = SearchNode{ kInvalidFloat, kNoParent, m_searchStamp, false };
+    }
+    return node;
+}
+
+bool yang::GridPathfinder::IsOpen(int x, int y, const IRect& bounds) const
+{
+    return x >= bounds.x && y >= bounds.y && x < bounds.x + bounds.width && y < bounds.y + bounds.height && m_grid.IsWalkable(x, y);
+}
+
+void yang::GridPathfinder::PushNode(int x, int y, float cost, float estimate, uint32_t parent)
+{
+    SearchNode& node = GetNode(x, y);
+    if (node.m_isClosed || cost >= node.m_cost)
+        return;
+
+    node.m_cost = cost;
+    node.m_parent = parent;
+    m_openList.push_back(OpenNode{ estimate, cost, GetCellIndex(x, y) });
+    std::push_heap(m_openList.begin(), m_openList.end(), GreaterEstimate());
+}
+
+uint32_t yang::GridPathfinder::PopNode()
+{
+    while (!m_openList.empty())
+    {
+        std::pop_heap(m_openList.begin(), m_openList.end(), GreaterEstimate());
+        OpenNode open = m_openList.back();
+        m_openList.pop_back();
+
+        IVec2 cell = GetCell(open.m_cell);
+        SearchNode& node = GetNode(cell.x, cell.y);
+        if (node.m_isClosed || open.m_cost > node.m_cost)
+            continue;
+
+        node.m_isClosed = true;
+        ++m_expandedNodeCount;
+        return open.m_cell;
+    }
+
+    return kNoParent;
+}
+
+bool yang::GridPathfinder::SearchAStar(IVec2 start, IVec2 goal, const IRect& bounds)
+{
+    BeginSearch();
+    PushNode(start.x, start.y, 0.f, GetOctileDistance(start, goal), kNoParent);
+
+    for (uint32_t cellIndex = PopNode(); cellIndex != kNoParent; cellIndex = PopNode())
+    {
+        IVec2 cell = GetCell(cellIndex);
+        if (IsSameCell(cell, goal))
+            return true;
+
+        float cost = GetNode(cell.x, cell.y).m_cost;
+        for (const auto& direction : kDirections)
+        {
+            int x = cell.x + direction[0];
+            int y = cell.y + direction[1];
+            if (!IsOpen(x, y, bounds))
+                continue;
+
+            bool isDiagonal = direction[0] != 0 && direction[1] != 0;
+            if (isDiagonal && (!IsOpen(cell.x + direction[0], cell.y, bounds) || !IsOpen(cell.x, cell.y + direction[1], bounds)))
+                continue;
+
+            float newCost = cost + m_grid.GetCost(x, y) * (isDiagonal ? kSqrt2 : 1.f);
+            PushNode(x, y, newCost, newCost + GetOctileDistance(IVec2(x, y), goal), cellIndex);
+        }
+    }
+
+    return false;
+}
+
+void yang::GridPathfinder::SearchCluster(IVec2 start, const IRect& rect, bool isReverse, std::vector<float>& costs)
+{
+    auto getLocalIndex = [&rect](int x, int y) { return static_cast<uint32_t>((y - rect.y) * rect.width + (x - rect.x)); };
+
+    costs.assign(static_cast<size_t>(rect.width) * rect.height, kInvalidFloat);
+    costs[getLocalIndex(start.x, start.y)] = 0.f;
+    m_clusterOpenList.clear();
+    m_clusterOpenList.push_back(OpenNode{ 0.f, 0.f, getLocalIndex(start.x, start.y) });
+
+    while (!m_clusterOpenList.empty())
+    {
+        std::pop_heap(m_clusterOpenList.begin(), m_clusterOpenList.end(), GreaterEstimate());
+        OpenNode open = m_clusterOpenList.back();
+        m_clusterOpenList.pop_back();
+        if (open.m_cost > costs[open.m_cell])
+            continue;
+
+        ++m_expandedNodeCount;
+        int cellX = rect.x + static_cast<int>(open.m_cell) % rect.width;
+        int cellY = rect.y + static_cast<int>(open.m_cell) / rect.width;
+        for (const auto& direction : kDirections)
+        {
+            int x = cellX + direction[0];
+            int y = cellY + direction[1];
+            if (!IsOpen(x, y, rect))
+                continue;
+
+            bool isDiagonal = direction[0] != 0 && direction[1] != 0;
+            if (isDiagonal && (!IsOpen(cellX + direction[0], cellY, rect) || !IsOpen(cellX, cellY + direction[1], rect)))
+                continue;
+
+            // Forward steps pay for the cell they enter, reverse steps for the cell they leave
+            uint8_t cellCost = isReverse ? m_grid.GetCost(cellX, cellY) : m_grid.GetCost(x, y);
+            float newCost = open.m_cost + cellCost * (isDiagonal ? kSqrt2 : 1.f);
+            uint32_t localIndex = getLocalIndex(x, y);
+            if (newCost < costs[localIndex])
+            {
+                costs[localIndex] = newCost;
+                m_clusterOpenList.push_back(OpenNode{ newCost, newCost, localIndex });
+                std::push_heap(m_clusterOpenList.begin(), m_clusterOpenList.end(), GreaterEstimate());
+            }
+        }
+    }
+}
+
+bool yang::GridPathfinder::SearchJumpPoints(IVec2 start, IVec2 goal, const IRect& bounds)
+{
+    BeginSearch();
+    PushNode(start.x, start.y, 0.f, GetOctileDistance(start, goal), kNoParent);
+
+    for (uint32_t cellIndex = PopNode(); cellIndex != kNoParent; cellIndex = PopNode())
+    {
+        IVec2 cell = GetCell(cellIndex);
+        if (IsSameCell(cell, goal))
+            return true;
+
+        const SearchNode& node = GetNode(cell.x, cell.y);
+        float cost = node.m_cost;
+
+        // Prune the neighbours that a path through the parent reaches at least as cheaply without this node
+        IVec2 directions[8];
+        int directionCount = 0;
+        auto addDirection = [&directions, &directionCount](int x, int y) { directions[directionCount++] = IVec2(x, y); };
+
+        if (node.m_parent == kNoParent)
+        {
+            for (const auto& direction : kDirections)
+            {
+                addDirection(direction[0], direction[1]);
+            }
+        }
+        else
+        {
+            IVec2 parent = GetCell(node.m_parent);
+            int dx = Sign(cell.x - parent.x);
+            int dy = Sign(cell.y - parent.y);
+            if (dx != 0 && dy != 0)
+            {
+                addDirection(dx, 0);
+                addDirection(0, dy);
+                addDirection(dx, dy);
+            }
+            else if (dx != 0)
+            {
+                addDirection(dx, 0);
+                if (IsOpen(cell.x, cell.y + 1, bounds))
+                {
+                    addDirection(0, 1);
+                    addDirection(dx, 1);
+                }
+                if (IsOpen(cell.x, cell.y - 1, bounds))
+                {
+                    addDirection(0, -1);
+                    addDirection(dx, -1);
+                }
+            }
+            else
+            {
+                addDirection(0, dy);
+                if (IsOpen(cell.x + 1, cell.y, bounds))
+                {
+                    addDirection(1, 0);
+                    addDirection(1, dy);
+                }
+                if (IsOpen(cell.x - 1, cell.y, bounds))
+                {
+                    addDirection(-1, 0);
+                    addDirection(-1, dy);
+                }
+            }
+        }
+
+        for (int i = 0; i < directionCount; ++i)
+        {
+            IVec2 jumpPoint;
+            if (Jump(cell, directions[i], goal, bounds, jumpPoint))
+            {
+                // Jump points lie on a straight or diagonal line, so the octile distance is the exact cost on a uniform grid
+                float newCost = cost + GetOctileDistance(cell, jumpPoint);
+                PushNode(jumpPoint.x, jumpPoint.y, newCost, newCost + GetOctileDistance(jumpPoint, goal), cellIndex);
+            }
+        }
+    }
+
+    return false;
+}
+
+bool yang::GridPathfinder::Jump(IVec2 from, IVec2 direction, IVec2 goal, const IRect& bounds, IVec2& jumpPoint) const
+{
+    int x = from.x;
+    int y = from.y;
+    int dx = direction.x;
+    int dy = direction.y;
+
+    while (true)
+    {
+        if (!IsOpen(x + dx, y + dy, bounds))
+            return false;
+
+        // Diagonal steps never cut a corner
+        if (dx != 0 && dy != 0 && (!IsOpen(x + dx, y, bounds) || !IsOpen(x, y + dy, bounds)))
+            return false;
+
+        x += dx;
+        y += dy;
+        if (x == goal.x && y == goal.y)
+            break;
+
+        if (dx != 0 && dy != 0)
+        {
+            // A diagonal move stops where one of its straight components finds a jump point
+            IVec2 straightJumpPoint;
+            if (Jump(IVec2(x, y), IVec2(dx, 0), goal, bounds, straightJumpPoint) || Jump(IVec2(x, y), IVec2(0, dy), goal, bounds, straightJumpPoint))
+                break;
+        }
+        else if (dx != 0)
+        {
+            // A side opens up right after a wall: a forced neighbour
+            if ((IsOpen(x, y - 1, bounds) && !IsOpen(x - dx, y - 1, bounds)) || (IsOpen(x, y + 1, bounds) && !IsOpen(x - dx, y + 1, bounds)))
+                break;
+        }
+        else
+        {
+            if ((IsOpen(x - 1, y, bounds) && !IsOpen(x - 1, y - dy, bounds)) || (IsOpen(x + 1, y, bounds) && !IsOpen(x + 1, y - dy, bounds)))
+                break;
+        }
+    }
+
+    jumpPoint = IVec2(x, y);
+    return true;
+}
+
+bool yang::GridPathfinder::SearchSegment(IVec2 start, IVec2 goal, const IRect& bounds, std::vector<IVec2>& path)
+{
+    if (IsSameCell(start, goal))
+        return true;
+
+    bool isFound = m_grid.IsUniform() ? SearchJumpPoints(start, goal, bounds) : SearchAStar(start, goal, bounds);
+    if (!isFound)
+        return false;
+
+    AppendSearchPath(goal, path);
+    return true;
+}
+
+void yang::GridPathfinder::AppendSearchPath(IVec2 goal, std::vector<IVec2>& path)
+{
+    size_t firstIndex = path.size();
+    IVec2 cell = goal;
+    for (uint32_t parentIndex = GetNode(cell.x, cell.y).m_parent; parentIndex != kNoParent; parentIndex = GetNode(cell.x, cell.y).m_parent)
+    {
+        // Walk back to the parent, every cell except the parent itself belongs to this part of the path
+        IVec2 parent = GetCell(parentIndex);
+        IVec2 step(Sign(parent.x - cell.x), Sign(parent.y - cell.y));
+        for (IVec2 current = cell; !IsSameCell(current, parent); current += step)
+        {
+            path.push_back(current);
+        }
+        cell = parent;
+    }
+
+    std::reverse(path.begin() + firstIndex, path.end());
+}
+
+bool yang::GridPathfinder::SearchHierarchical(IVec2 start, IVec2 goal, std::vector<IVec2>& path)
+{
+    size_t startClusterIndex = GetClusterIndex(start);
+    size_t goalClusterIndex = GetClusterIndex(goal);
+    const ClusterData& startCluster = GetCluster(startClusterIndex);
+    const ClusterData& goalCluster = GetCluster(goalClusterIndex);
+
+    // Connect the start and the goal to the nodes of their clusters
+    std::vector<std::pair<uint32_t, float>> startEdges;
+    std::vector<std::pair<uint32_t, float>> goalEdges;
+    float directCost = kInvalidFloat;
+    auto getClusterCost = [this](const IRect& rect, IVec2 cell) { return m_clusterCosts[static_cast<size_t>(cell.y - rect.y) * rect.width + (cell.x - rect.x)]; };
+
+    IRect startRect = GetClusterRect(startClusterIndex);
+    SearchCluster(start, startRect, false, m_clusterCosts);
+    for (uint32_t nodeCell : startCluster.m_nodes)
+    {
+        if (float cost = getClusterCost(startRect, GetCell(nodeCell)); cost != kInvalidFloat)
+        {
+            startEdges.emplace_back(nodeCell, cost);
+        }
+    }
+
+    if (startClusterIndex == goalClusterIndex)
+    {
+        directCost = getClusterCost(startRect, goal);
+    }
+
+    IRect goalRect = GetClusterRect(goalClusterIndex);
+    SearchCluster(goal, goalRect, true, m_clusterCosts);
+    for (uint32_t nodeCell : goalCluster.m_nodes)
+    {
+        if (float cost = getClusterCost(goalRect, GetCell(nodeCell)); cost != kInvalidFloat)
+        {
+            goalEdges.emplace_back(nodeCell, cost);
+        }
+    }
+
+    // A* over the abstract graph. It has its own open list, because expanding a node can rebuild a dirty cluster
+    struct AbstractNode
+    {
+        float m_cost;
+        uint32_t m_parent;
+        bool m_isClosed;
+    };
+
+    std::unordered_map<uint32_t, AbstractNode> abstractNodes;
+    std::vector<OpenNode> openList;
+    auto pushNode = [this, &abstractNodes, &openList, goal](uint32_t id, float cost, uint32_t parent)
+    {
+        auto [nodeIt, isNew] = abstractNodes.try_emplace(id, AbstractNode{ kInvalidFloat, kNoParent, false });
+        if (nodeIt->second.m_isClosed || cost >= nodeIt->second.m_cost)
+            return;
+
+        nodeIt->second.m_cost = cost;
+        nodeIt->second.m_parent = parent;
+        float heuristic = (id == kAbstractGoalNode) ? 0.f : GetOctileDistance(GetCell(id), goal);
+        openList.push_back(OpenNode{ cost + heuristic, cost, id });
+        std::push_heap(openList.begin(), openList.end(), GreaterEstimate());
+    };
+
+    pushNode(kAbstractStartNode, 0.f, kNoParent);
+    bool isFound = false;
+    while (!openList.empty())
+    {
+        std::pop_heap(openList.begin(), openList.end(), GreaterEstimate());
+        OpenNode open = openList.back();
+        openList.pop_back();
+
+        AbstractNode& current = abstractNodes[open.m_cell];
+        if (current.m_isClosed || open.m_cost > current.m_cost)
+            continue;
+
+        current.m_isClosed = true;
+        ++m_expandedNodeCount;
+
+        if (open.m_cell == kAbstractGoalNode)
+        {
+            isFound = true;
+            break;
+        }
+
+        if (open.m_cell == kAbstractStartNode)
+        {
+            for (const auto& [nodeCell, cost] : startEdges)
+            {
+                pushNode(nodeCell, cost, kAbstractStartNode);
+            }
+
+            if (directCost != kInvalidFloat)
+            {
+                pushNode(kAbstractGoalNode, directCost, kAbstractStartNode);
+            }
+            continue;
+        }
+
+        size_t clusterIndex = GetClusterIndex(GetCell(open.m_cell));
+        const ClusterData& cluster = GetCluster(clusterIndex);
+
+        // Paths to the other nodes of the cluster
+        auto nodeIt = std::lower_bound(cluster.m_nodes.begin(), cluster.m_nodes.end(), open.m_cell);
+        if (nodeIt != cluster.m_nodes.end() && *nodeIt == open.m_cell)
+        {
+            size_t nodeCount = cluster.m_nodes.size();
+            size_t row = static_cast<size_t>(nodeIt - cluster.m_nodes.begin()) * nodeCount;
+            for (size_t i = 0; i < nodeCount; ++i)
+            {
+                float distance = cluster.m_distances[row + i];
+                if (distance != kInvalidFloat && cluster.m_nodes[i] != open.m_cell)
+                {
+                    pushNode(cluster.m_nodes[i], open.m_cost + distance, open.m_cell);
+                }
+            }
+        }
+
+        // Steps over the borders
+        for (const Entrance& entrance : cluster.m_entrances)
+        {
+            if (entrance.m_cell == open.m_cell)
+            {
+                IVec2 otherCell = GetCell(entrance.m_otherCell);
+                pushNode(entrance.m_otherCell, open.m_cost + m_grid.GetCost(otherCell.x, otherCell.y), open.m_cell);
+            }
+        }
+
+        if (clusterIndex == goalClusterIndex)
+        {
+            for (const auto& [nodeCell, cost] : goalEdges)
+            {
+                if (nodeCell == open.m_cell)
+                {
+                    pushNode(kAbstractGoalNode, open.m_cost + cost, open.m_cell);
+                }
+            }
+        }
+    }
+
+    if (!isFound)
+        return false;
+
+    std::vector<uint32_t> waypoints;
+    for (uint32_t id = kAbstractGoalNode; id != kAbstractStartNode; id = abstractNodes[id].m_parent)
+    {
+        waypoints.push_back(id == kAbstractGoalNode ? GetCellIndex(goal.x, goal.y) : id);
+    }
+    waypoints.push_back(GetCellIndex(start.x, start.y));
+    std::reverse(waypoints.begin(), waypoints.end());
+
+    // Refine every abstract edge into cells. Edges inside a cluster are searched again inside it, border steps are single cells
+    for (size_t i = 1; i < waypoints.size(); ++i)
+    {
+        IVec2 from = GetCell(waypoints[i - 1]);
+        IVec2 to = GetCell(waypoints[i]);
+        size_t clusterIndex = GetClusterIndex(from);
+        if (clusterIndex != GetClusterIndex(to))
+        {
+            path.push_back(to);
+        }
+        else if (!SearchSegment(from, to, GetClusterRect(clusterIndex), path))
+        {
+            LOG(Warning, "Failed to refine an abstract path segment from %d, %d to %d, %d", from.x, from.y, to.x, to.y);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+yang::IRect yang::GridPathfinder::GetClusterRect(size_t clusterIndex) const
+{
+    int x = static_cast<int>(clusterIndex % m_clusterColumns) * kClusterSize;
+    int y = static_cast<int>(clusterIndex / m_clusterColumns) * kClusterSize;
+    return IRect(x, y, std::min(kClusterSize, m_grid.GetSize().x - x), std::min(kClusterSize, m_grid.GetSize().y - y));
+}
+
+GridPathfinder::ClusterData& yang::GridPathfinder::GetCluster(size_t clusterIndex)
+{
+    ClusterData& cluster = m_clusters[clusterIndex];
+    if (!cluster.m_isDirty)
+        return cluster;
+
+    cluster.m_isDirty = false;
+    cluster.m_entrances.clear();
+
+    // Both clusters of a border scan it from the same end with the same step, so they agree on the entrances
+    IRect rect = GetClusterRect(clusterIndex);
+    IVec2 size = m_grid.GetSize();
+    int right = rect.x + rect.width;
+    int bottom = rect.y + rect.height;
+    if (rect.x > 0)
+    {
+        FindEntrances(IVec2(rect.x, rect.y), IVec2(rect.x - 1, rect.y), IVec2(0, 1), rect.height, cluster.m_entrances);
+    }
+    if (right < size.x)
+    {
+        FindEntrances(IVec2(right - 1, rect.y), IVec2(right, rect.y), IVec2(0, 1), rect.height, cluster.m_entrances);
+    }
+    if (rect.y > 0)
+    {
+        FindEntrances(IVec2(rect.x, rect.y), IVec2(rect.x, rect.y - 1), IVec2(1, 0), rect.width, cluster.m_entrances);
+    }
+    if (bottom < size.y)
+    {
+        FindEntrances(IVec2(rect.x, bottom - 1), IVec2(rect.x, bottom), IVec2(1, 0), rect.width, cluster.m_entrances);
+    }
+
+    cluster.m_nodes.clear();
+    for (const Entrance& entrance : cluster.m_entrances)
+    {
+        cluster.m_nodes.push_back(entrance.m_cell);
+    }
+    std::sort(cluster.m_nodes.begin(), cluster.m_nodes.end());
+    cluster.m_nodes.erase(std::unique(cluster.m_nodes.begin(), cluster.m_nodes.end()), cluster.m_nodes.end());
+
+    // One Dijkstra per node gives its whole row of the distance table
+    size_t nodeCount = cluster.m_nodes.size();
+    cluster.m_distances.assign(nodeCount * nodeCount, kInvalidFloat);
+    for (size_t i = 0; i < nodeCount; ++i)
+    {
+        SearchCluster(GetCell(cluster.m_nodes[i]), rect, false, m_clusterCosts);
+        for (size_t j = 0; j < nodeCount; ++j)
+        {
+            IVec2 cell = GetCell(cluster.m_nodes[j]);
+            cluster.m_distances[i * nodeCount + j] = m_clusterCosts[static_cast<size_t>(cell.y - rect.y) * rect.width + (cell.x - rect.x)];
+        }
+    }
+
+    return cluster;
+}
+
+void yang::GridPathfinder::FindEntrances(IVec2 inside, IVec2 outside, IVec2 step, int length, std::vector<Entrance>& entrances) const
+{
+    auto addEntrance = [this, inside, outside, step, &entrances](int offset)
+    {
+        entrances.push_back(Entrance{ GetCellIndex(inside.x + step.x * offset, inside.y + step.y * offset), GetCellIndex(outside.x + step.x * offset, outside.y + step.y * offset) });
+    };
+
+    // Every run of open cell pairs becomes one or two entrances
+    int runStart = -1;
+    for (int i = 0; i <= length; ++i)
+    {
+        bool isOpen = i < length && m_grid.IsWalkable(inside.x + step.x * i, inside.y + step.y * i) && m_grid.IsWalkable(outside.x + step.x * i, outside.y + step.y * i);
+        if (isOpen)
+        {
+            runStart = (runStart < 0) ? i : runStart;
+            continue;
+        }
+
+        if (runStart < 0)
+            continue;
+
+        int runLength = i - runStart;
+        if (runLength <= kMaxSingleEntranceLength)
+        {
+            addEntrance(runStart + runLength / 2);
+        }
+        else
+        {
+            addEntrance(runStart);
+            addEntrance(i - 1);
+        }
+        runStart = -1;
+    }
+}
+
+void yang::GridPathfinder::LabelAreas()
+{
+    IVec2 size = m_grid.GetSize();
+    m_areas.assign(static_cast<size_t>(size.x) * size.y, 0);
+    m_areAreasDirty = false;
+
+    uint32_t areaCount = 0;
+    std::vector<uint32_t> stack;
+    for (uint32_t cellIndex = 0; cellIndex < m_areas.size(); ++cellIndex)
+    {
+        IVec2 cell = GetCell(cellIndex);
+        if (m_areas[cellIndex] != 0 || !m_grid.IsWalkable(cell.x, cell.y))
+            continue;
+
+        m_areas[cellIndex] = ++areaCount;
+        stack.push_back(cellIndex);
+        while (!stack.empty())
+        {
+            IVec2 current = GetCell(stack.back());
+            stack.pop_back();
+
+            for (int i = 0; i < 4; ++i)
+            {
+                int x = current.x + kDirections[i][0];
+                int y = current.y + kDirections[i][1];
+                if (!m_grid.IsWalkable(x, y) || m_areas[GetCellIndex(x, y)] != 0)
+                    continue;
+
+                m_areas[GetCellIndex(x, y)] = areaCount;
+                stack.push_back(GetCellIndex(x, y));
+            }
+        }
+    }
+}
+
+void yang::GridPathfinder::MarkClusterDirty(int clusterX, int clusterY)
+{
+    if (clusterX >= 0 && clusterY >= 0 && clusterX < m_clusterColumns && clusterY < m_clusterRows)
+    {
+        m_clusters[static_cast<size_t>(clusterY) * m_clusterColumns + clusterX].m_isDirty = true;
+    }
+}
+
+void yang::GridPathfinder::CachePath(uint64_t key, const std::vector<IVec2>& path, bool isOptimal)
+{
+    if (m_pathCache.size() >= kMaxCachedPaths && m_pathCache.find(key) == m_pathCache.end())
+    {
+        auto oldestIt = std::min_element(m_pathCache.begin(), m_pathCache.end(), [](const auto& left, const auto& right)
+            {
+                return left.second.m_lastUsed < right.second.m_lastUsed;
+            });
+        m_pathCache.erase(oldestIt);
+    }
+
+    CachedPath& cached = m_pathCache[key];
+    cached.m_path = path;
+    cached.m_lastUsed = ++m_cacheClock;
+    cached.m_isOptimal = isOptimal;
+    cached.m_clusters.clear();
+    for (IVec2 cell : path)
+    {
+        uint32_t clusterIndex = static_cast<uint32_t>(GetClusterIndex(cell));
+        if (cached.m_clusters.empty() || cached.m_clusters.back().first != clusterIndex)
+        {
+            cached.m_clusters.emplace_back(clusterIndex, m_clusters[clusterIndex].m_version);
+        }
+    }
+}
+
+float yang::GridPathfinder::GetOctileDistance(IVec2 from, IVec2 to)
+{
+    int dx = std::abs(to.x - from.x);
+    int dy = std::abs(to.y - from.y);
+    return static_cast<float>(std::max(dx, dy) - std::min(dx, dy)) + kSqrt2 * std::min(dx, dy);
+}
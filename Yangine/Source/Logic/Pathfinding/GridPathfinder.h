@@ -0,0 +1,296 @@
+#pragma once
+/** \file GridPathfinder.h */
+/** Path queries on a tile grid */
+
+#include <Logic/Pathfinding/NavGrid.h>
+#include <Utils/Rectangle.h>
+#include <Utils/Vector2.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+    class TiledMap;
+
+/** \class GridPathfinder */
+/** Finds 8-connected paths on a NavGrid. Diagonal steps are allowed only when both side cells are walkable.
+    Uniform grids are searched with Jump Point Search, weighted grids with A*. Queries longer than kHierarchicalDistance
+    first search an abstract graph of cluster entrances (HPA*) and then refine it cluster by cluster, which trades
+    a few percent of path length for searching a tiny fraction of the grid. Results are cached until a cell on the path's
+    clusters changes. Goals in another connected area are rejected without a search.
+    When the grid is compiled from a TiledMap, SetTileIdAtIndex repairs it incrementally */
+class GridPathfinder
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+    static constexpr int kClusterSize = 32;                             ///< Width and height of an abstraction cluster in cells
+    static constexpr int kHierarchicalDistance = 2 * kClusterSize;      ///< Queries with a longer octile distance use the abstraction
+    static constexpr int kMaxSingleEntranceLength = 6;                  ///< Open border runs up to this length get one entrance in the middle, longer ones get two at the ends
+    static constexpr size_t kMaxCachedPaths = 256;                      ///< Paths kept in the cache, the least recently used one is dropped first
+
+    /// \enum SearchMode
+    /// How the path is searched
+    enum class SearchMode
+    {
+        kAuto,              ///< Flat search for short queries, hierarchical for long ones
+        kFlat,              ///< Always search the grid directly. Gives optimal paths
+        kHierarchical       ///< Always search through the cluster abstraction
+    };
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /** Default Constructor */
+    GridPathfinder() = default;
+
+    /** Destructor. Stops listening for the map changes */
+    ~GridPathfinder();
+
+    GridPathfinder(const GridPathfinder&) = delete;
+    GridPathfinder& operator=(const GridPathfinder&) = delete;
+
+    /// Compiles the navigation grid from the map layer and listens for the tile changes. The map must outlive the pathfinder
+    /// \param pMap - map to compile
+    /// \param layerIndex - index of the layer to compile
+    /// \param pWalkableProperty - name of the bool tile property that marks walkable tiles
+    /// \param pCostProperty - name of the int tile property with the tile cost, can be null
+    /// \return true if successfully initialized
+    bool Init(TiledMap* pMap, size_t layerIndex, const char* pWalkableProperty, const char* pCostProperty = nullptr);
+
+    /// Uses a grid filled by hand
+    /// \param grid - navigation grid to search
+    /// \return true if successfully initialized
+    bool Init(NavGrid&& grid);
+
+    /// Finds a path between two cells
+    /// \param start - start cell
+    /// \param goal - goal cell
+    /// \param path - cleared and filled with every cell of the path, from start to goal inclusive
+    /// \param mode - how to search \see yang::GridPathfinder::SearchMode
+    /// \return true if the path exists
+    bool FindPath(IVec2 start, IVec2 goal, std::vector<IVec2>& path, SearchMode mode = SearchMode::kAuto);
+
+    /// Changes the cost of a cell and repairs the cluster abstraction and the path cache. Called automatically for the map tile changes
+    /// \param cell - cell to change
+    /// \param cost - new cost, NavGrid::kBlocked to block the cell
+    void SetCellCost(IVec2 cell, uint8_t cost);
+
+    /// Builds the abstraction of every cluster. Otherwise clusters are built by the first query that reaches them,
+    /// which makes the first long queries on a big map slow
+    void BuildAbstraction();
+
+    /// Drops every cached path
+    void ClearPathCache() { m_pathCache.clear(); }
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+
+    static constexpr int kPageShift = 6;                                ///< Search nodes are allocated in pages of 64 x 64 cells
+    static constexpr int kPageSize = 1 << kPageShift;                   ///< Width and height of a node page
+    static constexpr uint32_t kNoParent = 0xFFFFFFFF;                   ///< Parent of the search start
+
+    /// \struct SearchNode
+    /// State of a cell in the current search
+    struct SearchNode
+    {
+        float m_cost;               ///< Cost from the search start
+        uint32_t m_parent;          ///< Cell index of the previous node on the best known path
+        uint32_t m_stamp;           ///< Search the node belongs to. Nodes of older searches are treated as unvisited
+        bool m_isClosed;            ///< Was the node expanded
+    };
+
+    /// \struct OpenNode
+    /// Entry of the open list
+    struct OpenNode
+    {
+        float m_estimate;           ///< Cost so far plus the heuristic
+        float m_cost;               ///< Cost so far, stale entries have more than their node
+        uint32_t m_cell;            ///< Cell index
+    };
+
+    /// \struct Entrance
+    /// Pair of walkable cells on both sides of a cluster border
+    struct Entrance
+    {
+        uint32_t m_cell;            ///< Cell inside the cluster
+        uint32_t m_otherCell;       ///< Cell inside the neighbouring cluster
+    };
+
+    /// \struct ClusterData
+    /// Abstract graph of a cluster, rebuilt lazily after its cells or borders change
+    struct ClusterData
+    {
+        std::vector<Entrance> m_entrances;      ///< Entrances on all four borders
+        std::vector<uint32_t> m_nodes;          ///< Unique inside cells of the entrances
+        std::vector<float> m_distances;         ///< Cost between every pair of nodes, row per start node. Unreachable pairs are kInvalidFloat
+        uint32_t m_version = 0;                 ///< Incremented on every change of a cell in the cluster
+        bool m_isDirty = true;                  ///< Do the entrances and distances have to be rebuilt
+    };
+
+    /// \struct CachedPath
+    /// Path kept in the cache
+    struct CachedPath
+    {
+        std::vector<IVec2> m_path;                                  ///< Cells of the path
+        std::vector<std::pair<uint32_t, uint32_t>> m_clusters;      ///< Every cluster the path crosses and its version when the path was found
+        uint32_t m_lastUsed = 0;                                    ///< Cache clock value of the last use
+        bool m_isOptimal = false;                                   ///< Was the path found by the flat search. Only optimal paths answer kFlat queries
+    };
+
+    NavGrid m_grid;                                         ///< Grid to search
+    TiledMap* m_pMap = nullptr;                             ///< Map the grid was compiled from, can be null
+    size_t m_tileChangedHandle = 0;                         ///< Handle of the map tile change callback
+
+    std::vector<std::unique_ptr<SearchNode[]>> m_nodePages; ///< Search nodes, allocated once a search touches the page
+    int m_pageColumns = 0;                                  ///< Number of node pages in a row
+    uint32_t m_searchStamp = 0;                             ///< Stamp of the current search
+    std::vector<OpenNode> m_openList;                       ///< Binary heap of the open nodes
+    std::vector<OpenNode> m_clusterOpenList;                ///< Binary heap of the cluster searches
+    std::vector<float> m_clusterCosts;                      ///< Costs found by the last cluster search
+
+    std::vector<ClusterData> m_clusters;                    ///< Abstraction clusters, row by row
+    int m_clusterColumns = 0;                               ///< Number of clusters in a row
+    int m_clusterRows = 0;                                  ///< Number of cluster rows
+
+    std::vector<uint32_t> m_areas;                          ///< Connected area of every cell, 0 for the blocked cells
+    bool m_areAreasDirty = true;                            ///< Was a cell blocked or opened since the areas were labeled
+
+    std::unordered_map<uint64_t, CachedPath> m_pathCache;   ///< Cached paths by start and goal cell
+    uint32_t m_cacheClock = 0;                              ///< Incremented on every cache use
+
+    size_t m_expandedNodeCount = 0;                         ///< Nodes expanded by the last query
+    size_t m_cacheHitCount = 0;                             ///< Queries answered from the cache
+    size_t m_cacheMissCount = 0;                            ///< Queries that had to search
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Marks the cluster of the changed cell dirty and bumps its version, so the cached paths crossing it are dropped
+    /// \param cell - changed cell
+    void OnCellChanged(IVec2 cell);
+
+    /// Allocates the node pages and the clusters for the grid size and drops all cached data
+    void ResetSearchData();
+
+    /// Starts a new search, so every node is treated as unvisited
+    void BeginSearch();
+
+    /// Get search node of the cell, resetting it if it belongs to an older search
+    SearchNode& GetNode(int x, int y);
+
+    /// Get cell index from coordinates
+    uint32_t GetCellIndex(int x, int y) const { return static_cast<uint32_t>(y) * m_grid.GetSize().x + x; }
+
+    /// Get coordinates from cell index
+    IVec2 GetCell(uint32_t cellIndex) const { return IVec2(static_cast<int>(cellIndex % m_grid.GetSize().x), static_cast<int>(cellIndex / m_grid.GetSize().x)); }
+
+    /// Is the cell walkable and inside the bounds
+    bool IsOpen(int x, int y, const IRect& bounds) const;
+
+    /// Opens the node if the new cost is better than the known one
+    void PushNode(int x, int y, float cost, float estimate, uint32_t parent);
+
+    /// Pops the open node with the lowest estimate, skipping the closed and stale entries
+    /// \return cell index, or kNoParent if the open list is empty
+    uint32_t PopNode();
+
+    /// A* search inside the bounds
+    /// \param start - start cell
+    /// \param goal - goal cell
+    /// \param bounds - cells the search can visit
+    /// \return true if the goal was reached
+    bool SearchAStar(IVec2 start, IVec2 goal, const IRect& bounds);
+
+    /// Dijkstra search of every cell of a cluster, on flat arrays since a cluster is small
+    /// \param start - start cell
+    /// \param rect - cells of the cluster
+    /// \param isReverse - search the edges backwards, so the costs are from every cell to the start instead of from the start
+    /// \param costs - filled with the cost of every cell of the cluster, row by row. Unreachable cells are kInvalidFloat
+    void SearchCluster(IVec2 start, const IRect& rect, bool isReverse, std::vector<float>& costs);
+
+    /// Jump Point Search inside the bounds. The grid must be uniform
+    /// \param start - start cell
+    /// \param goal - goal cell
+    /// \param bounds - cells the search can visit
+    /// \return true if the goal was reached
+    bool SearchJumpPoints(IVec2 start, IVec2 goal, const IRect& bounds);
+
+    /// Follows a straight or diagonal direction until a jump point
+    /// \param from - cell to jump from
+    /// \param direction - direction to jump to
+    /// \param goal - goal cell, always a jump point
+    /// \param bounds - cells the jump can visit
+    /// \param jumpPoint - found jump point
+    /// \return true if a jump point was found
+    bool Jump(IVec2 from, IVec2 direction, IVec2 goal, const IRect& bounds, IVec2& jumpPoint) const;
+
+    /// Searches the grid inside the bounds with JPS or A*, and appends the path cells after start
+    /// \return true if the path exists
+    bool SearchSegment(IVec2 start, IVec2 goal, const IRect& bounds, std::vector<IVec2>& path);
+
+    /// Appends the cells from the search start to the goal, excluding the start, by following the node parents.
+    /// Consecutive nodes can be far apart when they are jump points, the cells between them are filled in
+    void AppendSearchPath(IVec2 goal, std::vector<IVec2>& path);
+
+    /// Searches the cluster abstraction and refines the result into cells
+    /// \return true if the path exists
+    bool SearchHierarchical(IVec2 start, IVec2 goal, std::vector<IVec2>& path);
+
+    /// Get index of the cluster that contains the cell
+    size_t GetClusterIndex(IVec2 cell) const { return static_cast<size_t>(cell.y / kClusterSize) * m_clusterColumns + cell.x / kClusterSize; }
+
+    /// Get cells of the cluster
+    IRect GetClusterRect(size_t clusterIndex) const;
+
+    /// Rebuilds the entrances and the node distances of the cluster if it is dirty
+    ClusterData& GetCluster(size_t clusterIndex);
+
+    /// Finds the entrances along one border of the cluster
+    /// \param inside - first cell of the border inside the cluster
+    /// \param outside - first cell across the border
+    /// \param step - direction along the border
+    /// \param length - border length in cells
+    /// \param entrances - found entrances are appended here
+    void FindEntrances(IVec2 inside, IVec2 outside, IVec2 step, int length, std::vector<Entrance>& entrances) const;
+
+    /// Labels the connected areas of the grid. Diagonal steps need both side cells open, so 4-connected flood fill gives the same areas
+    void LabelAreas();
+
+    /// Marks the cluster dirty if it exists
+    void MarkClusterDirty(int clusterX, int clusterY);
+
+    /// Adds the path to the cache, dropping the least recently used one if the cache is full
+    /// \param isOptimal - true if the flat search found the path
+    void CachePath(uint64_t key, const std::vector<IVec2>& path, bool isOptimal);
+
+    /// Octile distance between two cells
+    static float GetOctileDistance(IVec2 from, IVec2 to);
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Get the navigation grid
+    const NavGrid& GetNavGrid() const { return m_grid; }
+
+    /// Get number of search nodes expanded by the last query, including the abstraction rebuilds it caused
+    size_t GetExpandedNodeCount() const { return m_expandedNodeCount; }
+
+    /// Get number of queries answered from the cache
+    size_t GetCacheHitCount() const { return m_cacheHitCount; }
+
+    /// Get number of queries that had to search
+    size_t GetCacheMissCount() const { return m_cacheMissCount; }
+};
+}
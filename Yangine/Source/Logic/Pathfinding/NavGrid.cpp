@@ -0,0 +1,84 @@
+#include "NavGrid.h"
+#include <Utils/Logger.h>
+#include <algorithm>
+
+using yang::NavGrid;
+
+bool yang::NavGrid::Init(IVec2 size, uint8_t cost)
+{
+    if (size.x <= 0 || size.y <= 0)
+    {
+        LOG(Error, "Invalid navigation grid size %d x %d", size.x, size.y);
+        return false;
+    }
+
+    m_size = size;
+    m_costs.assign(static_cast<size_t>(size.x) * size.y, cost);
+    m_weightedCellCount = (cost != kBlocked && cost != kDefaultCost) ? m_costs.size() : 0;
+    m_walkableColumn = {};
+    m_costColumn = {};
+    return true;
+}
+
+bool yang::NavGrid::BuildFromMap(TiledMap& map, size_t layerIndex, const char* pWalkableProperty, const char* pCostProperty)
+{
+    if (!Init(map.GetMapSize()))
+        return false;
+
+    m_layerIndex = layerIndex;
+    m_walkableColumn = map.CompileTileProperty<bool>(layerIndex, pWalkableProperty, true);
+    if (!m_walkableColumn.IsValid())
+        return false;
+
+    if (pCostProperty)
+    {
+        m_costColumn = map.CompileTileProperty<int>(layerIndex, pCostProperty, kDefaultCost);
+        if (!m_costColumn.IsValid())
+            return false;
+    }
+
+    for (size_t tileIndex = 0; tileIndex < m_costs.size(); ++tileIndex)
+    {
+        m_costs[tileIndex] = ReadTileCost(map, tileIndex);
+        if (m_costs[tileIndex] != kBlocked && m_costs[tileIndex] != kDefaultCost)
+        {
+            ++m_weightedCellCount;
+        }
+    }
+
+    return true;
+}
+
+bool yang::NavGrid::UpdateFromMap(const TiledMap& map, size_t tileIndex)
+{
+    if (!m_walkableColumn.IsValid() || tileIndex >= m_costs.size())
+        return false;
+
+    uint8_t cost = ReadTileCost(map, tileIndex);
+    if (cost == m_costs[tileIndex])
+        return false;
+
+    SetCost(IVec2(static_cast<int>(tileIndex % m_size.x), static_cast<int>(tileIndex / m_size.x)), cost);
+    return true;
+}
+
+void yang::NavGrid::SetCost(IVec2 cell, uint8_t cost)
+{
+    uint8_t& currentCost = m_costs[static_cast<size_t>(cell.y) * m_size.x + cell.x];
+    auto isWeighted = [](uint8_t value) { return value != kBlocked && value != kDefaultCost; };
+
+    m_weightedCellCount -= isWeighted(currentCost) ? 1 : 0;
+    m_weightedCellCount += isWeighted(cost) ? 1 : 0;
+    currentCost = cost;
+}
+
+uint8_t yang::NavGrid::ReadTileCost(const TiledMap& map, size_t tileIndex) const
+{
+    if (!map.GetTilePropertyValue(m_walkableColumn, tileIndex))
+        return kBlocked;
+
+    if (!m_costColumn.IsValid())
+        return kDefaultCost;
+
+    return static_cast<uint8_t>(std::clamp(map.GetTilePropertyValue(m_costColumn, tileIndex), 1, 255));
+}
@@ -0,0 +1,99 @@
+#pragma once
+/** \file NavGrid.h */
+/** Movement cost of every tile of a grid */
+
+#include <Utils/Vector2.h>
+#include <Logic/Map/TiledMap.h>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \class NavGrid */
+/** Dense grid of movement costs used by the pathfinding. A cost of 0 marks a blocked cell, any other value is the cost of
+    stepping into the cell. The grid is either filled by hand or compiled from the tile properties of a TiledMap layer */
+class NavGrid
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+    static constexpr uint8_t kBlocked = 0;          ///< Cost of the cells that can't be entered
+    static constexpr uint8_t kDefaultCost = 1;      ///< Cost of the cells that don't declare their own cost
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Creates the grid with every cell at the same cost
+    /// \param size - width and height in cells
+    /// \param cost - cost of every cell
+    /// \return true if the size is valid
+    bool Init(IVec2 size, uint8_t cost = kDefaultCost);
+
+    /// Compiles the grid from the tile properties of the map layer. The property columns are kept, so UpdateFromMap
+    /// can recompile single tiles later
+    /// \param map - map to compile from
+    /// \param layerIndex - index of the layer to compile
+    /// \param pWalkableProperty - name of the bool property, tiles with it set to false are blocked. Tiles without it are walkable
+    /// \param pCostProperty - name of the int property with the tile cost, clamped to [1, 255]. Can be null, then every walkable tile costs kDefaultCost
+    /// \return true if successfully compiled
+    bool BuildFromMap(TiledMap& map, size_t layerIndex, const char* pWalkableProperty, const char* pCostProperty = nullptr);
+
+    /// Compiles the tile again from the map the grid was built from
+    /// \param map - map passed to BuildFromMap
+    /// \param tileIndex - index of the changed tile
+    /// \return true if the cost of the cell has changed
+    bool UpdateFromMap(const TiledMap& map, size_t tileIndex);
+
+    /// Sets the cost of the cell
+    /// \param cell - cell to change
+    /// \param cost - new cost, kBlocked to block the cell
+    void SetCost(IVec2 cell, uint8_t cost);
+
+    /// Is the cell inside the grid and not blocked
+    bool IsWalkable(int x, int y) const { return x >= 0 && y >= 0 && x < m_size.x && y < m_size.y && m_costs[static_cast<size_t>(y) * m_size.x + x] != kBlocked; }
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+    IVec2 m_size;                                           ///< Width and height in cells
+    std::vector<uint8_t> m_costs;                           ///< Cost of every cell, row by row
+    size_t m_weightedCellCount = 0;                         ///< Number of walkable cells with a cost other than kDefaultCost
+
+    size_t m_layerIndex = 0;                                ///< Layer the grid was compiled from
+    TiledMap::TilePropertyColumn<bool> m_walkableColumn;    ///< Compiled walkable property
+    TiledMap::TilePropertyColumn<int> m_costColumn;         ///< Compiled cost property, invalid if the map has no costs
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Reads the cost of the tile from the compiled property columns
+    /// \param map - map the grid was built from
+    /// \param tileIndex - index of the tile
+    /// \return cost of the tile
+    uint8_t ReadTileCost(const TiledMap& map, size_t tileIndex) const;
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Get width and height in cells
+    IVec2 GetSize() const { return m_size; }
+
+    /// Get cost of the cell, the cell must be inside the grid
+    uint8_t GetCost(int x, int y) const { return m_costs[static_cast<size_t>(y) * m_size.x + x]; }
+
+    /// Does every walkable cell have the same cost. Uniform grids are searched with Jump Point Search
+    bool IsUniform() const { return m_weightedCellCount == 0; }
+
+    /// Get index of the layer the grid was compiled from
+    size_t GetLayerIndex() const { return m_layerIndex; }
+};
+}
@@ -6,15 +6,26 @@
 #include <Logic/Actor/ActorFactory.h>
 #include <Logic/Components/TransformComponent.h>
 #include <Logic/Collisions/CollisionSystem.h>
+#include <Application/ApplicationGlobals.h>
+#include <Application/Graphics/Viewport.h>
+#include <Application/Graphics/RenderQueue.h>
 #include <Utils/TinyXml2/tinyxml2.h>
 #include <Utils/Vector2.h>
 #include <Utils/XMLHelpers.h>
+#include <Utils/FrameProfiler.h>
 
 using namespace yang;
 
 yang::Scene::Scene(yang::IGameLayer& owner)
     :m_owner(owner)
+    ,m_uiHitTestService(m_eventDispatcher)
 {
+    EventDispatcher::Get()->AddForwardTarget(&m_eventDispatcher);
+}
+
+yang::Scene::~Scene()
+{
+    EventDispatcher::Get()->RemoveForwardTarget(&m_eventDispatcher);
 }
 
 bool yang::Scene::Init(tinyxml2::XMLElement* pData)
@@ -90,27 +101,48 @@ void yang::Scene::AddView(std::unique_ptr<IView> pView)
 
 void yang::Scene::Update(float deltaSeconds)
 {
-    for (auto& pActor : m_actorsToSpawn)
     {
-        m_actors.emplace(pActor->GetId(), pActor);
+        FrameProfiler::ScopedSection section(FrameProfiler::Section::kEvents);
+        m_eventDispatcher.ProcessEvents();
+    }
+
+    {
+        FrameProfiler::ScopedSection section(FrameProfiler::Section::kSceneBookkeeping);
+        for (auto& pActor : m_actorsToSpawn)
+        {
+            m_actors.emplace(pActor->GetId(), pActor);
+        }
+        m_actorsToSpawn.clear();
+        m_queuedActorIds.clear();
     }
-    m_actorsToSpawn.clear();
-    m_queuedActorIds.clear();
 
-    for (auto& pView : m_pViews)
     {
-        pView->UpdateInput();
+        FrameProfiler::ScopedSection section(FrameProfiler::Section::kInput);
+        for (auto& pView : m_pViews)
+        {
+            pView->UpdateInput();
+        }
     }
 
-    m_processManager.UpdateProcesses(deltaSeconds);
+    {
+        FrameProfiler::ScopedSection section(FrameProfiler::Section::kProcesses);
+        m_processManager.UpdateProcesses(deltaSeconds);
+    }
 
-    for (auto& pActor : m_actors)
     {
-        pActor.second->Update(deltaSeconds);
+        FrameProfiler::ScopedSection section(FrameProfiler::Section::kActors);
+        for (auto& pActor : m_actors)
+        {
+            pActor.second->Update(deltaSeconds);
+        }
     }
 
-    m_pCollisionSystem->Update(deltaSeconds);
+    {
+        FrameProfiler::ScopedSection section(FrameProfiler::Section::kCollisions);
+        m_pCollisionSystem->Update(deltaSeconds);
+    }
 
+    FrameProfiler::ScopedSection section(FrameProfiler::Section::kSceneBookkeeping);
     for (Id id : m_actorsToKill)
     {
         auto pActorIdPair = m_actors.find(id);
@@ -133,12 +165,20 @@ void yang::Scene::Update(float deltaSeconds)
                 pActorView->DetachActor();
                 DeleteView(pActorView);
             }
+            if (auto handleIt = m_spatialHandles.find(id); handleIt != m_spatialHandles.end())
+            {
+                m_spatialIndex.Remove(handleIt->second);
+                m_spatialHandles.erase(handleIt);
+            }
+
             m_pCollisionSystem->ClearCollisionsWithActor(pActorIdPair->second.get());
             m_processManager.AbortProcessesOnActor(id);
             m_actors.erase(id);
         }
     }
     m_actorsToKill.clear();
+
+    UpdateRenderBounds();
 }
 
 void yang::Scene::Render()
@@ -149,14 +189,49 @@ void yang::Scene::Render()
     }
 }
 
+void yang::Scene::RenderActors(IGraphics* pGraphics)
+{
+    const Viewport& viewport = GetGlobalViewport();
+    FVec2 topLeft = viewport.TopLeft();
+    FVec2 bottomRight = viewport.BottomRight();
+
+    m_visibleActors.clear();
+    m_spatialIndex.Query(FRect(topLeft.x, topLeft.y, bottomRight.x - topLeft.x, bottomRight.y - topLeft.y), m_visibleActors);
+
+    m_drawnActorCount = m_visibleActors.size() + m_unboundedActors.size();
+    m_culledActorCount = m_spatialIndex.GetActorCount() - m_visibleActors.size();
+
+    for (Actor* pActor : m_visibleActors)
+    {
+        pActor->Render(pGraphics);
+    }
+
+    for (Actor* pActor : m_unboundedActors)
+    {
+        pActor->Render(pGraphics);
+    }
+
+    // Whatever the view draws after the actors goes on top of them
+    pGraphics->SetDrawLayer(RenderQueue::kOverlayLayer);
+    pGraphics->SetDrawDepth(0.f);
+}
+
 void yang::Scene::Cleanup()
 {
+    EventDispatcher::Get()->RemoveForwardTarget(&m_eventDispatcher);
+    m_eventDispatcher.SetEnabled(false);
+
     for (auto& pView : m_pViews)
     {
         pView->DetachActor();
         pView.reset();
     }
 
+    m_spatialIndex = SceneSpatialIndex();
+    m_spatialHandles.clear();
+    m_unboundedActors.clear();
+    m_visibleActors.clear();
+
     m_actors.clear();
     m_actorsToSpawn.clear();
     m_queuedActorIds.clear();
@@ -230,6 +305,39 @@ void yang::Scene::DeleteView(IView* pView)
     DeleteView(index);
 }
 
+void yang::Scene::UpdateRenderBounds()
+{
+    m_unboundedActors.clear();
+
+    for (auto& [id, pActor] : m_actors)
+    {
+        FRect bounds;
+        bool canIndex = pActor->GetRenderBounds(bounds) && SceneSpatialIndex::CanIndex(bounds);
+        auto handleIt = m_spatialHandles.find(id);
+
+        if (!canIndex)
+        {
+            if (handleIt != m_spatialHandles.end())
+            {
+                m_spatialIndex.Remove(handleIt->second);
+                m_spatialHandles.erase(handleIt);
+            }
+
+            m_unboundedActors.push_back(pActor.get());
+            continue;
+        }
+
+        if (handleIt == m_spatialHandles.end())
+        {
+            m_spatialHandles.emplace(id, m_spatialIndex.Add(pActor.get(), bounds));
+        }
+        else
+        {
+            m_spatialIndex.Update(handleIt->second, bounds);
+        }
+    }
+}
+
 void yang::Scene::DeleteView(size_t index)
 {
     assert(index < m_pViews.size());
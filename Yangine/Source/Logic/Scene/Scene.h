@@ -8,6 +8,9 @@
 #include <string_view>
 #include <optional>
 #include <Logic/Process/ProcessManager.h>
+#include <Logic/Event/EventDispatcher.h>
+#include <Logic/Scene/UIHitTestService.h>
+#include <Logic/Scene/SceneSpatialIndex.h>
 #include <Views/IView.h>
 #include <Utils/Typedefs.h>
 #include <Utils/Vector2.h>
@@ -24,12 +27,13 @@ namespace yang
     class CollisionSystem;
     class ICollisionCallback;
     class IResource;
+    class IGraphics;
 
     class Scene : public std::enable_shared_from_this<Scene>
     {
     public:
         Scene(yang::IGameLayer& owner);
-        virtual ~Scene() = default;
+        virtual ~Scene();
 
         bool Init(tinyxml2::XMLElement* pData);
 
@@ -43,6 +47,11 @@ namespace yang
 
         void Render();
 
+        /// Renders the actors whose render bounds overlap the global viewport, and the actors without render bounds.
+        /// Views call it instead of rendering every actor of the scene
+        /// \param pGraphics - graphics system to use
+        void RenderActors(IGraphics* pGraphics);
+
         /// Cleans up memory allocations and 3rd party libraries
         void Cleanup();
 
@@ -67,10 +76,10 @@ namespace yang
         /// \param actorId - Id of the actor to destroy
         void DestroyActor(Id actorId);
 
-        // thing to consider:
-        // Since event dispatcher is a singleton and is global for everything, we need to disable event handlers when scene is not active
+        // Scene listeners live in the scene's own event dispatcher, which receives everything from the global one.
+        // IGameLayer disables it while the scene is paused, so there is no need to unsubscribe here
         virtual void OnSceneLoad() {};     // Subscribe for events
-        virtual void OnScenePause() {};    // Do stuff when scene pauses (unsubscribe from events?)
+        virtual void OnScenePause() {};    // Do stuff when scene pauses
         virtual void OnSceneResume() {};   // Do stuff when scene becomes active
         virtual void OnSceneUnload() {};   // Do stuff when scene unloads?
 
@@ -86,6 +95,8 @@ namespace yang
         uint32_t m_hashName;
         yang::IGameLayer& m_owner;
 
+        EventDispatcher m_eventDispatcher;                          ///< Scene event dispatcher. Declared before actors, so it outlives their listeners
+        UIHitTestService m_uiHitTestService;                        ///< Routes mouse events to the scene MouseInputListeners. Outlives actors as well
         std::unordered_map<Id, std::shared_ptr<Actor>> m_actors;    ///< Hash table of actors, where keys are their ids
         ProcessManager m_processManager;                            ///< Instance of ProcessManager that handles all game processes
         std::vector<std::shared_ptr<Actor>> m_actorsToSpawn;        ///< Collection of actors that are going to be spawned at next frame
@@ -94,10 +105,20 @@ namespace yang
         std::vector<Id> m_actorsToKill;                             ///< Collection of IDs of actors that are going to be destroyed at next frame
         std::vector<std::unique_ptr<IView>> m_pViews;               ///< Collection of all views
         std::shared_ptr<CollisionSystem> m_pCollisionSystem;
+
+        SceneSpatialIndex m_spatialIndex;                           ///< Render bounds of the actors, used to cull actors outside of the viewport
+        std::unordered_map<Id, size_t> m_spatialHandles;            ///< Spatial index handle of every indexed actor
+        std::vector<Actor*> m_unboundedActors;                      ///< Actors without render bounds, rendered every frame
+        std::vector<Actor*> m_visibleActors;                        ///< Actors found by the last viewport query, kept to reuse the memory
+        size_t m_drawnActorCount = 0;                               ///< Number of actors rendered by the last RenderActors
+        size_t m_culledActorCount = 0;                              ///< Number of actors skipped by the last RenderActors
     private:
         /// Internal helper function. Deletes view by it's index in the vector
         /// \param index - view's index in the vector
         void DeleteView(size_t index);
+
+        /// Internal helper function. Moves the render bounds of every actor in the spatial index, called at the end of Update
+        void UpdateRenderBounds();
     public:
         /// \param pView - view to delete
         void DeleteView(IView* pView);
@@ -123,5 +144,17 @@ namespace yang
         std::string_view GetName() const { return m_name; }
         uint32_t GetHashName() const { return m_hashName; }
         std::shared_ptr<CollisionSystem> GetCollisionSystem() const { return m_pCollisionSystem; }
+
+        /// Get the scene event dispatcher. Listeners added here are skipped while the scene is paused
+        EventDispatcher& GetEventDispatcher() { return m_eventDispatcher; }
+
+        /// Get the service that routes mouse events to the scene MouseInputListeners
+        UIHitTestService& GetUIHitTestService() { return m_uiHitTestService; }
+
+        /// Get number of actors rendered by the last RenderActors
+        size_t GetDrawnActorCount() const { return m_drawnActorCount; }
+
+        /// Get number of actors skipped by the last RenderActors, because they were outside of the viewport
+        size_t GetCulledActorCount() const { return m_culledActorCount; }
     };
 }
\ No newline at end of file
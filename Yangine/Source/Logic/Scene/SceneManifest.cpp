@@ -0,0 +1,217 @@
+#include "SceneManifest.h"
+#include <algorithm>
+#include <functional>
+#include <string_view>
+#include <tuple>
+
+#include <Utils/Logger.h>
+#include <Utils/TinyXml2/tinyxml2.h>
+#include <Utils/BinaryXml.h>
+#include <Utils/StringHash.h>
+
+using yang::SceneManifest;
+
+namespace
+{
+    /// Names of the resource categories in the manifest file
+    constexpr const char* kCategoryNames[] = { "Raw", "Texture", "Sound", "Music", "Font" };
+    static_assert(std::size(kCategoryNames) == static_cast<size_t>(yang::ResourceCategory::kMaxCategories), "Every resource category needs a name");
+
+    /// Hashes the content of a source file of the manifest with FNV-1a
+    /// \param id - interned path of the file
+    /// \return the hash, 0 if the file can't be loaded
+    uint64_t HashSourceFile(yang::ResourceId id)
+    {
+        auto pResource = yang::ResourceCache::Get()->Load<yang::IResource>(id);
+        if (!pResource)
+            return 0;
+
+        uint64_t hash = kVal64;
+        for (std::byte value : pResource->GetData())
+        {
+            hash = (hash ^ static_cast<uint64_t>(value)) * kPrime64;
+        }
+        return hash;
+    }
+}
+
+bool yang::SceneManifest::Load(const char* scenePath)
+{
+    using namespace tinyxml2;
+
+    std::string manifestPath = std::string(scenePath) + kFileSuffix;
+    ResourceCache* pCache = ResourceCache::Get();
+    if (!pCache->HasResource(manifestPath.c_str()))
+        return false;
+
+    auto pResource = pCache->Load<IResource>(manifestPath.c_str());
+    if (!pResource)
+        return false;
+
+    XMLDocument doc;
+    XMLError error = LoadXmlDocument(pResource->GetData().data(), pResource->GetData().size(), doc);
+    if (error != XML_SUCCESS)
+    {
+        LOG(Error, "Failed to load scene manifest: %s -- %s", manifestPath.c_str(), XMLDocument::ErrorIDToName(error));
+        return false;
+    }
+
+#ifdef DEBUG
+    // The scene file and the raw resources (actors, maps, tilesets) decide what the scene loads. If any of them changed
+    // since the manifest was written, the scene is recorded again
+    bool isStale = doc.RootElement()->Unsigned64Attribute("sceneHash") != HashSourceFile(pCache->InternPath(scenePath));
+#endif
+
+    m_dependencies.clear();
+    for (XMLElement* pResourceData = doc.RootElement()->FirstChildElement("Resource"); pResourceData != nullptr; pResourceData = pResourceData->NextSiblingElement("Resource"))
+    {
+        const char* pSource = pResourceData->Attribute("src");
+        const char* pType = pResourceData->Attribute("type");
+        if (!pSource || !pType)
+        {
+            LOG(Warning, "Scene manifest %s has a resource without src or type. Skipping the resource", manifestPath.c_str());
+            continue;
+        }
+
+        auto categoryIt = std::find_if(std::begin(kCategoryNames), std::end(kCategoryNames), [pType](const char* pName) { return std::string_view(pName) == pType; });
+        if (categoryIt == std::end(kCategoryNames))
+        {
+            LOG(Warning, "Scene manifest %s has a resource of unknown type %s. Skipping the resource", manifestPath.c_str(), pType);
+            continue;
+        }
+
+        ResourceDependency dependency;
+        dependency.m_id = pCache->InternPath(pSource);
+        dependency.m_category = static_cast<ResourceCategory>(categoryIt - std::begin(kCategoryNames));
+        dependency.m_fontSize = pResourceData->IntAttribute("size");
+        m_dependencies.push_back(dependency);
+
+#ifdef DEBUG
+        if (!isStale && dependency.m_category == ResourceCategory::kRaw)
+        {
+            isStale = pResourceData->Unsigned64Attribute("hash") != HashSourceFile(dependency.m_id);
+        }
+#endif
+    }
+
+#ifdef DEBUG
+    if (isStale)
+    {
+        LOG(Info, "Scene manifest %s is out of date, the scene is recorded again", manifestPath.c_str());
+        m_dependencies.clear();
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+bool yang::SceneManifest::Save(const char* scenePath) const
+{
+    using namespace tinyxml2;
+
+    XMLDocument doc;
+    XMLElement* pRoot = doc.NewElement("SceneManifest");
+    pRoot->SetAttribute("sceneHash", HashSourceFile(ResourceCache::Get()->InternPath(scenePath)));
+    doc.InsertFirstChild(pRoot);
+
+    for (const ResourceDependency& dependency : m_dependencies)
+    {
+        const std::string* pPath = ResourceCache::Get()->GetInternedPath(dependency.m_id);
+        if (!pPath)
+            continue;
+
+        XMLElement* pResourceData = doc.NewElement("Resource");
+        pResourceData->SetAttribute("type", kCategoryNames[static_cast<size_t>(dependency.m_category)]);
+        pResourceData->SetAttribute("src", pPath->c_str());
+        if (dependency.m_category == ResourceCategory::kFont)
+        {
+            pResourceData->SetAttribute("size", dependency.m_fontSize);
+        }
+        else if (dependency.m_category == ResourceCategory::kRaw)
+        {
+            pResourceData->SetAttribute("hash", HashSourceFile(dependency.m_id));
+        }
+        pRoot->InsertEndChild(pResourceData);
+    }
+
+    std::string manifestPath = std::string(scenePath) + kFileSuffix;
+    if (doc.SaveFile(manifestPath.c_str()) != XML_SUCCESS)
+    {
+        LOG(Warning, "Failed to save scene manifest %s", manifestPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void yang::SceneManifest::BeginRecording()
+{
+    m_dependencies.clear();
+    ResourceCache::Get()->BeginDependencyRecording(&m_dependencies);
+}
+
+void yang::SceneManifest::EndRecording()
+{
+    ResourceCache::Get()->EndDependencyRecording();
+
+    auto toTuple = [](const ResourceDependency& dependency) { return std::make_tuple(dependency.m_id, dependency.m_category, dependency.m_fontSize); };
+    std::sort(m_dependencies.begin(), m_dependencies.end(), [&toTuple](const ResourceDependency& left, const ResourceDependency& right)
+        {
+            return toTuple(left) < toTuple(right);
+        });
+    m_dependencies.erase(std::unique(m_dependencies.begin(), m_dependencies.end(), [&toTuple](const ResourceDependency& left, const ResourceDependency& right)
+        {
+            return toTuple(left) == toTuple(right);
+        }), m_dependencies.end());
+}
+
+void yang::SceneManifest::Prefetch(std::vector<std::shared_ptr<IResource>>& resources) const
+{
+    ResourceCache* pCache = ResourceCache::Get();
+
+    // Queue everything first, so the worker threads read and decode in parallel
+    std::vector<std::function<std::shared_ptr<IResource>()>> pendingLoads;
+    pendingLoads.reserve(m_dependencies.size());
+
+    for (const ResourceDependency& dependency : m_dependencies)
+    {
+        switch (dependency.m_category)
+        {
+        case ResourceCategory::kRaw:
+            pendingLoads.emplace_back([handle = pCache->LoadAsync<IResource>(dependency.m_id)]() mutable { return handle.Wait(); });
+            break;
+        case ResourceCategory::kTexture:
+            pendingLoads.emplace_back([handle = pCache->LoadAsync<ITexture>(dependency.m_id)]() mutable { return handle.Wait(); });
+            break;
+        case ResourceCategory::kSound:
+            pendingLoads.emplace_back([handle = pCache->LoadAsync<ISound>(dependency.m_id)]() mutable { return handle.Wait(); });
+            break;
+        case ResourceCategory::kMusic:
+            pendingLoads.emplace_back([handle = pCache->LoadAsync<IMusic>(dependency.m_id)]() mutable { return handle.Wait(); });
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Fonts can't be loaded asynchronously, load them while the workers are busy
+    for (const ResourceDependency& dependency : m_dependencies)
+    {
+        if (dependency.m_category != ResourceCategory::kFont)
+            continue;
+
+        if (auto pFont = pCache->Load<IFont>(dependency.m_id, dependency.m_fontSize); pFont != nullptr)
+        {
+            resources.emplace_back(std::move(pFont));
+        }
+    }
+
+    for (auto& waitForLoad : pendingLoads)
+    {
+        if (auto pResource = waitForLoad(); pResource != nullptr)
+        {
+            resources.emplace_back(std::move(pResource));
+        }
+    }
+}
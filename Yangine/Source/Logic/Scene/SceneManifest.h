@@ -0,0 +1,70 @@
+#pragma once
+/** \file SceneManifest.h */
+/** List of all resources a scene loads */
+
+#include <vector>
+#include <memory>
+#include <string>
+
+#include <Application/Resources/ResourceCache.h>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \class SceneManifest */
+/** Every resource a scene requests while it is initialized: actor files, textures, fonts, sounds, maps and tilesets.
+    Recorded on the first load of the scene, or read from the manifest file next to the scene file, and used to
+    prefetch all of them in parallel before the scene spawns its actors.
+    The file keeps content hashes of the scene file and of the raw resources. Debug builds check them on load
+    and record the scene again when the scene, an actor file or a map changed since the file was written */
+class SceneManifest
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+    static constexpr const char* kFileSuffix = ".manifest";     ///< Manifest file path is the scene file path with this suffix
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Reads the manifest file of the scene, if there is one
+    /// \param scenePath - path to the scene file
+    /// \return true if the manifest was read. Debug builds also return false if the manifest is out of date
+    bool Load(const char* scenePath);
+
+    /// Writes the manifest file next to the scene file
+    /// \param scenePath - path to the scene file
+    /// \return true if the manifest was written
+    bool Save(const char* scenePath) const;
+
+    /// Starts recording the resources requested from the cache
+    void BeginRecording();
+
+    /// Stops recording and removes duplicates
+    void EndRecording();
+
+    /// Starts loading all resources on the worker threads and waits for them. Fonts are loaded on the calling thread meanwhile
+    /// \param resources - loaded resources are appended here. Keeping them alive until the scene is spawned keeps them in the cache
+    void Prefetch(std::vector<std::shared_ptr<IResource>>& resources) const;
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+    std::vector<ResourceDependency> m_dependencies;     ///< All resources of the scene
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Get number of resources in the manifest
+    size_t GetResourceCount() const { return m_dependencies.size(); }
+
+    /// Does the manifest contain any resources
+    bool IsEmpty() const { return m_dependencies.empty(); }
+};
+}
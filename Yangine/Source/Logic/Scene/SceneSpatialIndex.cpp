@@ -0,0 +1,150 @@
+#include "SceneSpatialIndex.h"
+#include <Utils/Logger.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using yang::SceneSpatialIndex;
+
+/* static */ bool yang::SceneSpatialIndex::CanIndex(const FRect& bounds)
+{
+    // Comparisons with NaN are false, so NaN sizes are rejected as well
+    constexpr float kMaxSize = kCellSize * kMaxCellSpan;
+    return bounds.width >= 0.f && bounds.width <= kMaxSize && bounds.height >= 0.f && bounds.height <= kMaxSize
+        && std::isfinite(bounds.x) && std::isfinite(bounds.y);
+}
+
+size_t yang::SceneSpatialIndex::Add(Actor* pActor, const FRect& bounds)
+{
+    assert(pActor);
+
+    size_t handle;
+    if (!m_freeHandles.empty())
+    {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    }
+    else
+    {
+        handle = m_entries.size();
+        m_entries.emplace_back();
+    }
+
+    Entry& entry = m_entries[handle];
+    entry.m_pActor = pActor;
+    entry.m_bounds = bounds;
+    LinkCells(handle, true);
+
+    return handle;
+}
+
+void yang::SceneSpatialIndex::Update(size_t handle, const FRect& bounds)
+{
+    if (handle >= m_entries.size() || !m_entries[handle].m_pActor)
+    {
+        LOG(Error, "Invalid handle received when attempting to update actor render bounds");
+        return;
+    }
+
+    Entry& entry = m_entries[handle];
+    IRect cells = CellsFromRect(bounds);
+
+    // Most of the moves stay in the same cells, so relinking is only needed sometimes
+    if (cells.x == entry.m_cells.x && cells.y == entry.m_cells.y && cells.width == entry.m_cells.width && cells.height == entry.m_cells.height)
+    {
+        entry.m_bounds = bounds;
+        return;
+    }
+
+    LinkCells(handle, false);
+    entry.m_bounds = bounds;
+    LinkCells(handle, true);
+}
+
+void yang::SceneSpatialIndex::Remove(size_t handle)
+{
+    if (handle >= m_entries.size() || !m_entries[handle].m_pActor)
+    {
+        LOG(Error, "Invalid handle received when attempting to remove actor render bounds");
+        return;
+    }
+
+    LinkCells(handle, false);
+    m_entries[handle].m_pActor = nullptr;
+    m_freeHandles.push_back(handle);
+}
+
+void yang::SceneSpatialIndex::Query(const FRect& rect, std::vector<Actor*>& actors)
+{
+    ++m_queryStamp;
+    IRect cells = CellsFromRect(rect);
+
+    for (int y = cells.y; y <= cells.height; ++y)
+    {
+        for (int x = cells.x; x <= cells.width; ++x)
+        {
+            auto cellIt = m_cells.find(CellKey(x, y));
+            if (cellIt == m_cells.end())
+                continue;
+
+            for (size_t handle : cellIt->second)
+            {
+                Entry& entry = m_entries[handle];
+                if (entry.m_queryStamp == m_queryStamp)
+                    continue;
+
+                entry.m_queryStamp = m_queryStamp;
+                if (entry.m_bounds.Collide(rect))
+                {
+                    actors.push_back(entry.m_pActor);
+                }
+            }
+        }
+    }
+}
+
+void yang::SceneSpatialIndex::LinkCells(size_t handle, bool link)
+{
+    Entry& entry = m_entries[handle];
+
+    if (link)
+    {
+        entry.m_cells = CellsFromRect(entry.m_bounds);
+    }
+
+    for (int y = entry.m_cells.y; y <= entry.m_cells.height; ++y)
+    {
+        for (int x = entry.m_cells.x; x <= entry.m_cells.width; ++x)
+        {
+            if (link)
+            {
+                m_cells[CellKey(x, y)].push_back(handle);
+                continue;
+            }
+
+            auto cellIt = m_cells.find(CellKey(x, y));
+            if (cellIt == m_cells.end())
+                continue;
+
+            auto& handles = cellIt->second;
+            auto handleIt = std::find(handles.begin(), handles.end(), handle);
+            if (handleIt != handles.end())
+            {
+                std::iter_swap(handleIt, handles.end() - 1);
+                handles.pop_back();
+            }
+
+            if (handles.empty())
+            {
+                m_cells.erase(cellIt);
+            }
+        }
+    }
+}
+
+/* static */ yang::IRect yang::SceneSpatialIndex::CellsFromRect(const FRect& rect)
+{
+    // Stored as first and last cell instead of position and size, like in UIHitTestService
+    return IRect(static_cast<int>(std::floor(rect.x / kCellSize)), static_cast<int>(std::floor(rect.y / kCellSize)),
+        static_cast<int>(std::floor((rect.x + rect.width) / kCellSize)), static_cast<int>(std::floor((rect.y + rect.height) / kCellSize)));
+}
@@ -0,0 +1,97 @@
+#pragma once
+/** \file SceneSpatialIndex.h */
+/** Uniform grid of actor render bounds */
+
+#include <Utils/Rectangle.h>
+#include <Utils/Vector2.h>
+#include <unordered_map>
+#include <vector>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+    class Actor;
+
+/** \class SceneSpatialIndex */
+/** Keeps the render bounds of scene actors in a uniform grid, so the actors inside the viewport are found
+    without testing every actor of the scene */
+class SceneSpatialIndex
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+    static constexpr float kCellSize = 256.f;      ///< Width and height of a grid cell in world units
+    static constexpr int kMaxCellSpan = 64;         ///< Bounds that cover more cells on either axis are not indexed
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Checks whether the bounds are small enough to be indexed. Actors with huge or infinite bounds are cheaper to draw than to index
+    /// \param bounds - render bounds to check
+    /// \return true if the bounds can be added
+    static bool CanIndex(const FRect& bounds);
+
+    /// Adds the actor to the grid
+    /// \param pActor - actor to add
+    /// \param bounds - render bounds of the actor
+    /// \return handle of the actor, used to move or remove it
+    size_t Add(Actor* pActor, const FRect& bounds);
+
+    /// Moves the actor to new bounds
+    /// \param handle - handle returned from Add
+    /// \param bounds - new render bounds
+    void Update(size_t handle, const FRect& bounds);
+
+    /// Removes the actor from the grid
+    /// \param handle - handle returned from Add
+    void Remove(size_t handle);
+
+    /// Finds all actors whose bounds overlap the rectangle. Every actor is reported once
+    /// \param rect - rectangle to test
+    /// \param actors - overlapping actors are appended here
+    void Query(const FRect& rect, std::vector<Actor*>& actors);
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+
+    /// Registered actor
+    struct Entry
+    {
+        Actor* m_pActor = nullptr;      ///< Actor, null if the slot is free
+        FRect m_bounds;                 ///< Actor render bounds
+        IRect m_cells;                  ///< Range of grid cells that the bounds cover (inclusive)
+        uint32_t m_queryStamp = 0;      ///< Last query that reported the actor, to report actors spanning several cells once
+    };
+
+    std::vector<Entry> m_entries;                                   ///< All registered actors, indexed by handle
+    std::vector<size_t> m_freeHandles;                              ///< Handles of removed actors, reused first
+    std::unordered_map<uint64_t, std::vector<size_t>> m_cells;      ///< Handles of the actors touching each grid cell
+    uint32_t m_queryStamp = 0;                                      ///< Number of queries made
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Internal helper function. Adds or removes the entry handle to or from every cell of its range
+    void LinkCells(size_t handle, bool link);
+
+    /// Internal helper function. Get the range of grid cells that the rectangle covers (inclusive)
+    static IRect CellsFromRect(const FRect& rect);
+
+    /// Internal helper function. Get the cell key for the cell map
+    static uint64_t CellKey(int x, int y) { return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y); }
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Get the number of registered actors
+    size_t GetActorCount() const { return m_entries.size() - m_freeHandles.size(); }
+};
+}
@@ -0,0 +1,250 @@
+#include "UIHitTestService.h"
+#include <Logic/Event/EventDispatcher.h>
+#include <Logic/Event/Input/MouseMotionEvent.h>
+#include <Logic/Event/Input/MouseButtonEvent.h>
+#include <Logic/Event/Input/MouseWheelEvent.h>
+#include <Logic/Components/MouseInputListener.h>
+#include <Utils/Logger.h>
+#include <algorithm>
+#include <cassert>
+
+using yang::UIHitTestService;
+
+UIHitTestService::UIHitTestService(EventDispatcher& dispatcher)
+    :m_dispatcher(dispatcher)
+{
+    m_mouseMotionListenerIndex = m_dispatcher.AddEventListener(MouseMotionEvent::kEventId, [this](IEvent* pEvent) { HandleMouseMotion(pEvent); });
+    m_clickListenerIndex = m_dispatcher.AddEventListener(MouseButtonEvent::kEventId, [this](IEvent* pEvent) { HandleClick(pEvent); });
+    m_wheelListenerIndex = m_dispatcher.AddEventListener(MouseWheelEvent::kEventId, [this](IEvent* pEvent) { HandleWheelScroll(pEvent); });
+}
+
+UIHitTestService::~UIHitTestService()
+{
+    m_dispatcher.RemoveEventListener(MouseMotionEvent::kEventId, m_mouseMotionListenerIndex);
+    m_dispatcher.RemoveEventListener(MouseButtonEvent::kEventId, m_clickListenerIndex);
+    m_dispatcher.RemoveEventListener(MouseWheelEvent::kEventId, m_wheelListenerIndex);
+}
+
+size_t yang::UIHitTestService::AddListener(MouseInputListener* pListener, const IRect& rect)
+{
+    assert(pListener);
+
+    size_t handle;
+    if (!m_freeHandles.empty())
+    {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    }
+    else
+    {
+        handle = m_entries.size();
+        m_entries.emplace_back();
+    }
+
+    Entry& entry = m_entries[handle];
+    entry.m_pListener = pListener;
+    entry.m_rect = rect;
+    LinkCells(handle, true);
+
+    return handle;
+}
+
+void yang::UIHitTestService::UpdateListener(size_t handle, const IRect& rect)
+{
+    if (handle >= m_entries.size() || !m_entries[handle].m_pListener)
+    {
+        LOG(Error, "Invalid handle received when attempting to update hit test listener");
+        return;
+    }
+
+    Entry& entry = m_entries[handle];
+    IVec2 topLeft = CellFromPoint(IVec2(rect.x, rect.y));
+    IVec2 bottomRight = CellFromPoint(IVec2(rect.x + rect.width, rect.y + rect.height));
+
+    // Most of the moves stay in the same cells, so relinking is only needed sometimes
+    if (topLeft.x == entry.m_cells.x && topLeft.y == entry.m_cells.y &&
+        bottomRight.x == entry.m_cells.width && bottomRight.y == entry.m_cells.height)
+    {
+        entry.m_rect = rect;
+        return;
+    }
+
+    LinkCells(handle, false);
+    entry.m_rect = rect;
+    LinkCells(handle, true);
+}
+
+void yang::UIHitTestService::RemoveListener(size_t handle)
+{
+    if (handle >= m_entries.size() || !m_entries[handle].m_pListener)
+    {
+        LOG(Error, "Invalid handle received when attempting to remove hit test listener");
+        return;
+    }
+
+    LinkCells(handle, false);
+    m_entries[handle].m_pListener = nullptr;
+    m_freeHandles.push_back(handle);
+}
+
+void yang::UIHitTestService::HandleMouseMotion(IEvent* pEvent)
+{
+    assert(MouseMotionEvent::kEventId == pEvent->GetEventId());
+    MouseMotionEvent* pResult = static_cast<MouseMotionEvent*>(pEvent);
+
+    const IVec2& startPoint = pResult->GetStartPoint();
+    const IVec2& endPoint = pResult->GetEndPoint();
+
+    // Callbacks are allowed to add and remove listeners, so the candidates are copied before calling them
+    std::vector<MouseInputListener*> entered;
+    std::vector<MouseInputListener*> exited;
+
+    // Any rectangle that contains the end point is linked to its cell, same for the start point
+    if (auto pCandidates = GetCandidates(endPoint); pCandidates != nullptr)
+    {
+        for (size_t handle : *pCandidates)
+        {
+            const IRect& rect = m_entries[handle].m_rect;
+            if (rect.Contains(endPoint) && !rect.Contains(startPoint))
+            {
+                entered.push_back(m_entries[handle].m_pListener);
+            }
+        }
+    }
+
+    if (auto pCandidates = GetCandidates(startPoint); pCandidates != nullptr)
+    {
+        for (size_t handle : *pCandidates)
+        {
+            const IRect& rect = m_entries[handle].m_rect;
+            if (rect.Contains(startPoint) && !rect.Contains(endPoint))
+            {
+                exited.push_back(m_entries[handle].m_pListener);
+            }
+        }
+    }
+
+    for (MouseInputListener* pListener : exited)
+    {
+        pListener->HandleMouseOut();
+    }
+
+    for (MouseInputListener* pListener : entered)
+    {
+        pListener->HandleMouseOver();
+    }
+}
+
+void yang::UIHitTestService::HandleClick(IEvent* pEvent)
+{
+    assert(MouseButtonEvent::kEventId == pEvent->GetEventId());
+    MouseButtonEvent* pResult = static_cast<MouseButtonEvent*>(pEvent);
+
+    IVec2 clickPosition = pResult->GetClickPosition();
+    auto pCandidates = GetCandidates(clickPosition);
+    if (!pCandidates)
+        return;
+
+    std::vector<MouseInputListener*> hits;
+    for (size_t handle : *pCandidates)
+    {
+        if (m_entries[handle].m_rect.Contains(clickPosition))
+        {
+            hits.push_back(m_entries[handle].m_pListener);
+        }
+    }
+
+    for (MouseInputListener* pListener : hits)
+    {
+        pListener->HandleClick(pResult);
+    }
+}
+
+void yang::UIHitTestService::HandleWheelScroll(IEvent* pEvent)
+{
+    assert(MouseWheelEvent::kEventId == pEvent->GetEventId());
+    MouseWheelEvent* pResult = static_cast<MouseWheelEvent*>(pEvent);
+
+    // The event carries the cursor position, motion events are not seen while the scene is paused
+    IVec2 wheelPosition = pResult->GetPosition();
+    auto pCandidates = GetCandidates(wheelPosition);
+    if (!pCandidates)
+        return;
+
+    std::vector<MouseInputListener*> hits;
+    for (size_t handle : *pCandidates)
+    {
+        if (m_entries[handle].m_rect.Contains(wheelPosition))
+        {
+            hits.push_back(m_entries[handle].m_pListener);
+        }
+    }
+
+    for (MouseInputListener* pListener : hits)
+    {
+        pListener->HandleWheelScroll(pResult->GetScrollAmount());
+    }
+}
+
+void yang::UIHitTestService::LinkCells(size_t handle, bool link)
+{
+    Entry& entry = m_entries[handle];
+
+    if (link)
+    {
+        IVec2 topLeft = CellFromPoint(IVec2(entry.m_rect.x, entry.m_rect.y));
+        IVec2 bottomRight = CellFromPoint(IVec2(entry.m_rect.x + entry.m_rect.width, entry.m_rect.y + entry.m_rect.height));
+        entry.m_cells = IRect(topLeft.x, topLeft.y, bottomRight.x, bottomRight.y);
+    }
+
+    for (int y = entry.m_cells.y; y <= entry.m_cells.height; ++y)
+    {
+        for (int x = entry.m_cells.x; x <= entry.m_cells.width; ++x)
+        {
+            if (link)
+            {
+                m_cells[CellKey(x, y)].push_back(handle);
+                continue;
+            }
+
+            auto cellIt = m_cells.find(CellKey(x, y));
+            if (cellIt == m_cells.end())
+                continue;
+
+            auto& handles = cellIt->second;
+            auto handleIt = std::find(handles.begin(), handles.end(), handle);
+            if (handleIt != handles.end())
+            {
+                std::iter_swap(handleIt, handles.end() - 1);
+                handles.pop_back();
+            }
+
+            if (handles.empty())
+            {
+                m_cells.erase(cellIt);
+            }
+        }
+    }
+}
+
+/* static */ yang::IVec2 yang::UIHitTestService::CellFromPoint(const IVec2& point)
+{
+    // Round towards negative infinity, so the cells left and above the origin don't get merged with the first one
+    auto toCell = [](int coordinate)
+    {
+        return coordinate >= 0 ? coordinate / kCellSize : (coordinate - kCellSize + 1) / kCellSize;
+    };
+
+    return IVec2(toCell(point.x), toCell(point.y));
+}
+
+const std::vector<size_t>* yang::UIHitTestService::GetCandidates(const IVec2& point) const
+{
+    IVec2 cell = CellFromPoint(point);
+    if (auto cellIt = m_cells.find(CellKey(cell.x, cell.y)); cellIt != m_cells.end())
+    {
+        return &cellIt->second;
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,115 @@
+#pragma once
+/** \file UIHitTestService.h */
+/** Scene level mouse hit testing for MouseInputListener components */
+
+#include <Utils/Rectangle.h>
+#include <Utils/Vector2.h>
+#include <Utils/Typedefs.h>
+#include <unordered_map>
+#include <vector>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+    class EventDispatcher;
+    class MouseInputListener;
+    class IEvent;
+
+/** \class UIHitTestService */
+/** Keeps the rectangles of all scene mouse listeners in a uniform grid. Listens for mouse events once per scene and
+    routes them only to the listeners that are actually hit, instead of every listener testing every event itself */
+class UIHitTestService
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+    static constexpr int kCellSize = 128;      ///< Width and height of a grid cell in pixels
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Constructor
+    /// \param dispatcher - scene event dispatcher to listen to
+    UIHitTestService(EventDispatcher& dispatcher);
+
+    /** Default Destructor */
+    ~UIHitTestService();
+
+    UIHitTestService(const UIHitTestService&) = delete;
+    UIHitTestService& operator=(const UIHitTestService&) = delete;
+
+    /// Adds the listener to the grid
+    /// \param pListener - listener to add
+    /// \param rect - rectangle the listener reacts on
+    /// \return handle of the listener, used to move or remove it
+    size_t AddListener(MouseInputListener* pListener, const IRect& rect);
+
+    /// Moves the listener to a new rectangle
+    /// \param handle - handle returned from AddListener
+    /// \param rect - new rectangle
+    void UpdateListener(size_t handle, const IRect& rect);
+
+    /// Removes the listener from the grid
+    /// \param handle - handle returned from AddListener
+    void RemoveListener(size_t handle);
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+
+    /// Registered listener
+    struct Entry
+    {
+        MouseInputListener* m_pListener = nullptr;  ///< Listener, null if the slot is free
+        IRect m_rect;                               ///< Listener rectangle
+        IRect m_cells;                              ///< Range of grid cells that the rectangle covers (inclusive)
+    };
+
+    EventDispatcher& m_dispatcher;                                  ///< Dispatcher mouse listeners are registered to
+    std::vector<Entry> m_entries;                                   ///< All registered listeners, indexed by handle
+    std::vector<size_t> m_freeHandles;                              ///< Handles of removed listeners, reused first
+    std::unordered_map<uint64_t, std::vector<size_t>> m_cells;      ///< Handles of the listeners touching each grid cell
+
+    size_t m_mouseMotionListenerIndex;                              ///< Index of the mouse motion event listener
+    size_t m_clickListenerIndex;                                    ///< Index of the mouse button event listener
+    size_t m_wheelListenerIndex;                                    ///< Index of the mouse wheel event listener
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Internal helper function. Handles the mouse motion event, calls enter/exit callbacks on listeners whose rectangles were crossed
+    void HandleMouseMotion(IEvent* pEvent);
+
+    /// Internal helper function. Handles the mouse button event, calls click callbacks on listeners under the click position
+    void HandleClick(IEvent* pEvent);
+
+    /// Internal helper function. Handles the mouse wheel event, calls scroll callbacks on listeners under the cursor
+    void HandleWheelScroll(IEvent* pEvent);
+
+    /// Internal helper function. Adds or removes the entry handle to or from every cell of its range
+    void LinkCells(size_t handle, bool link);
+
+    /// Internal helper function. Get the grid cell that contains the point
+    static IVec2 CellFromPoint(const IVec2& point);
+
+    /// Internal helper function. Get the cell key for the cell map
+    static uint64_t CellKey(int x, int y) { return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y); }
+
+    /// Internal helper function. Get the handles of the listeners touching the cell that contains the point
+    /// \return pointer to the handles, or null if nothing touches the cell
+    const std::vector<size_t>* GetCandidates(const IVec2& point) const;
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Get the number of registered listeners
+    size_t GetListenerCount() const { return m_entries.size() - m_freeHandles.size(); }
+};
+}
@@ -91,8 +91,14 @@ bool yang::ConeShape::DebugDraw(IGraphics* pGraphics)
             return m.TransformPoint(v);
         });
 
-    // Chaaaange!
-    return pGraphics->DrawPolygon({ toDraw[0], toDraw[1], toDraw[2], toDraw[3] }, m_color);
+    // Outline as a line list, one draw call without allocating the polygon
+    yang::FVec2 lines[8];
+    for (size_t i = 0; i < 4; ++i)
+    {
+        lines[i * 2] = toDraw[i];
+        lines[i * 2 + 1] = toDraw[(i + 1) % 4];
+    }
+    return pGraphics->DrawLineList(lines, 8, m_color);
 }
 #endif
 
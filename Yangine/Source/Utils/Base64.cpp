@@ -0,0 +1,125 @@
+#include "Base64.h"
+#include <array>
+#include <cstdint>
+
+namespace
+{
+    constexpr uint8_t kInvalid = 0xFF;      ///< Not a base64 character
+    constexpr uint8_t kSkip = 0xFE;         ///< Whitespace
+    constexpr uint8_t kPadding = 0xFD;      ///< Padding, only whitespace and more padding can follow it
+
+    /// Value of every character
+    constexpr std::array<uint8_t, 256> BuildDecodeTable()
+    {
+        std::array<uint8_t, 256> table{};
+        for (auto& value : table)
+        {
+            value = kInvalid;
+        }
+
+        constexpr const char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (uint8_t i = 0; i < 64; ++i)
+        {
+            table[static_cast<uint8_t>(kAlphabet[i])] = i;
+        }
+
+        table[' '] = table['\t'] = table['\r'] = table['\n'] = kSkip;
+        table['='] = kPadding;
+        return table;
+    }
+
+    constexpr std::array<uint8_t, 256> kDecodeTable = BuildDecodeTable();
+}
+
+bool yang::DecodeBase64(std::string_view text, std::vector<std::byte>& output)
+{
+    // Decoded size is at most 3 bytes per 4 characters, the output is trimmed once the real size is known
+    size_t startSize = output.size();
+    output.resize(startSize + text.size() / 4 * 3 + 3);
+    uint8_t* pOutput = reinterpret_cast<uint8_t*>(output.data() + startSize);
+
+    const uint8_t* pCurrent = reinterpret_cast<const uint8_t*>(text.data());
+    const uint8_t* pEnd = pCurrent + text.size();
+
+    uint32_t accumulator = 0;
+    int sextetCount = 0;
+
+    while (pCurrent < pEnd)
+    {
+        // Fast path: 4 characters without whitespace or padding make 3 bytes
+        if (sextetCount == 0 && pEnd - pCurrent >= 4)
+        {
+            uint32_t a = kDecodeTable[pCurrent[0]];
+            uint32_t b = kDecodeTable[pCurrent[1]];
+            uint32_t c = kDecodeTable[pCurrent[2]];
+            uint32_t d = kDecodeTable[pCurrent[3]];
+            if ((a | b | c | d) < 64)
+            {
+                uint32_t triple = (a << 18) | (b << 12) | (c << 6) | d;
+                pOutput[0] = static_cast<uint8_t>(triple >> 16);
+                pOutput[1] = static_cast<uint8_t>(triple >> 8);
+                pOutput[2] = static_cast<uint8_t>(triple);
+                pOutput += 3;
+                pCurrent += 4;
+                continue;
+            }
+        }
+
+        uint8_t value = kDecodeTable[*pCurrent++];
+        if (value == kSkip)
+            continue;
+        if (value == kPadding)
+        {
+            // Padding ends the data, it only completes a group of 2 or 3 characters
+            bool isTrailValid = (sextetCount == 2 || sextetCount == 3);
+            for (; isTrailValid && pCurrent < pEnd; ++pCurrent)
+            {
+                uint8_t trailValue = kDecodeTable[*pCurrent];
+                isTrailValid = (trailValue == kSkip || trailValue == kPadding);
+            }
+
+            if (!isTrailValid)
+            {
+                output.resize(startSize);
+                return false;
+            }
+            break;
+        }
+        if (value == kInvalid)
+        {
+            output.resize(startSize);
+            return false;
+        }
+
+        accumulator = (accumulator << 6) | value;
+        if (++sextetCount == 4)
+        {
+            pOutput[0] = static_cast<uint8_t>(accumulator >> 16);
+            pOutput[1] = static_cast<uint8_t>(accumulator >> 8);
+            pOutput[2] = static_cast<uint8_t>(accumulator);
+            pOutput += 3;
+            accumulator = 0;
+            sextetCount = 0;
+        }
+    }
+
+    // 2 or 3 trailing characters carry 1 or 2 bytes
+    switch (sextetCount)
+    {
+    case 0:
+        break;
+    case 2:
+        *pOutput++ = static_cast<uint8_t>(accumulator >> 4);
+        break;
+    case 3:
+        *pOutput++ = static_cast<uint8_t>(accumulator >> 10);
+        *pOutput++ = static_cast<uint8_t>(accumulator >> 2);
+        break;
+    default:
+        output.resize(startSize);
+        return false;
+    }
+
+    output.resize(static_cast<size_t>(reinterpret_cast<std::byte*>(pOutput) - output.data()));
+    return true;
+}
@@ -0,0 +1,17 @@
+#pragma once
+/** \file Base64.h */
+/** Base64 decoding */
+
+#include <vector>
+#include <string_view>
+#include <cstddef>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+    /// Decodes base64 text. Whitespace anywhere in the text is skipped, padding is optional but ends the data
+    /// \param text - base64 text
+    /// \param output - decoded bytes are appended here
+    /// \return true if the text was decoded, false if it has invalid characters, a dangling character or data after the padding
+    bool DecodeBase64(std::string_view text, std::vector<std::byte>& output);
+}
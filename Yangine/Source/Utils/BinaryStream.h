@@ -0,0 +1,113 @@
+#pragma once
+/** \file BinaryStream.h */
+/** Minimal helpers to write and read cooked binary data */
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \class BinaryWriter */
+/** Appends values to a byte vector in the native (little endian) layout */
+class BinaryWriter
+{
+public:
+    /// Constructor
+    /// \param output - vector to append to
+    explicit BinaryWriter(std::vector<std::byte>& output) : m_output(output) {}
+
+    /// Appends the value
+    template <class Type>
+    void Write(const Type& value)
+    {
+        static_assert(std::is_trivially_copyable_v<Type>, "Only trivially copyable types can be written");
+        WriteBytes(&value, sizeof(value));
+    }
+
+    /// Appends the string length followed by its characters
+    void WriteString(std::string_view value)
+    {
+        Write(static_cast<uint32_t>(value.size()));
+        WriteBytes(value.data(), value.size());
+    }
+
+    /// Appends raw bytes
+    void WriteBytes(const void* pData, size_t size)
+    {
+        const std::byte* pBytes = static_cast<const std::byte*>(pData);
+        m_output.insert(m_output.end(), pBytes, pBytes + size);
+    }
+
+private:
+    std::vector<std::byte>& m_output;       ///< Vector to append to
+};
+
+/** \class BinaryReader */
+/** Reads values written by BinaryWriter. Every read is bounds checked, once a read fails all following reads fail too */
+class BinaryReader
+{
+public:
+    /// Constructor
+    /// \param pData - first byte to read
+    /// \param size - number of bytes available
+    BinaryReader(const std::byte* pData, size_t size) : m_pCurrent(pData), m_pEnd(pData + size), m_hasFailed(false) {}
+
+    /// Reads the value
+    /// \return false if there is not enough data
+    template <class Type>
+    bool Read(Type& value)
+    {
+        static_assert(std::is_trivially_copyable_v<Type>, "Only trivially copyable types can be read");
+        const std::byte* pBytes = ReadBytes(sizeof(value));
+        if (!pBytes)
+            return false;
+
+        std::memcpy(&value, pBytes, sizeof(value));
+        return true;
+    }
+
+    /// Reads the string written by BinaryWriter::WriteString
+    /// \return view over the characters in the source data, empty if there is not enough data
+    std::string_view ReadString()
+    {
+        uint32_t size = 0;
+        if (!Read(size))
+            return {};
+
+        const std::byte* pBytes = ReadBytes(size);
+        return pBytes ? std::string_view(reinterpret_cast<const char*>(pBytes), size) : std::string_view();
+    }
+
+    /// Skips the bytes
+    /// \return pointer to the first skipped byte, or null if there is not enough data
+    const std::byte* ReadBytes(size_t size)
+    {
+        if (m_hasFailed || static_cast<size_t>(m_pEnd - m_pCurrent) < size)
+        {
+            m_hasFailed = true;
+            return nullptr;
+        }
+
+        const std::byte* pBytes = m_pCurrent;
+        m_pCurrent += size;
+        return pBytes;
+    }
+
+    /// Did any read fail
+    bool HasFailed() const { return m_hasFailed; }
+
+    /// Get number of bytes left
+    size_t GetRemainingSize() const { return static_cast<size_t>(m_pEnd - m_pCurrent); }
+
+private:
+    const std::byte* m_pCurrent;    ///< Next byte to read
+    const std::byte* m_pEnd;        ///< Past the last byte
+    bool m_hasFailed;               ///< Did any read fail
+};
+}
@@ -0,0 +1,186 @@
+#include "BinaryXml.h"
+#include <Utils/BinaryStream.h>
+#include <string_view>
+#include <unordered_map>
+
+using namespace tinyxml2;
+
+namespace
+{
+    constexpr uint32_t kNoString = 0xFFFFFFFF;      ///< String index of the missing element text
+
+    /// Collects unique strings while the element tree is written
+    class StringTable
+    {
+    public:
+        /// Get index of the string, adding it if needed
+        uint32_t GetIndex(const char* pString)
+        {
+            auto [stringIt, isNew] = m_indices.try_emplace(std::string_view(pString), static_cast<uint32_t>(m_strings.size()));
+            if (isNew)
+            {
+                m_strings.push_back(pString);
+            }
+            return stringIt->second;
+        }
+
+        /// Get all strings in the index order
+        const std::vector<const char*>& GetStrings() const { return m_strings; }
+
+    private:
+        std::unordered_map<std::string_view, uint32_t> m_indices;       ///< Index of each string
+        std::vector<const char*> m_strings;                             ///< Strings in the index order
+    };
+
+    /// Writes the element and its children
+    void WriteElement(const XMLElement* pElement, StringTable& strings, yang::BinaryWriter& writer)
+    {
+        writer.Write(strings.GetIndex(pElement->Name()));
+
+        uint32_t attributeCount = 0;
+        for (const XMLAttribute* pAttribute = pElement->FirstAttribute(); pAttribute != nullptr; pAttribute = pAttribute->Next())
+        {
+            ++attributeCount;
+        }
+
+        writer.Write(attributeCount);
+        for (const XMLAttribute* pAttribute = pElement->FirstAttribute(); pAttribute != nullptr; pAttribute = pAttribute->Next())
+        {
+            writer.Write(strings.GetIndex(pAttribute->Name()));
+            writer.Write(strings.GetIndex(pAttribute->Value()));
+        }
+
+        const char* pText = pElement->GetText();
+        writer.Write(pText ? strings.GetIndex(pText) : kNoString);
+
+        uint32_t childCount = 0;
+        for (const XMLElement* pChild = pElement->FirstChildElement(); pChild != nullptr; pChild = pChild->NextSiblingElement())
+        {
+            ++childCount;
+        }
+
+        writer.Write(childCount);
+        for (const XMLElement* pChild = pElement->FirstChildElement(); pChild != nullptr; pChild = pChild->NextSiblingElement())
+        {
+            WriteElement(pChild, strings, writer);
+        }
+    }
+
+    /// Reads the element and its children and adds them to the parent node
+    bool ReadElement(yang::BinaryReader& reader, const std::vector<const char*>& strings, XMLDocument& doc, XMLNode* pParent)
+    {
+        auto getString = [&strings](uint32_t index) { return index < strings.size() ? strings[index] : nullptr; };
+
+        uint32_t nameIndex = kNoString;
+        uint32_t attributeCount = 0;
+        if (!reader.Read(nameIndex) || !getString(nameIndex) || !reader.Read(attributeCount))
+            return false;
+
+        XMLElement* pElement = doc.NewElement(getString(nameIndex));
+        pParent->InsertEndChild(pElement);
+
+        for (uint32_t i = 0; i < attributeCount; ++i)
+        {
+            uint32_t attributeNameIndex = kNoString;
+            uint32_t attributeValueIndex = kNoString;
+            if (!reader.Read(attributeNameIndex) || !reader.Read(attributeValueIndex) || !getString(attributeNameIndex) || !getString(attributeValueIndex))
+                return false;
+
+            pElement->SetAttribute(getString(attributeNameIndex), getString(attributeValueIndex));
+        }
+
+        uint32_t textIndex = kNoString;
+        uint32_t childCount = 0;
+        if (!reader.Read(textIndex) || !reader.Read(childCount))
+            return false;
+
+        if (textIndex != kNoString)
+        {
+            if (!getString(textIndex))
+                return false;
+            pElement->SetText(getString(textIndex));
+        }
+
+        for (uint32_t i = 0; i < childCount; ++i)
+        {
+            if (!ReadElement(reader, strings, doc, pElement))
+                return false;
+        }
+
+        return true;
+    }
+}
+
+void yang::WriteBinaryXml(const XMLDocument& doc, std::vector<std::byte>& output)
+{
+    // The tree goes after the string table, but the table is only known once the tree is written
+    StringTable strings;
+    std::vector<std::byte> tree;
+    BinaryWriter treeWriter(tree);
+
+    uint32_t rootCount = 0;
+    for (const XMLElement* pRoot = doc.FirstChildElement(); pRoot != nullptr; pRoot = pRoot->NextSiblingElement())
+    {
+        ++rootCount;
+    }
+
+    treeWriter.Write(rootCount);
+    for (const XMLElement* pRoot = doc.FirstChildElement(); pRoot != nullptr; pRoot = pRoot->NextSiblingElement())
+    {
+        WriteElement(pRoot, strings, treeWriter);
+    }
+
+    BinaryWriter writer(output);
+    writer.Write(kBinaryXmlMagic);
+    writer.Write(kBinaryXmlVersion);
+    writer.Write(static_cast<uint32_t>(strings.GetStrings().size()));
+    for (const char* pString : strings.GetStrings())
+    {
+        // Null terminators are stored, so the reader hands the strings to tinyxml2 in place
+        writer.WriteString(std::string_view(pString, std::strlen(pString) + 1));
+    }
+    writer.WriteBytes(tree.data(), tree.size());
+}
+
+bool yang::IsBinaryXml(const std::byte* pData, size_t size)
+{
+    uint32_t magic = 0;
+    return BinaryReader(pData, size).Read(magic) && magic == kBinaryXmlMagic;
+}
+
+XMLError yang::LoadXmlDocument(const std::byte* pData, size_t size, XMLDocument& doc)
+{
+    if (!IsBinaryXml(pData, size))
+    {
+        return doc.Parse(reinterpret_cast<const char*>(pData), size);
+    }
+
+    BinaryReader reader(pData, size);
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t stringCount = 0;
+    if (!reader.Read(magic) || !reader.Read(version) || version != kBinaryXmlVersion || !reader.Read(stringCount))
+        return XML_ERROR_PARSING;
+
+    std::vector<const char*> strings;
+    strings.reserve(stringCount);
+    for (uint32_t i = 0; i < stringCount; ++i)
+    {
+        std::string_view string = reader.ReadString();
+        if (string.empty() || string.back() != '\0')
+            return XML_ERROR_PARSING;
+        strings.push_back(string.data());
+    }
+
+    uint32_t rootCount = 0;
+    if (!reader.Read(rootCount))
+        return XML_ERROR_PARSING;
+
+    for (uint32_t i = 0; i < rootCount; ++i)
+    {
+        if (!ReadElement(reader, strings, doc, &doc))
+            return XML_ERROR_PARSING;
+    }
+
+    return XML_SUCCESS;
+}
@@ -0,0 +1,37 @@
+#pragma once
+/** \file BinaryXml.h */
+/** Cooked binary form of XML documents */
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <Utils/TinyXml2/tinyxml2.h>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+    /// Magic number at the beginning of the cooked XML documents, "YXML"
+    constexpr uint32_t kBinaryXmlMagic = 0x4C4D5859;
+
+    /// Version of the cooked XML format, bumped on every layout change
+    constexpr uint32_t kBinaryXmlVersion = 1;
+
+    /// Cooks the document. The output has a table of unique null terminated strings, followed by the element tree
+    /// that references the strings by index. Comments and declarations are dropped
+    /// \param doc - parsed document to cook
+    /// \param output - cooked bytes are appended here
+    void WriteBinaryXml(const tinyxml2::XMLDocument& doc, std::vector<std::byte>& output);
+
+    /// Checks whether the bytes are a cooked XML document
+    /// \param pData - bytes to check
+    /// \param size - number of bytes
+    bool IsBinaryXml(const std::byte* pData, size_t size);
+
+    /// Fills the document from either a cooked or a text XML. Loaders use it for every XML resource,
+    /// so cooked data is picked up automatically and text XML keeps working as the authoring and fallback format
+    /// \param pData - bytes to read
+    /// \param size - number of bytes
+    /// \param doc - empty document to fill
+    /// \return XML_SUCCESS, or the error code
+    tinyxml2::XMLError LoadXmlDocument(const std::byte* pData, size_t size, tinyxml2::XMLDocument& doc);
+}
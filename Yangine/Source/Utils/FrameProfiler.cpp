@@ -0,0 +1,43 @@
+#include "FrameProfiler.h"
+
+using yang::FrameProfiler;
+
+yang::FrameProfiler::ScopedSection::ScopedSection(Section section)
+    : m_section(section)
+    , m_isTiming(FrameProfiler::Get()->IsEnabled())
+{
+    if (m_isTiming)
+    {
+        m_startTime = Clock::now();
+    }
+}
+
+yang::FrameProfiler::ScopedSection::~ScopedSection()
+{
+    if (m_isTiming)
+    {
+        FrameProfiler::Get()->AddTime(m_section, Clock::now() - m_startTime);
+    }
+}
+
+/* static */ FrameProfiler* yang::FrameProfiler::Get()
+{
+    static FrameProfiler s_instance;
+    return &s_instance;
+}
+
+const char* yang::FrameProfiler::GetSectionName(Section section)
+{
+    switch (section)
+    {
+    case Section::kEvents: return "events";
+    case Section::kInput: return "input";
+    case Section::kProcesses: return "processes";
+    case Section::kActors: return "actors";
+    case Section::kCollisions: return "collisions";
+    case Section::kSceneBookkeeping: return "scene_bookkeeping";
+    case Section::kRender: return "render";
+    case Section::kResources: return "resources";
+    default: return "unknown";
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+/** \file FrameProfiler.h */
+/** Per-frame time spent in each engine system */
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \class FrameProfiler */
+/** Singleton that sums up the time the game thread spends in each engine system during a frame. Disabled by default,
+    then a ScopedSection costs a single branch. The sections don't nest, every one covers a separate part of the frame */
+class FrameProfiler
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+    /// \enum Section
+    /// Engine system the time is spent in
+    enum class Section : uint8_t
+    {
+        kEvents,            ///< Dispatching the global and scene events
+        kInput,             ///< Views reading the input
+        kProcesses,         ///< Updating the processes
+        kActors,            ///< Updating the actors and their components
+        kCollisions,        ///< Updating the collision system
+        kSceneBookkeeping,  ///< Spawning, destroying and indexing the actors, unloading the scenes
+        kRender,            ///< Rendering the current scene, including EndDrawing
+        kResources,         ///< Finishing the async loads and trimming the resource cache
+        kMaxSections        ///< Number of sections
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    /** \class ScopedSection */
+    /** Adds the time until the end of its scope to the section */
+    class ScopedSection
+    {
+    public:
+        /// Starts timing if the profiler is enabled
+        /// \param section - section to add the time to
+        ScopedSection(Section section);
+
+        /// Adds the elapsed time to the section
+        ~ScopedSection();
+
+        ScopedSection(const ScopedSection&) = delete;
+        ScopedSection& operator=(const ScopedSection&) = delete;
+
+    private:
+        Section m_section;              ///< Section to add the time to
+        bool m_isTiming;                ///< Was the profiler enabled when the scope started
+        Clock::time_point m_startTime;  ///< When the scope started
+    };
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Get FrameProfiler singleton instance
+    static FrameProfiler* Get();
+
+    /// Resets the section times for a new frame
+    void BeginFrame() { m_sectionTimes.fill(Clock::duration::zero()); }
+
+    /// Adds time to a section of the current frame
+    /// \param section - section to add to
+    /// \param duration - time spent
+    void AddTime(Section section, Clock::duration duration) { m_sectionTimes[static_cast<size_t>(section)] += duration; }
+
+    /// Get name of the section, as used in the stats outputs
+    static const char* GetSectionName(Section section);
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+
+    bool m_isEnabled = false;                                                       ///< Do the scoped sections time anything
+    std::array<Clock::duration, static_cast<size_t>(Section::kMaxSections)> m_sectionTimes{};   ///< Time spent in every section this frame
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Enable or disable timing. Only the game thread may time sections
+    void SetEnabled(bool isEnabled) { m_isEnabled = isEnabled; }
+
+    /// Are the sections timed
+    bool IsEnabled() const { return m_isEnabled; }
+
+    /// Get time spent in the section this frame, in milliseconds
+    float GetSectionTime(Section section) const { return std::chrono::duration<float, std::milli>(m_sectionTimes[static_cast<size_t>(section)]).count(); }
+};
+}
@@ -0,0 +1,552 @@
+#include "Inflate.h"
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+namespace
+{
+    constexpr int kMaxCodeBits = 15;                ///< Longest Huffman code in deflate
+    constexpr int kFastBits = 10;                   ///< Codes up to this length are decoded with a single table lookup
+    constexpr int kMaxLiteralCodes = 288;           ///< Literal/length alphabet size
+    constexpr int kMaxDistanceCodes = 32;           ///< Distance alphabet size
+    constexpr int kCodeLengthCodes = 19;            ///< Code length alphabet size
+    constexpr uint16_t kEndOfBlock = 256;           ///< Literal/length symbol that ends the block
+
+    constexpr uint16_t kLengthBase[] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    constexpr uint8_t kLengthExtraBits[] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    constexpr uint16_t kDistanceBase[] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    constexpr uint8_t kDistanceExtraBits[] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+    constexpr uint8_t kCodeLengthOrder[kCodeLengthCodes] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+    /// Reads the stream least significant bit first through a 64 bit buffer
+    class BitReader
+    {
+    public:
+        BitReader(const uint8_t* pData, size_t size) : m_pCurrent(pData), m_pEnd(pData + size), m_bits(0), m_bitCount(0) {}
+
+        /// Tops the buffer up with whole bytes
+        void Refill()
+        {
+            while (m_bitCount <= 56 && m_pCurrent < m_pEnd)
+            {
+                m_bits |= static_cast<uint64_t>(*m_pCurrent++) << m_bitCount;
+                m_bitCount += 8;
+            }
+        }
+
+        /// Makes sure the buffer has the bits
+        /// \return false if the stream ended
+        bool Ensure(int count)
+        {
+            if (m_bitCount < count)
+            {
+                Refill();
+            }
+            return m_bitCount >= count;
+        }
+
+        /// Get the buffered bits without consuming them. Bits past the end of the stream are zero
+        uint32_t Peek(int count) const { return static_cast<uint32_t>(m_bits & ((uint64_t(1) << count) - 1)); }
+
+        /// Consumes buffered bits
+        void Consume(int count) { m_bits >>= count; m_bitCount -= count; }
+
+        /// Reads the value
+        /// \return false if the stream ended
+        bool Read(int count, uint32_t& value)
+        {
+            if (!Ensure(count))
+                return false;
+
+            value = Peek(count);
+            Consume(count);
+            return true;
+        }
+
+        /// Drops the bits up to the next byte boundary
+        void AlignToByte() { Consume(m_bitCount % 8); }
+
+        /// Get number of buffered bits
+        int GetBitCount() const { return m_bitCount; }
+
+        /// Get the bytes that were not buffered yet
+        const uint8_t* GetCurrent() const { return m_pCurrent; }
+
+    private:
+        const uint8_t* m_pCurrent;      ///< Next byte to buffer
+        const uint8_t* m_pEnd;          ///< Past the last byte
+        uint64_t m_bits;                ///< Buffered bits, next bit is the lowest
+        int m_bitCount;                 ///< Number of buffered bits
+    };
+
+    /// Canonical Huffman decoder with a lookup table for the short codes
+    class HuffmanTable
+    {
+    public:
+        /// Builds the table from the code lengths
+        /// \return false if the lengths are over-subscribed
+        bool Build(const uint8_t* pLengths, int symbolCount)
+        {
+            std::memset(m_lengthCounts, 0, sizeof(m_lengthCounts));
+            std::memset(m_fastTable, 0, sizeof(m_fastTable));
+
+            for (int symbol = 0; symbol < symbolCount; ++symbol)
+            {
+                ++m_lengthCounts[pLengths[symbol]];
+            }
+            m_lengthCounts[0] = 0;
+
+            int left = 1;
+            uint16_t offsets[kMaxCodeBits + 1] = {};
+            for (int length = 1; length <= kMaxCodeBits; ++length)
+            {
+                left = (left << 1) - m_lengthCounts[length];
+                if (left < 0)
+                    return false;
+                if (length < kMaxCodeBits)
+                {
+                    offsets[length + 1] = offsets[length] + m_lengthCounts[length];
+                }
+            }
+
+            // Symbols sorted by code, for the codes that don't fit the fast table
+            for (int symbol = 0; symbol < symbolCount; ++symbol)
+            {
+                if (pLengths[symbol] != 0)
+                {
+                    m_symbols[offsets[pLengths[symbol]]++] = static_cast<uint16_t>(symbol);
+                }
+            }
+
+            // Every fast table entry that starts with a short code holds its symbol and length
+            uint32_t code = 0;
+            int index = 0;
+            for (int length = 1; length <= kFastBits; ++length)
+            {
+                for (int i = 0; i < m_lengthCounts[length]; ++i, ++code, ++index)
+                {
+                    uint32_t reversed = ReverseBits(code, length);
+                    for (uint32_t entry = reversed; entry < (1u << kFastBits); entry += (1u << length))
+                    {
+                        m_fastTable[entry] = static_cast<uint16_t>((m_symbols[index] << 4) | length);
+                    }
+                }
+                code <<= 1;
+            }
+
+            return true;
+        }
+
+        /// Decodes the next symbol
+        /// \return false if the stream ended or the code is invalid
+        bool Decode(BitReader& reader, uint16_t& symbol) const
+        {
+            reader.Ensure(kMaxCodeBits);
+
+            uint16_t entry = m_fastTable[reader.Peek(kFastBits)];
+            if (entry != 0)
+            {
+                int length = entry & 0xF;
+                if (length > reader.GetBitCount())
+                    return false;
+
+                symbol = entry >> 4;
+                reader.Consume(length);
+                return true;
+            }
+
+            // Long code, walk the canonical code one bit at a time
+            int code = 0;
+            int first = 0;
+            int index = 0;
+            for (int length = 1; length <= kMaxCodeBits; ++length)
+            {
+                if (reader.GetBitCount() < length)
+                    return false;
+
+                code |= (reader.Peek(length) >> (length - 1)) & 1;
+                int count = m_lengthCounts[length];
+                if (code - count < first)
+                {
+                    symbol = m_symbols[index + (code - first)];
+                    reader.Consume(length);
+                    return true;
+                }
+
+                index += count;
+                first = (first + count) << 1;
+                code <<= 1;
+            }
+
+            return false;
+        }
+
+    private:
+        uint16_t m_lengthCounts[kMaxCodeBits + 1];      ///< Number of codes of each length
+        uint16_t m_symbols[kMaxLiteralCodes];           ///< Symbols sorted by code
+        uint16_t m_fastTable[1 << kFastBits];           ///< Symbol << 4 | code length, indexed by the next bits. Zero for the long codes
+
+        /// Deflate stores Huffman codes most significant bit first
+        static uint32_t ReverseBits(uint32_t code, int length)
+        {
+            uint32_t reversed = 0;
+            for (int i = 0; i < length; ++i, code >>= 1)
+            {
+                reversed = (reversed << 1) | (code & 1);
+            }
+            return reversed;
+        }
+    };
+
+    /// Writes the decompressed bytes and resolves back references
+    class OutputWindow
+    {
+    public:
+        OutputWindow(uint8_t* pData, size_t size) : m_pBegin(pData), m_pCurrent(pData), m_pEnd(pData + size) {}
+
+        /// Writes the byte
+        /// \return false if the output is full
+        bool WriteLiteral(uint8_t value)
+        {
+            if (m_pCurrent >= m_pEnd)
+                return false;
+
+            *m_pCurrent++ = value;
+            return true;
+        }
+
+        /// Repeats earlier output
+        /// \return false if the distance points before the output or the match doesn't fit
+        bool WriteMatch(size_t length, size_t distance)
+        {
+            if (distance > static_cast<size_t>(m_pCurrent - m_pBegin) || length > static_cast<size_t>(m_pEnd - m_pCurrent))
+                return false;
+
+            // Overlapping matches repeat the last bytes, so the copy has to go forward byte by byte
+            const uint8_t* pSource = m_pCurrent - distance;
+            for (size_t i = 0; i < length; ++i)
+            {
+                m_pCurrent[i] = pSource[i];
+            }
+            m_pCurrent += length;
+            return true;
+        }
+
+        size_t GetWrittenSize() const { return static_cast<size_t>(m_pCurrent - m_pBegin); }
+
+    private:
+        uint8_t* m_pBegin;      ///< First byte of the output
+        uint8_t* m_pCurrent;    ///< Next byte to write
+        uint8_t* m_pEnd;        ///< Past the last byte of the output
+    };
+
+    /// Decodes the compressed block with the given tables
+    bool InflateBlock(BitReader& reader, OutputWindow& output, const HuffmanTable& literals, const HuffmanTable& distances)
+    {
+        for (;;)
+        {
+            uint16_t symbol;
+            if (!literals.Decode(reader, symbol))
+                return false;
+
+            if (symbol < kEndOfBlock)
+            {
+                if (!output.WriteLiteral(static_cast<uint8_t>(symbol)))
+                    return false;
+                continue;
+            }
+
+            if (symbol == kEndOfBlock)
+                return true;
+
+            symbol -= kEndOfBlock + 1;
+            if (symbol >= std::size(kLengthBase))
+                return false;
+
+            uint32_t extra = 0;
+            if (!reader.Read(kLengthExtraBits[symbol], extra))
+                return false;
+            size_t length = kLengthBase[symbol] + extra;
+
+            if (!distances.Decode(reader, symbol) || symbol >= std::size(kDistanceBase))
+                return false;
+            if (!reader.Read(kDistanceExtraBits[symbol], extra))
+                return false;
+            size_t distance = kDistanceBase[symbol] + extra;
+
+            if (!output.WriteMatch(length, distance))
+                return false;
+        }
+    }
+
+    /// Copies the stored block
+    bool InflateStoredBlock(BitReader& reader, OutputWindow& output)
+    {
+        reader.AlignToByte();
+
+        uint32_t length = 0;
+        uint32_t lengthComplement = 0;
+        if (!reader.Read(16, length) || !reader.Read(16, lengthComplement) || length != (~lengthComplement & 0xFFFF))
+            return false;
+
+        for (uint32_t i = 0; i < length; ++i)
+        {
+            uint32_t value = 0;
+            if (!reader.Read(8, value) || !output.WriteLiteral(static_cast<uint8_t>(value)))
+                return false;
+        }
+
+        return true;
+    }
+
+    /// Builds the fixed Huffman tables of block type 1
+    void BuildFixedTables(HuffmanTable& literals, HuffmanTable& distances)
+    {
+        uint8_t lengths[kMaxLiteralCodes];
+        std::memset(lengths, 8, 144);
+        std::memset(lengths + 144, 9, 256 - 144);
+        std::memset(lengths + 256, 7, 280 - 256);
+        std::memset(lengths + 280, 8, kMaxLiteralCodes - 280);
+        literals.Build(lengths, kMaxLiteralCodes);
+
+        std::memset(lengths, 5, kMaxDistanceCodes);
+        distances.Build(lengths, kMaxDistanceCodes);
+    }
+
+    /// Reads the Huffman tables of block type 2
+    bool ReadDynamicTables(BitReader& reader, HuffmanTable& literals, HuffmanTable& distances)
+    {
+        uint32_t literalCount = 0;
+        uint32_t distanceCount = 0;
+        uint32_t codeLengthCount = 0;
+        if (!reader.Read(5, literalCount) || !reader.Read(5, distanceCount) || !reader.Read(4, codeLengthCount))
+            return false;
+
+        literalCount += 257;
+        distanceCount += 1;
+        codeLengthCount += 4;
+        if (literalCount > 286 || distanceCount > 30)
+            return false;
+
+        uint8_t codeLengthLengths[kCodeLengthCodes] = {};
+        for (uint32_t i = 0; i < codeLengthCount; ++i)
+        {
+            uint32_t length = 0;
+            if (!reader.Read(3, length))
+                return false;
+            codeLengthLengths[kCodeLengthOrder[i]] = static_cast<uint8_t>(length);
+        }
+
+        HuffmanTable codeLengths;
+        if (!codeLengths.Build(codeLengthLengths, kCodeLengthCodes))
+            return false;
+
+        // Literal and distance code lengths are one sequence, repeats can cross from one to the other
+        uint8_t lengths[kMaxLiteralCodes + kMaxDistanceCodes] = {};
+        uint32_t index = 0;
+        while (index < literalCount + distanceCount)
+        {
+            uint16_t symbol;
+            if (!codeLengths.Decode(reader, symbol))
+                return false;
+
+            if (symbol < 16)
+            {
+                lengths[index++] = static_cast<uint8_t>(symbol);
+                continue;
+            }
+
+            uint8_t repeatedLength = 0;
+            uint32_t repeatCount = 0;
+            if (symbol == 16)
+            {
+                if (index == 0 || !reader.Read(2, repeatCount))
+                    return false;
+                repeatedLength = lengths[index - 1];
+                repeatCount += 3;
+            }
+            else if (symbol == 17)
+            {
+                if (!reader.Read(3, repeatCount))
+                    return false;
+                repeatCount += 3;
+            }
+            else
+            {
+                if (!reader.Read(7, repeatCount))
+                    return false;
+                repeatCount += 11;
+            }
+
+            if (index + repeatCount > literalCount + distanceCount)
+                return false;
+
+            std::memset(lengths + index, repeatedLength, repeatCount);
+            index += repeatCount;
+        }
+
+        // The block has to be able to end
+        if (lengths[kEndOfBlock] == 0)
+            return false;
+
+        return literals.Build(lengths, literalCount) && distances.Build(lengths + literalCount, distanceCount);
+    }
+
+    /// Decompresses the bare deflate stream
+    /// \param pConsumedEnd - set to the first byte after the stream, to find the container trailer
+    bool InflateStream(const uint8_t* pSource, size_t sourceSize, OutputWindow& output, const uint8_t*& pConsumedEnd)
+    {
+        BitReader reader(pSource, sourceSize);
+        HuffmanTable literals;
+        HuffmanTable distances;
+
+        uint32_t isFinal = 0;
+        do
+        {
+            uint32_t blockType = 0;
+            if (!reader.Read(1, isFinal) || !reader.Read(2, blockType))
+                return false;
+
+            bool succeeded = false;
+            switch (blockType)
+            {
+            case 0:
+                succeeded = InflateStoredBlock(reader, output);
+                break;
+            case 1:
+                BuildFixedTables(literals, distances);
+                succeeded = InflateBlock(reader, output, literals, distances);
+                break;
+            case 2:
+                succeeded = ReadDynamicTables(reader, literals, distances) && InflateBlock(reader, output, literals, distances);
+                break;
+            default:
+                break;
+            }
+
+            if (!succeeded)
+                return false;
+        } while (!isFinal);
+
+        // Whole bytes left in the bit buffer belong to the trailer
+        reader.AlignToByte();
+        pConsumedEnd = reader.GetCurrent() - reader.GetBitCount() / 8;
+        return true;
+    }
+
+    /// Checksum of the zlib trailer
+    uint32_t ComputeAdler32(const uint8_t* pData, size_t size)
+    {
+        constexpr uint32_t kModulo = 65521;
+        constexpr size_t kBlockSize = 5552;     ///< Largest block that can't overflow the sums before the modulo
+
+        uint32_t a = 1;
+        uint32_t b = 0;
+        while (size > 0)
+        {
+            size_t blockSize = size < kBlockSize ? size : kBlockSize;
+            size -= blockSize;
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                a += pData[i];
+                b += a;
+            }
+            pData += blockSize;
+            a %= kModulo;
+            b %= kModulo;
+        }
+        return (b << 16) | a;
+    }
+
+    uint32_t ReadBigEndian32(const uint8_t* pData)
+    {
+        return (uint32_t(pData[0]) << 24) | (uint32_t(pData[1]) << 16) | (uint32_t(pData[2]) << 8) | uint32_t(pData[3]);
+    }
+
+    uint32_t ReadLittleEndian32(const uint8_t* pData)
+    {
+        return uint32_t(pData[0]) | (uint32_t(pData[1]) << 8) | (uint32_t(pData[2]) << 16) | (uint32_t(pData[3]) << 24);
+    }
+
+    /// Skips the gzip header
+    /// \return first byte of the deflate stream, or null if the header is invalid
+    const uint8_t* SkipGzipHeader(const uint8_t* pSource, const uint8_t* pEnd)
+    {
+        constexpr uint8_t kExtraField = 0x04;
+        constexpr uint8_t kFileName = 0x08;
+        constexpr uint8_t kComment = 0x10;
+        constexpr uint8_t kHeaderCrc = 0x02;
+
+        if (pEnd - pSource < 10 || pSource[0] != 0x1F || pSource[1] != 0x8B || pSource[2] != 8)
+            return nullptr;
+
+        uint8_t flags = pSource[3];
+        const uint8_t* pCurrent = pSource + 10;
+        if (flags & kExtraField)
+        {
+            if (pEnd - pCurrent < 2)
+                return nullptr;
+            size_t extraSize = pCurrent[0] | (pCurrent[1] << 8);
+            pCurrent += 2;
+            if (static_cast<size_t>(pEnd - pCurrent) < extraSize)
+                return nullptr;
+            pCurrent += extraSize;
+        }
+
+        for (uint8_t stringFlag : { kFileName, kComment })
+        {
+            if (flags & stringFlag)
+            {
+                pCurrent = static_cast<const uint8_t*>(std::memchr(pCurrent, 0, pEnd - pCurrent));
+                if (!pCurrent)
+                    return nullptr;
+                ++pCurrent;
+            }
+        }
+
+        if (flags & kHeaderCrc)
+        {
+            pCurrent += 2;
+        }
+
+        return pCurrent <= pEnd ? pCurrent : nullptr;
+    }
+}
+
+bool yang::Inflate(const std::byte* pSource, size_t sourceSize, std::byte* pDestination, size_t destinationSize, InflateFormat format)
+{
+    const uint8_t* pCurrent = reinterpret_cast<const uint8_t*>(pSource);
+    const uint8_t* pEnd = pCurrent + sourceSize;
+    OutputWindow output(reinterpret_cast<uint8_t*>(pDestination), destinationSize);
+
+    switch (format)
+    {
+    case InflateFormat::kZlib:
+    {
+        // Deflate method, no preset dictionary, header checksum
+        if (sourceSize < 6 || (pCurrent[0] & 0xF) != 8 || (pCurrent[1] & 0x20) != 0 || ((pCurrent[0] << 8) | pCurrent[1]) % 31 != 0)
+            return false;
+
+        const uint8_t* pTrailer = nullptr;
+        if (!InflateStream(pCurrent + 2, sourceSize - 2, output, pTrailer) || pEnd - pTrailer < 4)
+            return false;
+
+        return output.GetWrittenSize() == destinationSize
+            && ReadBigEndian32(pTrailer) == ComputeAdler32(reinterpret_cast<const uint8_t*>(pDestination), destinationSize);
+    }
+    case InflateFormat::kGzip:
+    {
+        const uint8_t* pStream = SkipGzipHeader(pCurrent, pEnd);
+        const uint8_t* pTrailer = nullptr;
+        if (!pStream || !InflateStream(pStream, pEnd - pStream, output, pTrailer) || pEnd - pTrailer < 8)
+            return false;
+
+        return output.GetWrittenSize() == destinationSize && ReadLittleEndian32(pTrailer + 4) == static_cast<uint32_t>(destinationSize);
+    }
+    default:
+    {
+        const uint8_t* pTrailer = nullptr;
+        return InflateStream(pCurrent, sourceSize, output, pTrailer) && output.GetWrittenSize() == destinationSize;
+    }
+    }
+}
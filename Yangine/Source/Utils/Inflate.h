@@ -0,0 +1,27 @@
+#pragma once
+/** \file Inflate.h */
+/** Decompression of deflate streams (RFC 1951) in zlib (RFC 1950) and gzip (RFC 1952) containers */
+
+#include <cstddef>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+    /// \enum InflateFormat
+    /// Container around the deflate stream
+    enum class InflateFormat
+    {
+        kRaw,           ///< Bare deflate stream
+        kZlib,          ///< zlib header and Adler-32 trailer. The checksum is verified
+        kGzip,          ///< gzip header and CRC-32 trailer. Only the size in the trailer is verified
+    };
+
+    /// Decompresses the deflate stream
+    /// \param pSource - compressed bytes
+    /// \param sourceSize - number of compressed bytes
+    /// \param pDestination - buffer for decompressed bytes
+    /// \param destinationSize - exact size of the decompressed data
+    /// \param format - container around the stream
+    /// \return true if the data was decompressed successfully, false if it is corrupted or doesn't match the size
+    bool Inflate(const std::byte* pSource, size_t sourceSize, std::byte* pDestination, size_t destinationSize, InflateFormat format);
+}
@@ -0,0 +1,165 @@
+#include "LZCompression.h"
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+    constexpr size_t kMinMatchLength = 4;                   ///< Shorter matches cost more than the literals they replace
+    constexpr size_t kMaxOffset = 0xFFFF;                   ///< Offsets are stored in 2 bytes
+    constexpr size_t kHashBits = 14;                        ///< Size of the match finder table
+    constexpr uint8_t kLengthMask = 0xF;                    ///< Mask of a length in the token
+
+    /// Hashes 4 bytes to index the match finder table
+    uint32_t HashSequence(const std::byte* pData)
+    {
+        uint32_t sequence;
+        std::memcpy(&sequence, pData, sizeof(sequence));
+        return (sequence * 2654435761u) >> (32 - kHashBits);
+    }
+
+    /// Writes the part of a length that didn't fit the token
+    void WriteLengthExtension(std::vector<std::byte>& output, size_t length)
+    {
+        length -= kLengthMask;
+        while (length >= 0xFF)
+        {
+            output.push_back(std::byte{ 0xFF });
+            length -= 0xFF;
+        }
+        output.push_back(static_cast<std::byte>(length));
+    }
+
+    /// Reads the part of a length that didn't fit the token
+    /// \return false if the input ended
+    bool ReadLengthExtension(const std::byte*& pSource, const std::byte* pSourceEnd, size_t& length)
+    {
+        uint8_t value;
+        do
+        {
+            if (pSource >= pSourceEnd)
+                return false;
+            value = static_cast<uint8_t>(*pSource++);
+            length += value;
+        } while (value == 0xFF);
+
+        return true;
+    }
+
+    /// Writes a block: literals followed by an optional match
+    void WriteBlock(std::vector<std::byte>& output, const std::byte* pLiterals, size_t literalLength, size_t offset, size_t matchLength)
+    {
+        size_t matchCode = matchLength >= kMinMatchLength ? matchLength - kMinMatchLength : 0;
+        uint8_t token = static_cast<uint8_t>((literalLength < kLengthMask ? literalLength : kLengthMask) << 4);
+        token |= static_cast<uint8_t>(matchCode < kLengthMask ? matchCode : kLengthMask);
+        output.push_back(static_cast<std::byte>(token));
+
+        if (literalLength >= kLengthMask)
+            WriteLengthExtension(output, literalLength);
+
+        output.insert(output.end(), pLiterals, pLiterals + literalLength);
+
+        // The last block has no match
+        if (matchLength == 0)
+            return;
+
+        output.push_back(static_cast<std::byte>(offset & 0xFF));
+        output.push_back(static_cast<std::byte>(offset >> 8));
+
+        if (matchCode >= kLengthMask)
+            WriteLengthExtension(output, matchCode);
+    }
+}
+
+std::vector<std::byte> yang::LZCompress(const std::byte* pSource, size_t size)
+{
+    std::vector<std::byte> output;
+    output.reserve(size / 2 + 16);
+
+    std::vector<int64_t> lastPositions(size_t(1) << kHashBits, -1);
+
+    size_t literalStart = 0;
+    size_t position = 0;
+
+    while (position + kMinMatchLength <= size)
+    {
+        uint32_t hash = HashSequence(pSource + position);
+        int64_t candidate = lastPositions[hash];
+        lastPositions[hash] = static_cast<int64_t>(position);
+
+        if (candidate < 0 || position - static_cast<size_t>(candidate) > kMaxOffset ||
+            std::memcmp(pSource + candidate, pSource + position, kMinMatchLength) != 0)
+        {
+            ++position;
+            continue;
+        }
+
+        size_t matchLength = kMinMatchLength;
+        while (position + matchLength < size && pSource[candidate + matchLength] == pSource[position + matchLength])
+        {
+            ++matchLength;
+        }
+
+        WriteBlock(output, pSource + literalStart, position - literalStart, position - static_cast<size_t>(candidate), matchLength);
+
+        position += matchLength;
+        literalStart = position;
+    }
+
+    WriteBlock(output, pSource + literalStart, size - literalStart, 0, 0);
+    return output;
+}
+
+bool yang::LZDecompress(const std::byte* pSource, size_t sourceSize, std::byte* pDestination, size_t destinationSize)
+{
+    const std::byte* pSourceEnd = pSource + sourceSize;
+    std::byte* pOutput = pDestination;
+    std::byte* pOutputEnd = pDestination + destinationSize;
+
+    while (pSource < pSourceEnd)
+    {
+        uint8_t token = static_cast<uint8_t>(*pSource++);
+
+        size_t literalLength = token >> 4;
+        if (literalLength == kLengthMask && !ReadLengthExtension(pSource, pSourceEnd, literalLength))
+            return false;
+
+        if (literalLength > static_cast<size_t>(pSourceEnd - pSource) || literalLength > static_cast<size_t>(pOutputEnd - pOutput))
+            return false;
+
+        // The output can be null when it is empty, memcpy of null is undefined even for zero bytes
+        if (literalLength > 0)
+        {
+            std::memcpy(pOutput, pSource, literalLength);
+            pOutput += literalLength;
+            pSource += literalLength;
+        }
+
+        // Last block
+        if (pSource == pSourceEnd)
+            break;
+
+        if (pSourceEnd - pSource < 2)
+            return false;
+
+        size_t offset = static_cast<size_t>(pSource[0]) | (static_cast<size_t>(pSource[1]) << 8);
+        pSource += 2;
+
+        size_t matchLength = token & kLengthMask;
+        if (matchLength == kLengthMask && !ReadLengthExtension(pSource, pSourceEnd, matchLength))
+            return false;
+        matchLength += kMinMatchLength;
+
+        if (offset == 0 || offset > static_cast<size_t>(pOutput - pDestination) || matchLength > static_cast<size_t>(pOutputEnd - pOutput))
+            return false;
+
+        // Matches may overlap the output they produce, so it's copied byte by byte
+        const std::byte* pMatch = pOutput - offset;
+        for (size_t i = 0; i < matchLength; ++i)
+        {
+            pOutput[i] = pMatch[i];
+        }
+        pOutput += matchLength;
+    }
+
+    return pOutput == pOutputEnd;
+}
@@ -0,0 +1,25 @@
+#pragma once
+/** \file LZCompression.h */
+/** Small byte oriented LZ77 codec used by the packed resource archives */
+
+#include <vector>
+#include <cstddef>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+    /// Compresses the bytes. The format is a sequence of blocks: token byte (literal length in high 4 bits, match length - 4 in low 4 bits),
+    /// optional length extension bytes, literals, 2 byte little endian match offset, optional match length extension bytes
+    /// \param pSource - bytes to compress
+    /// \param size - number of bytes to compress
+    /// \return compressed bytes
+    std::vector<std::byte> LZCompress(const std::byte* pSource, size_t size);
+
+    /// Decompresses the bytes compressed by LZCompress
+    /// \param pSource - compressed bytes
+    /// \param sourceSize - number of compressed bytes
+    /// \param pDestination - buffer for decompressed bytes
+    /// \param destinationSize - exact size of the decompressed data
+    /// \return true if the data was decompressed successfully, false if it is corrupted or doesn't match the size
+    bool LZDecompress(const std::byte* pSource, size_t sourceSize, std::byte* pDestination, size_t destinationSize);
+}
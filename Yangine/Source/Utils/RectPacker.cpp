@@ -0,0 +1,125 @@
+#include "RectPacker.h"
+#include <algorithm>
+#include <limits>
+
+using yang::RectPacker;
+
+yang::RectPacker::RectPacker(IVec2 pageSize, int padding)
+{
+    Init(pageSize, padding);
+}
+
+void yang::RectPacker::Init(IVec2 pageSize, int padding)
+{
+    m_pageSize = pageSize;
+    m_padding = std::max(padding, 0);
+    m_usedSize = IVec2(0, 0);
+    m_usedArea = 0;
+    m_skyline.clear();
+    m_skyline.push_back(SkylineNode{ 0, 0, pageSize.x });
+}
+
+bool yang::RectPacker::Insert(IVec2 size, IRect& placed)
+{
+    if (size.x <= 0 || size.y <= 0)
+        return false;
+
+    // Every rectangle keeps the padding on its left and top, the page keeps it on the right and bottom
+    int width = size.x + m_padding;
+    int height = size.y + m_padding;
+
+    size_t bestIndex = m_skyline.size();
+    int bestTop = std::numeric_limits<int>::max();
+    int bestWidth = std::numeric_limits<int>::max();
+    int bestY = 0;
+
+    for (size_t i = 0; i < m_skyline.size(); ++i)
+    {
+        int y = 0;
+        if (!Fit(i, width, height, y))
+            continue;
+
+        // Lowest top wins, the narrower segment breaks ties so wide gaps stay open for wide rectangles
+        if (y + height < bestTop || (y + height == bestTop && m_skyline[i].m_width < bestWidth))
+        {
+            bestIndex = i;
+            bestTop = y + height;
+            bestWidth = m_skyline[i].m_width;
+            bestY = y;
+        }
+    }
+
+    if (bestIndex == m_skyline.size())
+        return false;
+
+    IRect usedRect(m_skyline[bestIndex].m_x, bestY, width, height);
+    AddSkylineLevel(bestIndex, usedRect);
+
+    placed = IRect(usedRect.x + m_padding, usedRect.y + m_padding, size.x, size.y);
+    m_usedSize.x = std::max(m_usedSize.x, placed.x + placed.width + m_padding);
+    m_usedSize.y = std::max(m_usedSize.y, placed.y + placed.height + m_padding);
+    m_usedArea += static_cast<size_t>(width) * static_cast<size_t>(height);
+    return true;
+}
+
+bool yang::RectPacker::Fit(size_t index, int width, int height, int& y) const
+{
+    int x = m_skyline[index].m_x;
+    if (x + width > m_pageSize.x - m_padding)
+        return false;
+
+    // The rectangle rests on the highest segment it spans
+    y = 0;
+    for (int widthLeft = width; widthLeft > 0; ++index)
+    {
+        if (index == m_skyline.size())
+            return false;
+
+        y = std::max(y, m_skyline[index].m_y);
+        if (y + height > m_pageSize.y - m_padding)
+            return false;
+
+        widthLeft -= m_skyline[index].m_width;
+    }
+
+    return true;
+}
+
+void yang::RectPacker::AddSkylineLevel(size_t index, const IRect& rect)
+{
+    m_skyline.insert(m_skyline.begin() + index, SkylineNode{ rect.x, rect.y + rect.height, rect.width });
+
+    // Cut the segments the new one covers
+    int right = rect.x + rect.width;
+    for (size_t i = index + 1; i < m_skyline.size(); )
+    {
+        SkylineNode& node = m_skyline[i];
+        if (node.m_x >= right)
+            break;
+
+        int shrink = right - node.m_x;
+        if (node.m_width <= shrink)
+        {
+            m_skyline.erase(m_skyline.begin() + i);
+            continue;
+        }
+
+        node.m_x += shrink;
+        node.m_width -= shrink;
+        break;
+    }
+
+    // Neighbours of the same height become one segment
+    for (size_t i = 0; i + 1 < m_skyline.size(); )
+    {
+        if (m_skyline[i].m_y == m_skyline[i + 1].m_y)
+        {
+            m_skyline[i].m_width += m_skyline[i + 1].m_width;
+            m_skyline.erase(m_skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+/** \file RectPacker.h */
+/** Skyline rectangle packer for texture atlases */
+
+#include <Utils/Rectangle.h>
+#include <Utils/Vector2.h>
+#include <vector>
+
+//! \namespace yang Contains all Yangine code
+namespace yang
+{
+/** \class RectPacker */
+/** Packs rectangles into one fixed size page with the skyline bottom-left heuristic. The packer keeps the top edge
+    of the packed area as a list of horizontal segments and puts every rectangle where its top ends up lowest.
+    Packing is fast and wastes little space when the rectangles are inserted tallest first. A full page does not grow,
+    Insert fails and the caller starts a new page */
+class RectPacker
+{
+public:
+	// --------------------------------------------------------------------- //
+	// Public Member Variables
+	// --------------------------------------------------------------------- //
+
+
+	// --------------------------------------------------------------------- //
+	// Public Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Default Constructor
+    RectPacker() = default;
+
+    /// Constructor
+    /// \param pageSize - width and height of the page
+    /// \param padding - empty pixels kept between the rectangles and around them
+    RectPacker(IVec2 pageSize, int padding = 0);
+
+    /// Empties the page
+    /// \param pageSize - width and height of the page
+    /// \param padding - empty pixels kept between the rectangles and around them
+    void Init(IVec2 pageSize, int padding = 0);
+
+    /// Finds the place for the rectangle and marks it used
+    /// \param size - width and height of the rectangle, without padding
+    /// \param placed - position of the rectangle on the page, without padding
+    /// \return true if the rectangle fit on the page
+    bool Insert(IVec2 size, IRect& placed);
+
+private:
+	// --------------------------------------------------------------------- //
+	// Private Member Variables
+	// --------------------------------------------------------------------- //
+
+    /// \struct SkylineNode
+    /// One horizontal segment of the top edge of the packed area
+    struct SkylineNode
+    {
+        int m_x;            ///< Left end of the segment
+        int m_y;            ///< Height of the packed area under the segment
+        int m_width;        ///< Length of the segment
+    };
+
+    std::vector<SkylineNode> m_skyline;     ///< Segments from left to right, covering the whole page width
+    IVec2 m_pageSize;                       ///< Width and height of the page
+    IVec2 m_usedSize;                       ///< Right and bottom edge of the rectangles packed so far
+    int m_padding = 0;                      ///< Empty pixels kept between the rectangles and around them
+    size_t m_usedArea = 0;                  ///< Area of the packed rectangles, with padding
+
+	// --------------------------------------------------------------------- //
+	// Private Member Functions
+	// --------------------------------------------------------------------- //
+
+    /// Finds the height a rectangle starting at the segment would be placed at
+    /// \param index - index of the leftmost segment under the rectangle
+    /// \param width - width of the rectangle
+    /// \param height - height of the rectangle
+    /// \param y - height the rectangle would be placed at
+    /// \return true if the rectangle fits there
+    bool Fit(size_t index, int width, int height, int& y) const;
+
+    /// Raises the skyline under the placed rectangle and merges the segments of the same height
+    /// \param index - index of the leftmost segment under the rectangle
+    /// \param rect - placed rectangle
+    void AddSkylineLevel(size_t index, const IRect& rect);
+
+public:
+	// --------------------------------------------------------------------- //
+	// Accessors & Mutators
+	// --------------------------------------------------------------------- //
+
+    /// Get width and height of the page
+    IVec2 GetPageSize() const { return m_pageSize; }
+
+    /// Get smallest width and height the packed rectangles fit in. Pages can be cropped to it
+    IVec2 GetUsedSize() const { return m_usedSize; }
+
+    /// Get fraction of the used page area covered by the packed rectangles and their padding
+    float GetOccupancy() const { return m_usedSize.x > 0 && m_usedSize.y > 0 ? static_cast<float>(m_usedArea) / (static_cast<float>(m_usedSize.x) * static_cast<float>(m_usedSize.y)) : 0.f; }
+};
+}
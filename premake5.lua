@@ -124,4 +124,181 @@ project "Engine"
         defines { "NDEBUG" }
 		optimize "Full"
 
-	
\ No newline at end of file
+	
+project "AssetPacker"
+	kind "ConsoleApp"
+	location "Tools/AssetPacker"
+	includedirs {"Yangine/Source", "Toolset/Include", "Tools/AssetPacker/Source"}
+	files {"Tools/AssetPacker/Source/**.h", "Tools/AssetPacker/Source/**.cpp"}
+	links {"Engine", "vld", "Box2D_$(PlatformShortName)_$(Configuration)", "SDL2", "SDL2_image", "SDL2_mixer", "SDL2_ttf", "SDL2main", "Lua-5.3.5_$(PlatformShortName)_$(Configuration)"}
+	
+	postbuildcommands { 'xcopy "$(SolutionDir)Toolset\\$(PlatformShortName)\\*.dll" "$(OutDir)" /d /i /y' }
+	
+	filter {"platforms:x86"}
+		libdirs{"Toolset/x86"}
+		
+	filter {"platforms:x64"}
+		libdirs{"Toolset/x64"}
+	
+	filter {"configurations:Debug", "platforms:x86"}
+		architecture "x86"
+		targetdir "Tools/AssetPacker/Builds/Debug_x86"
+		libdirs "Yangine/Binaries/Debug_x86"
+		
+	filter {"configurations:Release", "platforms:x86"}
+		architecture "x86"
+		targetdir "Tools/AssetPacker/Builds/Release_x86"
+		libdirs "Yangine/Binaries/Release_x86"
+		
+	filter {"configurations:Debug", "platforms:x64"}
+		architecture "x86_64"
+		targetdir "Tools/AssetPacker/Builds/Debug_x64"
+		libdirs "Yangine/Binaries/Debug_x64"
+		
+	filter {"configurations:Release", "platforms:x64"}
+		architecture "x86_64"
+		targetdir "Tools/AssetPacker/Builds/Release_x64"
+		libdirs "Yangine/Binaries/Release_x64"
+	
+	filter "configurations:Debug"
+        defines { "DEBUG" }
+        symbols "On"
+
+    filter "configurations:Release"
+        defines { "NDEBUG" }
+		optimize "Full"
+
+project "AssetCooker"
+	kind "ConsoleApp"
+	location "Tools/AssetCooker"
+	includedirs {"Yangine/Source", "Toolset/Include", "Tools/AssetCooker/Source"}
+	files {"Tools/AssetCooker/Source/**.h", "Tools/AssetCooker/Source/**.cpp"}
+	links {"Engine", "vld", "Box2D_$(PlatformShortName)_$(Configuration)", "SDL2", "SDL2_image", "SDL2_mixer", "SDL2_ttf", "SDL2main", "Lua-5.3.5_$(PlatformShortName)_$(Configuration)"}
+	
+	postbuildcommands { 'xcopy "$(SolutionDir)Toolset\\$(PlatformShortName)\\*.dll" "$(OutDir)" /d /i /y' }
+	
+	filter {"platforms:x86"}
+		libdirs{"Toolset/x86"}
+		
+	filter {"platforms:x64"}
+		libdirs{"Toolset/x64"}
+	
+	filter {"configurations:Debug", "platforms:x86"}
+		architecture "x86"
+		targetdir "Tools/AssetCooker/Builds/Debug_x86"
+		libdirs "Yangine/Binaries/Debug_x86"
+		
+	filter {"configurations:Release", "platforms:x86"}
+		architecture "x86"
+		targetdir "Tools/AssetCooker/Builds/Release_x86"
+		libdirs "Yangine/Binaries/Release_x86"
+		
+	filter {"configurations:Debug", "platforms:x64"}
+		architecture "x86_64"
+		targetdir "Tools/AssetCooker/Builds/Debug_x64"
+		libdirs "Yangine/Binaries/Debug_x64"
+		
+	filter {"configurations:Release", "platforms:x64"}
+		architecture "x86_64"
+		targetdir "Tools/AssetCooker/Builds/Release_x64"
+		libdirs "Yangine/Binaries/Release_x64"
+	
+	filter "configurations:Debug"
+        defines { "DEBUG" }
+        symbols "On"
+
+    filter "configurations:Release"
+        defines { "NDEBUG" }
+		optimize "Full"
+
+	
+
+project "PathfindingBenchmark"
+	kind "ConsoleApp"
+	location "Tools/PathfindingBenchmark"
+	includedirs {"Yangine/Source", "Toolset/Include", "Tools/PathfindingBenchmark/Source"}
+	files {"Tools/PathfindingBenchmark/Source/**.h", "Tools/PathfindingBenchmark/Source/**.cpp"}
+	links {"Engine", "vld", "Box2D_$(PlatformShortName)_$(Configuration)", "SDL2", "SDL2_image", "SDL2_mixer", "SDL2_ttf", "SDL2main", "Lua-5.3.5_$(PlatformShortName)_$(Configuration)"}
+	
+	postbuildcommands { 'xcopy "$(SolutionDir)Toolset\\$(PlatformShortName)\\*.dll" "$(OutDir)" /d /i /y' }
+	
+	filter {"platforms:x86"}
+		libdirs{"Toolset/x86"}
+		
+	filter {"platforms:x64"}
+		libdirs{"Toolset/x64"}
+	
+	filter {"configurations:Debug", "platforms:x86"}
+		architecture "x86"
+		targetdir "Tools/PathfindingBenchmark/Builds/Debug_x86"
+		libdirs "Yangine/Binaries/Debug_x86"
+		
+	filter {"configurations:Release", "platforms:x86"}
+		architecture "x86"
+		targetdir "Tools/PathfindingBenchmark/Builds/Release_x86"
+		libdirs "Yangine/Binaries/Release_x86"
+		
+	filter {"configurations:Debug", "platforms:x64"}
+		architecture "x86_64"
+		targetdir "Tools/PathfindingBenchmark/Builds/Debug_x64"
+		libdirs "Yangine/Binaries/Debug_x64"
+		
+	filter {"configurations:Release", "platforms:x64"}
+		architecture "x86_64"
+		targetdir "Tools/PathfindingBenchmark/Builds/Release_x64"
+		libdirs "Yangine/Binaries/Release_x64"
+	
+	filter "configurations:Debug"
+        defines { "DEBUG" }
+        symbols "On"
+
+    filter "configurations:Release"
+        defines { "NDEBUG" }
+		optimize "Full"
+
+	
+
+project "EngineBenchmark"
+	kind "ConsoleApp"
+	location "Tools/EngineBenchmark"
+	includedirs {"Yangine/Source", "Toolset/Include", "Tools/EngineBenchmark/Source"}
+	files {"Tools/EngineBenchmark/Source/**.h", "Tools/EngineBenchmark/Source/**.cpp"}
+	links {"Engine", "vld", "Box2D_$(PlatformShortName)_$(Configuration)", "SDL2", "SDL2_image", "SDL2_mixer", "SDL2_ttf", "SDL2main", "Lua-5.3.5_$(PlatformShortName)_$(Configuration)"}
+	
+	postbuildcommands { 'xcopy "$(SolutionDir)Toolset\\$(PlatformShortName)\\*.dll" "$(OutDir)" /d /i /y' }
+	
+	filter {"platforms:x86"}
+		libdirs{"Toolset/x86"}
+		
+	filter {"platforms:x64"}
+		libdirs{"Toolset/x64"}
+	
+	filter {"configurations:Debug", "platforms:x86"}
+		architecture "x86"
+		targetdir "Tools/EngineBenchmark/Builds/Debug_x86"
+		libdirs "Yangine/Binaries/Debug_x86"
+		
+	filter {"configurations:Release", "platforms:x86"}
+		architecture "x86"
+		targetdir "Tools/EngineBenchmark/Builds/Release_x86"
+		libdirs "Yangine/Binaries/Release_x86"
+		
+	filter {"configurations:Debug", "platforms:x64"}
+		architecture "x86_64"
+		targetdir "Tools/EngineBenchmark/Builds/Debug_x64"
+		libdirs "Yangine/Binaries/Debug_x64"
+		
+	filter {"configurations:Release", "platforms:x64"}
+		architecture "x86_64"
+		targetdir "Tools/EngineBenchmark/Builds/Release_x64"
+		libdirs "Yangine/Binaries/Release_x64"
+	
+	filter "configurations:Debug"
+        defines { "DEBUG" }
+        symbols "On"
+
+    filter "configurations:Release"
+        defines { "NDEBUG" }
+		optimize "Full"
+
+	